@@ -0,0 +1,231 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file Consensusr.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/json.hpp"
+
+#include "Consensusr.h"
+#include "chains/Schain.h"
+#include "crypto/BLAKE3Hash.h"
+#include "crypto/CryptoManager.h"
+#include "crypto/ThresholdSignature.h"
+#include "datastructures/BlockProposal.h"
+#include "datastructures/CommittedBlockList.h"
+#include "datastructures/DAProof.h"
+#include "db/BlockProposalDB.h"
+#include "messages/NetworkMessage.h"
+#include "messages/NetworkMessageEnvelope.h"
+#include "network/ConsensusTrace.h"
+#include "network/Network.h"
+#include "node/ConsensusEngine.h"
+#include "node/Node.h"
+
+// Replays a trace recorded with consensusTraceFile into a single live node as fast as possible
+// and reports per stage latencies. Peers are not started, so outgoing traffic of the replay
+// node is lost.
+
+static uint64_t elapsedUs( const chrono::steady_clock::time_point& _start ) {
+    return chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - _start )
+        .count();
+}
+
+
+static void replayNetworkMessage( const ptr< Network >& _network, const ptr< TraceRecord >& _rec,
+    ReplayStageStats& _parseStats, ReplayStageStats& _verifyStats,
+    ReplayStageStats& _dispatchStats ) {
+    auto start = chrono::steady_clock::now();
+    auto msg = _network->parseNetworkMessage( _rec->payload );
+    _parseStats.addSample( elapsedUs( start ) );
+
+    if ( !msg ) {
+        _parseStats.addFailure();
+        return;
+    }
+
+    start = chrono::steady_clock::now();
+    auto envelope = _network->createVerifiedEnvelope( msg );
+    _verifyStats.addSample( elapsedUs( start ) );
+
+    start = chrono::steady_clock::now();
+    _network->dispatchReceivedMessage( envelope );
+    _dispatchStats.addSample( elapsedUs( start ) );
+}
+
+
+static void replayProposal(
+    Schain* _sChain, const ptr< TraceRecord >& _rec, ReplayStageStats& _stats ) {
+    auto start = chrono::steady_clock::now();
+    auto data = make_shared< vector< uint8_t > >( _rec->payload.begin(), _rec->payload.end() );
+    auto proposal = BlockProposal::deserialize( data, _sChain->getCryptoManager(), true );
+    CHECK_STATE( proposal );
+    _sChain->proposedBlockArrived( proposal );
+    _stats.addSample( elapsedUs( start ) );
+}
+
+
+static void replayDAProof(
+    Schain* _sChain, const ptr< TraceRecord >& _rec, ReplayStageStats& _stats ) {
+    auto start = chrono::steady_clock::now();
+    auto proofJson = nlohmann::json::parse( _rec->payload );
+    auto blockHash = BLAKE3Hash::fromHex( proofJson["hash"].get< string >() );
+
+    auto sig = _sChain->getCryptoManager()->verifyDAProofThresholdSig(
+        blockHash, proofJson["sig"].get< string >(), block_id( _rec->blockID ), uint64_t( -1 ) );
+    CHECK_STATE( sig );
+
+    auto proposal = _sChain->getNode()->getBlockProposalDB()->getBlockProposal(
+        block_id( _rec->blockID ), schain_index( _rec->srcIndex ) );
+
+    if ( !proposal ) {
+        // the proposal was regenerated locally or never arrived
+        _stats.addFailure();
+        return;
+    }
+
+    _sChain->daProofArrived( make_shared< DAProof >( proposal, sig ) );
+    _stats.addSample( elapsedUs( start ) );
+}
+
+
+static void replayCatchup(
+    Schain* _sChain, const ptr< TraceRecord >& _rec, ReplayStageStats& _stats ) {
+    auto start = chrono::steady_clock::now();
+
+    auto lineEnd = _rec->payload.find( '\n' );
+    CHECK_STATE( lineEnd != string::npos );
+
+    auto sizesJson = nlohmann::json::parse( _rec->payload.substr( 0, lineEnd ) );
+    auto sizes = make_shared< vector< uint64_t > >( sizesJson["sizes"].get< vector< uint64_t > >() );
+    auto data = make_shared< vector< uint8_t > >( _rec->payload.begin(), _rec->payload.end() );
+
+    auto blocks =
+        CommittedBlockList::deserialize( _sChain->getCryptoManager(), sizes, data, lineEnd + 1 );
+
+    ( void ) _sChain->blockCommitsArrivedThroughCatchup( blocks, 0 );
+    _stats.addSample( elapsedUs( start ) );
+}
+
+
+int main( int argc, char** argv ) {
+    signal( SIGPIPE, SIG_IGN );
+
+    if ( argc < 4 ) {
+        printf( "Usage: consensusr nodes_dir node_id trace_file\n" );
+        exit( 1 );
+    }
+
+    auto nodeID = node_id( stoull( argv[2] ) );
+
+    ConsensusTraceReader reader( argv[3] );
+
+    ConsensusEngine engine( 0, 100000000 );
+    engine.getNodeIDs().insert( nodeID );
+
+    fs_path dirPath( boost::filesystem::system_complete( fs_path( argv[1] ) ) );
+    engine.parseTestConfigsAndCreateAllNodes( dirPath );
+    engine.slowStartBootStrapTest();
+
+    auto node = engine.getNode( nodeID );
+    CHECK_STATE2( node, "Node not found in config dir:" + to_string( nodeID ) );
+
+    auto sChain = node->getSchain();
+    auto network = node->getNetwork();
+
+    CHECK_STATE2( ( uint64_t ) sChain->getSchainIndex() == reader.getSchainIndex(),
+        "Trace was recorded by schain index " + to_string( reader.getSchainIndex() ) );
+
+    ReplayStageStats parseStats( "msg_parse" );
+    ReplayStageStats verifyStats( "msg_verify" );
+    ReplayStageStats dispatchStats( "msg_dispatch" );
+    ReplayStageStats proposalStats( "proposal" );
+    ReplayStageStats daProofStats( "da_proof" );
+    ReplayStageStats catchupStats( "catchup" );
+
+    auto startBlock = sChain->getLastCommittedBlockID();
+    auto wallStart = chrono::steady_clock::now();
+    uint64_t records = 0;
+
+    while ( auto rec = reader.readNext() ) {
+        records++;
+        try {
+            switch ( rec->type ) {
+            case TRACE_CONSENSUS_MESSAGE:
+                replayNetworkMessage( network, rec, parseStats, verifyStats, dispatchStats );
+                break;
+            case TRACE_BLOCK_PROPOSAL:
+                replayProposal( sChain, rec, proposalStats );
+                break;
+            case TRACE_DA_PROOF:
+                replayDAProof( sChain, rec, daProofStats );
+                break;
+            case TRACE_CATCHUP_BLOCKS:
+                replayCatchup( sChain, rec, catchupStats );
+                break;
+            default:
+                LOG( err, "Unknown trace record type:" << to_string( rec->type ) );
+            }
+        } catch ( exception& e ) {
+            SkaleException::logNested( e );
+            switch ( rec->type ) {
+            case TRACE_CONSENSUS_MESSAGE:
+                dispatchStats.addFailure();
+                break;
+            case TRACE_BLOCK_PROPOSAL:
+                proposalStats.addFailure();
+                break;
+            case TRACE_DA_PROOF:
+                daProofStats.addFailure();
+                break;
+            default:
+                catchupStats.addFailure();
+            }
+        }
+    }
+
+    // let the message thread drain the queue
+    uint64_t lastBlock = 0;
+    do {
+        lastBlock = sChain->getLastCommittedBlockID();
+        usleep( 500 * 1000 );
+    } while ( lastBlock != sChain->getLastCommittedBlockID() );
+
+    auto wallUs = elapsedUs( wallStart );
+
+    cout << "records: " << records << " wall_ms: " << wallUs / 1000 << endl;
+    cout << "blocks committed: " << lastBlock - ( uint64_t ) startBlock << endl;
+
+    parseStats.print( cout );
+    verifyStats.print( cout );
+    dispatchStats.print( cout );
+    proposalStats.print( cout );
+    daProofStats.print( cout );
+    catchupStats.print( cout );
+
+    engine.exitGracefully();
+
+    while ( engine.getStatus() != CONSENSUS_EXITED ) {
+        usleep( 100 * 1000 );
+    }
+}
@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file Consensusr.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// per stage latency samples collected while replaying a consensus trace
+class ReplayStageStats {
+    string name;
+    vector< uint64_t > samplesUs;
+    uint64_t failures = 0;
+
+public:
+    explicit ReplayStageStats( const string& _name ) : name( _name ) {}
+
+    void addSample( uint64_t _us ) { samplesUs.push_back( _us ); }
+
+    void addFailure() { failures++; }
+
+    void print( ostream& _out ) {
+        if ( samplesUs.empty() && failures == 0 )
+            return;
+
+        uint64_t total = 0;
+        for ( auto&& s : samplesUs )
+            total += s;
+
+        sort( samplesUs.begin(), samplesUs.end() );
+
+        auto percentile = [&]( uint64_t _p ) -> uint64_t {
+            if ( samplesUs.empty() )
+                return 0;
+            return samplesUs.at( ( samplesUs.size() - 1 ) * _p / 100 );
+        };
+
+        _out << name << ": count " << samplesUs.size() << " failed " << failures << " avg_us "
+             << ( samplesUs.empty() ? 0 : total / samplesUs.size() ) << " p50_us "
+             << percentile( 50 ) << " p99_us " << percentile( 99 ) << " max_us "
+             << percentile( 100 ) << endl;
+    }
+};
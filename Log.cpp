@@ -42,6 +42,8 @@ void SkaleLog::setGlobalLogLevel( string& _s ) {
         item.second->set_level( globalLogLevel );
     }
 
+    updateMinLogLevel();
+
     ConsensusEngine::setConfigLogLevel( _s );
 }
 
@@ -114,6 +116,17 @@ SkaleLog::SkaleLog( node_id _nodeID, ConsensusEngine* _engine ) {
     loggers["Datastructures"] = dataStructuresLogger;
     pendingQueueLogger = _engine->createLogger( prefix + "pending" );
     loggers["Pending"] = pendingQueueLogger;
+
+    updateMinLogLevel();
+}
+
+
+void SkaleLog::updateMinLogLevel() {
+    auto level = spdlog::level::off;
+    for ( auto&& item : loggers ) {
+        level = min( level, item.second->level() );
+    }
+    minLogLevel = level;
 }
 
 
@@ -52,12 +52,17 @@ class logger;
 #define __CLASS_NAME__ className( __PRETTY_FUNCTION__ )
 
 
+// The message is not evaluated if the severity is disabled. The class name is parsed once
+// per call site
 #define LOG( __SEVERITY__, __MESSAGE__ )                                                  \
     {                                                                                     \
-        std::stringstream __TMP__LOG__STREAM__;                                           \
-        __TMP__LOG__STREAM__ << __MESSAGE__;                                              \
-        ConsensusEngine::log(                                                             \
-            __SEVERITY__, __TMP__LOG__STREAM__.str(), className( __PRETTY_FUNCTION__ ) ); \
+        if ( SkaleLog::isEnabled( __SEVERITY__ ) ) {                                      \
+            static const string __TMP__LOG__CLASS__ = className( __PRETTY_FUNCTION__ );   \
+            std::stringstream __TMP__LOG__STREAM__;                                       \
+            __TMP__LOG__STREAM__ << __MESSAGE__;                                          \
+            ConsensusEngine::log(                                                         \
+                __SEVERITY__, __TMP__LOG__STREAM__.str(), __TMP__LOG__CLASS__ );          \
+        }                                                                                 \
     }
 
 
@@ -82,13 +87,26 @@ public:
 
     level_enum globalLogLevel;
 
+    // the lowest level any of the loggers writes
+    atomic< int > minLogLevel = spdlog::level::trace;
+
 
     void setGlobalLogLevel( string& _s );
 
+    // must be called after the level of a logger changes
+    void updateMinLogLevel();
+
 
     shared_ptr< spdlog::logger > loggerForClass( const char* _className );
 
 
     static level_enum logLevelFromString( string& _s );
+
+    static bool isEnabled( level_enum _severity ) {
+        auto& log = logThreadLocal_;
+        if ( log )
+            return _severity >= log->minLogLevel.load( memory_order_relaxed );
+        return ConsensusEngine::isConfigLogEnabled( _severity );
+    }
 };
 #endif
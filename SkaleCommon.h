@@ -150,6 +150,13 @@ using namespace std;
 
 static const uint64_t LEVELDB_SHARDS = 4;
 
+// the newest shard is rescanned every time 1 / DB_SIZE_SCANS_PER_SHARD of its size limit is
+// written to it
+static const uint64_t DB_SIZE_SCANS_PER_SHARD = 64;
+
+// the rotation thread has no signal for the node exit, so it checks it this often
+static const uint64_t DB_ROTATION_POLL_MS = 1000;
+
 
 static const uint64_t MAX_ACTIVE_CONSENSUSES = 5;
 
@@ -209,11 +216,22 @@ static constexpr uint64_t MAX_DEFERRED_QUEUE_SIZE_FOR_BLOCK = 1024;
 
 static const uint64_t KNOWN_TRANSACTIONS_HISTORY = 2 * MAX_TRANSACTIONS_PER_BLOCK;
 static const uint64_t MAX_KNOWN_TRANSACTIONS_TOTAL_SIZE = 256 * 1024 * 1024;  // 256 MBYTE FOR NOW
+// number of keys a batched partial hash lookup prefetches ahead of the probe
+static const uint64_t PARTIAL_HASH_PREFETCH_DISTANCE = 8;
+// relocations a cuckoo filter insert tries before the filter is considered full
+static const uint64_t CUCKOO_FILTER_MAX_KICKS = 500;
+// keys per committed transaction filter, fits into 256K buckets of 8 bytes
+static const uint64_t COMMITTED_TRANSACTIONS_FILTER_CAPACITY = 900000;
+// newest blocks whose unsynced database writes are checked and repaired on startup
+static const uint64_t BLOCK_COMMIT_REPAIR_WINDOW = 1024;
 
 static const uint64_t KNOWN_MSG_HASHES_SIZE = 1024;
 
 static const uint64_t LEVELDB_STATS_HISTORY = 8;
 
+// fixed point scale of the block size and block time moving averages
+static const uint64_t BLOCK_AVERAGE_SCALE = 256;
+
 static const int ZMQ_TIMEOUT = 1000;
 
 static const int CONSENSUS_ZMQ_HWM = 32;
@@ -235,7 +253,8 @@ enum port_type {
     BINARY_CONSENSUS = 4,
     ZMQ_BROADCAST = 5,
     MTA = 6,
-    STATUS = 10
+    STATUS = 10,
+    METRICS = 11
 };
 
 
@@ -326,10 +345,22 @@ static const num_threads NUM_ORACLE_THREADS = num_threads( 1 );
 static const uint64_t ORACLE_QUEUE_TIMEOUT_MS = 1000;
 static const uint64_t ORACLE_TIMEOUT_MS = 30000;
 static const uint64_t ORACLE_REQUEST_AGE_ON_RECEIPT_MS = 10000;
+static const uint64_t ORACLE_HTTP_TIMEOUT_MS = 2000;
+static const uint64_t ORACLE_FETCH_POLL_MS = 100;
+static const uint64_t ORACLE_MAX_CONNECTIONS_PER_HOST = 8;
+static const uint64_t ORACLE_MAX_TOTAL_CONNECTIONS = 256;
+static const uint64_t ORACLE_RESPONSE_CACHE_SIZE = 1000;
+static const uint64_t ORACLE_SIGNED_RESULTS_CACHE_SIZE = 1000;
 
 
 static const uint64_t DEFAULT_DB_STORAGE_LIMIT = 5000000000;  // 5Gbyte
 
+static const uint64_t DEFAULT_DECODED_BLOCK_CACHE_BYTES = 64000000;
+
+// newest blocks whose metadata index records are rebuilt on startup. Older blocks missing from
+// the index stay missing, reads of them always go to BlockDB and PriceDB
+static const uint64_t BLOCK_METADATA_REBUILD_WINDOW = 1024;
+
 static const uint64_t MAX_DELAYED_MESSAGE_SENDS = 128;
 
 static const uint64_t MAX_PROPOSAL_QUEUE_SIZE = 4;
@@ -338,6 +369,69 @@ static const uint64_t SGX_SSL_PORT = 1026;
 
 static const uint64_t BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS = 30000;
 
+// the adaptive proposal receipt timeout waits for a missing proposer until its DA proof is later
+// than this percentile of its recent DA proofs, times the factor
+static const uint64_t PROPOSAL_ARRIVAL_PERCENTILE = 99;
+
+static const uint64_t PROPOSAL_ARRIVAL_TIMEOUT_FACTOR = 2;
+
+static const uint64_t PROPOSAL_ARRIVAL_WINDOW = 64;
+
+// below this many samples the fixed BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS applies
+static const uint64_t PROPOSAL_ARRIVAL_MIN_SAMPLES = 16;
+
+// lower bound of the adaptive timeout, so that a missing live proposer always gets some slack
+// over its learned latency
+static const uint64_t PROPOSAL_RECEIPT_MIN_TIMEOUT_MS = 500;
+
+// the deferred messages loop also wakes up on every block commit
+static const uint64_t DEFERRED_MESSAGES_POLL_MS = 1000;
+
+static const uint64_t FINALIZE_SCHEDULER_POLL_MS = 50;
+
+static const uint64_t FINALIZE_DEFAULT_FRAGMENT_LATENCY_MS = 1000;
+
+static const uint64_t FINALIZE_MAX_REQUESTS_PER_FRAGMENT = 3;
+
+static const uint64_t FINALIZE_RACE_FRAGMENTS = 2;
+
+// subsets of erasure coded fragments decoded before one more fragment is downloaded, a corrupt
+// fragment fails every subset it is in
+static const uint64_t FINALIZE_MAX_DECODE_ATTEMPTS = 64;
+
+static const uint64_t CATCHUP_MAX_PARALLEL_REQUESTS = 4;
+
+static const uint64_t CATCHUP_SCHEDULER_POLL_MS = 100;
+
+static const uint64_t CATCHUP_INITIAL_CHUNK_BLOCKS = 64;
+
+static const uint64_t CATCHUP_MIN_CHUNK_BLOCKS = 16;
+
+static const uint64_t CATCHUP_MAX_CHUNK_BLOCKS = 4096;
+
+// a chunk should take this long to download, and many times the peer latency
+static const uint64_t CATCHUP_TARGET_CHUNK_MS = 2000;
+
+static const uint64_t CATCHUP_LATENCY_FACTOR = 8;
+
+static const uint64_t CATCHUP_FAILED_PEER_BACKOFF_MS = 1000;
+
+static const uint64_t CATCHUP_VERIFY_THREADS = 8;
+
+// a catchup response is rejected before inflating if its blocks decompress to more than this
+// many times the maximum download size
+static const uint64_t CATCHUP_MAX_INFLATE_FACTOR = 4;
+
+// catchup saves this many blocks at once before passing them to the EVM. Bootstrap
+// refuses to start if consensus is more than 128 blocks ahead of the EVM
+static const uint64_t CATCHUP_BLOCK_SAVE_BATCH = 64;
+
+// log records waiting for the background log writer
+static const uint64_t LOG_QUEUE_SIZE = 65536;
+
+// deflate level, 1 is fastest and 10 is smallest
+static const uint64_t BLOCK_COMPRESSION_LEVEL = 6;
+
 static const uint64_t REBROADCAST_TIMEOUT_MS = 120000;
 
 static const uint64_t ZMQ_RECEIVE_RETRY_MS = 10;
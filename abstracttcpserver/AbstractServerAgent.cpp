@@ -108,11 +108,9 @@ void AbstractServerAgent::workerThreadConnectionProcessingLoop( void* _params )
 void AbstractServerAgent::send(
     const ptr< ServerConnection >& _connectionEnvelope, const ptr< Header >& _header ) {
     CHECK_ARGUMENT( _connectionEnvelope );
-    CHECK_ARGUMENT( _header );
-    CHECK_ARGUMENT( _header->isComplete() );
 
-    auto buf = _header->toBuffer();
-    getSchain()->getIo()->writeBuf( _connectionEnvelope->getDescriptor(), buf );
+    getSchain()->getIo()->writeHeader(
+        _connectionEnvelope->getDescriptor(), _connectionEnvelope->getIP(), _header );
 }
 
 AbstractServerAgent::AbstractServerAgent(
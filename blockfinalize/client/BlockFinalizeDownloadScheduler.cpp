@@ -0,0 +1,230 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockFinalizeDownloadScheduler.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "exceptions/ConnectionRefusedException.h"
+#include "exceptions/ExitRequestedException.h"
+#include "exceptions/FatalError.h"
+
+#include "chains/Schain.h"
+#include "node/ConsensusEngine.h"
+#include "node/Node.h"
+#include "utils/Time.h"
+
+#include "BlockFinalizeDownloader.h"
+#include "BlockFinalizeDownloaderThreadPool.h"
+#include "FragmentDownloadPlan.h"
+
+#include "BlockFinalizeDownloadScheduler.h"
+
+
+uint64_t PeerDownloadStats::getThroughputBytesPerSec() const {
+    if ( busyMs == 0 )
+        return 0;
+    return bytes * 1000 / busyMs;
+}
+
+
+BlockFinalizeDownloadScheduler::BlockFinalizeDownloadScheduler( Schain& _sChain )
+    : Agent( _sChain, false ), peerStats( ( uint64_t ) _sChain.getNodeCount() + 1 ) {
+    try {
+        logThreadLocal_ = _sChain.getNode()->getLog();
+
+        if ( _sChain.getNodeCount() > 1 ) {
+            threadPool = make_shared< BlockFinalizeDownloaderThreadPool >(
+                ( uint64_t ) _sChain.getNodeCount(), this );
+            threadPool->startService();
+        }
+    } catch ( ExitRequestedException& ) {
+        throw;
+    } catch ( ... ) {
+        throw_with_nested( FatalError( __FUNCTION__, __CLASS_NAME__ ) );
+    }
+}
+
+
+BlockFinalizeDownloadScheduler::~BlockFinalizeDownloadScheduler() {}
+
+
+void BlockFinalizeDownloadScheduler::download( BlockFinalizeDownloader* _downloader ) {
+    CHECK_ARGUMENT( _downloader )
+
+    auto nodeCount = ( uint64_t ) getSchain()->getNodeCount();
+
+    auto job = make_shared< Job >();
+    job->downloader = _downloader;
+    job->plan = make_shared< FragmentDownloadPlan >( nodeCount - 1,
+        _downloader->getTargetFragments(), nodeCount,
+        ( uint64_t ) getSchain()->getSchainIndex() );
+
+    // a repeated download after a failed decode only fetches new fragments
+    for ( auto index : _downloader->getReceivedFragments() ) {
+        job->plan->complete( index, 0 );
+    }
+
+    {
+        lock_guard< mutex > lock( messageMutex );
+        jobs.push_back( job );
+    }
+
+    messageCond.notify_all();
+
+    auto node = getNode();
+
+    // the proposal may also arrive from the proposer or the block through catchup,
+    // then the download stops early
+    while ( !node->isExitRequested() && _downloader->isDownloadNeeded() ) {
+        unique_lock< mutex > lock( messageMutex );
+        if ( job->plan->isComplete() || job->plan->isHopeless() )
+            break;
+        messageCond.wait_for( lock, chrono::milliseconds( FINALIZE_SCHEDULER_POLL_MS ) );
+    }
+
+    // the downloader is destroyed once this returns, so wait for the requests still using it
+    unique_lock< mutex > lock( messageMutex );
+    jobs.remove( job );
+    while ( job->activeRequests > 0 ) {
+        messageCond.wait_for( lock, chrono::milliseconds( FINALIZE_SCHEDULER_POLL_MS ) );
+    }
+}
+
+
+ptr< BlockFinalizeDownloadScheduler::Job > BlockFinalizeDownloadScheduler::assignFragment(
+    schain_index _dstIndex, uint64_t& _fragmentIndex ) {
+    unique_lock< mutex > lock( messageMutex );
+
+    vector< uint64_t > latencyMs( peerStats.size() );
+    for ( uint64_t i = 0; i < peerStats.size(); i++ ) {
+        latencyMs[i] = peerStats[i].latencyMs;
+    }
+
+    auto nowMs = Time::getCurrentTimeMs();
+
+    // jobs are served in the order they were submitted, older blocks hold up the chain
+    for ( auto&& job : jobs ) {
+        _fragmentIndex = job->plan->assign( ( uint64_t ) _dstIndex, nowMs, latencyMs );
+        if ( _fragmentIndex > 0 ) {
+            job->activeRequests++;
+            return job;
+        }
+    }
+
+    messageCond.wait_for( lock, chrono::milliseconds( FINALIZE_SCHEDULER_POLL_MS ) );
+
+    return nullptr;
+}
+
+
+void BlockFinalizeDownloadScheduler::recordResult( const ptr< Job >& _job,
+    schain_index _dstIndex, uint64_t _fragmentIndex, uint64_t _bytes, uint64_t _elapsedMs,
+    bool _failed ) {
+    CHECK_ARGUMENT( _job )
+
+    {
+        lock_guard< mutex > lock( messageMutex );
+
+        auto& stats = peerStats.at( ( uint64_t ) _dstIndex );
+        stats.busyMs += _elapsedMs;
+
+        if ( _failed ) {
+            stats.failures++;
+            // a failing peer counts as slow, so that others race its fragments
+            stats.latencyMs = min( max( 2 * stats.latencyMs, FINALIZE_DEFAULT_FRAGMENT_LATENCY_MS ),
+                BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS );
+            _job->plan->fail( _fragmentIndex, ( uint64_t ) _dstIndex,
+                Time::getCurrentTimeMs() + getNode()->getWaitAfterNetworkErrorMs() );
+        } else if ( _bytes == 0 ) {
+            _job->plan->exclude( _fragmentIndex, ( uint64_t ) _dstIndex );
+        } else {
+            auto latency = max( _elapsedMs, ( uint64_t ) 1 );
+            stats.fragments++;
+            stats.bytes += _bytes;
+            stats.latencyMs =
+                stats.latencyMs == 0 ? latency : ( 3 * stats.latencyMs + latency ) / 4;
+            _job->plan->complete( _fragmentIndex, ( uint64_t ) _dstIndex );
+        }
+
+        _job->activeRequests--;
+    }
+
+    messageCond.notify_all();
+}
+
+
+void BlockFinalizeDownloadScheduler::workerThreadFragmentDownloadLoop(
+    BlockFinalizeDownloadScheduler* _scheduler, schain_index _dstIndex ) {
+    CHECK_STATE( _scheduler )
+
+    auto node = _scheduler->getNode();
+
+    setThreadName( "BlckFinLoop", node->getConsensusEngine() );
+
+    node->waitOnGlobalClientStartBarrier();
+
+    try {
+        while ( !node->isExitRequested() ) {
+            uint64_t fragmentIndex = 0;
+            auto job = _scheduler->assignFragment( _dstIndex, fragmentIndex );
+            if ( !job )
+                continue;
+
+            auto startMs = Time::getCurrentTimeMs();
+            uint64_t bytes = 0;
+            bool failed = false;
+
+            try {
+                bytes = job->downloader->downloadFragment( _dstIndex, fragmentIndex );
+            } catch ( ExitRequestedException& ) {
+                failed = true;
+            } catch ( ConnectionRefusedException& e ) {
+                _scheduler->logConnectionRefused( e, _dstIndex );
+                failed = true;
+            } catch ( exception& e ) {
+                SkaleException::logNested( e );
+                failed = true;
+            }
+
+            _scheduler->recordResult( job, _dstIndex, fragmentIndex, bytes,
+                Time::getCurrentTimeMs() - startMs, failed );
+        }
+    } catch ( FatalError& e ) {
+        SkaleException::logNested( e );
+        node->initiateApplicationExitOnFatalConsensusError( e.what() );
+    }
+}
+
+
+vector< PeerDownloadStats > BlockFinalizeDownloadScheduler::getPeerStats() {
+    vector< PeerDownloadStats > result( peerStats.size() );
+    for ( uint64_t i = 0; i < peerStats.size(); i++ ) {
+        result[i].fragments = peerStats[i].fragments;
+        result[i].bytes = peerStats[i].bytes;
+        result[i].failures = peerStats[i].failures;
+        result[i].busyMs = peerStats[i].busyMs;
+        result[i].latencyMs = peerStats[i].latencyMs;
+    }
+    return result;
+}
@@ -0,0 +1,92 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockFinalizeDownloadScheduler.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include "Agent.h"
+
+class BlockFinalizeDownloader;
+class BlockFinalizeDownloaderThreadPool;
+class FragmentDownloadPlan;
+
+
+// snapshot of the download counters of one peer
+struct PeerDownloadStats {
+    uint64_t fragments = 0;
+    uint64_t bytes = 0;
+    uint64_t failures = 0;
+    uint64_t busyMs = 0;
+    // moving average of the fragment latency
+    uint64_t latencyMs = 0;
+
+    uint64_t getThroughputBytesPerSec() const;
+};
+
+
+// Downloads proposal fragments for BlockFinalizeDownloader on one long-lived thread per peer.
+// Threads are shared by all finalizations, so nothing is created per block. Fragments go to
+// whichever peer asks first, so fast peers download more of them, and slow peers are raced
+// by fast ones on the last missing fragments, see FragmentDownloadPlan.
+class BlockFinalizeDownloadScheduler : public Agent {
+    struct Job {
+        BlockFinalizeDownloader* downloader = nullptr;
+        ptr< FragmentDownloadPlan > plan;
+        uint64_t activeRequests = 0;
+    };
+
+    // guarded by messageMutex
+    list< ptr< Job > > jobs;
+
+    struct PeerCounters {
+        atomic< uint64_t > fragments = 0;
+        atomic< uint64_t > bytes = 0;
+        atomic< uint64_t > failures = 0;
+        atomic< uint64_t > busyMs = 0;
+        atomic< uint64_t > latencyMs = 0;
+    };
+
+    // written under messageMutex, read without locks by getPeerStats. Indexed by schain index
+    vector< PeerCounters > peerStats;
+
+    ptr< BlockFinalizeDownloaderThreadPool > threadPool;
+
+    ptr< Job > assignFragment( schain_index _dstIndex, uint64_t& _fragmentIndex );
+
+    void recordResult( const ptr< Job >& _job, schain_index _dstIndex, uint64_t _fragmentIndex,
+        uint64_t _bytes, uint64_t _elapsedMs, bool _failed );
+
+public:
+    explicit BlockFinalizeDownloadScheduler( Schain& _sChain );
+
+    ~BlockFinalizeDownloadScheduler() override;
+
+    // returns once the proposal is downloaded, is no longer needed or can not be downloaded
+    void download( BlockFinalizeDownloader* _downloader );
+
+    static void workerThreadFragmentDownloadLoop(
+        BlockFinalizeDownloadScheduler* _scheduler, schain_index _dstIndex );
+
+    // indexed by schain index, does not lock so that the metrics server never waits for
+    // the scheduler
+    vector< PeerDownloadStats > getPeerStats();
+};
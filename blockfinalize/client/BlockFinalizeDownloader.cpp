@@ -48,17 +48,32 @@
 #include "pendingqueue/PendingTransactionsAgent.h"
 #include "utils/Time.h"
 
+#include "BlockFinalizeDownloadScheduler.h"
 #include "BlockFinalizeDownloader.h"
-#include "BlockFinalizeDownloaderThreadPool.h"
 #include "crypto/CryptoManager.h"
 
 
+uint64_t BlockFinalizeDownloader::getRequiredFragmentCount( Schain* _sChain ) {
+    CHECK_ARGUMENT( _sChain )
+
+    auto totalFragments = ( uint64_t ) _sChain->getNodeCount() - 1;
+
+    if ( !_sChain->erasureCodedFragmentsPatch(
+             _sChain->getLastCommittedBlockTimeStamp().getS() ) ) {
+        return totalFragments;
+    }
+
+    return min( totalFragments, _sChain->getErasureCodedDataFragments() );
+}
+
+
 BlockFinalizeDownloader::BlockFinalizeDownloader(
     Schain* _sChain, block_id _blockId, schain_index _proposerIndex )
     : Agent( *_sChain, false, true ),
       blockId( _blockId ),
       proposerIndex( _proposerIndex ),
-      fragmentList( _blockId, ( uint64_t ) _sChain->getNodeCount() - 1 ) {
+      fragmentList( _blockId, ( uint64_t ) _sChain->getNodeCount() - 1,
+          getRequiredFragmentCount( _sChain ) ) {
     CHECK_ARGUMENT( _sChain )
 
     CHECK_STATE( _sChain->getNodeCount() > 1 )
@@ -94,8 +109,10 @@ uint64_t BlockFinalizeDownloader::downloadFragment(
     LOG( debug, "BLCK_FRG_DWNLD:" << to_string( _fragmentIndex ) << ":" << to_string( _dstIndex ) );
 
     try {
-        auto header = make_shared< BlockFinalizeRequestHeader >(
-            *sChain, blockId, proposerIndex, this->getNode()->getNodeID(), _fragmentIndex );
+        uint64_t dataFragments =
+            fragmentList.isErasureCoded() ? fragmentList.getRequiredFragments() : 0;
+        auto header = make_shared< BlockFinalizeRequestHeader >( *sChain, blockId, proposerIndex,
+            this->getNode()->getNodeID(), _fragmentIndex, dataFragments );
         CHECK_STATE( _dstIndex != ( uint64_t ) getSchain()->getSchainIndex() )
         if ( getSchain()->getDeathTimeMs( ( uint64_t ) _dstIndex ) + NODE_DEATH_INTERVAL_MS >
              Time::getCurrentTimeMs() ) {
@@ -153,6 +170,17 @@ uint64_t BlockFinalizeDownloader::downloadFragment(
                 "Server error in BlockFinalize response:" + to_string( status ), __CLASS_NAME__ ) );
         }
 
+        uint64_t responseDataFragments = 0;
+        if ( response.find( "dataFragments" ) != response.end() )
+            responseDataFragments = Header::getUint64( response, "dataFragments" );
+
+        if ( responseDataFragments != dataFragments ) {
+            BOOST_THROW_EXCEPTION( NetworkProtocolException(
+                "Fragment coding mismatch in BlockFinalize response:" +
+                    to_string( responseDataFragments ),
+                __CLASS_NAME__ ) );
+        }
+
 
         ptr< BlockProposalFragment > blockFragment;
 
@@ -173,7 +201,7 @@ uint64_t BlockFinalizeDownloader::downloadFragment(
 
         fragmentList.addFragment( blockFragment, next );
 
-        return next;
+        return readFragmentSize( response );
 
     } catch ( ExitRequestedException& e ) {
         throw;
@@ -280,111 +308,83 @@ ptr< BlockProposalFragment > BlockFinalizeDownloader::readBlockFragment(
 }
 
 
-void BlockFinalizeDownloader::workerThreadFragmentDownloadLoop(
-    BlockFinalizeDownloader* _agent, schain_index _dstIndex ) {
-    CHECK_STATE( _agent )
+bool BlockFinalizeDownloader::isDownloadNeeded() {
+    if ( fragmentList.isComplete() )
+        return false;
 
+    auto node = getNode();
 
-    auto sChain = _agent->getSchain();
-    auto node = sChain->getNode();
-    auto proposalDB = node->getBlockProposalDB();
-    auto daProofDB = node->getDaProofDB();
-    auto blockId = _agent->getBlockId();
-    auto proposerIndex = _agent->getProposerIndex();
-    auto sChainIndex = sChain->getSchainIndex();
-    bool testFinalizationDownloadOnly = node->getTestConfig()->isFinalizationDownloadOnly();
+    if ( node->getTestConfig()->isFinalizationDownloadOnly() )
+        return true;
 
-    setThreadName( "BlckFinLoop", node->getConsensusEngine() );
+    // the block can be committed in parallel through catchup
+    if ( getSchain()->getLastCommittedBlockID() >= blockId )
+        return false;
 
-    node->waitOnGlobalClientStartBarrier();
-    if ( node->isExitRequested() )
-        return;
+    // the proposal and the da proof can arrive through BlockProposalServerAgent
+    auto proposal = node->getBlockProposalDB()->getBlockProposal( blockId, proposerIndex );
+    if ( proposal && node->getDaProofDB()->haveDAProof( proposal ) )
+        return false;
 
-    // since the node does not download from itself
-    // and since the number of fragment is one less the number of
-    // nodes, nodes that have sChainIndex more than current node, download _dstNodeIndex - 1
-    // fragment
+    return true;
+}
 
-    uint64_t nextFragment;
+ptr< BlockProposal > BlockFinalizeDownloader::downloadProposal() {
+    MONITOR( __CLASS_NAME__, __FUNCTION__ )
 
-    if ( _dstIndex > ( uint64_t ) sChainIndex ) {
-        nextFragment = ( uint64_t ) _dstIndex - 1;
-    } else {
-        nextFragment = ( uint64_t ) _dstIndex;
-    }
+    getSchain()->getBlockFinalizeDownloadScheduler()->download( this );
 
     try {
-        while ( !node->isExitRequested() && !_agent->fragmentList.isComplete() ) {
-            if ( !testFinalizationDownloadOnly ) {
-                // take into account that the block can
-                //  be in parallel committed through catchup
-                // then we need to stop working
-                if ( sChain->getLastCommittedBlockID() >= blockId ) {
-                    return;
-                }
-
-                // take into account that the proposal and da proof can arrive through
-                // BlockproposalServerAgent
-                // then we need to stop working
-                auto proposal = proposalDB->getBlockProposal( blockId, proposerIndex );
-                if ( proposal && daProofDB->haveDAProof( proposal ) ) {
-                    return;
-                }
-            }
+        if ( !fragmentList.isComplete() )
+            return nullptr;
 
+        if ( !fragmentList.isErasureCoded() ) {
+            auto block = BlockProposal::deserialize(
+                fragmentList.serialize(), getSchain()->getCryptoManager(), true );
+            checkProposal( block );
+            return block;
+        }
+
+        ptr< BlockProposal > block;
+
+        auto isValid = [&]( const ptr< vector< uint8_t > >& _serialized ) {
             try {
-                nextFragment = _agent->downloadFragment( _dstIndex, nextFragment );
-                if ( nextFragment == 0 ) {
-                    // all fragments have been downloaded
-                    return;
-                }
+                block = BlockProposal::deserialize(
+                    _serialized, getSchain()->getCryptoManager(), true );
+                checkProposal( block );
+                return true;
             } catch ( ExitRequestedException& ) {
-                return;
-            } catch ( ConnectionRefusedException& e ) {
-                _agent->logConnectionRefused( e, _dstIndex );
-                if ( _agent->fragmentList.isComplete() )
-                    return;
-                usleep( static_cast< __useconds_t >( node->getWaitAfterNetworkErrorMs() * 1000 ) );
-            } catch ( exception& e ) {
-                SkaleException::logNested( e );
-                if ( _agent->fragmentList.isComplete() )
-                    return;
-                usleep( static_cast< __useconds_t >( node->getWaitAfterNetworkErrorMs() * 1000 ) );
+                throw;
+            } catch ( ... ) {
+                block = nullptr;
+                return false;
+            }
+        };
+
+        // a corrupt fragment fails the subsets it is in, so other subsets are tried and more
+        // fragments are downloaded until the proposal decodes
+        while ( fragmentList.isComplete() ) {
+            if ( fragmentList.decode( isValid, FINALIZE_MAX_DECODE_ATTEMPTS ) ) {
+                CHECK_STATE( block );
+                return block;
             }
-        }
-    } catch ( FatalError& e ) {
-        SkaleException::logNested( e );
-        node->initiateApplicationExitOnFatalConsensusError( e.what() );
-    }
-}
 
-ptr< BlockProposal > BlockFinalizeDownloader::downloadProposal() {
-    MONITOR( __CLASS_NAME__, __FUNCTION__ )
+            if ( !fragmentList.requestMoreFragments() ) {
+                // all fragments are here, try every subset left
+                CHECK_STATE2( fragmentList.decode( isValid, UINT64_MAX ),
+                    "No subset of the fragments decodes to the proposal" );
+                CHECK_STATE( block );
+                return block;
+            }
 
-    {
-        threadPool = make_shared< BlockFinalizeDownloaderThreadPool >(
-            ( uint64_t ) getSchain()->getNodeCount(), this );
-        threadPool->startService();
-        threadPool->joinAll();
-    }
+            LOG( warn, "Could not decode proposal " << blockId << ":" << proposerIndex
+                                                    << " from fragments, downloading more" );
 
-    try {
-        if ( fragmentList.isComplete() ) {
-            auto block = BlockProposal::deserialize(
-                fragmentList.serialize(), getSchain()->getCryptoManager(), true );
-            CHECK_STATE( block )
-            CHECK_STATE( block->getProposerIndex() == ( uint64_t ) proposerIndex );
-            {
-                LOCK( m )
-                if ( !this->blockHash.empty() ) {
-                    auto h = BLAKE3Hash::fromHex( blockHash );
-                    CHECK_STATE2( block->getHash().compare( h ) == 0, "Incorrect block hash" );
-                }
-            }
-            return block;
-        } else {
-            return nullptr;
+            getSchain()->getBlockFinalizeDownloadScheduler()->download( this );
         }
+
+        return nullptr;
+
     } catch ( ExitRequestedException& ) {
         throw;
     } catch ( exception& e ) {
@@ -393,8 +393,27 @@ ptr< BlockProposal > BlockFinalizeDownloader::downloadProposal() {
     }
 }
 
+
+void BlockFinalizeDownloader::checkProposal( const ptr< BlockProposal >& _block ) {
+    CHECK_STATE( _block )
+    CHECK_STATE( _block->getProposerIndex() == ( uint64_t ) proposerIndex );
+    LOCK( m )
+    if ( !this->blockHash.empty() ) {
+        auto h = BLAKE3Hash::fromHex( blockHash );
+        CHECK_STATE2( _block->getHash().compare( h ) == 0, "Incorrect block hash" );
+    }
+}
+
 BlockFinalizeDownloader::~BlockFinalizeDownloader() {}
 
+uint64_t BlockFinalizeDownloader::getTargetFragments() {
+    return fragmentList.getTargetFragments();
+}
+
+vector< uint64_t > BlockFinalizeDownloader::getReceivedFragments() {
+    return fragmentList.getReceivedFragments();
+}
+
 block_id BlockFinalizeDownloader::getBlockId() {
     return blockId;
 }
@@ -32,7 +32,6 @@ class BlockFinalizeResponseHeader;
 class BlockProposalFragment;
 class BlockProposalFragmentList;
 class BlockProposal;
-class BlockFinalizeDownloaderThreadPool;
 class BlockProposalSet;
 class ThresholdSignature;
 
@@ -51,21 +50,24 @@ private:
 
     recursive_mutex m;
 
+    static uint64_t getRequiredFragmentCount( Schain* _sChain );
+
+    // throws unless _block is the proposal this downloader is after
+    void checkProposal( const ptr< BlockProposal >& _block );
+
 public:
     ptr< ThresholdSignature > getDaSig( uint64_t _blockTimeStampS );
 
-    ptr< BlockFinalizeDownloaderThreadPool > threadPool = nullptr;
-
     BlockFinalizeDownloader( Schain* _sChain, block_id _blockId, schain_index _proposerIndex );
 
 
     ~BlockFinalizeDownloader() override;
 
+    // returns the fragment size, or 0 if the peer does not have the proposal
     uint64_t downloadFragment( schain_index _dstIndex, fragment_index _fragmentIndex );
 
-
-    static void workerThreadFragmentDownloadLoop(
-        BlockFinalizeDownloader* _agent, schain_index _dstIndex );
+    // false once the fragments are all here, or the proposal or the block arrived otherwise
+    bool isDownloadNeeded();
 
     nlohmann::json readBlockFinalizeResponseHeader( const ptr< ClientSocket >& _socket );
 
@@ -82,6 +84,13 @@ public:
 
     block_id getBlockId();
 
+    // fragments to download, any of them if they are erasure coded. More than needed to
+    // rebuild the proposal after a corrupt fragment failed the decode
+    uint64_t getTargetFragments();
+
+    // fragments kept from an earlier download
+    vector< uint64_t > getReceivedFragments();
+
     schain_index getProposerIndex();
 
     static uint64_t readBlockSize( nlohmann::json _responseHeader );
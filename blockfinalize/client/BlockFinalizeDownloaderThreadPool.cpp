@@ -32,6 +32,7 @@
 #include "chains/Schain.h"
 #include "node/Node.h"
 #include "exceptions/FatalError.h"
+#include "threads/GlobalThreadRegistry.h"
 
 
 #include "abstracttcpserver/ConnectionStatus.h"
@@ -39,7 +40,7 @@
 
 #include "thirdparty/json.hpp"
 
-#include "BlockFinalizeDownloader.h"
+#include "BlockFinalizeDownloadScheduler.h"
 #include "BlockFinalizeDownloaderThreadPool.h"
 
 BlockFinalizeDownloaderThreadPool::BlockFinalizeDownloaderThreadPool(
@@ -48,20 +49,21 @@ BlockFinalizeDownloaderThreadPool::BlockFinalizeDownloaderThreadPool(
 
 
 void BlockFinalizeDownloaderThreadPool::createThread( uint64_t threadIndex ) {
-    auto downloader = ( BlockFinalizeDownloader* ) agent;
+    auto scheduler = ( BlockFinalizeDownloadScheduler* ) agent;
 
-    CHECK_STATE( downloader );
+    CHECK_STATE( scheduler );
 
     // thread numbering starts with 0 and schain indexes start with 1
     uint64_t destinationIndex = threadIndex + 1;
 
     // the node does not download from itself
-    if ( destinationIndex == downloader->getSchain()->getSchainIndex() )
+    if ( destinationIndex == scheduler->getSchain()->getSchainIndex() )
         return;
 
     LOCK( threadPoolLock );
-    this->threadpool.push_back( make_shared< thread >(
-        BlockFinalizeDownloader::workerThreadFragmentDownloadLoop, downloader, destinationIndex ) );
+    this->threadpool.push_back(
+        make_shared< thread >( BlockFinalizeDownloadScheduler::workerThreadFragmentDownloadLoop,
+            scheduler, schain_index( destinationIndex ) ) );
 }
 
 
@@ -69,13 +71,14 @@ void BlockFinalizeDownloaderThreadPool::startService() {
     for ( uint64_t i = 0; i < ( uint64_t ) numThreads; i++ ) {
         createThread( i );
     }
-}
 
-BlockFinalizeDownloaderThreadPool::~BlockFinalizeDownloaderThreadPool() {
-    if ( !joined ) {
-        cerr << "Destroying non-joined BlockFinalizeDownloaderThreadPool"
-             << "/n";
+    // the threads live as long as the node, so they are joined on exit
+    LOCK( threadPoolLock );
+    for ( auto&& t : threadpool ) {
+        agent->getThreadRegistry()->add( t );
     }
+}
 
+BlockFinalizeDownloaderThreadPool::~BlockFinalizeDownloaderThreadPool() {
     threadpool.clear();
 }
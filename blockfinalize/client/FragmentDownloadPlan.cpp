@@ -0,0 +1,180 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file FragmentDownloadPlan.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "FragmentDownloadPlan.h"
+
+
+FragmentDownloadPlan::FragmentDownloadPlan( uint64_t _totalFragments,
+    uint64_t _requiredFragments, uint64_t _nodeCount, uint64_t _ownIndex )
+    : fragments( _totalFragments + 1 ),
+      retryAtMs( _nodeCount + 1, 0 ),
+      excluded( _nodeCount + 1, false ),
+      ownIndex( _ownIndex ),
+      missingCount( _requiredFragments ) {
+    CHECK_ARGUMENT( _requiredFragments > 0 && _requiredFragments <= _totalFragments );
+    CHECK_ARGUMENT( _ownIndex > 0 && _ownIndex <= _nodeCount );
+}
+
+
+uint64_t FragmentDownloadPlan::getLatencyMs(
+    const vector< uint64_t >& _latencyMs, uint64_t _peerIndex ) {
+    if ( _peerIndex < _latencyMs.size() && _latencyMs[_peerIndex] > 0 )
+        return _latencyMs[_peerIndex];
+    return FINALIZE_DEFAULT_FRAGMENT_LATENCY_MS;
+}
+
+
+uint64_t FragmentDownloadPlan::assign(
+    uint64_t _peerIndex, uint64_t _nowMs, const vector< uint64_t >& _latencyMs ) {
+    CHECK_ARGUMENT( _peerIndex > 0 && _peerIndex < excluded.size() );
+    CHECK_ARGUMENT( _peerIndex != ownIndex );
+
+    if ( missingCount == 0 || excluded[_peerIndex] || retryAtMs[_peerIndex] > _nowMs )
+        return 0;
+
+    for ( auto&& fragment : fragments ) {
+        if ( fragment.requests.count( _peerIndex ) > 0 )
+            return 0;
+    }
+
+    // the node does not download from itself, so peers above it own the fragment one below
+    // their index
+    uint64_t home = _peerIndex > ownIndex ? _peerIndex - 1 : _peerIndex;
+
+    if ( home < fragments.size() && !fragments[home].done && fragments[home].requests.empty() ) {
+        fragments[home].requests[_peerIndex] = _nowMs;
+        return home;
+    }
+
+    for ( uint64_t i = 1; i < fragments.size(); i++ ) {
+        if ( !fragments[i].done && fragments[i].requests.empty() ) {
+            fragments[i].requests[_peerIndex] = _nowMs;
+            return i;
+        }
+    }
+
+    // everything is in flight. Duplicate the fragment expected to arrive last, if the
+    // fragments arriving before this peer could deliver one are not enough to finish
+    auto ownArrivalMs = _nowMs + getLatencyMs( _latencyMs, _peerIndex );
+    uint64_t inFlight = 0;
+    uint64_t arrivingEarlier = 0;
+    uint64_t best = 0;
+    uint64_t bestArrivalMs = 0;
+
+    for ( uint64_t i = 1; i < fragments.size(); i++ ) {
+        auto& fragment = fragments[i];
+        if ( fragment.done )
+            continue;
+
+        uint64_t arrivalMs = UINT64_MAX;
+        for ( auto&& [peer, startMs] : fragment.requests ) {
+            arrivalMs = min( arrivalMs, startMs + getLatencyMs( _latencyMs, peer ) );
+        }
+
+        inFlight++;
+        if ( arrivalMs <= ownArrivalMs )
+            arrivingEarlier++;
+
+        if ( fragment.requests.size() >= FINALIZE_MAX_REQUESTS_PER_FRAGMENT )
+            continue;
+
+        if ( best == 0 || arrivalMs > bestArrivalMs ) {
+            best = i;
+            bestArrivalMs = arrivalMs;
+        }
+    }
+
+    if ( best == 0 )
+        return 0;
+
+    // the last few fragments are raced anyway, unless spare coded fragments are on the way
+    bool isTail = missingCount <= FINALIZE_RACE_FRAGMENTS && inFlight <= missingCount;
+
+    if ( arrivingEarlier >= missingCount && !isTail )
+        return 0;
+
+    fragments[best].requests[_peerIndex] = _nowMs;
+    return best;
+}
+
+
+void FragmentDownloadPlan::complete( uint64_t _fragmentIndex, uint64_t _peerIndex ) {
+    CHECK_ARGUMENT( _fragmentIndex > 0 && _fragmentIndex < fragments.size() );
+
+    auto& fragment = fragments[_fragmentIndex];
+    fragment.requests.erase( _peerIndex );
+
+    if ( !fragment.done ) {
+        fragment.done = true;
+        if ( missingCount > 0 )
+            missingCount--;
+    }
+}
+
+
+void FragmentDownloadPlan::fail(
+    uint64_t _fragmentIndex, uint64_t _peerIndex, uint64_t _retryAtMs ) {
+    CHECK_ARGUMENT( _fragmentIndex > 0 && _fragmentIndex < fragments.size() );
+    CHECK_ARGUMENT( _peerIndex > 0 && _peerIndex < retryAtMs.size() );
+
+    fragments[_fragmentIndex].requests.erase( _peerIndex );
+    retryAtMs[_peerIndex] = _retryAtMs;
+}
+
+
+void FragmentDownloadPlan::exclude( uint64_t _fragmentIndex, uint64_t _peerIndex ) {
+    CHECK_ARGUMENT( _fragmentIndex > 0 && _fragmentIndex < fragments.size() );
+    CHECK_ARGUMENT( _peerIndex > 0 && _peerIndex < excluded.size() );
+
+    fragments[_fragmentIndex].requests.erase( _peerIndex );
+    excluded[_peerIndex] = true;
+}
+
+
+uint64_t FragmentDownloadPlan::getRequestCount( uint64_t _fragmentIndex ) const {
+    CHECK_ARGUMENT( _fragmentIndex > 0 && _fragmentIndex < fragments.size() );
+    return fragments[_fragmentIndex].requests.size();
+}
+
+
+uint64_t FragmentDownloadPlan::getMissingCount() const {
+    return missingCount;
+}
+
+
+bool FragmentDownloadPlan::isComplete() const {
+    return missingCount == 0;
+}
+
+
+bool FragmentDownloadPlan::isHopeless() const {
+    for ( uint64_t i = 1; i < excluded.size(); i++ ) {
+        if ( i != ownIndex && !excluded[i] )
+            return false;
+    }
+    return true;
+}
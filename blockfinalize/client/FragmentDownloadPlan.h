@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file FragmentDownloadPlan.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Decides which fragment of one proposal each peer requests next. Every peer first gets its
+// own fragment, then whatever fragment nobody is downloading. The proposal is complete once
+// _requiredFragments are here, which is less than all of them if they are erasure coded.
+// When everything is in flight, an idle peer duplicates the fragment expected to arrive last,
+// unless enough other fragments will arrive before it could deliver one, and it races the
+// last few fragments.
+// Not thread safe, BlockFinalizeDownloadScheduler calls it under its lock.
+class FragmentDownloadPlan {
+    struct FragmentState {
+        bool done = false;
+        // peer index -> request start time
+        map< uint64_t, uint64_t > requests;
+    };
+
+    // indexed by fragment index, element 0 is unused
+    vector< FragmentState > fragments;
+
+    // indexed by peer index, element 0 is unused
+    vector< uint64_t > retryAtMs;
+    vector< bool > excluded;
+
+    uint64_t ownIndex = 0;
+    uint64_t missingCount = 0;
+
+    static uint64_t getLatencyMs( const vector< uint64_t >& _latencyMs, uint64_t _peerIndex );
+
+public:
+    FragmentDownloadPlan( uint64_t _totalFragments, uint64_t _requiredFragments,
+        uint64_t _nodeCount, uint64_t _ownIndex );
+
+    // returns the fragment the peer should request now, or 0 if it has nothing to do.
+    // _latencyMs holds the expected fragment latency of each peer, 0 if unknown
+    uint64_t assign( uint64_t _peerIndex, uint64_t _nowMs, const vector< uint64_t >& _latencyMs );
+
+    void complete( uint64_t _fragmentIndex, uint64_t _peerIndex );
+
+    // the request failed, the peer will not get new fragments before _retryAtMs
+    void fail( uint64_t _fragmentIndex, uint64_t _peerIndex, uint64_t _retryAtMs );
+
+    // the peer does not have the proposal
+    void exclude( uint64_t _fragmentIndex, uint64_t _peerIndex );
+
+    uint64_t getRequestCount( uint64_t _fragmentIndex ) const;
+
+    uint64_t getMissingCount() const;
+
+    bool isComplete() const;
+
+    // true if no peer has the proposal, so the download can not complete
+    bool isHopeless() const;
+};
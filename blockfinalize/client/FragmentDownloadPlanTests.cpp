@@ -0,0 +1,149 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file FragmentDownloadPlanTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "FragmentDownloadPlan.h"
+
+
+TEST_CASE( "Fragment plan assigns own fragments first", "[fragment-plan]" ) {
+    // 4 nodes, this node is 2, fragments 1..3
+    FragmentDownloadPlan plan( 3, 3, 4, 2 );
+    vector< uint64_t > latency( 5, 0 );
+
+    REQUIRE( plan.assign( 1, 0, latency ) == 1 );
+    REQUIRE( plan.assign( 3, 0, latency ) == 2 );
+    REQUIRE( plan.assign( 4, 0, latency ) == 3 );
+    // one request per peer at a time
+    REQUIRE( plan.assign( 4, 0, latency ) == 0 );
+
+    plan.complete( 3, 4 );
+    plan.complete( 1, 1 );
+    REQUIRE( plan.getMissingCount() == 1 );
+    REQUIRE( !plan.isComplete() );
+
+    // a duplicate result does not count twice
+    plan.complete( 1, 4 );
+    REQUIRE( plan.getMissingCount() == 1 );
+
+    plan.complete( 2, 3 );
+    REQUIRE( plan.isComplete() );
+    REQUIRE( plan.assign( 1, 0, latency ) == 0 );
+}
+
+
+TEST_CASE( "Fragment plan races slow peers", "[fragment-plan]" ) {
+    // 16 nodes, this node is 16, fragments 1..15
+    FragmentDownloadPlan plan( 15, 15, 16, 16 );
+    vector< uint64_t > latency( 17, 100 );
+    // peer 15 is slow
+    latency[15] = 5000;
+
+    for ( uint64_t i = 1; i <= 15; i++ ) {
+        REQUIRE( plan.assign( i, 0, latency ) == i );
+    }
+
+    // fast peers finish, 8 fragments are still missing
+    for ( uint64_t i = 1; i <= 7; i++ ) {
+        plan.complete( i, i );
+    }
+
+    // peer 1 duplicates the slow peer fragment, since it will arrive earlier
+    REQUIRE( plan.assign( 1, 100, latency ) == 15 );
+    REQUIRE( plan.getRequestCount( 15 ) == 2 );
+
+    // peer 2 would not beat the fast peers, so it waits
+    REQUIRE( plan.assign( 2, 100, latency ) == 0 );
+    for ( uint64_t i = 8; i <= 14; i++ ) {
+        plan.complete( i, i );
+    }
+    plan.complete( 15, 1 );
+    REQUIRE( plan.isComplete() );
+
+    // with only a few fragments missing every idle peer races
+    FragmentDownloadPlan tail( 15, 15, 16, 16 );
+    vector< uint64_t > same( 17, 100 );
+    for ( uint64_t i = 1; i <= 15; i++ ) {
+        REQUIRE( tail.assign( i, 0, same ) == i );
+    }
+    for ( uint64_t i = 1; i <= 12; i++ ) {
+        tail.complete( i, i );
+    }
+    REQUIRE( tail.assign( 1, 50, same ) == 0 );
+    tail.complete( 13, 13 );
+    REQUIRE( tail.getMissingCount() == FINALIZE_RACE_FRAGMENTS );
+    REQUIRE( tail.assign( 1, 50, same ) > 13 );
+}
+
+
+TEST_CASE( "Fragment plan handles failures", "[fragment-plan]" ) {
+    FragmentDownloadPlan plan( 3, 3, 4, 4 );
+    vector< uint64_t > latency( 5, 0 );
+
+    REQUIRE( plan.assign( 1, 0, latency ) == 1 );
+    REQUIRE( plan.assign( 2, 0, latency ) == 2 );
+
+    // a failed fragment goes to the next idle peer, the failed peer backs off
+    plan.fail( 1, 1, 1000 );
+    REQUIRE( plan.assign( 1, 500, latency ) == 0 );
+    REQUIRE( plan.assign( 3, 500, latency ) == 3 );
+    plan.complete( 3, 3 );
+    REQUIRE( plan.assign( 3, 500, latency ) == 1 );
+    REQUIRE( plan.assign( 1, 1000, latency ) > 0 );
+
+    // nobody has the proposal
+    FragmentDownloadPlan hopeless( 3, 3, 4, 4 );
+    for ( uint64_t i = 1; i <= 3; i++ ) {
+        REQUIRE( !hopeless.isHopeless() );
+        hopeless.exclude( hopeless.assign( i, 0, latency ), i );
+    }
+    REQUIRE( hopeless.isHopeless() );
+}
+
+
+TEST_CASE( "Fragment plan completes with any coded fragments", "[fragment-plan]" ) {
+    // 16 nodes, any 10 of the 15 coded fragments rebuild the proposal
+    FragmentDownloadPlan plan( 15, 10, 16, 1 );
+    vector< uint64_t > latency( 17, 100 );
+    // five slow peers
+    for ( uint64_t i = 12; i <= 16; i++ ) {
+        latency[i] = 10000;
+    }
+
+    for ( uint64_t i = 2; i <= 16; i++ ) {
+        REQUIRE( plan.assign( i, 0, latency ) == i - 1 );
+    }
+
+    // the fast peers alone complete the proposal, nobody races the slow ones
+    for ( uint64_t i = 2; i <= 11; i++ ) {
+        REQUIRE( !plan.isComplete() );
+        plan.complete( i - 1, i );
+        REQUIRE( plan.assign( i, 100, latency ) == 0 );
+    }
+
+    REQUIRE( plan.isComplete() );
+    REQUIRE( plan.getMissingCount() == 0 );
+}
@@ -54,6 +54,7 @@
 #include "node/Node.h"
 #include "node/NodeInfo.h"
 #include "pendingqueue/PendingTransactionsAgent.h"
+#include "utils/LatencyHistogram.h"
 #include "utils/Time.h"
 
 #include "BlockProposalClientAgent.h"
@@ -123,7 +124,10 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalClientAgent::sendItem
 
     auto _proposal = dynamic_pointer_cast< BlockProposal >( _item );
     if ( _proposal != nullptr ) {
-        return sendBlockProposal( _proposal, _socket, _index );
+        auto startTimeUs = Time::getMonotonicTimeUs();
+        auto result = sendBlockProposal( _proposal, _socket, _index );
+        LatencyHistogram::record( LAT_PROPOSAL_PUSH, Time::getMonotonicTimeUs() - startTimeUs );
+        return result;
     } else {
         auto _daProof = dynamic_pointer_cast< DAProof >( _item );
         CHECK_STATE( _daProof );  // a sendable item is either DAProof or Proposal
@@ -236,9 +240,7 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalClientAgent::sendBloc
         LOG( trace, "Proposal complete::no missing transactions" );
 
     } else {
-        ptr< unordered_set< ptr< partial_sha_hash >, PendingTransactionsAgent::Hasher,
-            PendingTransactionsAgent::Equal > >
-            missingHashes;
+        ptr< unordered_set< uint64_t > > missingHashes;
 
         try {
             missingHashes = readMissingHashes( _socket, count );
@@ -258,7 +260,7 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalClientAgent::sendBloc
         auto missingTransactionsSizes = make_shared< vector< uint64_t > >();
 
         for ( auto&& transaction : *_proposal->getTransactionList()->getItems() ) {
-            if ( missingHashes->count( transaction->getPartialHash() ) ) {
+            if ( missingHashes->count( transaction->getPartialHashKey() ) ) {
                 missingTransactions->push_back( transaction );
 
                 missingTransactionsSizes->push_back( transaction->getSerializedSize( false ) );
@@ -443,8 +445,7 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalClientAgent::sendDAPr
 }
 
 
-ptr< unordered_set< ptr< partial_sha_hash >, PendingTransactionsAgent::Hasher,
-    PendingTransactionsAgent::Equal > >
+ptr< unordered_set< uint64_t > >
 
 BlockProposalClientAgent::readMissingHashes( const ptr< ClientSocket >& _socket, uint64_t _count ) {
     CHECK_ARGUMENT( _socket );
@@ -468,18 +469,14 @@ BlockProposalClientAgent::readMissingHashes( const ptr< ClientSocket >& _socket,
     }
 
 
-    auto result = make_shared< unordered_set< ptr< partial_sha_hash >,
-        PendingTransactionsAgent::Hasher, PendingTransactionsAgent::Equal > >();
+    auto result = make_shared< unordered_set< uint64_t > >( _count );
 
 
     try {
         for ( uint64_t i = 0; i < _count; i++ ) {
-            auto hash = make_shared< partial_sha_hash >();
-            for ( size_t j = 0; j < PARTIAL_HASH_LEN; j++ ) {
-                hash->at( j ) = buffer->at( PARTIAL_HASH_LEN * i + j );
-            }
-
-            result->insert( hash );
+            uint64_t key;
+            memcpy( &key, buffer->data() + PARTIAL_HASH_LEN * i, PARTIAL_HASH_LEN );
+            result->insert( key );
         }
     } catch ( ExitRequestedException& ) {
         throw;
@@ -51,8 +51,7 @@ class BlockProposalClientAgent : public AbstractClientAgent {
         const ptr< ClientSocket >& _socket );
 
 
-    ptr< unordered_set< ptr< partial_sha_hash >, PendingTransactionsAgent::Hasher,
-        PendingTransactionsAgent::Equal > >
+    ptr< unordered_set< uint64_t > >
     readMissingHashes( const ptr< ClientSocket >& _socket, uint64_t _count );
 
 
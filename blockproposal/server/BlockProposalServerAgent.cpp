@@ -59,6 +59,7 @@
 #include "headers/FinalProposalResponseHeader.h"
 #include "headers/Header.h"
 #include "headers/MissingTransactionsRequestHeader.h"
+#include "network/ConsensusTrace.h"
 #include "network/IO.h"
 #include "network/Network.h"
 #include "network/ServerConnection.h"
@@ -86,9 +87,7 @@
 #include "monitoring/LivelinessMonitor.h"
 
 
-ptr< unordered_map< ptr< partial_sha_hash >, ptr< Transaction >, PendingTransactionsAgent::Hasher,
-    PendingTransactionsAgent::Equal > >
-BlockProposalServerAgent::readMissingTransactions(
+ptr< PartialHashIndex< ptr< Transaction > > > BlockProposalServerAgent::readMissingTransactions(
     const ptr< ServerConnection >& _connectionEnvelope,
     nlohmann::json missingTransactionsResponseHeader ) {
     CHECK_ARGUMENT( _connectionEnvelope );
@@ -132,41 +131,29 @@ BlockProposalServerAgent::readMissingTransactions(
 
     CHECK_STATE( trs );
 
-    auto missed = make_shared< unordered_map< ptr< partial_sha_hash >, ptr< Transaction >,
-        PendingTransactionsAgent::Hasher, PendingTransactionsAgent::Equal > >();
+    auto missed = make_shared< PartialHashIndex< ptr< Transaction > > >( trs->size() );
 
     for ( auto&& t : *trs ) {
-        ( *missed )[t->getPartialHash()] = t;
+        missed->insert( t->getPartialHashKey(), t );
     }
 
     return missed;
 }
 
-pair< ptr< map< uint64_t, ptr< Transaction > > >, ptr< map< uint64_t, ptr< partial_sha_hash > > > >
+pair< ptr< vector< ptr< Transaction > > >, ptr< vector< uint64_t > > >
 BlockProposalServerAgent::getPresentAndMissingTransactions(
     Schain& _sChain, const ptr< Header > /*tcpHeader*/, const ptr< PartialHashesList >& _phList ) {
     CHECK_ARGUMENT( _phList );
 
     LOG( debug, "Calculating missing hashes" );
 
-    auto transactionsCount = _phList->getTransactionCount();
+    auto presentTransactions = make_shared< vector< ptr< Transaction > > >();
+    auto missingBitmap = make_shared< vector< uint64_t > >();
 
-    auto presentTransactions = make_shared< map< uint64_t, ptr< Transaction > > >();
-    auto missingHashes = make_shared< map< uint64_t, ptr< partial_sha_hash > > >();
+    _sChain.getPendingTransactionsAgent()->getKnownTransactionsByPartialHashes(
+        _phList, *presentTransactions, *missingBitmap );
 
-    for ( uint64_t i = 0; i < transactionsCount; i++ ) {
-        auto hash = _phList->getPartialHash( i );
-        CHECK_STATE( hash );
-        auto transaction =
-            _sChain.getPendingTransactionsAgent()->getKnownTransactionByPartialHash( hash );
-        if ( transaction == nullptr ) {
-            ( *missingHashes )[i] = hash;
-        } else {
-            ( *presentTransactions )[i] = transaction;
-        }
-    }
-
-    return { presentTransactions, missingHashes };
+    return { presentTransactions, missingBitmap };
 }
 
 
@@ -308,13 +295,19 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalServerAgent::processP
     auto result = getPresentAndMissingTransactions( *sChain, responseHeader, partialHashesList );
 
     auto presentTransactions = result.first;
-    auto missingTransactionHashes = result.second;
+    auto missingBitmap = result.second;
 
     CHECK_STATE( presentTransactions );
-    CHECK_STATE( missingTransactionHashes );
+    CHECK_STATE( missingBitmap );
+
+    uint64_t missingCount = 0;
+
+    for ( auto word : *missingBitmap ) {
+        missingCount += __builtin_popcountll( word );
+    }
 
     auto missingHashesRequestHeader =
-        make_shared< MissingTransactionsRequestHeader >( missingTransactionHashes );
+        make_shared< MissingTransactionsRequestHeader >( missingCount );
 
     try {
         send( _connection, missingHashesRequestHeader );
@@ -326,17 +319,15 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalServerAgent::processP
     }
 
 
-    ptr< unordered_map< ptr< partial_sha_hash >, ptr< Transaction >,
-        PendingTransactionsAgent::Hasher, PendingTransactionsAgent::Equal > >
-        missingTransactions = nullptr;
+    ptr< PartialHashIndex< ptr< Transaction > > > missingTransactions = nullptr;
 
-    if ( missingTransactionHashes->size() == 0 ) {
+    if ( missingCount == 0 ) {
         LOG( debug, "Server: No missing partial hashes" );
     } else {
         LOG( debug, "Server: missing partial hashes" );
         try {
             getSchain()->getIo()->writePartialHashes(
-                _connection->getDescriptor(), missingTransactionHashes );
+                _connection->getDescriptor(), partialHashesList, missingBitmap );
         } catch ( ExitRequestedException& ) {
             throw;
         } catch ( ... ) {
@@ -354,46 +345,35 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalServerAgent::processP
             BOOST_THROW_EXCEPTION( CouldNotReadPartialDataHashesException(
                 "Null missing transactions", __CLASS_NAME__ ) );
         }
-
-
-        for ( auto&& item : *missingTransactions ) {
-            CHECK_STATE( item.second );
-            sChain->getPendingTransactionsAgent()->pushKnownTransaction( item.second );
-        }
     }
 
     LOG( debug, "Storing block proposal" );
 
-    auto transactions = make_shared< vector< ptr< Transaction > > >();
+    auto transactions = presentTransactions;
 
     auto transactionCount = partialHashesList->getTransactionCount();
 
-    for ( uint64_t i = 0; i < transactionCount; i++ ) {
-        auto partialHash = partialHashesList->getPartialHash( i );
-        CHECK_STATE( partialHash );
+    CHECK_STATE( transactions->size() == ( uint64_t ) transactionCount );
 
-        ptr< Transaction > transaction;
+    // only the positions flagged as missing are filled in and added to the known transactions,
+    // the present ones came from the known transactions in the first place
+    for ( uint64_t w = 0; w < missingBitmap->size(); w++ ) {
+        for ( auto word = missingBitmap->at( w ); word != 0; word &= word - 1 ) {
+            auto i = w * 64 + __builtin_ctzll( word );
+            CHECK_STATE( i < ( uint64_t ) transactionCount );
 
-        if ( presentTransactions->count( i ) > 0 ) {
-            transaction = presentTransactions->at( i );
-        } else {
-            transaction = ( *missingTransactions )[partialHash];
-        };
-
-        if ( transaction == nullptr ) {
-            checkForOldBlock( requestHeader->getBlockId() );
-            CHECK_STATE( missingTransactions );
+            if ( missingTransactions ) {
+                ( *transactions )[i] =
+                    missingTransactions->find( partialHashesList->getPartialHashKey( i ) );
+            }
 
-            if ( missingTransactions->count( partialHash ) > 0 ) {
-                LOG( err, "Found in missing" );
+            if ( ( *transactions )[i] == nullptr ) {
+                checkForOldBlock( requestHeader->getBlockId() );
+                CHECK_STATE( false );
             }
 
-            CHECK_STATE( false );
+            sChain->getPendingTransactionsAgent()->pushKnownTransaction( ( *transactions )[i] );
         }
-
-        CHECK_STATE( transactions != nullptr );
-
-        transactions->push_back( transaction );
     }
 
     CHECK_STATE( transactionCount == 0 || transactions->at( ( uint64_t ) transactionCount - 1 ) );
@@ -423,6 +403,11 @@ pair< ConnectionStatus, ConnectionSubStatus > BlockProposalServerAgent::processP
         CHECK_STATE( finalResponseHeader );
         CHECK_STATE( proposal );
 
+        if ( auto recorder = getNode()->getTraceRecorder() ) {
+            recorder->record( TRACE_BLOCK_PROPOSAL, proposal->getProposerIndex(),
+                proposal->getBlockID(), proposal->serializeProposal() );
+        }
+
         sChain->proposedBlockArrived( proposal );
 
 
@@ -718,6 +703,15 @@ ptr< Header > BlockProposalServerAgent::createDAProofResponseHeader(
 
     auto proof = make_shared< DAProof >( proposal, sig );
 
+    if ( auto recorder = getNode()->getTraceRecorder() ) {
+        nlohmann::json traceProof = nlohmann::json::object();
+        traceProof["hash"] = _header->getBlockHash();
+        traceProof["sig"] = _header->getSignature();
+        auto traceData = traceProof.dump();
+        recorder->record( TRACE_DA_PROOF, proposal->getProposerIndex(), proposal->getBlockID(),
+            traceData.data(), traceData.size() );
+    }
+
     sChain->daProofArrived( proof );
 
     responseHeader->setStatusSubStatus( CONNECTION_SUCCESS, CONNECTION_OK );
@@ -69,14 +69,14 @@ public:
 
     ~BlockProposalServerAgent() override;
 
-    ptr< unordered_map< ptr< partial_sha_hash >, ptr< Transaction >,
-        PendingTransactionsAgent::Hasher, PendingTransactionsAgent::Equal > >
-    readMissingTransactions( const ptr< ServerConnection >& _connectionEnvelope,
+    ptr< PartialHashIndex< ptr< Transaction > > > readMissingTransactions(
+        const ptr< ServerConnection >& _connectionEnvelope,
         nlohmann::json missingTransactionsResponseHeader );
 
 
-    pair< ptr< map< uint64_t, ptr< Transaction > > >,
-        ptr< map< uint64_t, ptr< partial_sha_hash > > > >
+    // returns the known transactions indexed by position in the list, null where missing,
+    // and a bitmap of missing positions
+    pair< ptr< vector< ptr< Transaction > > >, ptr< vector< uint64_t > > >
     getPresentAndMissingTransactions(
         Schain& _sChain, const ptr< Header >, const ptr< PartialHashesList >& _phList );
 
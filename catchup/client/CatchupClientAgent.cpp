@@ -32,6 +32,7 @@
 
 #include "CatchupClientAgent.h"
 #include "CatchupClientThreadPool.h"
+#include "CatchupPlan.h"
 #include "chains/Schain.h"
 #include "datastructures/CommittedBlock.h"
 #include "datastructures/CommittedBlockList.h"
@@ -41,10 +42,11 @@
 #include "headers/CatchupRequestHeader.h"
 #include "headers/CatchupResponseHeader.h"
 #include "network/ClientSocket.h"
+#include "network/ConsensusTrace.h"
 #include "network/IO.h"
 #include "network/Network.h"
+#include "node/Node.h"
 #include "pendingqueue/PendingTransactionsAgent.h"
-#include "sys/random.h"
 #include "utils/Time.h"
 
 
@@ -54,7 +56,14 @@ CatchupClientAgent::CatchupClientAgent( Schain& _sChain ) : Agent( _sChain, fals
         this->sChain = &_sChain;
 
         if ( _sChain.getNodeCount() > 1 ) {
-            this->catchupClientThreadPool = make_shared< CatchupClientThreadPool >( 1, this );
+            catchupPlan = make_shared< CatchupPlan >( ( uint64_t ) _sChain.getNodeCount(),
+                ( uint64_t ) _sChain.getSchainIndex(), 0,
+                _sChain.getNode()->getMaxCatchupDownloadBytes(),
+                _sChain.getNode()->getCatchupIntervalMs() );
+            auto threadCount =
+                min( ( uint64_t ) _sChain.getNodeCount() - 1, CATCHUP_MAX_PARALLEL_REQUESTS );
+            this->catchupClientThreadPool =
+                make_shared< CatchupClientThreadPool >( threadCount, this );
             catchupClientThreadPool->startService();
         }
 
@@ -81,13 +90,18 @@ nlohmann::json CatchupClientAgent::readCatchupResponseHeader(
 }
 
 
-[[nodiscard]] uint64_t CatchupClientAgent::sync( schain_index _dstIndex ) {
-    LOG( debug, "Catchupc step 0: requesting blocks after "
-                    << to_string( getSchain()->getLastCommittedBlockID() ) );
+[[nodiscard]] uint64_t CatchupClientAgent::sync( const CatchupChunk& _chunk ) {
+    CHECK_ARGUMENT( _chunk.blockCount > 0 );
+
+    auto _dstIndex = schain_index( _chunk.peerIndex );
+
+    LOG( debug, "Catchupc step 0: requesting " << _chunk.blockCount << " blocks from "
+                                                << _chunk.startBlock );
 
     auto catchupDownloadStartTimeMs = Time::getCurrentTimeMs();
 
-    auto requestHeader = make_shared< CatchupRequestHeader >( *sChain, _dstIndex );
+    auto requestHeader = make_shared< CatchupRequestHeader >(
+        *sChain, _dstIndex, block_id( _chunk.startBlock - 1 ), _chunk.blockCount );
     CHECK_STATE( _dstIndex != ( uint64_t ) getSchain()->getSchainIndex() )
 
     if ( getSchain()->getDeathTimeMs( ( uint64_t ) _dstIndex ) + NODE_DEATH_INTERVAL_MS >
@@ -132,13 +146,20 @@ nlohmann::json CatchupClientAgent::readCatchupResponseHeader(
         throw_with_nested( NetworkProtocolException( errString, __CLASS_NAME__ ) );
     }
 
+    auto catchupLatencyMs = Time::getCurrentTimeMs() - catchupDownloadStartTimeMs;
+
     // now see if peerinfo information returned by the peer
     ptr<PeerStateInfo> peerStateInfo = PeerStateInfo::extract(response);
 
     if (peerStateInfo) {
         // update the info on the peer
-        WRITE_LOCK(peerStateInfosMutex)
-        peerStateInfos.at((uint64_t)_dstIndex - 1) = peerStateInfo;
+        {
+            WRITE_LOCK(peerStateInfosMutex)
+            peerStateInfos.at((uint64_t)_dstIndex - 1) = peerStateInfo;
+        }
+        LOCK( catchupPlanMutex )
+        catchupPlan->reportLastBlockId( _chunk.peerIndex,
+            ( uint64_t ) peerStateInfo->getLastBlockId(), Time::getCurrentTimeMs() );
     }
 
     LOG( debug, "Catchupc step 2: read catchup response requestHeader" );
@@ -147,6 +168,9 @@ nlohmann::json CatchupClientAgent::readCatchupResponseHeader(
 
     if ( status == CONNECTION_DISCONNECT ) {
         LOG( debug, "Catchupc got response::no missing blocks" );
+        LOCK( catchupPlanMutex )
+        catchupPlan->complete( _chunk, 0, 0, catchupLatencyMs, catchupLatencyMs,
+            Time::getCurrentTimeMs() );
         return 0;
     }
 
@@ -174,14 +198,134 @@ nlohmann::json CatchupClientAgent::readCatchupResponseHeader(
 
     auto catchupDownloadTimeMs = Time::getCurrentTimeMs() - catchupDownloadStartTimeMs;
 
-    LOG(
-        debug, "Catchupc step 3: got missing blocks:" << to_string( blocks->getBlocks()->size() ) );
+    auto blockVector = blocks->getBlocks();
+    CHECK_STATE( blockVector );
+
+    LOG( debug, "Catchupc step 3: got missing blocks:" << to_string( blockVector->size() ) );
+
+    if ( !blockVector->empty() && blockVector->at( 0 )->getBlockID() != _chunk.startBlock ) {
+        BOOST_THROW_EXCEPTION( NetworkProtocolException(
+            "Catchup response does not start at block " + to_string( _chunk.startBlock ),
+            __CLASS_NAME__ ) );
+    }
+
+    // servers that do not know blockCount return everything they have
+    if ( blockVector->size() > _chunk.blockCount ) {
+        blockVector = make_shared< vector< ptr< CommittedBlock > > >(
+            blockVector->begin(), blockVector->begin() + _chunk.blockCount );
+        blocks = make_shared< CommittedBlockList >( blockVector );
+    }
+
+    // bytes on the wire, the server limit applies to them whether blocks are compressed or not
+    uint64_t bytes = 0;
+    for ( uint64_t i = 0; i < blockVector->size() && i < response["sizes"].size(); i++ ) {
+        bytes += response["sizes"][i].get< uint64_t >();
+    }
+
+    {
+        LOCK( catchupPlanMutex )
+        catchupPlan->complete( _chunk, blockVector->size(), bytes, catchupLatencyMs,
+            catchupDownloadTimeMs, Time::getCurrentTimeMs() );
+    }
+
+    if ( !blockVector->empty() ) {
+        LOCK( downloadedChunksMutex )
+        downloadedChunks[_chunk.startBlock] = { blocks, catchupDownloadTimeMs };
+    }
 
-    auto result = getSchain()->blockCommitsArrivedThroughCatchup( blocks, catchupDownloadTimeMs );
+    auto result = commitDownloadedChunks();
     LOG( debug, "Catchupc success" );
     return result;
 }
 
+
+uint64_t CatchupClientAgent::commitDownloadedChunks() {
+    LOCK( commitMutex )
+
+    uint64_t result = 0;
+
+    while ( true ) {
+        ptr< CommittedBlockList > blocks;
+        uint64_t startBlock = 0;
+        uint64_t catchupDownloadTimeMs = 0;
+
+        {
+            LOCK( downloadedChunksMutex )
+            auto nextBlockId = ( uint64_t ) getSchain()->getLastCommittedBlockID() + 1;
+            auto it = downloadedChunks.begin();
+
+            // chunks the chain committed meanwhile are dropped
+            while ( it != downloadedChunks.end() &&
+                    it->first + it->second.first->getBlocks()->size() <= nextBlockId ) {
+                it = downloadedChunks.erase( it );
+            }
+
+            if ( it == downloadedChunks.end() || it->first > nextBlockId )
+                break;
+
+            startBlock = it->first;
+            blocks = it->second.first;
+            catchupDownloadTimeMs = it->second.second;
+            downloadedChunks.erase( it );
+        }
+
+        if ( auto recorder = getNode()->getTraceRecorder() ) {
+            // json line with block sizes, followed by the serialized block list
+            nlohmann::json traceSizes = nlohmann::json::object();
+            traceSizes["sizes"] = *blocks->createSizes();
+            auto traceData = make_shared< vector< uint8_t > >();
+            auto sizesStr = traceSizes.dump() + "\n";
+            traceData->insert( traceData->end(), sizesStr.begin(), sizesStr.end() );
+            auto serializedBlocks = blocks->serialize();
+            traceData->insert(
+                traceData->end(), serializedBlocks->begin(), serializedBlocks->end() );
+            recorder->record( TRACE_CATCHUP_BLOCKS, schain_index( 0 ),
+                getSchain()->getLastCommittedBlockID() + 1, traceData );
+        }
+
+        uint64_t committed = 0;
+
+        try {
+            committed =
+                getSchain()->blockCommitsArrivedThroughCatchup( blocks, catchupDownloadTimeMs );
+        } catch ( ... ) {
+            LOCK( catchupPlanMutex )
+            catchupPlan->release( startBlock );
+            throw;
+        }
+
+        // the chain could not take the blocks now, they are downloaded again
+        if ( committed == 0 ) {
+            LOCK( catchupPlanMutex )
+            catchupPlan->release( startBlock );
+            break;
+        }
+
+        result += committed;
+    }
+
+    {
+        LOCK( catchupPlanMutex )
+        catchupPlan->setLastCommittedBlockId(
+            ( uint64_t ) getSchain()->getLastCommittedBlockID() );
+    }
+
+    return result;
+}
+
+
+CatchupChunk CatchupClientAgent::assignChunk() {
+    LOCK( catchupPlanMutex )
+    catchupPlan->setLastCommittedBlockId( ( uint64_t ) getSchain()->getLastCommittedBlockID() );
+    return catchupPlan->assign( Time::getCurrentTimeMs() );
+}
+
+
+void CatchupClientAgent::failChunk( const CatchupChunk& _chunk ) {
+    LOCK( catchupPlanMutex )
+    catchupPlan->fail( _chunk, Time::getCurrentTimeMs() + CATCHUP_FAILED_PEER_BACKOFF_MS );
+}
+
 size_t CatchupClientAgent::parseBlockSizes( nlohmann::json _responseHeader,
     const ptr< vector< uint64_t > >& _blockSizes, ptr< CatchupRequestHeader > _requestHeader ) {
     if ( _responseHeader.count( "sizes" ) == 0 ) {
@@ -261,8 +405,9 @@ ptr< CommittedBlockList > CatchupClientAgent::readMissingBlocks( ptr< ClientSock
     try {
         // During node rotation, some block sigs may not verify durign catchup
         // in such a case we return a partial block list, up to the first non-verifying block
-        blockList = CommittedBlockList::deserialize(
-            getSchain()->getCryptoManager(), blockSizes, serializedBlocks, 0, true );
+        blockList = CommittedBlockList::deserialize( getSchain()->getCryptoManager(), blockSizes,
+            serializedBlocks, 0, true,
+            CATCHUP_MAX_INFLATE_FACTOR * getNode()->getMaxCatchupDownloadBytes() );
         CHECK_STATE( blockList )
 
 
@@ -296,43 +441,28 @@ void CatchupClientAgent::workerThreadItemSendLoop( CatchupClientAgent* _agent )
         usleep( 100 * 1000 );
     }
 
-
-    // start with a random index and then to round-robin
-
-
-    auto nodeCount = ( uint64_t ) _agent->getSchain()->getNodeCount();
-    auto selfIndex = _agent->getSchain()->getSchainIndex();
-
-    uint64_t startIndex;
-
-    auto lastBlockCount = 0;
-
-    do {
-        uint64_t random;
-        getrandom( &random, sizeof( random ), 0 );
-        startIndex = random % nodeCount + 1;
-    } while ( startIndex == ( uint64_t ) selfIndex );
-
-    auto destinationSchainIndex = schain_index( startIndex );
-
     try {
         while ( !_agent->getSchain()->getNode()->isExitRequested() ) {
-            // sleep if previous iteration did not result in blocks
-            if ( lastBlockCount == 0 )
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds( _agent->getNode()->getCatchupIntervalMs() ) );
+            // the plan spreads chunks over the peers and probes one peer per catchup
+            // interval when no peer reports new blocks
+            auto chunk = _agent->assignChunk();
+
+            if ( chunk.blockCount == 0 ) {
+                usleep( CATCHUP_SCHEDULER_POLL_MS * 1000 );
+                continue;
+            }
 
             try {
-                lastBlockCount = _agent->sync( destinationSchainIndex );
+                ( void ) _agent->sync( chunk );
             } catch ( ExitRequestedException& ) {
                 return;
             } catch ( ConnectionRefusedException& e ) {
-                _agent->logConnectionRefused( e, destinationSchainIndex );
+                _agent->logConnectionRefused( e, schain_index( chunk.peerIndex ) );
+                _agent->failChunk( chunk );
             } catch ( exception& e ) {
                 SkaleException::logNested( e );
+                _agent->failChunk( chunk );
             }
-
-            destinationSchainIndex = nextSyncNodeIndex( _agent, destinationSchainIndex );
         }
     } catch ( FatalError& e ) {
         SkaleException::logNested( e );
@@ -340,21 +470,6 @@ void CatchupClientAgent::workerThreadItemSendLoop( CatchupClientAgent* _agent )
     }
 }
 
-schain_index CatchupClientAgent::nextSyncNodeIndex(
-    const CatchupClientAgent* _agent, schain_index _destinationSchainIndex ) {
-    CHECK_ARGUMENT( _agent )
-
-    auto nodeCount = ( uint64_t ) _agent->getSchain()->getNodeCount();
-
-    auto index = _destinationSchainIndex - 1;
-
-    do {
-        index = ( ( uint64_t ) index + 1 ) % nodeCount;
-    } while ( index == ( _agent->getSchain()->getSchainIndex() - 1 ) );
-
-    return index + 1;
-}
-
 
 constexpr uint64_t ALLOWED_CATCHUP_DELAY_S = 30;
 
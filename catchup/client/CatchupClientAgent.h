@@ -37,6 +37,10 @@ class CatchupResponseHeader;
 
 class PeerStateInfo;
 
+class CatchupPlan;
+
+struct CatchupChunk;
+
 
 class CatchupClientAgent : public Agent {
 
@@ -49,10 +53,28 @@ class CatchupClientAgent : public Agent {
     // last catchup starting block
     block_id lastStartingBlock;
 
+    // decides which peer downloads which blocks
+    ptr<CatchupPlan> catchupPlan;
+    recursive_mutex catchupPlanMutex;
+
+    // downloaded block lists waiting for the blocks before them, by first block id
+    map<uint64_t, pair<ptr<CommittedBlockList>, uint64_t>> downloadedChunks;
+    recursive_mutex downloadedChunksMutex;
+
+    // blocks are committed by one thread at a time, in order
+    recursive_mutex commitMutex;
+
+    CatchupChunk assignChunk();
+
+    void failChunk(const CatchupChunk &_chunk);
+
+    uint64_t commitDownloadedChunks();
+
 public:
     explicit CatchupClientAgent(Schain &_sChain);
 
-    [[nodiscard]] uint64_t sync(schain_index _dstIndex);
+    // downloads a chunk of blocks from a peer, returns the number of blocks committed
+    [[nodiscard]] uint64_t sync(const CatchupChunk &_chunk);
 
     static void workerThreadItemSendLoop(CatchupClientAgent *_agent);
 
@@ -71,8 +93,5 @@ public:
 
     [[nodiscard]] block_id getMaxKnownBlockId();
 
-    [[nodiscard]] static schain_index nextSyncNodeIndex(
-            const CatchupClientAgent *_agent, schain_index _destinationSchainIndex);
-
     [[nodiscard]] ConsensusInterface::SyncInfo getSyncInfo();
 };
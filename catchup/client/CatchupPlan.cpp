@@ -0,0 +1,249 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CatchupPlan.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "CatchupPlan.h"
+
+
+CatchupPlan::CatchupPlan( uint64_t _nodeCount, uint64_t _ownIndex,
+    uint64_t _lastCommittedBlockId, uint64_t _maxChunkBytes, uint64_t _intervalMs )
+    : peers( _nodeCount + 1 ),
+      ownIndex( _ownIndex ),
+      lastCommittedBlockId( _lastCommittedBlockId ),
+      maxReportedBlockId( _lastCommittedBlockId ),
+      maxChunkBytes( _maxChunkBytes ),
+      intervalMs( _intervalMs ),
+      lastProbedPeer( _ownIndex ) {
+    CHECK_ARGUMENT( _ownIndex > 0 && _ownIndex <= _nodeCount );
+    CHECK_ARGUMENT( _maxChunkBytes > 0 );
+}
+
+
+uint64_t CatchupPlan::getAvailableBlockId( uint64_t _peerIndex, uint64_t _nowMs ) const {
+    auto& peer = peers.at( _peerIndex );
+
+    if ( peer.reported && peer.reportedAtMs + intervalMs > _nowMs )
+        return peer.lastBlockId;
+
+    // peers that did not report recently are assumed to keep up with the others
+    return max( maxReportedBlockId, peer.lastBlockId );
+}
+
+
+bool CatchupPlan::isIdle( uint64_t _peerIndex, uint64_t _nowMs ) const {
+    auto& peer = peers.at( _peerIndex );
+    return _peerIndex != ownIndex && !peer.busy && peer.retryAtMs <= _nowMs;
+}
+
+
+CatchupChunk CatchupPlan::assign( uint64_t _nowMs ) {
+    // find the lowest block nobody claimed, and where the next claim starts
+    uint64_t start = lastCommittedBlockId + 1;
+    uint64_t end = UINT64_MAX;
+
+    for ( auto&& [claimStart, claim] : claims ) {
+        if ( claimStart + claim.blockCount <= start )
+            continue;
+        if ( claimStart > start ) {
+            end = claimStart - 1;
+            break;
+        }
+        start = claimStart + claim.blockCount;
+    }
+
+    if ( start > maxReportedBlockId ) {
+        if ( claims.empty() )
+            return probe( _nowMs );
+        return {};
+    }
+
+    // do not buffer much more than the parallel requests download at once
+    auto bufferedBytes = ( double ) ( start - lastCommittedBlockId - 1 ) * blockBytes;
+    if ( bufferedBytes > ( double ) maxChunkBytes * CATCHUP_MAX_PARALLEL_REQUESTS )
+        return {};
+
+    uint64_t best = 0;
+    uint64_t candidates = 0;
+
+    for ( uint64_t i = 1; i < peers.size(); i++ ) {
+        if ( !isIdle( i, _nowMs ) || getAvailableBlockId( i, _nowMs ) < start )
+            continue;
+        candidates++;
+        if ( best == 0 || peers[i].bytesPerSec > peers[best].bytesPerSec )
+            best = i;
+    }
+
+    if ( best == 0 )
+        return {};
+
+    // split a short range between the idle peers, so that all of them work
+    auto last = min( min( end, maxReportedBlockId ), getAvailableBlockId( best, _nowMs ) );
+    auto share = ( maxReportedBlockId - start + candidates ) / candidates;
+    auto count = min( getChunkBlocks( best ), max( share, CATCHUP_MIN_CHUNK_BLOCKS ) );
+    count = min( count, last - start + 1 );
+
+    peers[best].busy = true;
+    claims[start] = { count, false };
+
+    return { best, start, count };
+}
+
+
+CatchupChunk CatchupPlan::probe( uint64_t _nowMs ) {
+    if ( _nowMs < nextProbeMs )
+        return {};
+
+    for ( uint64_t i = 1; i < peers.size(); i++ ) {
+        auto peerIndex = ( lastProbedPeer + i - 1 ) % ( peers.size() - 1 ) + 1;
+        if ( !isIdle( peerIndex, _nowMs ) )
+            continue;
+
+        lastProbedPeer = peerIndex;
+        nextProbeMs = _nowMs + intervalMs;
+
+        auto start = lastCommittedBlockId + 1;
+        auto count = getChunkBlocks( peerIndex );
+        peers[peerIndex].busy = true;
+        claims[start] = { count, false };
+
+        return { peerIndex, start, count };
+    }
+
+    return {};
+}
+
+
+void CatchupPlan::complete( const CatchupChunk& _chunk, uint64_t _blockCount, uint64_t _bytes,
+    uint64_t _latencyMs, uint64_t _elapsedMs, uint64_t _nowMs ) {
+    CHECK_ARGUMENT( _chunk.blockCount > 0 );
+    CHECK_ARGUMENT( _blockCount <= _chunk.blockCount );
+
+    auto& peer = peers.at( _chunk.peerIndex );
+    peer.busy = false;
+    claims.erase( _chunk.startBlock );
+
+    if ( _blockCount == 0 ) {
+        // the peer does not have the first block of the chunk
+        peer.reported = true;
+        peer.lastBlockId = _chunk.startBlock - 1;
+        peer.reportedAtMs = _nowMs;
+        return;
+    }
+
+    // whatever the peer did not return is claimed again by the next assign
+    if ( _chunk.startBlock + _blockCount - 1 > lastCommittedBlockId )
+        claims[_chunk.startBlock] = { _blockCount, true };
+
+    auto bytesPerSec = ( double ) _bytes * 1000 / ( double ) max( _elapsedMs, ( uint64_t ) 1 );
+    auto averageBlockBytes = ( double ) _bytes / ( double ) _blockCount;
+
+    if ( peer.bytesPerSec == 0 ) {
+        peer.bytesPerSec = bytesPerSec;
+        peer.latencyMs = _latencyMs;
+    } else {
+        peer.bytesPerSec = 0.7 * peer.bytesPerSec + 0.3 * bytesPerSec;
+        peer.latencyMs = 0.7 * peer.latencyMs + 0.3 * ( double ) _latencyMs;
+    }
+
+    if ( blockBytes == 0 )
+        blockBytes = averageBlockBytes;
+    else
+        blockBytes = 0.7 * blockBytes + 0.3 * averageBlockBytes;
+}
+
+
+void CatchupPlan::fail( const CatchupChunk& _chunk, uint64_t _retryAtMs ) {
+    auto& peer = peers.at( _chunk.peerIndex );
+    peer.busy = false;
+    peer.retryAtMs = _retryAtMs;
+
+    auto it = claims.find( _chunk.startBlock );
+    if ( it != claims.end() && !it->second.downloaded )
+        claims.erase( it );
+}
+
+
+void CatchupPlan::release( uint64_t _startBlock ) {
+    auto it = claims.find( _startBlock );
+    if ( it != claims.end() && it->second.downloaded )
+        claims.erase( it );
+}
+
+
+void CatchupPlan::reportLastBlockId(
+    uint64_t _peerIndex, uint64_t _lastBlockId, uint64_t _nowMs ) {
+    auto& peer = peers.at( _peerIndex );
+    peer.reported = true;
+    peer.lastBlockId = _lastBlockId;
+    peer.reportedAtMs = _nowMs;
+    maxReportedBlockId = max( maxReportedBlockId, _lastBlockId );
+}
+
+
+void CatchupPlan::setLastCommittedBlockId( uint64_t _lastCommittedBlockId ) {
+    lastCommittedBlockId = max( lastCommittedBlockId, _lastCommittedBlockId );
+    maxReportedBlockId = max( maxReportedBlockId, lastCommittedBlockId );
+
+    for ( auto it = claims.begin(); it != claims.end(); ) {
+        if ( it->second.downloaded &&
+             it->first + it->second.blockCount - 1 <= lastCommittedBlockId ) {
+            it = claims.erase( it );
+        } else {
+            it++;
+        }
+    }
+}
+
+
+uint64_t CatchupPlan::getChunkBlocks( uint64_t _peerIndex ) const {
+    auto& peer = peers.at( _peerIndex );
+
+    if ( peer.bytesPerSec == 0 || blockBytes == 0 )
+        return CATCHUP_INITIAL_CHUNK_BLOCKS;
+
+    // long enough to hide the request latency
+    auto durationMs =
+        max( ( double ) CATCHUP_TARGET_CHUNK_MS, CATCHUP_LATENCY_FACTOR * peer.latencyMs );
+    auto bytes = min( peer.bytesPerSec * durationMs / 1000, ( double ) maxChunkBytes );
+    auto blocks = ( uint64_t ) ( bytes / blockBytes );
+
+    return min( max( blocks, CATCHUP_MIN_CHUNK_BLOCKS ), CATCHUP_MAX_CHUNK_BLOCKS );
+}
+
+
+uint64_t CatchupPlan::getMaxReportedBlockId() const {
+    return maxReportedBlockId;
+}
+
+
+double CatchupPlan::getBytesPerSec( uint64_t _peerIndex ) const {
+    return peers.at( _peerIndex ).bytesPerSec;
+}
+
+
+bool CatchupPlan::isBehind() const {
+    return maxReportedBlockId > lastCommittedBlockId;
+}
@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CatchupPlan.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+struct CatchupChunk {
+    uint64_t peerIndex = 0;
+    uint64_t startBlock = 0;
+    // 0 if there is nothing to request
+    uint64_t blockCount = 0;
+};
+
+
+// Splits the blocks missing after the last committed block into chunks and decides which peer
+// downloads which chunk. A peer gets chunks below the last block it reported, peers that have
+// not reported recently are assumed to have the highest block anybody reported. Chunks are sized
+// from the measured throughput and latency of the peer, so that a request takes about
+// CATCHUP_TARGET_CHUNK_MS, and split evenly when the missing range is short.
+// When no peer reports newer blocks, one peer at a time is probed every catchup interval.
+// Not thread safe, CatchupClientAgent calls it under its lock.
+class CatchupPlan {
+    struct PeerState {
+        bool busy = false;
+        bool reported = false;
+        uint64_t lastBlockId = 0;
+        uint64_t reportedAtMs = 0;
+        uint64_t retryAtMs = 0;
+        // EWMA, 0 if unknown
+        double bytesPerSec = 0;
+        double latencyMs = 0;
+    };
+
+    struct Claim {
+        uint64_t blockCount = 0;
+        bool downloaded = false;
+    };
+
+    // indexed by peer index, element 0 is unused
+    vector< PeerState > peers;
+
+    // chunks in flight or downloaded and waiting to be committed, by start block
+    map< uint64_t, Claim > claims;
+
+    uint64_t ownIndex = 0;
+    uint64_t lastCommittedBlockId = 0;
+    uint64_t maxReportedBlockId = 0;
+    uint64_t maxChunkBytes = 0;
+    uint64_t intervalMs = 0;
+    uint64_t nextProbeMs = 0;
+    uint64_t lastProbedPeer = 0;
+    double blockBytes = 0;
+
+    uint64_t getAvailableBlockId( uint64_t _peerIndex, uint64_t _nowMs ) const;
+
+    bool isIdle( uint64_t _peerIndex, uint64_t _nowMs ) const;
+
+    CatchupChunk probe( uint64_t _nowMs );
+
+public:
+    CatchupPlan( uint64_t _nodeCount, uint64_t _ownIndex, uint64_t _lastCommittedBlockId,
+        uint64_t _maxChunkBytes, uint64_t _intervalMs );
+
+    // returns the next request to send, with blockCount 0 if there is nothing to do
+    CatchupChunk assign( uint64_t _nowMs );
+
+    // the peer returned _blockCount blocks from the chunk start, 0 if it had none
+    void complete( const CatchupChunk& _chunk, uint64_t _blockCount, uint64_t _bytes,
+        uint64_t _latencyMs, uint64_t _elapsedMs, uint64_t _nowMs );
+
+    void fail( const CatchupChunk& _chunk, uint64_t _retryAtMs );
+
+    // a downloaded chunk could not be committed, it is downloaded again
+    void release( uint64_t _startBlock );
+
+    void reportLastBlockId( uint64_t _peerIndex, uint64_t _lastBlockId, uint64_t _nowMs );
+
+    void setLastCommittedBlockId( uint64_t _lastCommittedBlockId );
+
+    uint64_t getChunkBlocks( uint64_t _peerIndex ) const;
+
+    uint64_t getMaxReportedBlockId() const;
+
+    double getBytesPerSec( uint64_t _peerIndex ) const;
+
+    // true if some peer reported blocks this node does not have
+    bool isBehind() const;
+};
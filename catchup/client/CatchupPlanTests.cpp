@@ -0,0 +1,256 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CatchupPlanTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "CatchupPlan.h"
+
+
+TEST_CASE( "Catchup plan splits missing blocks between peers", "[catchup-plan]" ) {
+    // 4 nodes, this node is 1 and has no blocks
+    CatchupPlan plan( 4, 1, 0, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    plan.reportLastBlockId( 2, 1000, 0 );
+    REQUIRE( plan.isBehind() );
+
+    // peers 3 and 4 did not report, they are assumed to have the blocks too
+    set< uint64_t > usedPeers;
+    uint64_t next = 1;
+    for ( int i = 0; i < 3; i++ ) {
+        auto chunk = plan.assign( 0 );
+        REQUIRE( chunk.startBlock == next );
+        REQUIRE( chunk.blockCount == CATCHUP_INITIAL_CHUNK_BLOCKS );
+        usedPeers.insert( chunk.peerIndex );
+        next += chunk.blockCount;
+    }
+    REQUIRE( usedPeers == set< uint64_t >{ 2, 3, 4 } );
+
+    // one request per peer at a time
+    REQUIRE( plan.assign( 0 ).blockCount == 0 );
+}
+
+
+TEST_CASE( "Catchup plan respects peer last blocks", "[catchup-plan]" ) {
+    CatchupPlan plan( 4, 4, 100, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    plan.reportLastBlockId( 1, 110, 0 );
+    plan.reportLastBlockId( 2, 100, 0 );
+    plan.reportLastBlockId( 3, 100, 0 );
+
+    auto chunk = plan.assign( 0 );
+    REQUIRE( chunk.peerIndex == 1 );
+    REQUIRE( chunk.startBlock == 101 );
+    REQUIRE( chunk.blockCount == 10 );
+    REQUIRE( plan.assign( 0 ).blockCount == 0 );
+
+    // the peer returned part of the chunk, the rest is requested again
+    plan.complete( chunk, 4, 4000, 10, 100, 100 );
+    chunk = plan.assign( 100 );
+    REQUIRE( chunk.peerIndex == 1 );
+    REQUIRE( chunk.startBlock == 105 );
+    REQUIRE( chunk.blockCount == 6 );
+
+    // a failed peer backs off
+    plan.fail( chunk, 1000 );
+    REQUIRE( plan.assign( 500 ).blockCount == 0 );
+    REQUIRE( plan.assign( 1000 ).startBlock == 105 );
+
+    // reports go stale, then the peers are tried again
+    plan.setLastCommittedBlockId( 110 );
+    plan.reportLastBlockId( 1, 120, 1000 );
+    chunk = plan.assign( 1000 + CATCHUP_INTERVAL_MS );
+    REQUIRE( chunk.startBlock == 111 );
+    REQUIRE( chunk.peerIndex != 1 );
+}
+
+
+TEST_CASE( "Catchup plan adapts chunk size", "[catchup-plan]" ) {
+    CatchupPlan plan( 4, 1, 0, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    plan.reportLastBlockId( 2, 100000, 0 );
+    plan.reportLastBlockId( 3, 100000, 0 );
+
+    auto fast = plan.assign( 0 );
+    auto slow = plan.assign( 0 );
+    REQUIRE( fast.blockCount == CATCHUP_INITIAL_CHUNK_BLOCKS );
+
+    // 10 KB blocks, 6.4 MB/s and 1.28 MB/s
+    plan.complete( fast, fast.blockCount, fast.blockCount * 10000, 10, 100, 100 );
+    plan.complete( slow, slow.blockCount, slow.blockCount * 10000, 10, 500, 500 );
+
+    REQUIRE( plan.getChunkBlocks( fast.peerIndex ) == 1280 );
+    REQUIRE( plan.getChunkBlocks( slow.peerIndex ) == 256 );
+
+    // the fastest idle peer is served first
+    REQUIRE( plan.assign( 500 ).peerIndex == fast.peerIndex );
+
+    // a high latency peer gets larger chunks, 1.28 MB/s with 1 s latency
+    CatchupPlan far( 2, 1, 0, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    far.reportLastBlockId( 2, 100000, 0 );
+    auto chunk = far.assign( 0 );
+    far.complete( chunk, chunk.blockCount, chunk.blockCount * 10000, 1000, 500, 500 );
+    REQUIRE( far.getChunkBlocks( 2 ) == 1024 );
+}
+
+
+TEST_CASE( "Catchup plan probes one peer per interval", "[catchup-plan]" ) {
+    CatchupPlan plan( 4, 2, 50, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    REQUIRE( !plan.isBehind() );
+
+    auto chunk = plan.assign( 0 );
+    REQUIRE( chunk.peerIndex == 3 );
+    REQUIRE( chunk.startBlock == 51 );
+    REQUIRE( plan.assign( 0 ).blockCount == 0 );
+
+    // nothing new, wait for the interval
+    plan.complete( chunk, 0, 0, 10, 10, 10 );
+    REQUIRE( plan.assign( 10 ).blockCount == 0 );
+    REQUIRE( plan.assign( CATCHUP_INTERVAL_MS ).peerIndex == 4 );
+
+    // a peer reports new blocks, the others are asked right away
+    plan.reportLastBlockId( 4, 60, CATCHUP_INTERVAL_MS );
+    REQUIRE( plan.isBehind() );
+    plan.complete( { 4, 51, CATCHUP_INITIAL_CHUNK_BLOCKS }, 10, 10000, 10, 10,
+        CATCHUP_INTERVAL_MS );
+    plan.setLastCommittedBlockId( 60 );
+    REQUIRE( !plan.isBehind() );
+    plan.reportLastBlockId( 4, 70, CATCHUP_INTERVAL_MS + 10 );
+    chunk = plan.assign( CATCHUP_INTERVAL_MS + 10 );
+    REQUIRE( chunk.startBlock == 61 );
+    REQUIRE( chunk.blockCount == 10 );
+}
+
+
+namespace {
+
+struct SimulatedPeer {
+    double bytesPerMs;
+    uint64_t latencyMs;
+};
+
+
+struct SimulatedRequest {
+    CatchupChunk chunk;
+    uint64_t startMs;
+    uint64_t blockCount;
+    uint64_t bytes;
+};
+
+
+// returns how many blocks a server returns from _start, at most MAX_CATCHUP_DOWNLOAD_BYTES
+uint64_t serveBlocks( const vector< uint64_t >& _sizes, uint64_t _start, uint64_t _count,
+    uint64_t& _bytes ) {
+    uint64_t count = 0;
+    _bytes = 0;
+    for ( auto i = _start; i < _sizes.size() && count < _count; i++ ) {
+        if ( count > 0 && _bytes + _sizes[i] > MAX_CATCHUP_DOWNLOAD_BYTES )
+            break;
+        _bytes += _sizes[i];
+        count++;
+    }
+    return count;
+}
+
+
+uint64_t transferMs( const SimulatedPeer& _peer, uint64_t _bytes ) {
+    return _peer.latencyMs + ( uint64_t ) ( ( double ) _bytes / _peer.bytesPerMs );
+}
+
+}  // namespace
+
+
+TEST_CASE( "Catchup 10k blocks from 4 peers", "[.benchmark]" ) {
+    const uint64_t blockCount = 10000;
+    // this node is 1, peers 2..5 differ in bandwidth and latency
+    vector< SimulatedPeer > peers = { {}, {}, { 40000, 5 }, { 20000, 20 }, { 10000, 50 },
+        { 2500, 100 } };
+
+    mt19937 generator( 7 );
+    uniform_int_distribution< uint64_t > blockSize( 1000, 200000 );
+    vector< uint64_t > sizes( blockCount + 1, 0 );
+    for ( uint64_t i = 1; i <= blockCount; i++ ) {
+        sizes[i] = blockSize( generator );
+    }
+
+    // one peer at a time, round robin, as much as the server returns
+    uint64_t sequentialMs = 0;
+    uint64_t sequentialRequests = 0;
+    for ( uint64_t committed = 0, peer = 2; committed < blockCount; peer = peer % 4 + 2 ) {
+        uint64_t bytes;
+        auto count = serveBlocks( sizes, committed + 1, UINT64_MAX, bytes );
+        sequentialMs += transferMs( peers[peer], bytes );
+        sequentialRequests++;
+        committed += count;
+    }
+
+    // the plan, with one request per peer in parallel
+    CatchupPlan plan( 5, 1, 0, MAX_CATCHUP_DOWNLOAD_BYTES, CATCHUP_INTERVAL_MS );
+    // by finish time
+    multimap< uint64_t, SimulatedRequest > inFlight;
+    map< uint64_t, uint64_t > downloaded;
+    uint64_t committed = 0;
+    uint64_t nowMs = 0;
+    uint64_t requests = 0;
+
+    while ( committed < blockCount ) {
+        plan.setLastCommittedBlockId( committed );
+
+        for ( auto chunk = plan.assign( nowMs ); chunk.blockCount > 0;
+              chunk = plan.assign( nowMs ) ) {
+            uint64_t bytes;
+            auto count = serveBlocks( sizes, chunk.startBlock, chunk.blockCount, bytes );
+            inFlight.insert( { nowMs + transferMs( peers[chunk.peerIndex], bytes ),
+                { chunk, nowMs, count, bytes } } );
+            requests++;
+        }
+
+        if ( inFlight.empty() ) {
+            nowMs += CATCHUP_SCHEDULER_POLL_MS;
+            continue;
+        }
+
+        auto [finishMs, request] = *inFlight.begin();
+        inFlight.erase( inFlight.begin() );
+        nowMs = finishMs;
+
+        auto& chunk = request.chunk;
+        plan.reportLastBlockId( chunk.peerIndex, blockCount, nowMs );
+        plan.complete( chunk, request.blockCount, request.bytes,
+            peers[chunk.peerIndex].latencyMs, nowMs - request.startMs, nowMs );
+
+        if ( request.blockCount > 0 )
+            downloaded[chunk.startBlock] = request.blockCount;
+
+        // commit in order
+        for ( auto it = downloaded.begin(); it != downloaded.end() && it->first <= committed + 1;
+              it = downloaded.erase( it ) ) {
+            committed = max( committed, it->first + it->second - 1 );
+        }
+    }
+
+    WARN( "Catchup of " << blockCount << " blocks from 4 peers:" );
+    WARN( "  one peer at a time: " << sequentialMs << " ms, " << sequentialRequests
+          << " requests" );
+    WARN( "  catchup plan:       " << nowMs << " ms, " << requests << " requests" );
+
+}
@@ -227,7 +227,7 @@ ptr< vector< uint8_t > > CatchupServerAgent::createResponseHeaderAndBinary(
 
 
 ptr< vector< uint8_t > > CatchupServerAgent::createBlockCatchupResponse(
-        nlohmann::json /*_jsonRequest */, const ptr< CatchupResponseHeader >& _responseHeader,
+        nlohmann::json _jsonRequest, const ptr< CatchupResponseHeader >& _responseHeader,
         block_id _blockID ) {
     CHECK_ARGUMENT( _responseHeader );
 
@@ -257,9 +257,20 @@ ptr< vector< uint8_t > > CatchupServerAgent::createBlockCatchupResponse(
         }
 
 
+        // clients downloading from several peers ask for a range
+        block_id endBlockID = lastCommittedBlockID;
+        if ( _jsonRequest.find( "blockCount" ) != _jsonRequest.end() ) {
+            auto blockCount = Header::getUint64( _jsonRequest, "blockCount" );
+            if ( blockCount > 0 && ( uint64_t ) _blockID + blockCount < endBlockID )
+                endBlockID = ( uint64_t ) _blockID + blockCount;
+        }
+
+        // older clients do not send this and get uncompressed blocks
+        bool compressed = _jsonRequest.value( "compressed", false );
+
         auto serializedBlocks =
                 getSchain()->getNode()->getBlockDB()->getSerializedBlocksFromLevelDB(
-                        ( uint64_t ) _blockID + 1, lastCommittedBlockID, blockSizes );
+                        ( uint64_t ) _blockID + 1, endBlockID, blockSizes, compressed );
 
         CHECK_STATE( blockSizes->size() > 0 );
 
@@ -274,6 +285,8 @@ ptr< vector< uint8_t > > CatchupServerAgent::createBlockCatchupResponse(
 
         _responseHeader->setStatusSubStatus( CONNECTION_PROCEED, CONNECTION_OK );
 
+        _responseHeader->setCompressed( compressed );
+
         _responseHeader->setBlockSizesAndLatestBlockInfo(
                 blockSizes, lastCommittedBlockID, lastCommittedBlockTimestampS );
 
@@ -362,8 +375,30 @@ ptr< vector< uint8_t > > CatchupServerAgent::createBlockFinalizeResponse(
         CHECK_STATE( !daSig.empty() );
 
 
-        auto fragment =
-                proposal->getFragment( ( uint64_t ) getSchain()->getNodeCount() - 1, fragmentIndex );
+        auto totalFragments = ( uint64_t ) getSchain()->getNodeCount() - 1;
+
+        // clients past the erasure coding patch ask for Reed-Solomon coded fragments
+        uint64_t dataFragments = 0;
+        if ( _jsonRequest.find( "dataFragments" ) != _jsonRequest.end() )
+            dataFragments = Header::getUint64( _jsonRequest, "dataFragments" );
+
+        if ( dataFragments > totalFragments ) {
+            LOG( debug, "Incorrect data fragments:" << to_string( dataFragments ) );
+            _responseHeader->setStatusSubStatus(
+                    CONNECTION_DISCONNECT, CONNECTION_ERROR_INVALID_FRAGMENT_INDEX );
+            _responseHeader->setComplete();
+            return nullptr;
+        }
+
+        ptr< BlockProposalFragment > fragment;
+
+        if ( dataFragments > 0 ) {
+            fragment = proposal->getErasureCodedFragment(
+                    totalFragments, dataFragments, fragmentIndex );
+            _responseHeader->setDataFragments( dataFragments );
+        } else {
+            fragment = proposal->getFragment( totalFragments, fragmentIndex );
+        }
 
 
         CHECK_STATE( fragment );
@@ -45,8 +45,11 @@
 #include "node/ConsensusEngine.h"
 #include "node/Node.h"
 #include "pendingqueue/PendingTransactionsAgent.h"
+#include "statusserver/MetricsServer.h"
+#include "utils/LatencyHistogram.h"
 #include "utils/Time.h"
 
+#include "blockfinalize/client/BlockFinalizeDownloadScheduler.h"
 #include "blockfinalize/client/BlockFinalizeDownloader.h"
 #include "blockproposal/server/BlockProposalServerAgent.h"
 #include "catchup/client/CatchupClientAgent.h"
@@ -66,6 +69,7 @@
 #include "datastructures/Transaction.h"
 #include "datastructures/TransactionList.h"
 #include "db/BlockProposalDB.h"
+#include "db/BlockMetadataIndex.h"
 #include "db/BlockSigShareDB.h"
 #include "db/DAProofDB.h"
 #include "db/DASigShareDB.h"
@@ -82,6 +86,7 @@
 #include "messages/Message.h"
 #include "messages/MessageEnvelope.h"
 #include "messages/NetworkMessageEnvelope.h"
+#include "monitoring/AdaptiveProposalTimeout.h"
 #include "monitoring/MonitoringAgent.h"
 #include "monitoring/StuckDetectionAgent.h"
 #include "network/ClientSocket.h"
@@ -106,6 +111,7 @@
 #include "crypto/CryptoManager.h"
 #include "crypto/ThresholdSigShare.h"
 #include "crypto/bls_include.h"
+#include "db/BlockCommitBatch.h"
 #include "db/BlockDB.h"
 #include "db/CacheLevelDB.h"
 #include "db/ProposalHashDB.h"
@@ -242,8 +248,11 @@ Schain::Schain( weak_ptr< Node > _node, schain_index _schainIndex, const schain_
       schainIndex( _schainIndex ) {
     lastCommittedBlockTimeStamp = TimeStamp( 0, 0 );
 
+    deathTimesMs = vector< atomic< uint64_t > >( getNode()->getNodeInfosByIndex()->size() + 1 );
+
     // construct monitoring, timeout and stuck detection agents early
     monitoringAgent = make_shared< MonitoringAgent >( *this );
+    proposalTimeout = make_shared< AdaptiveProposalTimeout >();
     if ( !getNode()->isSyncOnlyNode() ) {
         timeoutAgent = make_shared< TimeoutAgent >( *this );
         stuckDetectionAgent = make_shared< StuckDetectionAgent >( *this );
@@ -260,7 +269,7 @@ Schain::Schain( weak_ptr< Node > _node, schain_index _schainIndex, const schain_
     }
 
     try {
-        this->io = make_shared< IO >( this );
+        this->io = make_shared< IO >( this, getNode()->isBinaryHeaders() );
 
 
         for ( auto const& iterator : *getNode()->getNodeInfosByIndex() ) {
@@ -296,6 +305,11 @@ Schain::Schain( weak_ptr< Node > _node, schain_index _schainIndex, const schain_
                 getNode()->getPatchTimestamps().at( "verifyDaSigsPatchTimestamp" );
         }
 
+        if ( getNode()->getPatchTimestamps().count( "erasureCodedFragmentsPatchTimestamp" ) > 0 ) {
+            this->erasureCodedFragmentsPatchTimestampS =
+                getNode()->getPatchTimestamps().at( "erasureCodedFragmentsPatchTimestamp" );
+        }
+
     } catch ( ExitRequestedException& ) {
         throw;
     } catch ( ... ) {
@@ -321,6 +335,7 @@ void Schain::constructChildAgents() {
 
         pendingTransactionsAgent = make_shared< PendingTransactionsAgent >( *this );
         blockProposalClient = make_shared< BlockProposalClientAgent >( *this );
+        blockFinalizeDownloadScheduler = make_shared< BlockFinalizeDownloadScheduler >( *this );
 
         testMessageGeneratorAgent = make_shared< TestMessageGeneratorAgent >( *this );
 
@@ -379,16 +394,33 @@ void Schain::lockWithDeadLockCheck( const char* _functionName ) {
 
         CHECK_STATE( blocks->at( 0 )->getBlockID() <= ( uint64_t ) getLastCommittedBlockID() + 1 );
 
-        for ( size_t i = 0; i < blocks->size(); i++ ) {
+        for ( size_t i = 0; i < blocks->size(); ) {
             checkForExit();
 
-            auto block = blocks->at( i );
+            // a node far behind saves runs of new blocks with one database write,
+            // then passes them to the EVM back to back
+            vector< ptr< CommittedBlock > > batch;
+            auto lastTimeStamp = getLastCommittedBlockTimeStamp();
 
-            CHECK_STATE( block );
+            for ( ; i < blocks->size() && batch.size() < CATCHUP_BLOCK_SAVE_BATCH; i++ ) {
+                auto block = blocks->at( i );
 
-            if ( ( uint64_t ) block->getBlockID() == ( getLastCommittedBlockID() + 1 ) ) {
-                CHECK_STATE( getLastCommittedBlockTimeStamp() < block->getTimeStamp() );
-                processCommittedBlock( block );
+                CHECK_STATE( block );
+
+                if ( ( uint64_t ) block->getBlockID() ==
+                     ( getLastCommittedBlockID() + 1 + batch.size() ) ) {
+                    CHECK_STATE( lastTimeStamp < block->getTimeStamp() );
+                    lastTimeStamp = block->getTimeStamp();
+                    batch.push_back( block );
+                }
+            }
+
+            if ( batch.size() > 1 )
+                getNode()->getBlockDB()->saveBlocks( batch );
+
+            for ( auto&& block : batch ) {
+                checkForExit();
+                processCommittedBlock( block, batch.size() > 1 );
             }
         }
 
@@ -436,6 +468,17 @@ bool Schain::verifyDASigsPatch( uint64_t _blockTimeStampS ) {
     return verifyDaSigsPatchTimestampS != 0 && _blockTimeStampS >= verifyDaSigsPatchTimestampS;
 }
 
+bool Schain::erasureCodedFragmentsPatch( uint64_t _blockTimeStampS ) {
+    return erasureCodedFragmentsPatchTimestampS != 0 &&
+           _blockTimeStampS >= erasureCodedFragmentsPatchTimestampS;
+}
+
+uint64_t Schain::getErasureCodedDataFragments() {
+    // this node is one of the required signers, at most a third of the other nodes can be
+    // faulty, so the fragments of the remaining peers have to be enough
+    return max( getRequiredSigners(), ( uint64_t ) 2 ) - 1;
+}
+
 
 void Schain::blockCommitArrived( block_id _committedBlockID, schain_index _proposerIndex,
     const ptr< ThresholdSignature >& _thresholdSig, ptr< ThresholdSignature > _daSig ) {
@@ -616,6 +659,8 @@ void Schain::printBlockLog( const ptr< CommittedBlock >& _block ) {
 
     totalTransactions += _block->getTransactionList()->size();
 
+    updateBlockMovingAverages( _block );
+
     auto h = _block->getHash().toHex().substr( 0, 8 );
 
     auto stamp = TimeStamp( _block->getTimeStampS(), _block->getTimeStampMs() );
@@ -637,7 +682,8 @@ void Schain::printBlockLog( const ptr< CommittedBlock >& _block ) {
            << ":BPS:" << BlockProposalSet::getTotalObjects()
            << ":HDRS:" << Header::getTotalObjects() << ":SOCK:" << ClientSocket::getTotalSockets()
            << ":FDS:" << ConsensusEngine::getOpenDescriptors() << ":PRT:" << proposalReceiptTime
-           << ":BTA:" << blockTimeAverageMs << ":BSA:" << blockSizeAverage << ":TPS:" << tpsAverage
+           << ":BTA:" << getBlockTimeAverageMs() << ":BSA:" << getBlockSizeAverage()
+           << ":TPS:" << getTpsAverage()
            << ":LWT:" << CacheLevelDB::getWriteStats() << ":LRT:" << CacheLevelDB::getReadStats()
            << ":LWC:" << CacheLevelDB::getWrites() << ":LRC:" << CacheLevelDB::getReads();
 
@@ -683,7 +729,7 @@ void Schain::printBlockLog( const ptr< CommittedBlock >& _block ) {
     counter++;
 }
 
-void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block ) {
+void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block, bool _isSaved ) {
     CHECK_ARGUMENT( _block );
     // process committed block needs to be called why holding main mutex
 
@@ -704,7 +750,11 @@ void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block ) {
 
         CHECK_STATE( _block->getBlockID() = getLastCommittedBlockID() + 1 )
 
-        saveBlock( _block );
+        // the block, its price and the last committed marker are written together
+        BlockCommitBatch commit;
+
+        if ( !_isSaved )
+            saveBlock( _block, commit );
 
         cleanupUnneededMemoryBeforePushingToEvm( _block );
 
@@ -721,7 +771,7 @@ void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block ) {
                              << to_string( pendingTransactionsAgent->getTransactionListWaitTime() )
                              << ":SBPT:" << to_string( cryptoManager->sgxBlockProcessingTime() ) );
         }
-        pushBlockToExtFace( _block );
+        pushBlockToExtFace( _block, &commit );
         auto evmProcessingTimeMs = Time::getCurrentTimeMs() - evmProcessingStartMs;
 
         auto stamp = TimeStamp( _block->getTimeStampS(), _block->getTimeStampMs() );
@@ -729,6 +779,12 @@ void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block ) {
         updateLastCommittedBlockInfo( ( uint64_t ) _block->getBlockID(), stamp,
             _block->getTransactionList()->size(), evmProcessingTimeMs );
 
+        // agents waiting for the next block react now instead of on their next poll
+        if ( !getNode()->isSyncOnlyNode() ) {
+            timeoutAgent->wakeUp();
+            getNode()->getNetwork()->wakeUpDeferredMessagesLoop();
+        }
+
         // the last thing is to run analyzers to log any errors that happened during
         // block processing
 
@@ -741,14 +797,14 @@ void Schain::processCommittedBlock( const ptr< CommittedBlock >& _block ) {
     }
 }
 
-void Schain::saveBlock( const ptr< CommittedBlock >& _block ) {
+void Schain::saveBlock( const ptr< CommittedBlock >& _block, BlockCommitBatch& _commit ) {
     CHECK_ARGUMENT( _block );
 
     MONITOR( __CLASS_NAME__, __FUNCTION__ )
 
     try {
         checkForExit();
-        getNode()->getBlockDB()->saveBlock( _block );
+        getNode()->getBlockDB()->stageBlock( _commit, _block );
     } catch ( ExitRequestedException& ) {
         throw;
     } catch ( ... ) {
@@ -771,20 +827,30 @@ void Schain::cleanupUnneededMemoryBeforePushingToEvm( const ptr< CommittedBlock
 }
 
 
-void Schain::pushBlockToExtFace( const ptr< CommittedBlock >& _block ) {
+void Schain::pushBlockToExtFace(
+    const ptr< CommittedBlock >& _block, BlockCommitBatch* _commit ) {
     CHECK_ARGUMENT( _block );
 
     MONITOR2( __CLASS_NAME__, __FUNCTION__, getMaxExternalBlockProcessingTime() )
 
-    checkForExit();
+    // a staged block is written before exit is checked, as it was saved before
+    if ( !_commit )
+        checkForExit();
 
     try {
         auto tv = _block->getTransactionList()->createTransactionVector();
 
         // auto next_price = // VERIFY PRICING
 
-        this->pricingAgent->calculatePrice(
-            *tv, _block->getTimeStampS(), _block->getTimeStampMs(), _block->getBlockID() );
+        auto price = this->pricingAgent->calculatePrice( *tv, _block->getTimeStampS(),
+            _block->getTimeStampMs(), _block->getBlockID(), _commit );
+
+        if ( _commit ) {
+            _commit->apply();
+        }
+
+        getNode()->getBlockMetadataIndex()->write(
+            _block->getBlockID(), BlockMetadataIndex::createMetadata( _block, price ) );
 
         auto currentPrice = this->pricingAgent->readPrice( _block->getBlockID() - 1 );
 
@@ -796,9 +862,12 @@ void Schain::pushBlockToExtFace( const ptr< CommittedBlock >& _block ) {
         if ( extFace ) {
             try {
                 inCreateBlock = true;
+                auto createBlockStartUs = Time::getMonotonicTimeUs();
                 extFace->createBlock( *tv, _block->getTimeStampS(), _block->getTimeStampMs(),
                     ( __uint64_t ) _block->getBlockID(), currentPrice, _block->getStateRoot(),
                     ( uint64_t ) _block->getProposerIndex() );
+                LatencyHistogram::record(
+                    LAT_EVM_CREATE_BLOCK, Time::getMonotonicTimeUs() - createBlockStartUs );
                 inCreateBlock = false;
             } catch ( ... ) {
                 inCreateBlock = false;
@@ -891,8 +960,20 @@ void Schain::daProofArrived( const ptr< DAProof >& _daProof ) {
         if ( _daProof->getBlockId() <= getLastCommittedBlockID() )
             return;
 
+        if ( _daProof->getBlockId() == getLastCommittedBlockID() + 1 ) {
+            auto timeZero = max( getLastCommitTimeMs(), getStartTimeMs() );
+            auto now = Time::getCurrentTimeMs();
+            if ( timeZero > 0 && now >= timeZero )
+                proposalTimeout->proofArrived( _daProof->getBlockId(),
+                    ( uint64_t ) _daProof->getProposerIndex(), now - timeZero );
+        }
+
         auto pv = getNode()->getDaProofDB()->addDAProof( _daProof );
 
+        // one proposer fewer to wait for can shorten the receipt timeout
+        if ( pv == nullptr && timeoutAgent )
+            timeoutAgent->wakeUp();
+
 
         if ( pv != nullptr ) {
             auto bid = _daProof->getBlockId();
@@ -939,6 +1020,45 @@ void Schain::updateInternalChainInfo( block_id _lastCommittedBlockID ) {
 }
 
 
+void Schain::rebuildBlockMetadataIndex() {
+    auto index = getNode()->getBlockMetadataIndex();
+
+    auto lastInDb = ( uint64_t ) readLastCommittedBlockIDFromDb();
+    auto lastIndexed = ( uint64_t ) index->getLastBlockId();
+
+    if ( lastIndexed > lastInDb ) {
+        LOG( warn, "Block metadata index is ahead of the block database, clearing it" );
+        index->clear();
+        lastIndexed = 0;
+    }
+
+    uint64_t rebuilt = 0;
+
+    // only the newest blocks, so that a missing or old index does not make startup read the
+    // whole block database. Older records fall back to the databases
+    if ( lastInDb > BLOCK_METADATA_REBUILD_WINDOW )
+        lastIndexed = max( lastIndexed, lastInDb - BLOCK_METADATA_REBUILD_WINDOW );
+
+    // walk back from the newest block until the indexed tail, or until blocks or prices
+    // have been rotated out of the databases
+    for ( uint64_t id = lastInDb; id > lastIndexed; id-- ) {
+        try {
+            auto block = getNode()->getBlockDB()->getBlock( id, getCryptoManager(), false );
+            if ( !block )
+                break;
+            auto price = getNode()->getPriceDB()->readPrice( id );
+            index->write( id, BlockMetadataIndex::createMetadata( block, price ) );
+            rebuilt++;
+        } catch ( ExitRequestedException& ) {
+            throw;
+        } catch ( ... ) {
+            break;
+        }
+    }
+
+    LOG( info, "Rebuilt block metadata index for " << rebuilt << " blocks" );
+}
+
 void Schain::bootstrap( block_id _lastCommittedBlockID, uint64_t _lastCommittedBlockTimeStamp,
     uint64_t _lastCommittedBlockTimeStampMs ) {
     // should be called only once
@@ -989,11 +1109,19 @@ void Schain::bootstrap( block_id _lastCommittedBlockID, uint64_t _lastCommittedB
 
     // Step 0 Workaround for the fact that skaled does not yet save timestampMs
 
+    rebuildBlockMetadataIndex();
+
     if ( _lastCommittedBlockTimeStampMs == 0 && _lastCommittedBlockID > 0 ) {
-        auto block = getNode()->getBlockDB()->getBlock( _lastCommittedBlockID, getCryptoManager() );
-        if ( block ) {
-            _lastCommittedBlockTimeStampMs = block->getTimeStampMs();
-        };
+        BlockMetadata metadata;
+        if ( getNode()->getBlockMetadataIndex()->read( _lastCommittedBlockID, metadata ) ) {
+            _lastCommittedBlockTimeStampMs = metadata.timeStampMs;
+        } else {
+            auto block =
+                getNode()->getBlockDB()->getBlock( _lastCommittedBlockID, getCryptoManager() );
+            if ( block ) {
+                _lastCommittedBlockTimeStampMs = block->getTimeStampMs();
+            };
+        }
     }
 
 
@@ -1195,6 +1323,13 @@ void Schain::daProofSigShareArrived(
         auto proof =
             getNode()->getDaSigShareDB()->addAndMergeSigShareAndVerifySig( _sigShare, _proposal );
         if ( proof != nullptr ) {
+            // assembly time is counted from the proposal timestamp, so ms resolution
+            auto proposalTimeMs = _proposal->getTimeStampS() * 1000 + _proposal->getTimeStampMs();
+            auto nowMs = Time::getCurrentTimeMs();
+            if ( nowMs >= proposalTimeMs )
+                LatencyHistogram::record(
+                    LAT_DA_PROOF_ASSEMBLY, 1000 * ( nowMs - proposalTimeMs ) );
+
             getSchain()->daProofArrived( proof );
             blockProposalClient->enqueueItem( proof );
         }
@@ -1290,10 +1425,7 @@ void Schain::finalizeDecidedAndSignedBlock( block_id _blockId, schain_index _pro
             auto agent = make_unique< BlockFinalizeDownloader >( this, _blockId, _proposerIndex );
 
             {
-                const string msg = "Finalization download:" + to_string( _blockId ) + ":" +
-                                   to_string( _proposerIndex );
-
-                MONITOR( __CLASS_NAME__, msg.c_str() );
+                MONITOR( __CLASS_NAME__, "finalizationDownload" );
                 // This will complete successfully also if block arrives through catchup
                 proposal = agent->downloadProposal();
                 // if null is returned it means that catchup happened first and
@@ -1321,15 +1453,36 @@ void Schain::finalizeDecidedAndSignedBlock( block_id _blockId, schain_index _pro
 Schain::Schain() : Agent() {}
 
 bool Schain::fixCorruptStateIfNeeded( block_id _lastCommittedBlockID ) {
-    block_id nextBlock = _lastCommittedBlockID + 1;
-    if ( getNode()->getBlockDB()->unfinishedBlockExists( nextBlock ) ) {
-        return true;
-        LOG( warn,
-            "Corrupt consensus database has been repaired successfully."
-            "Starting from repaired consensus database." );
-    } else {
+    // BlockCommitBatch writes a block in one batch with the last committed marker, so BlockDB
+    // can not hold a partial block. Prices are written without fsync before the marker, so the
+    // newest ones may be lost after a power failure. Recompute them from the committed blocks.
+    auto priceDB = getNode()->getPriceDB();
+    auto last = ( uint64_t ) _lastCommittedBlockID;
+    auto id = last;
+
+    while ( id > 1 && last - id < BLOCK_COMMIT_REPAIR_WINDOW && !priceDB->hasPrice( id ) ) {
+        id--;
+    }
+
+    if ( id == last )
+        return false;
+
+    if ( id > 1 && !priceDB->hasPrice( id ) ) {
+        LOG( err, "Can not repair block prices, price missing for block " << id );
         return false;
     }
+
+    for ( auto blockID = id + 1; blockID <= last; blockID++ ) {
+        auto block = getNode()->getBlockDB()->getBlock( blockID, getCryptoManager() );
+        CHECK_STATE2( block, "No block to repair price:" + to_string( blockID ) );
+        auto tv = block->getTransactionList()->createTransactionVector();
+        pricingAgent->calculatePrice(
+            *tv, block->getTimeStampS(), block->getTimeStampMs(), blockID );
+    }
+
+    LOG( warn, "Repaired prices of blocks " << id + 1 << " to " << last );
+
+    return true;
 }
 
 
@@ -1340,6 +1493,14 @@ void Schain::startStatusServer() {
         s = make_shared< StatusServer >( this, *httpserver, jsonrpc::JSONRPC_SERVER_V1V2 );
     }
 
+    if ( !metricsServer && getNode()->getParamUint64( "metricsEnabled", 0 ) > 0 ) {
+        metricsServer = make_shared< MetricsServer >(
+            this, getNode()->getBindIP(), ( uint16_t ) getNode()->getBasePort() + METRICS );
+        CHECK_STATE2( metricsServer->start(), "Could not start metrics server" );
+        LOG( info, "Started metrics server on port "
+                       << ( uint16_t ) getNode()->getBasePort() + METRICS );
+    }
+
 #ifdef CONSENSUS_DEMO
     CHECK_STATE( s );
     LOG( info, "Starting status server ..." );
@@ -1351,6 +1512,30 @@ void Schain::startStatusServer() {
 void Schain::stopStatusServer() {
     if ( s )
         s->StopListening();
+    if ( metricsServer )
+        metricsServer->stop();
+}
+
+
+void Schain::updateBlockMovingAverages( const ptr< CommittedBlock >& _block ) {
+    CHECK_ARGUMENT( _block );
+
+    // called before the block is committed, so this is the previous block stamp
+    auto previous = getLastCommittedBlockTimeStamp();
+    auto previousMs = previous.getS() * 1000 + previous.getMs();
+    auto currentMs = _block->getTimeStampS() * 1000 + _block->getTimeStampMs();
+
+    if ( previous.getS() == 0 || currentMs < previousMs )
+        return;
+
+    // exponential moving averages over roughly the last 8 blocks, in fixed point so that
+    // small averages are not truncated to 0
+    uint64_t blockSize = ( uint64_t ) _block->getTransactionCount() * BLOCK_AVERAGE_SCALE;
+    uint64_t blockTime = ( currentMs - previousMs ) * BLOCK_AVERAGE_SCALE;
+    blockSize = blockSizeMovingAverage = ( 7 * blockSizeMovingAverage + blockSize ) / 8;
+    blockTime = blockTimeMovingAverageMs = ( 7 * blockTimeMovingAverageMs + blockTime ) / 8;
+    blockTime = max< uint64_t >( blockTime, 1 );
+    tpsMovingAverage = ( blockSize * 1000 + blockTime / 2 ) / blockTime;
 }
 
 uint64_t Schain::getBlockSizeAverage() const {
@@ -1365,39 +1550,41 @@ uint64_t Schain::getTpsAverage() const {
     return tpsAverage;
 }
 
+uint64_t Schain::getBlockSizeMovingAverage() const {
+    return ( blockSizeMovingAverage + BLOCK_AVERAGE_SCALE / 2 ) / BLOCK_AVERAGE_SCALE;
+}
+
+uint64_t Schain::getBlockTimeMovingAverageMs() const {
+    return ( blockTimeMovingAverageMs + BLOCK_AVERAGE_SCALE / 2 ) / BLOCK_AVERAGE_SCALE;
+}
+
+uint64_t Schain::getTpsMovingAverage() const {
+    return tpsMovingAverage;
+}
+
 void Schain::addDeadNode( uint64_t _schainIndex, uint64_t _checkTime ) {
     CHECK_STATE( _schainIndex > 0 );
     CHECK_STATE( _schainIndex <= getNodeCount() );
-    {
-        lock_guard< mutex > l( deadNodesLock );
-        if ( deadNodes.count( _schainIndex ) == 0 ) {
-            deadNodes.insert( { _schainIndex, _checkTime } );
-        }
-    }
+
+    // keep the time of the first failure if the node is already dead
+    uint64_t alive = 0;
+    bool added = deathTimesMs.at( _schainIndex ).compare_exchange_strong( alive, _checkTime );
+
+    // the receipt timeout does not wait for dead nodes
+    if ( added && timeoutAgent )
+        timeoutAgent->wakeUp();
 }
 
 void Schain::markAliveNode( uint64_t _schainIndex ) {
     CHECK_STATE( _schainIndex > 0 );
     CHECK_STATE( _schainIndex <= getNodeCount() );
-    {
-        lock_guard< mutex > l( deadNodesLock );
-        if ( deadNodes.count( _schainIndex ) > 0 ) {
-            deadNodes.erase( _schainIndex );
-        }
-    }
+    deathTimesMs.at( _schainIndex ) = 0;
 }
 
 uint64_t Schain::getDeathTimeMs( uint64_t _schainIndex ) {
     CHECK_STATE( _schainIndex > 0 );
     CHECK_STATE( _schainIndex <= getNodeCount() );
-    {
-        lock_guard< mutex > l( deadNodesLock );
-        if ( deadNodes.count( _schainIndex ) == 0 ) {
-            return 0;
-        } else {
-            return deadNodes.at( _schainIndex );
-        }
-    }
+    return deathTimesMs.at( _schainIndex );
 }
 
 ptr< ofstream > Schain::getVisualizationDataStream() {
@@ -1420,18 +1607,13 @@ void Schain::writeToVisualizationStream( string& _s ) {
 
 
 u256 Schain::getRandomForBlockId( block_id _blockId ) {
+    BlockMetadata metadata;
+    if ( getNode()->getBlockMetadataIndex()->read( _blockId, metadata ) )
+        return metadata.random;
+
     auto block = getBlock( _blockId );
     CHECK_STATE( block );
-    auto signature = block->getThresholdSig();
-
-    auto data = make_shared< vector< uint8_t > >();
-
-    for ( uint64_t i = 0; i < signature.size(); i++ ) {
-        data->push_back( ( uint8_t ) signature.at( i ) );
-    }
-
-    auto hash = BLAKE3Hash::calculateHash( data );
-    return u256( "0x" + hash.toHex() );
+    return block->getRandom();
 }
 
 ptr< ofstream > Schain::visualizationDataStream = nullptr;
@@ -47,6 +47,7 @@ class BlockProposalClientAgent;
 class BlockProposalPusherThreadPool;
 
 class BlockFinalizeDownloader;
+class BlockFinalizeDownloadScheduler;
 class BlockFinalizeDownloaderThreadPool;
 
 
@@ -60,6 +61,7 @@ class CatchupClientAgent;
 class CatchupServerAgent;
 class MonitoringAgent;
 class TimeoutAgent;
+class AdaptiveProposalTimeout;
 class StuckDetectionAgent;
 
 
@@ -76,6 +78,7 @@ class OracleServerAgent;
 class OracleThreadPool;
 
 class PricingAgent;
+class BlockCommitBatch;
 class IO;
 class Sockets;
 
@@ -87,6 +90,7 @@ class BooleanProposalVector;
 class TimeStamp;
 class CryptoManager;
 class StatusServer;
+class MetricsServer;
 class OracleClient;
 class OracleResultAssemblyAgent;
 
@@ -107,6 +111,7 @@ class Schain : public Agent {
 
     ptr< jsonrpc::HttpServer > httpserver;
     ptr< StatusServer > s;
+    ptr< MetricsServer > metricsServer;
 
 
     ptr< TestMessageGeneratorAgent > testMessageGeneratorAgent;
@@ -121,6 +126,8 @@ class Schain : public Agent {
 
     ptr< TimeoutAgent > timeoutAgent;
 
+    ptr< AdaptiveProposalTimeout > proposalTimeout;
+
     ptr< StuckDetectionAgent > stuckDetectionAgent;
 
     ptr< PendingTransactionsAgent > pendingTransactionsAgent;
@@ -129,6 +136,8 @@ class Schain : public Agent {
 
     ptr< CatchupClientAgent > catchupClientAgent;
 
+    ptr< BlockFinalizeDownloadScheduler > blockFinalizeDownloadScheduler;
+
     ptr< PricingAgent > pricingAgent;
 
     ptr< SchainMessageThreadPool > consensusMessageThreadPool;
@@ -160,16 +169,24 @@ class Schain : public Agent {
     atomic< uint64_t > bootstrapBlockID = 0;
     uint64_t maxExternalBlockProcessingTime = 0;
 
-    uint64_t blockSizeAverage = 0;
+    // averages since start, read without locks by the status and metrics servers
+    atomic< uint64_t > blockSizeAverage = 0;
 
-    unordered_map< uint64_t, uint64_t > deadNodes;
-    mutex deadNodesLock;
+    // indexed by schain index, 0 if the node is alive. Atomic so that the network threads and
+    // the metrics server check node liveness without a lock
+    vector< atomic< uint64_t > > deathTimesMs;
 
     static ptr< ofstream > visualizationDataStream;
     static mutex vdsMutex;
 
-    uint64_t blockTimeAverageMs = 0;
-    uint64_t tpsAverage = 0;
+    atomic< uint64_t > blockTimeAverageMs = 0;
+    atomic< uint64_t > tpsAverage = 0;
+
+    // moving averages over the last blocks. Block size and block time are scaled by
+    // BLOCK_AVERAGE_SCALE, the getters round them
+    atomic< uint64_t > blockSizeMovingAverage = 0;
+    atomic< uint64_t > blockTimeMovingAverageMs = 0;
+    atomic< uint64_t > tpsMovingAverage = 0;
 
     atomic< bool > isStateInitialized = false;
 
@@ -177,6 +194,8 @@ class Schain : public Agent {
 
     uint64_t verifyDaSigsPatchTimestampS = 0;
 
+    uint64_t erasureCodedFragmentsPatchTimestampS = 0;
+
     // If a BlockError analyzer is added to the queue
     // its analyze(CommittedBlock _block) function will be run on commit
     // and then t will be removed from the queue
@@ -185,18 +204,22 @@ class Schain : public Agent {
 
     void proposeNextBlock( bool _isCalledAfterCatchup );
 
-    void processCommittedBlock( const ptr< CommittedBlock >& _block );
+    // _isSaved is true if the block is already in BlockDB
+    void processCommittedBlock( const ptr< CommittedBlock >& _block, bool _isSaved = false );
 
     void startConsensus(
         const block_id _blockID, const ptr< BooleanProposalVector >& _propposalVector );
 
     void constructChildAgents();
 
-    void saveBlock( const ptr< CommittedBlock >& _block );
+    void saveBlock( const ptr< CommittedBlock >& _block, BlockCommitBatch& _commit );
 
     void cleanupUnneededMemoryBeforePushingToEvm( const ptr< CommittedBlock > _block );
 
-    void pushBlockToExtFace( const ptr< CommittedBlock >& _block );
+    // if _commit is set, the price is added to it and _commit is applied before the block
+    // goes to the EVM
+    void pushBlockToExtFace(
+        const ptr< CommittedBlock >& _block, BlockCommitBatch* _commit = nullptr );
 
     ptr< BlockProposal > createDefaultEmptyBlockProposal( block_id _blockId );
 
@@ -227,6 +250,10 @@ public:
     uint64_t getBlockTimeAverageMs() const;
     uint64_t getTpsAverage() const;
 
+    uint64_t getBlockSizeMovingAverage() const;
+    uint64_t getBlockTimeMovingAverageMs() const;
+    uint64_t getTpsMovingAverage() const;
+
 
     bool isStartingFromCorruptState() const;
 
@@ -297,7 +324,9 @@ public:
 
     ptr< PendingTransactionsAgent > getPendingTransactionsAgent() const;
 
-    ptr< MonitoringAgent > getMonitoringAgent() const;
+    const ptr< MonitoringAgent >& getMonitoringAgent() const;
+
+    const ptr< AdaptiveProposalTimeout >& getProposalTimeout() const;
 
     schain_index getSchainIndex() const;
 
@@ -365,11 +394,15 @@ public:
     static void bumpPriority();
     static void unbumpPriority();
     void startStatusServer();
+
+    void updateBlockMovingAverages( const ptr< CommittedBlock >& _block );
     void stopStatusServer();
     void setLastCommittedBlockId( uint64_t lastCommittedBlockId );
 
     block_id readLastCommittedBlockIDFromDb();
 
+    void rebuildBlockMetadataIndex();
+
     void lockWithDeadLockCheck( const char* _functionName );
 
     void printBlockLog( const ptr< CommittedBlock >& _block );
@@ -386,8 +419,15 @@ public:
 
     bool verifyDASigsPatch( uint64_t _blockTimeStampSec );
 
+    bool erasureCodedFragmentsPatch( uint64_t _blockTimeStampSec );
+
+    // number of Reed-Solomon coded fragments that rebuild a proposal
+    uint64_t getErasureCodedDataFragments();
+
     void updateInternalChainInfo( block_id _lastCommittedBlockID );
 
     const ptr<CatchupClientAgent> &getCatchupClientAgent() const;
 
+    const ptr< BlockFinalizeDownloadScheduler >& getBlockFinalizeDownloadScheduler() const;
+
 };
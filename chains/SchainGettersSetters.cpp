@@ -24,12 +24,14 @@
 #include "SkaleCommon.h"
 #include "Log.h"
 
+#include "blockfinalize/client/BlockFinalizeDownloadScheduler.h"
 #include "blockfinalize/client/BlockFinalizeDownloader.h"
 #include "blockproposal/pusher/BlockProposalClientAgent.h"
 #include "blockproposal/server/BlockProposalServerAgent.h"
 #include "catchup/client/CatchupClientAgent.h"
 #include "catchup/server/CatchupServerAgent.h"
 #include "headers/BlockProposalRequestHeader.h"
+#include "monitoring/AdaptiveProposalTimeout.h"
 #include "monitoring/MonitoringAgent.h"
 #include "monitoring/TimeoutAgent.h"
 #include "monitoring/StuckDetectionAgent.h"
@@ -76,11 +78,16 @@ ptr< PendingTransactionsAgent > Schain::getPendingTransactionsAgent() const {
 }
 
 
-ptr< MonitoringAgent > Schain::getMonitoringAgent() const {
+const ptr< MonitoringAgent >& Schain::getMonitoringAgent() const {
     CHECK_STATE( monitoringAgent )
     return monitoringAgent;
 }
 
+const ptr< AdaptiveProposalTimeout >& Schain::getProposalTimeout() const {
+    CHECK_STATE( proposalTimeout )
+    return proposalTimeout;
+}
+
 uint64_t Schain::getStartTimeMs() const {
     return startTimeMs;
 }
@@ -342,4 +349,9 @@ bool Schain::isInCreateBlock() const {
 const ptr<CatchupClientAgent> &Schain::getCatchupClientAgent() const {
     CHECK_STATE(catchupClientAgent);
     return catchupClientAgent;
+}
+
+const ptr< BlockFinalizeDownloadScheduler >& Schain::getBlockFinalizeDownloadScheduler() const {
+    CHECK_STATE( blockFinalizeDownloadScheduler );
+    return blockFinalizeDownloadScheduler;
 }
\ No newline at end of file
@@ -50,6 +50,7 @@
 #include "headers/BlockProposalRequestHeader.h"
 
 #include "utils//Time.h"
+#include "utils/ReedSolomon.h"
 
 #include "Transaction.h"
 #include "TransactionList.h"
@@ -151,10 +152,11 @@ ptr< PartialHashesList > BlockProposal::createPartialHashesList() {
 
     auto partialHashes = make_shared< vector< uint8_t > >( s );
 
+    CHECK_STATE( t->size() == ( uint64_t ) transactionCount );
+
     for ( uint64_t i = 0; i < transactionCount; i++ ) {
-        for ( size_t j = 0; j < PARTIAL_HASH_LEN; j++ ) {
-            partialHashes->at( i * PARTIAL_HASH_LEN + j ) = t->at( i )->getHash().at( j );
-        }
+        auto key = t->at( i )->getPartialHashKey();
+        memcpy( partialHashes->data() + i * PARTIAL_HASH_LEN, &key, PARTIAL_HASH_LEN );
     }
 
     return make_shared< PartialHashesList >(
@@ -396,6 +398,42 @@ ptr< BlockProposalFragment > BlockProposal::getFragment(
         getBlockID(), _totalFragments, _index, fragmentData, sp->size(), getHash().toHex() );
 }
 
+ptr< BlockProposalFragment > BlockProposal::getErasureCodedFragment(
+    uint64_t _totalFragments, uint64_t _dataFragments, fragment_index _index ) {
+    CHECK_ARGUMENT( _index > 0 && _index <= _totalFragments );
+    LOCK( m )
+
+    auto sp = serializeProposal();
+
+    CHECK_STATE( sp );
+
+    if ( cachedErasureCodedFragments.empty() || erasureTotalFragments != _totalFragments ||
+         erasureDataFragments != _dataFragments ) {
+        ReedSolomon code( _dataFragments, _totalFragments );
+
+        vector< ptr< vector< uint8_t > > > fragments;
+        fragments.reserve( _totalFragments );
+
+        for ( uint64_t i = 0; i < _totalFragments; i++ ) {
+            auto shard = code.encodeShard( sp->data(), sp->size(), i );
+            auto fragmentData = make_shared< vector< uint8_t > >();
+            fragmentData->reserve( shard->size() + 2 );
+            fragmentData->push_back( '<' );
+            fragmentData->insert( fragmentData->end(), shard->begin(), shard->end() );
+            fragmentData->push_back( '>' );
+            fragments.push_back( fragmentData );
+        }
+
+        cachedErasureCodedFragments = move( fragments );
+        erasureTotalFragments = _totalFragments;
+        erasureDataFragments = _dataFragments;
+    }
+
+    return make_shared< BlockProposalFragment >( getBlockID(), _totalFragments, _index,
+        cachedErasureCodedFragments.at( ( uint64_t ) _index - 1 ), sp->size(),
+        getHash().toHex() );
+}
+
 ptr< TransactionList > BlockProposal::deserializeTransactions(
     const ptr< BlockProposalHeader >& _header, const string& _headerString,
     const ptr< vector< uint8_t > >& _serializedBlock ) {
@@ -59,6 +59,12 @@ class BlockProposal : public SendableItem {
 
     ptr< vector< uint8_t > > cachedSerializedProposal = nullptr;  // tsafe
 
+    // Reed-Solomon coded fragment data, encoded once for all fragments on the first request.
+    // Only the last requested code is kept
+    uint64_t erasureTotalFragments = 0;
+    uint64_t erasureDataFragments = 0;
+    vector< ptr< vector< uint8_t > > > cachedErasureCodedFragments;  // tsafe
+
     ptr< BasicHeader > createProposalHeader();
 
     static atomic< int64_t > totalBlockProposalObjects;
@@ -133,6 +139,11 @@ public:
 
     ptr< BlockProposalFragment > getFragment( uint64_t _totalFragments, fragment_index _index );
 
+    // Reed-Solomon shard _index of _totalFragments, any _dataFragments of them rebuild the
+    // proposal
+    ptr< BlockProposalFragment > getErasureCodedFragment(
+        uint64_t _totalFragments, uint64_t _dataFragments, fragment_index _index );
+
     [[nodiscard]] u256 getStateRoot() const;
 
     ptr< BlockProposalRequestHeader > createProposalRequestHeader( Schain* _sChain );
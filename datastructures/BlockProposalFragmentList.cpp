@@ -30,6 +30,7 @@
 #include "Log.h"
 #include "SkaleCommon.h"
 #include "exceptions/SerializeException.h"
+#include "utils/ReedSolomon.h"
 
 #include "BlockProposalFragment.h"
 
@@ -37,9 +38,12 @@
 #include "BlockProposalFragmentList.h"
 
 BlockProposalFragmentList::BlockProposalFragmentList(
-    const block_id& _blockId, const uint64_t _totalFragments )
-    : blockID( _blockId ), totalFragments( _totalFragments ) {
+    const block_id& _blockId, const uint64_t _totalFragments, uint64_t _requiredFragments )
+    : blockID( _blockId ),
+      totalFragments( _totalFragments ),
+      requiredFragments( _requiredFragments == 0 ? _totalFragments : _requiredFragments ) {
     CHECK_ARGUMENT( totalFragments > 0 );
+    CHECK_ARGUMENT( requiredFragments <= totalFragments );
 
     for ( uint64_t i = 1; i <= totalFragments; i++ ) {
         missingFragments.push_back( i );
@@ -88,6 +92,11 @@ bool BlockProposalFragmentList::addFragment(
 
     checkSanity();
 
+    if ( isErasureCoded() ) {
+        CHECK_ARGUMENT( _fragment->serialize()->size() ==
+                        ReedSolomon::getShardSize( blockSize, requiredFragments ) + 2 );
+    }
+
     nextIndex = 0;
 
     if ( fragments.find( _fragment->getIndex() ) != fragments.end() ) {
@@ -127,6 +136,10 @@ bool BlockProposalFragmentList::isComplete() {
 
     checkSanity();
 
+    if ( isErasureCoded() ) {
+        return fragments.size() >= getTargetFragments();
+    }
+
     if ( fragments.size() == totalFragments ) {
         for ( uint64_t i = 1; i <= totalFragments; i++ ) {
             CHECK_STATE( fragments.find( i ) != fragments.end() )
@@ -150,6 +163,16 @@ const ptr< vector< uint8_t > > BlockProposalFragmentList::serialize() {
 
     isSerialized = true;
 
+    if ( isErasureCoded() ) {
+        vector< uint64_t > indices;
+        for ( auto&& [index, fragment] : fragments ) {
+            indices.push_back( ( uint64_t ) index );
+            if ( indices.size() == requiredFragments )
+                break;
+        }
+        return decodeSubset( indices );
+    }
+
     uint64_t totalLen = 0;
 
     try {
@@ -179,6 +202,114 @@ const ptr< vector< uint8_t > > BlockProposalFragmentList::serialize() {
 }
 
 
+ptr< vector< uint8_t > > BlockProposalFragmentList::decodeSubset(
+    const vector< uint64_t >& _indices ) {
+    LOCK( m )
+
+    map< uint64_t, ptr< vector< uint8_t > > > shards;
+    for ( auto index : _indices ) {
+        auto fragment = fragments.at( index );
+        CHECK_STATE( fragment );
+        shards.emplace( index - 1,
+            make_shared< vector< uint8_t > >( fragment->begin() + 1, fragment->end() - 1 ) );
+    }
+
+    ptr< vector< uint8_t > > result;
+
+    try {
+        ReedSolomon code( requiredFragments, totalFragments );
+        result = code.decode( shards, ( uint64_t ) blockSize );
+    } catch ( ... ) {
+        throw_with_nested( SerializeException( "Could not decode fragments", __CLASS_NAME__ ) );
+    }
+
+    CHECK_STATE( result->at( sizeof( uint64_t ) ) == '{' );
+    CHECK_STATE( result->back() == '>' );
+    return result;
+}
+
+
+ptr< vector< uint8_t > > BlockProposalFragmentList::decode(
+    const function< bool( const ptr< vector< uint8_t > >& ) >& _isValid, uint64_t _maxAttempts ) {
+    CHECK_STATE( isErasureCoded() );
+    CHECK_STATE( isComplete() );
+
+    LOCK( m )
+
+    auto received = getReceivedFragments();
+
+    // subsets in lexicographic order, the first requiredFragments positions selected first
+    vector< bool > selected( received.size(), false );
+    fill( selected.begin(), selected.begin() + requiredFragments, true );
+
+    uint64_t attempts = 0;
+
+    do {
+        vector< uint64_t > indices;
+        for ( uint64_t i = 0; i < received.size(); i++ ) {
+            if ( selected[i] )
+                indices.push_back( received[i] );
+        }
+
+        if ( failedSubsets.count( indices ) > 0 )
+            continue;
+
+        if ( attempts++ == _maxAttempts )
+            return nullptr;
+
+        ptr< vector< uint8_t > > result;
+        try {
+            result = decodeSubset( indices );
+        } catch ( exception& ) {
+            // a corrupt fragment in the subset
+        }
+
+        if ( result && _isValid( result ) )
+            return result;
+
+        failedSubsets.insert( indices );
+    } while ( prev_permutation( selected.begin(), selected.end() ) );
+
+    return nullptr;
+}
+
+
+bool BlockProposalFragmentList::requestMoreFragments() {
+    LOCK( m )
+
+    if ( fragments.size() >= totalFragments )
+        return false;
+
+    extraFragments = fragments.size() + 1 - requiredFragments;
+    return true;
+}
+
+
+uint64_t BlockProposalFragmentList::getTargetFragments() {
+    LOCK( m )
+    return min( totalFragments, requiredFragments + extraFragments );
+}
+
+
+vector< uint64_t > BlockProposalFragmentList::getReceivedFragments() {
+    LOCK( m )
+    vector< uint64_t > result;
+    for ( auto&& item : fragments ) {
+        result.push_back( ( uint64_t ) item.first );
+    }
+    return result;
+}
+
+
+bool BlockProposalFragmentList::isErasureCoded() const {
+    return requiredFragments < totalFragments;
+}
+
+uint64_t BlockProposalFragmentList::getRequiredFragments() const {
+    return requiredFragments;
+}
+
+
 boost::random::mt19937 BlockProposalFragmentList::gen;
 
 boost::random::uniform_int_distribution<> BlockProposalFragmentList::ubyte( 0, 1024 );
\ No newline at end of file
@@ -51,6 +51,18 @@ class BlockProposalFragmentList : public DataStructure {
 
     const uint64_t totalFragments = 0;
 
+    // fragments needed to rebuild the proposal, less than totalFragments if they are
+    // Reed-Solomon coded
+    const uint64_t requiredFragments = 0;
+
+    // fragments downloaded beyond requiredFragments after a decode failed
+    uint64_t extraFragments = 0;
+
+    // subsets of fragment indices that did not decode to a valid proposal
+    set< vector< uint64_t > > failedSubsets;
+
+    ptr< vector< uint8_t > > decodeSubset( const vector< uint64_t >& _indices );
+
     void checkSanity();
 
     static boost::random::mt19937 gen;
@@ -58,7 +70,8 @@ class BlockProposalFragmentList : public DataStructure {
     static boost::random::uniform_int_distribution<> ubyte;
 
 public:
-    BlockProposalFragmentList( const block_id& _blockId, uint64_t _totalFragments );
+    BlockProposalFragmentList(
+        const block_id& _blockId, uint64_t _totalFragments, uint64_t _requiredFragments = 0 );
 
     bool addFragment(
         const ptr< BlockProposalFragment >& _fragment, uint64_t& _nextIndexToRetrieve );
@@ -67,7 +80,26 @@ public:
 
     bool isComplete();
 
+    bool isErasureCoded() const;
+
+    uint64_t getRequiredFragments() const;
+
+    // fragments to download before the next decode attempt
+    uint64_t getTargetFragments();
+
+    vector< uint64_t > getReceivedFragments();
+
     const ptr< vector< uint8_t > > serialize();
+
+    // Decodes erasure coded fragments. Fragments carry no integrity check of their own, so
+    // subsets of requiredFragments received fragments are tried until _isValid accepts the
+    // result, at most _maxAttempts of them. Returns nullptr if none is accepted
+    ptr< vector< uint8_t > > decode(
+        const function< bool( const ptr< vector< uint8_t > >& ) >& _isValid,
+        uint64_t _maxAttempts );
+
+    // raises the target by one fragment, false if all fragments are here already
+    bool requestMoreFragments();
 };
 
 
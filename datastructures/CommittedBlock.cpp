@@ -113,6 +113,19 @@ string CommittedBlock::getThresholdSig() const {
     return thresholdSig;
 }
 
+u256 CommittedBlock::getRandom() const {
+    auto signature = getThresholdSig();
+
+    auto data = make_shared< vector< uint8_t > >();
+
+    for ( uint64_t i = 0; i < signature.size(); i++ ) {
+        data->push_back( ( uint8_t ) signature.at( i ) );
+    }
+
+    auto hash = BLAKE3Hash::calculateHash( data );
+    return u256( "0x" + hash.toHex() );
+}
+
 string CommittedBlock::getDaSig() const {
     return daSig;
 }
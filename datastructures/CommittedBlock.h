@@ -66,6 +66,9 @@ public:
 
     [[nodiscard]] string getDaSig() const;
 
+    // block random, derived from the threshold signature
+    [[nodiscard]] u256 getRandom() const;
+
 
     static ptr< CommittedBlock > makeFromProposal( const ptr< BlockProposal >& _proposal,
         const ptr< ThresholdSignature >& _thresholdSig, ptr< ThresholdSignature > _daSig );
@@ -28,6 +28,9 @@
 #include "crypto/BLAKE3Hash.h"
 #include "exceptions/InvalidStateException.h"
 #include "chains/Schain.h"
+#include "node/ConsensusEngine.h"
+#include "threads/WorkStealingExecutor.h"
+#include "utils/BlockCompression.h"
 #include "CommittedBlock.h"
 #include "CommittedBlockList.h"
 
@@ -39,57 +42,134 @@ CommittedBlockList::CommittedBlockList( const ptr< vector< ptr< CommittedBlock >
 }
 
 
+ptr< CommittedBlock > CommittedBlockList::deserializeBlock(
+    const ptr< CryptoManager >& _cryptoManager, const ptr< vector< uint8_t > >& _blockData ) {
+    // compressed blocks are inflated here, so that it runs on the verification threads
+    auto block = CommittedBlock::deserialize(
+        BlockCompression::decompress( _blockData ), _cryptoManager, true );
+
+    if ( _cryptoManager->getSchain()->verifyDASigsPatch( block->getTimeStampS() ) ) {
+        // a default block has a zero proposer index and no DA sig
+        if ( block->getProposerIndex() != 0 && block->getDaSig().empty() ) {
+            LOG( err, "EMPTY_DA_SIG_ON_CATCHUP:BLOCK_STAMP:"
+                          << to_string( block->getTimeStampS() ) << ":PATCH_STAMP:"
+                          << to_string(
+                                 _cryptoManager->getSchain()->getVerifyDaSigsPatchTimestampS() )
+                          << ":PRPS:" << to_string( block->getProposerIndex() ) );
+            CHECK_STATE2(
+                !block->getDaSig().empty(), "Catchup received a block without DA sig:" );
+        }
+    }
+
+    return block;
+}
+
+
 CommittedBlockList::CommittedBlockList( const ptr< CryptoManager >& _cryptoManager,
     const ptr< vector< uint64_t > >& _blockSizes, const ptr< vector< uint8_t > >& _serializedBlocks,
-    uint64_t _offset, bool _createPartialListIfSomeSignaturesDontVerify ) {
+    uint64_t _offset, bool _createPartialListIfSomeSignaturesDontVerify, uint64_t _maxRawBytes ) {
     CHECK_ARGUMENT( _cryptoManager );
     CHECK_ARGUMENT( _blockSizes );
     CHECK_ARGUMENT( _serializedBlocks );
-
-
     CHECK_ARGUMENT( _serializedBlocks->at( _offset ) == '[' );
     CHECK_ARGUMENT( _serializedBlocks->at( _serializedBlocks->size() - 1 ) == ']' );
 
-    uint64_t counter = 0;
-    size_t index = 0;
-    size_t endIndex = 0;
-
-    try {
-        index = _offset + 1;
-
-        blocks = make_shared< vector< ptr< CommittedBlock > > >();
-
-        for ( auto&& size : *_blockSizes ) {
-            endIndex = index + size;
-
-            CHECK_STATE( endIndex <= _serializedBlocks->size() );
+    auto blockCount = _blockSizes->size();
 
-            auto blockData = make_shared< vector< uint8_t > >(
-                _serializedBlocks->begin() + index, _serializedBlocks->begin() + endIndex );
+    // start offset of each block, plus the end of the last one
+    vector< size_t > offsets = { _offset + 1 };
+    for ( auto&& size : *_blockSizes ) {
+        offsets.push_back( offsets.back() + size );
+    }
 
-            auto block = CommittedBlock::deserialize( blockData, _cryptoManager, true );
+    CHECK_STATE( offsets.back() <= _serializedBlocks->size() );
 
-            if ( _cryptoManager->getSchain()->verifyDASigsPatch( block->getTimeStampS() ) ) {
-                // a default block has a zero proposer index and no DA sig
-                if ( block->getProposerIndex() != 0 && block->getDaSig().empty() ) {
-                    LOG( err,
-                        "EMPTY_DA_SIG_ON_CATCHUP:BLOCK_STAMP:"
-                            << to_string( block->getTimeStampS() ) << ":PATCH_STAMP:"
-                            << to_string(
-                                   _cryptoManager->getSchain()->getVerifyDaSigsPatchTimestampS() )
-                            << ":PRPS:" << to_string( block->getProposerIndex() ) );
+    // each block is bounded on its own when it is inflated, the whole response is bounded here
+    // before any block is inflated, since signatures are checked only after inflating
+    uint64_t totalRawSize = 0;
+    for ( uint64_t i = 0; i < blockCount; i++ ) {
+        totalRawSize += BlockCompression::getRawSize(
+            _serializedBlocks->data() + offsets[i], offsets[i + 1] - offsets[i] );
+        CHECK_STATE2( totalRawSize <= _maxRawBytes,
+            "Blocks decompress to more than " + to_string( _maxRawBytes ) + " bytes" );
+    }
 
-                    CHECK_STATE2(
-                        !block->getDaSig().empty(), "Catchup received a block without DA sig:" );
+    // signature checks dominate catchup, so blocks are verified in parallel.
+    // A block that does not verify cuts the list, the blocks after it are not needed
+    vector< ptr< CommittedBlock > > decoded( blockCount );
+    vector< exception_ptr > errors( blockCount );
+    atomic< uint64_t > nextBlock( 0 );
+    atomic< uint64_t > firstFailedBlock( blockCount );
+
+    auto verifyLoop = [&]( const ptr< SkaleLog >& _log ) {
+        logThreadLocal_ = _log;
+        for ( uint64_t i = nextBlock++; i < blockCount && i < firstFailedBlock; i = nextBlock++ ) {
+            try {
+                CHECK_STATE( offsets.at( i + 1 ) <= _serializedBlocks->size() );
+                auto blockData = make_shared< vector< uint8_t > >(
+                    _serializedBlocks->begin() + offsets[i],
+                    _serializedBlocks->begin() + offsets[i + 1] );
+                decoded[i] = deserializeBlock( _cryptoManager, blockData );
+            } catch ( ... ) {
+                errors[i] = current_exception();
+                auto failed = firstFailedBlock.load();
+                while ( i < failed && !firstFailedBlock.compare_exchange_weak( failed, i ) ) {
                 }
             }
+        }
+    };
+
+    auto& executor = WorkStealingExecutor::getInstance();
+    auto helperCount = min( executor.getThreadCount(), CATCHUP_VERIFY_THREADS - 1 );
+    helperCount = blockCount > 1 ? min( helperCount, blockCount - 1 ) : 0;
+
+    // the helpers run on the shared executor and use the locals of this constructor. Once the
+    // list is closed a helper that did not start yet returns at once, and the constructor
+    // waits only for the helpers that did start
+    struct Helpers {
+        mutex m;
+        condition_variable cond;
+        bool closed = false;
+        uint64_t running = 0;
+    };
+    auto helpers = make_shared< Helpers >();
+
+    auto log = logThreadLocal_;
+    for ( uint64_t i = 0; i < helperCount; i++ ) {
+        executor.submit( [helpers, &verifyLoop, log]() {
+            {
+                lock_guard< mutex > lock( helpers->m );
+                if ( helpers->closed )
+                    return;
+                helpers->running++;
+            }
+            verifyLoop( log );
+            {
+                lock_guard< mutex > lock( helpers->m );
+                helpers->running--;
+            }
+            helpers->cond.notify_all();
+        } );
+    }
 
-            blocks->push_back( block );
+    // the calling thread verifies too, so the list completes even if the executor is busy
+    verifyLoop( logThreadLocal_ );
 
-            index = endIndex;
+    {
+        unique_lock< mutex > lock( helpers->m );
+        helpers->closed = true;
+        helpers->cond.wait( lock, [&]() { return helpers->running == 0; } );
+    }
 
-            counter++;
-        }
+    uint64_t counter = firstFailedBlock;
+    blocks = make_shared< vector< ptr< CommittedBlock > > >(
+        decoded.begin(), decoded.begin() + counter );
+
+    if ( counter == blockCount )
+        return;
+
+    try {
+        rethrow_exception( errors.at( counter ) );
     } catch ( ... ) {
         if ( _blockSizes->size() > 1 ) {
             LOG( err, "Successfully deserialized "
@@ -108,7 +188,8 @@ CommittedBlockList::CommittedBlockList( const ptr< CryptoManager >& _cryptoManag
                 to_string( _blockSizes->size() ) +
                 ":SERIALIZED_BLOCK_SIZE:" + to_string( _serializedBlocks->size() ) +
                 ":OFFSET:" + to_string( _offset ) + ":COUNTER:" + to_string( counter ) +
-                ":INDEX:" + to_string( index ) + ":END_INDEX:" + to_string( endIndex ),
+                ":INDEX:" + to_string( offsets.at( counter ) ) +
+                ":END_INDEX:" + to_string( offsets.at( counter + 1 ) ),
             __CLASS_NAME__ ) );
     }
 };
@@ -156,14 +237,14 @@ ptr< CommittedBlockList > CommittedBlockList::createRandomSample(
 ptr< CommittedBlockList > CommittedBlockList::deserialize(
     const ptr< CryptoManager >& _cryptoManager, const ptr< vector< uint64_t > >& _blockSizes,
     const ptr< vector< uint8_t > >& _serializedBlocks, uint64_t _offset,
-    bool _createPartialListIfSomeSignaturesDontVerify ) {
+    bool _createPartialListIfSomeSignaturesDontVerify, uint64_t _maxRawBytes ) {
     if ( _serializedBlocks->at( 0 ) != '[' ) {
         BOOST_THROW_EXCEPTION(
             InvalidStateException( "Serialized blocks do not start with [", __CLASS_NAME__ ) );
     }
 
     return ptr< CommittedBlockList >( new CommittedBlockList( _cryptoManager, _blockSizes,
-        _serializedBlocks, _offset, _createPartialListIfSomeSignaturesDontVerify ) );
+        _serializedBlocks, _offset, _createPartialListIfSomeSignaturesDontVerify, _maxRawBytes ) );
 }
 
 ptr< vector< uint64_t > > CommittedBlockList::createSizes() {
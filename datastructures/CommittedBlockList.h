@@ -42,7 +42,11 @@ class CommittedBlockList : public DataStructure {
     CommittedBlockList( const ptr< CryptoManager >& _cryptoManager,
         const ptr< vector< uint64_t > >& _blockSizes,
         const ptr< vector< uint8_t > >& _serializedBlocks, uint64_t offset = 0,
-        bool _createPartialListIfSomeSignaturesDontVerify = false );
+        bool _createPartialListIfSomeSignaturesDontVerify = false,
+        uint64_t _maxRawBytes = CATCHUP_MAX_INFLATE_FACTOR * MAX_CATCHUP_DOWNLOAD_BYTES );
+
+    static ptr< CommittedBlock > deserializeBlock(
+        const ptr< CryptoManager >& _cryptoManager, const ptr< vector< uint8_t > >& _blockData );
 
 public:
     explicit CommittedBlockList( const ptr< vector< ptr< CommittedBlock > > >& _blocks );
@@ -57,7 +61,8 @@ public:
     static ptr< CommittedBlockList > deserialize( const ptr< CryptoManager >& _cryptoManager,
         const ptr< vector< uint64_t > >& _blockSizes,
         const ptr< vector< uint8_t > >& _serializedBlocks, uint64_t _offset,
-        bool _createPartialListIfSomeSignaturesDontVerify = false );
+        bool _createPartialListIfSomeSignaturesDontVerify = false,
+        uint64_t _maxRawBytes = CATCHUP_MAX_INFLATE_FACTOR * MAX_CATCHUP_DOWNLOAD_BYTES );
 
 
     static ptr< CommittedBlockList > createRandomSample( const ptr< CryptoManager >& _cryptoManager,
@@ -0,0 +1,218 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file PartialHashIndex.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Open addressing hash table keyed by partial hashes loaded as uint64_t.
+// Keys and values live in two flat arrays, so a probe touches one cache line of keys and
+// batched lookups can prefetch slots ahead of the probe. Key 0 is the empty slot marker and
+// is stored separately.
+template < typename V >
+class PartialHashIndex {
+    vector< uint64_t > keys;
+    vector< V > values;
+    uint64_t mask = 0;
+    uint64_t count = 0;
+
+    bool hasZeroKey = false;
+    V zeroKeyValue{};
+
+    [[nodiscard]] uint64_t slotOf( uint64_t _key ) const {
+        // keys are hash prefixes already, the multiply only protects against crafted keys
+        return ( ( _key * 0x9E3779B97F4A7C15ULL ) >> 32 ) & mask;
+    }
+
+    void rehash( uint64_t _capacity ) {
+        vector< uint64_t > oldKeys( _capacity, 0 );
+        vector< V > oldValues( _capacity );
+        oldKeys.swap( keys );
+        oldValues.swap( values );
+        mask = _capacity - 1;
+        for ( uint64_t i = 0; i < oldKeys.size(); i++ ) {
+            if ( oldKeys[i] == 0 )
+                continue;
+            auto slot = slotOf( oldKeys[i] );
+            while ( keys[slot] != 0 ) {
+                slot = ( slot + 1 ) & mask;
+            }
+            keys[slot] = oldKeys[i];
+            values[slot] = std::move( oldValues[i] );
+        }
+    }
+
+public:
+    explicit PartialHashIndex( uint64_t _initialCapacity = 64 ) {
+        uint64_t capacity = 16;
+        while ( capacity < 2 * _initialCapacity ) {
+            capacity *= 2;
+        }
+        rehash( capacity );
+    }
+
+    static uint64_t toKey( const partial_sha_hash& _hash ) {
+        uint64_t key;
+        memcpy( &key, _hash.data(), PARTIAL_HASH_LEN );
+        return key;
+    }
+
+    [[nodiscard]] uint64_t size() const { return count; }
+
+    // returns false if the key is already present
+    bool insert( uint64_t _key, const V& _value ) {
+        if ( _key == 0 ) {
+            if ( hasZeroKey )
+                return false;
+            hasZeroKey = true;
+            zeroKeyValue = _value;
+            count++;
+            return true;
+        }
+
+        // keep load factor under 1/2 so that probe sequences stay short
+        if ( 2 * ( count + 1 ) > keys.size() ) {
+            rehash( 2 * keys.size() );
+        }
+
+        auto slot = slotOf( _key );
+        while ( keys[slot] != 0 ) {
+            if ( keys[slot] == _key )
+                return false;
+            slot = ( slot + 1 ) & mask;
+        }
+        keys[slot] = _key;
+        values[slot] = _value;
+        count++;
+        return true;
+    }
+
+    [[nodiscard]] bool contains( uint64_t _key ) const {
+        if ( _key == 0 )
+            return hasZeroKey;
+        auto slot = slotOf( _key );
+        while ( keys[slot] != 0 ) {
+            if ( keys[slot] == _key )
+                return true;
+            slot = ( slot + 1 ) & mask;
+        }
+        return false;
+    }
+
+    // returns a default constructed value if the key is not present
+    [[nodiscard]] V find( uint64_t _key ) const {
+        if ( _key == 0 )
+            return hasZeroKey ? zeroKeyValue : V{};
+        auto slot = slotOf( _key );
+        while ( keys[slot] != 0 ) {
+            if ( keys[slot] == _key )
+                return values[slot];
+            slot = ( slot + 1 ) & mask;
+        }
+        return V{};
+    }
+
+    // returns false if the key is not present
+    bool erase( uint64_t _key ) {
+        if ( _key == 0 ) {
+            if ( !hasZeroKey )
+                return false;
+            hasZeroKey = false;
+            zeroKeyValue = V{};
+            count--;
+            return true;
+        }
+
+        auto slot = slotOf( _key );
+        while ( keys[slot] != _key ) {
+            if ( keys[slot] == 0 )
+                return false;
+            slot = ( slot + 1 ) & mask;
+        }
+
+        // backward shift deletion, so lookups never need tombstones
+        auto hole = slot;
+        auto next = ( hole + 1 ) & mask;
+        while ( keys[next] != 0 ) {
+            auto home = slotOf( keys[next] );
+            // move the entry into the hole unless its home slot lies cyclically in (hole, next]
+            if ( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) ) {
+                keys[hole] = keys[next];
+                values[hole] = std::move( values[next] );
+                hole = next;
+            }
+            next = ( next + 1 ) & mask;
+        }
+        keys[hole] = 0;
+        values[hole] = V{};
+        count--;
+        return true;
+    }
+
+    // Looks up _count keys at once. _found[i] receives the value for _keys[i], and bit i of
+    // _missing is set if _keys[i] is not present. Slots are prefetched
+    // PARTIAL_HASH_PREFETCH_DISTANCE keys ahead of the probe. Returns the number of misses.
+    uint64_t findBatch( const uint64_t* _keys, uint64_t _count, vector< V >& _found,
+        vector< uint64_t >& _missing ) const {
+        CHECK_ARGUMENT( _keys || _count == 0 );
+
+        _found.assign( _count, V{} );
+        _missing.assign( ( _count + 63 ) / 64, 0 );
+
+        uint64_t missingCount = 0;
+
+        for ( uint64_t i = 0; i < _count; i++ ) {
+            if ( i + PARTIAL_HASH_PREFETCH_DISTANCE < _count ) {
+                auto ahead = slotOf( _keys[i + PARTIAL_HASH_PREFETCH_DISTANCE] );
+                __builtin_prefetch( &keys[ahead] );
+                __builtin_prefetch( &values[ahead] );
+            }
+
+            auto key = _keys[i];
+            bool present;
+
+            if ( key == 0 ) {
+                present = hasZeroKey;
+                if ( present )
+                    _found[i] = zeroKeyValue;
+            } else {
+                present = false;
+                auto slot = slotOf( key );
+                while ( keys[slot] != 0 ) {
+                    if ( keys[slot] == key ) {
+                        _found[i] = values[slot];
+                        present = true;
+                        break;
+                    }
+                    slot = ( slot + 1 ) & mask;
+                }
+            }
+
+            if ( !present ) {
+                _missing[i / 64] |= ( uint64_t ) 1 << ( i % 64 );
+                missingCount++;
+            }
+        }
+
+        return missingCount;
+    }
+};
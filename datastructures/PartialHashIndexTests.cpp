@@ -0,0 +1,225 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file PartialHashIndexTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <random>
+
+#include "PartialHashIndex.h"
+#include "PartialHashesList.h"
+
+
+static bool isMissing( const vector< uint64_t >& _missing, uint64_t _i ) {
+    return ( _missing[_i / 64] >> ( _i % 64 ) ) & 1;
+}
+
+
+TEST_CASE( "Partial hash index insert find erase", "[partial-hash-index]" ) {
+    PartialHashIndex< uint64_t > index;
+
+    REQUIRE( index.insert( 5, 50 ) );
+    REQUIRE( !index.insert( 5, 51 ) );
+    REQUIRE( index.insert( 0, 7 ) );
+    REQUIRE( !index.insert( 0, 8 ) );
+    REQUIRE( index.size() == 2 );
+
+    REQUIRE( index.find( 5 ) == 50 );
+    REQUIRE( index.find( 0 ) == 7 );
+    REQUIRE( index.find( 6 ) == 0 );
+    REQUIRE( index.contains( 0 ) );
+
+    REQUIRE( index.erase( 0 ) );
+    REQUIRE( !index.erase( 0 ) );
+    REQUIRE( !index.contains( 0 ) );
+    REQUIRE( index.erase( 5 ) );
+    REQUIRE( !index.erase( 5 ) );
+    REQUIRE( index.size() == 0 );
+}
+
+
+TEST_CASE( "Partial hash index matches reference map", "[partial-hash-index]" ) {
+    mt19937_64 gen( 7 );
+    PartialHashIndex< uint64_t > index( 4 );
+    unordered_map< uint64_t, uint64_t > reference;
+    vector< uint64_t > inserted;
+
+    for ( uint64_t step = 0; step < 200000; step++ ) {
+        auto op = gen() % 3;
+        // draw keys from a small range so that probe chains collide and wrap
+        if ( op < 2 || inserted.empty() ) {
+            auto key = gen() % 4096;
+            auto fresh = reference.count( key ) == 0;
+            REQUIRE( index.insert( key, step ) == fresh );
+            if ( fresh ) {
+                reference[key] = step;
+                inserted.push_back( key );
+            }
+        } else {
+            auto pos = gen() % inserted.size();
+            auto key = inserted[pos];
+            inserted[pos] = inserted.back();
+            inserted.pop_back();
+            REQUIRE( index.erase( key ) == ( reference.erase( key ) > 0 ) );
+        }
+
+        if ( step % 1000 == 0 ) {
+            REQUIRE( index.size() == reference.size() );
+            for ( uint64_t key = 0; key < 4096; key++ ) {
+                auto it = reference.find( key );
+                REQUIRE( index.contains( key ) == ( it != reference.end() ) );
+                if ( it != reference.end() ) {
+                    REQUIRE( index.find( key ) == it->second );
+                }
+            }
+        }
+    }
+}
+
+
+TEST_CASE( "Partial hash index batch lookup", "[partial-hash-index]" ) {
+    mt19937_64 gen( 11 );
+    PartialHashIndex< uint64_t > index;
+
+    vector< uint64_t > keys;
+    for ( uint64_t i = 0; i < 1000; i++ ) {
+        keys.push_back( gen() );
+        if ( i % 3 != 0 ) {
+            index.insert( keys.back(), i + 1 );
+        }
+    }
+    keys.push_back( 0 );
+    index.insert( 0, 12345 );
+
+    vector< uint64_t > found;
+    vector< uint64_t > missing;
+
+    auto missingCount = index.findBatch( keys.data(), keys.size(), found, missing );
+
+    REQUIRE( found.size() == keys.size() );
+    REQUIRE( missing.size() == ( keys.size() + 63 ) / 64 );
+    REQUIRE( missingCount == 334 );
+
+    for ( uint64_t i = 0; i < 1000; i++ ) {
+        REQUIRE( isMissing( missing, i ) == ( i % 3 == 0 ) );
+        REQUIRE( found[i] == ( i % 3 == 0 ? 0 : i + 1 ) );
+    }
+    REQUIRE( !isMissing( missing, 1000 ) );
+    REQUIRE( found[1000] == 12345 );
+
+    REQUIRE( index.findBatch( nullptr, 0, found, missing ) == 0 );
+    REQUIRE( found.empty() );
+    REQUIRE( missing.empty() );
+}
+
+
+TEST_CASE( "Partial hashes list keys", "[partial-hash-index]" ) {
+    uint64_t count = 100;
+    auto bytes = make_shared< vector< uint8_t > >( count * PARTIAL_HASH_LEN );
+    for ( uint64_t i = 0; i < bytes->size(); i++ ) {
+        ( *bytes )[i] = ( uint8_t )( i * 31 + 7 );
+    }
+
+    auto list = make_shared< PartialHashesList >( transaction_count( count ), bytes );
+    auto keys = list->getPartialHashKeys();
+
+    REQUIRE( keys->size() == count );
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        auto hash = list->getPartialHash( i );
+        REQUIRE( ( *keys )[i] == PartialHashIndex< uint64_t >::toKey( *hash ) );
+        REQUIRE( ( *keys )[i] == list->getPartialHashKey( i ) );
+    }
+}
+
+
+TEST_CASE( "Partial hash index benchmark", "[.benchmark]" ) {
+    class Hasher {
+    public:
+        size_t operator()( const ptr< partial_sha_hash >& _a ) const {
+            return boost::hash_range( _a->begin(), _a->end() );
+        }
+    };
+
+    class Equal {
+    public:
+        bool operator()(
+            const ptr< partial_sha_hash >& _a, const ptr< partial_sha_hash >& _b ) const {
+            return *_a == *_b;
+        }
+    };
+
+    mt19937_64 gen( 3 );
+    uint64_t known = 2 * MAX_TRANSACTIONS_PER_BLOCK;
+    uint64_t lookups = MAX_TRANSACTIONS_PER_BLOCK;
+    uint64_t iterations = 100;
+
+    PartialHashIndex< uint64_t > index;
+    unordered_map< ptr< partial_sha_hash >, uint64_t, Hasher, Equal > map;
+
+    auto bytes = make_shared< vector< uint8_t > >( lookups * PARTIAL_HASH_LEN );
+
+    for ( uint64_t i = 0; i < known; i++ ) {
+        auto key = gen();
+        auto hash = make_shared< partial_sha_hash >();
+        memcpy( hash->data(), &key, PARTIAL_HASH_LEN );
+        index.insert( key, i + 1 );
+        map[hash] = i + 1;
+        // every other hash of the proposal is known
+        if ( i % 2 == 0 && i / 2 < lookups ) {
+            memcpy( bytes->data() + ( i / 2 ) * PARTIAL_HASH_LEN, &key, PARTIAL_HASH_LEN );
+        }
+    }
+
+    auto list = make_shared< PartialHashesList >( transaction_count( lookups ), bytes );
+
+    auto start = chrono::steady_clock::now();
+    uint64_t mapFound = 0;
+    for ( uint64_t j = 0; j < iterations; j++ ) {
+        for ( uint64_t i = 0; i < lookups; i++ ) {
+            auto hash = list->getPartialHash( i );
+            mapFound += map.count( hash );
+        }
+    }
+    auto mapNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - start ).count();
+
+    start = chrono::steady_clock::now();
+    uint64_t batchFound = 0;
+    vector< uint64_t > found;
+    vector< uint64_t > missing;
+    for ( uint64_t j = 0; j < iterations; j++ ) {
+        auto keys = list->getPartialHashKeys();
+        batchFound += lookups - index.findBatch( keys->data(), keys->size(), found, missing );
+    }
+    auto batchNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - start ).count();
+
+    REQUIRE( mapFound == batchFound );
+
+    WARN( "Lookup of " << lookups << " hashes: per hash map " << mapNs / iterations
+          << " ns, batched index " << batchNs / iterations << " ns" );
+}
@@ -70,3 +70,32 @@ ptr< partial_sha_hash > PartialHashesList::getPartialHash( uint64_t i ) {
 
     return hash;
 }
+
+uint64_t PartialHashesList::getPartialHashKey( uint64_t i ) const {
+    if ( i >= transactionCount ) {
+        BOOST_THROW_EXCEPTION( NetworkProtocolException(
+            "Index i is more than messageCount:" + to_string( i ), __CLASS_NAME__ ) );
+    }
+
+    CHECK_STATE( partialHashes );
+
+    uint64_t key;
+    memcpy( &key, partialHashes->data() + PARTIAL_HASH_LEN * i, PARTIAL_HASH_LEN );
+    return key;
+}
+
+ptr< vector< uint64_t > > PartialHashesList::getPartialHashKeys() const {
+    CHECK_STATE( partialHashes );
+
+    auto count = ( uint64_t ) transactionCount;
+
+    CHECK_STATE( partialHashes->size() >= count * PARTIAL_HASH_LEN );
+
+    auto keys = make_shared< vector< uint64_t > >( count );
+
+    if ( count > 0 ) {
+        memcpy( keys->data(), partialHashes->data(), count * PARTIAL_HASH_LEN );
+    }
+
+    return keys;
+}
@@ -46,4 +46,10 @@ public:
     msg_len getLen() { return msg_len( partialHashes->size() ); }
 
     ptr< partial_sha_hash > getPartialHash( uint64_t i );
+
+    // partial hash i loaded as uint64_t, see PartialHashIndex
+    [[nodiscard]] uint64_t getPartialHashKey( uint64_t i ) const;
+
+    // all partial hashes as a flat uint64_t array, converted with a single memcpy
+    [[nodiscard]] ptr< vector< uint64_t > > getPartialHashKeys() const;
 };
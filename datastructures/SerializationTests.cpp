@@ -34,6 +34,8 @@
 #include "exceptions/ParsingException.h"
 #include "crypto/CryptoManager.h"
 #include "chains/Schain.h"
+#include "utils/BlockCompression.h"
+#include "utils/ReedSolomon.h"
 
 #include "CommittedBlock.h"
 #include "CommittedBlockList.h"
@@ -261,6 +263,31 @@ void test_committed_block_list_serialize_deserialize() {
 }
 
 
+TEST_CASE( "Reject catchup blocks that inflate too much", "[committed-block-list-inflate]" ) {
+    Schain chain;
+    auto cryptoManager = make_shared< CryptoManager >( chain );
+
+    // compressed frames that claim 1 MB each, rejected before any of them is inflated
+    auto serialized = make_shared< vector< uint8_t > >( 1, '[' );
+    auto sizes = make_shared< vector< uint64_t > >();
+
+    for ( uint64_t i = 0; i < 8; i++ ) {
+        vector< uint8_t > frame( BlockCompression::FRAME_HEADER_SIZE + 16, 0 );
+        uint64_t rawSize = 1024 * 1024;
+        memcpy( frame.data(), &rawSize, sizeof( rawSize ) );
+        frame[sizeof( uint64_t )] = BlockCompression::COMPRESSED_MAGIC;
+        frame[sizeof( uint64_t ) + 1] = BlockCompression::FORMAT_VERSION;
+        serialized->insert( serialized->end(), frame.begin(), frame.end() );
+        sizes->push_back( frame.size() );
+    }
+
+    serialized->push_back( ']' );
+
+    REQUIRE_THROWS( CommittedBlockList::deserialize(
+        cryptoManager, sizes, serialized, 0, true, 4 * 1024 * 1024 ) );
+}
+
+
 TEST_CASE( "Serialize/deserialize transaction", "[tx-serialize]" ) {
     SECTION( "Test successful serialize/deserialize" )
 
@@ -324,6 +351,97 @@ TEST_CASE( "Test committed block fragment/defragment", "[committed-block-defragm
 }
 
 
+TEST_CASE( "Test erasure coded fragment/defragment", "[erasure-coded-defragment]" ) {
+    boost::random::mt19937 gen;
+
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    ConsensusEngine engine( 0, 100000000 );
+
+    Schain chain;
+
+    auto cryptoManager = make_shared< CryptoManager >( chain );
+
+    // 4 and 16 node chains, any 2 of 3 or 10 of 15 peers rebuild the proposal
+    for ( auto [totalFragments, dataFragments] : { pair( 3, 2 ), pair( 15, 10 ) } ) {
+        for ( int i = 1; i < 50; i++ ) {
+            auto t = CommittedBlock::createRandomSample( cryptoManager, i, gen, ubyte, i );
+
+            auto list =
+                make_shared< BlockProposalFragmentList >( i, totalFragments, dataFragments );
+
+            // the slowest peers never answer
+            uint64_t next;
+            for ( int j = totalFragments; j > totalFragments - dataFragments; j-- ) {
+                REQUIRE( !list->isComplete() );
+                list->addFragment(
+                    t->getErasureCodedFragment( totalFragments, dataFragments, j ), next );
+            }
+
+            REQUIRE( list->isComplete() );
+
+            auto imp = BlockProposal::defragment( list, cryptoManager );
+            REQUIRE( imp );
+            REQUIRE( *imp->serializeProposal() == *t->serializeProposal() );
+        }
+    }
+}
+
+
+TEST_CASE( "Erasure coded fragments decode around a corrupt fragment", "[erasure-coded-defragment]" ) {
+    boost::random::mt19937 gen;
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    uint64_t totalFragments = 15;
+    uint64_t dataFragments = 10;
+
+    // framed like a serialized proposal, the hash check is up to the caller
+    auto data = make_shared< vector< uint8_t > >( 10000 );
+    for ( auto&& b : *data )
+        b = ubyte( gen );
+    data->at( sizeof( uint64_t ) ) = '{';
+    data->back() = '>';
+
+    ReedSolomon code( dataFragments, totalFragments );
+
+    auto createFragment = [&]( uint64_t _index, bool _corrupt ) {
+        auto shard = code.encodeShard( data->data(), data->size(), _index - 1 );
+        if ( _corrupt )
+            shard->at( 7 ) ^= 0x55;
+        auto fragmentData = make_shared< vector< uint8_t > >();
+        fragmentData->push_back( '<' );
+        fragmentData->insert( fragmentData->end(), shard->begin(), shard->end() );
+        fragmentData->push_back( '>' );
+        return make_shared< BlockProposalFragment >(
+            5, totalFragments, _index, fragmentData, data->size(), "abcd" );
+    };
+
+    auto isValid = [&]( const ptr< vector< uint8_t > >& _result ) { return *_result == *data; };
+
+    BlockProposalFragmentList list( 5, totalFragments, dataFragments );
+
+    // the first peer to answer sends a corrupt fragment
+    uint64_t next;
+    for ( uint64_t i = 1; i <= dataFragments; i++ ) {
+        list.addFragment( createFragment( i, i == 3 ), next );
+    }
+
+    REQUIRE( list.isComplete() );
+    REQUIRE( list.decode( isValid, FINALIZE_MAX_DECODE_ATTEMPTS ) == nullptr );
+
+    // one more fragment and the subset without the corrupt one decodes
+    REQUIRE( list.requestMoreFragments() );
+    REQUIRE( !list.isComplete() );
+    REQUIRE( list.getTargetFragments() == dataFragments + 1 );
+    list.addFragment( createFragment( dataFragments + 1, false ), next );
+    REQUIRE( list.isComplete() );
+
+    auto result = list.decode( isValid, FINALIZE_MAX_DECODE_ATTEMPTS );
+    REQUIRE( result );
+    REQUIRE( *result == *data );
+}
+
+
 class CryptoFixture {
 public:
     CryptoFixture(){};
@@ -70,6 +70,13 @@ ptr< partial_sha_hash > Transaction::getPartialHash() {
     return partialHash;
 }
 
+uint64_t Transaction::getPartialHashKey() {
+    auto h = getPartialHash();
+    uint64_t key;
+    memcpy( &key, h->data(), PARTIAL_HASH_LEN );
+    return key;
+}
+
 Transaction::Transaction( const ptr< vector< uint8_t > >& _trx, bool _includesPartialHash ) {
     CHECK_ARGUMENT( _trx != nullptr );
 
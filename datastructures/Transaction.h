@@ -65,6 +65,9 @@ public:
 
     ptr< partial_sha_hash > getPartialHash();
 
+    // partial hash loaded as uint64_t, see PartialHashIndex
+    uint64_t getPartialHashKey();
+
     virtual ~Transaction();
 
 
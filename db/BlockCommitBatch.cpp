@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockCommitBatch.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "CacheLevelDB.h"
+#include "BlockCommitBatch.h"
+
+
+BlockCommitBatch::DBBatch& BlockCommitBatch::getBatch( CacheLevelDB* _db ) {
+    CHECK_ARGUMENT( _db );
+    CHECK_STATE( !applied );
+
+    for ( auto&& item : batches ) {
+        if ( item.db == _db )
+            return item;
+    }
+
+    batches.emplace_back();
+    batches.back().db = _db;
+    return batches.back();
+}
+
+void BlockCommitBatch::put(
+    CacheLevelDB* _db, const string& _key, const leveldb::Slice& _value ) {
+    auto& item = getBatch( _db );
+    item.batch.Put( _key, _value );
+    item.count++;
+}
+
+void BlockCommitBatch::putMarker(
+    CacheLevelDB* _db, const string& _key, const leveldb::Slice& _value ) {
+    CHECK_STATE2( markerDB == nullptr || markerDB == _db, "Commit marker in two databases" );
+    markerDB = _db;
+    put( _db, _key, _value );
+}
+
+void BlockCommitBatch::onApplied( function< void() > _action ) {
+    CHECK_STATE( !applied );
+    appliedActions.push_back( move( _action ) );
+}
+
+void BlockCommitBatch::apply() {
+    CHECK_STATE( !applied );
+    applied = true;
+
+    for ( auto&& item : batches ) {
+        if ( item.db != markerDB )
+            item.db->writeBatch( item.batch, item.count, false );
+    }
+
+    for ( auto&& item : batches ) {
+        if ( item.db == markerDB )
+            item.db->writeBatch( item.batch, item.count, true );
+    }
+
+    for ( auto&& action : appliedActions ) {
+        action();
+    }
+}
@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockCommitBatch.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include "leveldb/write_batch.h"
+
+class CacheLevelDB;
+
+
+// Stages the writes a committed block makes to several databases and applies them with one
+// LevelDB write per database. LevelDB can not write atomically across databases, so all
+// databases except the marker database are written without fsync first, and the marker
+// database is written last with the only synchronous write. The marker is the last committed
+// block id of BlockDB, staged in the same LevelDB batch as the block itself, so a block is
+// committed together with its marker or not at all. Unsynced writes are derived from committed
+// blocks and are recomputed on startup if they were lost, see Schain::fixCorruptStateIfNeeded.
+class BlockCommitBatch {
+    struct DBBatch {
+        CacheLevelDB* db;
+        leveldb::WriteBatch batch;
+        uint64_t count = 0;
+    };
+
+    list< DBBatch > batches;
+
+    CacheLevelDB* markerDB = nullptr;
+
+    // run after all batches are written, for example to fill caches
+    vector< function< void() > > appliedActions;
+
+    bool applied = false;
+
+    DBBatch& getBatch( CacheLevelDB* _db );
+
+public:
+    void put( CacheLevelDB* _db, const string& _key, const leveldb::Slice& _value );
+
+    // the database holding the marker is written last and synchronously
+    void putMarker( CacheLevelDB* _db, const string& _key, const leveldb::Slice& _value );
+
+    // _action runs once apply() has written all databases, and not at all if it fails
+    void onApplied( function< void() > _action );
+
+    [[nodiscard]] bool isEmpty() const { return batches.empty(); }
+
+    void apply();
+};
@@ -27,16 +27,18 @@
 #include "chains/Schain.h"
 #include "datastructures/CommittedBlock.h"
 #include "exceptions/InvalidStateException.h"
+#include "utils/BlockCompression.h"
 #include "utils/Time.h"
 
+#include "BlockCommitBatch.h"
 #include "LevelDBOptions.h"
 #include "BlockDB.h"
 
 
 constexpr uint64_t NUMBER_OF_BLOCKS_TO_CACHE = 3;
 
-ptr< vector< uint8_t > > BlockDB::getSerializedBlocksFromLevelDB(
-    block_id _startBlock, block_id _endBlock, ptr< list< uint64_t > > _blockSizes ) {
+ptr< vector< uint8_t > > BlockDB::getSerializedBlocksFromLevelDB( block_id _startBlock,
+    block_id _endBlock, ptr< list< uint64_t > > _blockSizes, bool _compressed ) {
     CHECK_STATE( _blockSizes );
 
     auto serializedBlocks = make_shared< vector< uint8_t > >();
@@ -48,13 +50,21 @@ ptr< vector< uint8_t > > BlockDB::getSerializedBlocksFromLevelDB(
     auto maxSize = getSchain()->getNode()->getMaxCatchupDownloadBytes();
 
     for ( uint64_t i = ( uint64_t ) _startBlock; i <= _endBlock; i++ ) {
-        auto serializedBlock =
-            getSchain()->getNode()->getBlockDB()->getSerializedBlockFromLevelDB( i );
+        auto serializedBlock = getStoredBlockFromLevelDB( i );
 
         if ( serializedBlock == nullptr ) {
             return nullptr;
         }
 
+        // blocks stored compressed are shipped as they are, raw ones are compressed first so
+        // that the byte limit covers more blocks
+        if ( _compressed ) {
+            if ( !BlockCompression::isCompressed( serializedBlock ) )
+                serializedBlock = BlockCompression::compress( serializedBlock );
+        } else {
+            serializedBlock = BlockCompression::decompress( serializedBlock );
+        }
+
         totalSize += serializedBlock->size();
 
 
@@ -81,6 +91,22 @@ ptr< vector< uint8_t > > BlockDB::getSerializedBlocksFromLevelDB(
 
 
 ptr< vector< uint8_t > > BlockDB::getSerializedBlockFromLevelDB( block_id _blockID ) {
+    auto storedBlock = getStoredBlockFromLevelDB( _blockID );
+
+    if ( storedBlock == nullptr )
+        return nullptr;
+
+    try {
+        auto serializedBlock = BlockCompression::decompress( storedBlock );
+        CommittedBlock::serializedSanityCheck( serializedBlock );
+        return serializedBlock;
+    } catch ( ... ) {
+        throw_with_nested( InvalidStateException( __FUNCTION__, __CLASS_NAME__ ) );
+    }
+}
+
+
+ptr< vector< uint8_t > > BlockDB::getStoredBlockFromLevelDB( block_id _blockID ) {
     // check if block is in the cache and return
     // cache is already thread safe
     auto result = blockCache.getIfExists( ( uint64_t ) _blockID );
@@ -101,7 +127,6 @@ ptr< vector< uint8_t > > BlockDB::getSerializedBlockFromLevelDB( block_id _block
             auto serializedBlock = make_shared< vector< uint8_t > >();
             serializedBlock->insert(
                 serializedBlock->begin(), value.data(), value.data() + value.size() );
-            CommittedBlock::serializedSanityCheck( serializedBlock );
             return serializedBlock;
         } else {
             return nullptr;
@@ -111,14 +136,34 @@ ptr< vector< uint8_t > > BlockDB::getSerializedBlockFromLevelDB( block_id _block
     }
 }
 
-BlockDB::BlockDB(
-    Schain* _sChain, string& _dirname, string& _prefix, node_id _nodeId, uint64_t _maxDBSize )
+BlockDB::BlockDB( Schain* _sChain, string& _dirname, string& _prefix, node_id _nodeId,
+    uint64_t _maxDBSize, uint64_t _decodedBlockCacheBytes, bool _compressBlocks )
     : CacheLevelDB( _sChain, _dirname, _prefix, _nodeId, _maxDBSize,
           LevelDBOptions::getBlockDBOptions(), false ),
-      blockCache( NUMBER_OF_BLOCKS_TO_CACHE ) {}
+      blockCache( NUMBER_OF_BLOCKS_TO_CACHE ),
+      decodedBlockCache( _decodedBlockCacheBytes ),
+      compressBlocks( _compressBlocks ) {}
+
+
+ptr< vector< uint8_t > > BlockDB::prepareForStorage(
+    const ptr< vector< uint8_t > >& _serializedBlock ) {
+    CHECK_ARGUMENT( _serializedBlock )
+
+    if ( !compressBlocks )
+        return _serializedBlock;
+
+    return BlockCompression::compress( _serializedBlock );
+}
 
 
 void BlockDB::saveBlock2LevelDB( const ptr< CommittedBlock >& _block ) {
+    BlockCommitBatch commit;
+    stageBlock( commit, _block );
+    commit.apply();
+}
+
+
+void BlockDB::stageBlock( BlockCommitBatch& _commit, const ptr< CommittedBlock >& _block ) {
     CHECK_ARGUMENT( _block )
     CHECK_ARGUMENT( !_block->getSignature().empty() )
 
@@ -127,15 +172,20 @@ void BlockDB::saveBlock2LevelDB( const ptr< CommittedBlock >& _block ) {
     try {
         auto serializedBlock = _block->serialize();
 
-        // put block into the cache
-        blockCache.put( ( uint64_t ) _block->getBlockID(), serializedBlock );
-
         CHECK_STATE( serializedBlock )
 
         auto key = createKey( _block->getBlockID() );
         CHECK_STATE( !key.empty() )
-        writeByteArray( key, serializedBlock );
-        writeString( createLastCommittedKey(), to_string( _block->getBlockID() ), true );
+        auto stored = prepareForStorage( serializedBlock );
+        _commit.put( this, key, leveldb::Slice( ( const char* ) stored->data(), stored->size() ) );
+        _commit.putMarker( this, createLastCommittedKey(), to_string( _block->getBlockID() ) );
+
+        // readers must not see the block before it is in the database
+        _commit.onApplied( [this, _block, serializedBlock]() {
+            blockCache.put( ( uint64_t ) _block->getBlockID(), serializedBlock );
+            // the block keeps its serialized copy, so it costs about twice the serialized size
+            decodedBlockCache.put( _block->getBlockID(), _block, 2 * serializedBlock->size() );
+        } );
     } catch ( ... ) {
         throw_with_nested( InvalidStateException( __FUNCTION__, __CLASS_NAME__ ) );
     }
@@ -146,10 +196,6 @@ string BlockDB::createLastCommittedKey() {
     return getFormatVersion() + ":last";
 }
 
-string BlockDB::createBlockStartKey( block_id _blockID ) {
-    return getFormatVersion() + ":start:" + to_string( ( uint64_t ) _blockID );
-}
-
 const string& BlockDB::getFormatVersion() {
     static const string version = "1.0";
     return version;
@@ -167,10 +213,55 @@ void BlockDB::saveBlock( const ptr< CommittedBlock >& _block ) {
 }
 
 
+void BlockDB::saveBlocks( const vector< ptr< CommittedBlock > >& _blocks ) {
+    CHECK_ARGUMENT( !_blocks.empty() )
+
+    lock_guard< shared_mutex > lock( m );
+
+    try {
+        vector< pair< string, ptr< vector< uint8_t > > > > entries;
+        vector< ptr< vector< uint8_t > > > serializedBlocks;
+
+        for ( auto&& block : _blocks ) {
+            CHECK_ARGUMENT( block )
+            CHECK_ARGUMENT( !block->getSignature().empty() )
+            CHECK_ARGUMENT( block->getBlockID() == _blocks.front()->getBlockID() + entries.size() )
+
+            auto serializedBlock = block->serialize();
+            CHECK_STATE( serializedBlock )
+
+            serializedBlocks.push_back( serializedBlock );
+            entries.emplace_back(
+                createKey( block->getBlockID() ), prepareForStorage( serializedBlock ) );
+        }
+
+        auto lastBlockID = to_string( _blocks.back()->getBlockID() );
+        entries.emplace_back( createLastCommittedKey(),
+            make_shared< vector< uint8_t > >( lastBlockID.begin(), lastBlockID.end() ) );
+
+        writeByteArrays( entries );
+
+        // readers must not see the blocks before they are in the database
+        for ( uint64_t i = 0; i < _blocks.size(); i++ ) {
+            auto& block = _blocks.at( i );
+            blockCache.put( ( uint64_t ) block->getBlockID(), serializedBlocks.at( i ) );
+            decodedBlockCache.put(
+                block->getBlockID(), block, 2 * serializedBlocks.at( i )->size() );
+        }
+    } catch ( ... ) {
+        throw_with_nested( InvalidStateException( __FUNCTION__, __CLASS_NAME__ ) );
+    }
+}
+
+
 ptr< CommittedBlock > BlockDB::getBlock(
-    block_id _blockID, const ptr< CryptoManager >& _cryptoManager ) {
+    block_id _blockID, const ptr< CryptoManager >& _cryptoManager, bool _cache ) {
     CHECK_ARGUMENT( _cryptoManager )
 
+    auto cachedBlock = decodedBlockCache.get( _blockID );
+    if ( cachedBlock )
+        return cachedBlock;
+
     shared_lock< shared_mutex > lock( m );
 
     try {
@@ -185,6 +276,8 @@ ptr< CommittedBlock > BlockDB::getBlock(
         // they have already been verified
         auto result = CommittedBlock::deserialize( serializedBlock, _cryptoManager, false );
         CHECK_STATE( result )
+        if ( _cache )
+            decodedBlockCache.put( _blockID, result, 2 * serializedBlock->size() );
         return result;
     }
 
@@ -193,6 +286,10 @@ ptr< CommittedBlock > BlockDB::getBlock(
     }
 }
 
+DecodedBlockCache& BlockDB::getDecodedBlockCache() {
+    return decodedBlockCache;
+}
+
 block_id BlockDB::readLastCommittedBlockID() {
     shared_lock< shared_mutex > lock( m );
 
@@ -210,14 +307,3 @@ block_id BlockDB::readLastCommittedBlockID() {
     return lastBlockId;
 }
 
-bool BlockDB::unfinishedBlockExists( block_id _blockID ) {
-    shared_lock< shared_mutex > lock( m );
-
-    auto key = createBlockStartKey( _blockID );
-    auto str = readString( key );
-
-    if ( !str.empty() ) {
-        return !this->keyExists( createKey( _blockID ) );
-    }
-    return false;
-}
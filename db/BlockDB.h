@@ -26,8 +26,10 @@
 #define SKALED_BLOCKDB_H
 
 class CommittedBlock;
+class BlockCommitBatch;
 
 #include "CacheLevelDB.h"
+#include "DecodedBlockCache.h"
 
 class CryptoManager;
 
@@ -36,17 +38,39 @@ class BlockDB : public CacheLevelDB {
 
     void saveBlock2LevelDB( const ptr< CommittedBlock >& _block );
 
+    // returns the block as stored, compressed or not
+    ptr< vector< uint8_t > > getStoredBlockFromLevelDB( block_id _blockID );
+
+    // returns the bytes to write to LevelDB for a serialized block
+    ptr< vector< uint8_t > > prepareForStorage( const ptr< vector< uint8_t > >& _serializedBlock );
+
+    bool compressBlocks = false;
+
     cache::lru_cache< uint64_t, ptr< vector< uint8_t > > > blockCache;  // tsafe
 
+    DecodedBlockCache decodedBlockCache;  // tsafe
+
 public:
-    BlockDB(
-        Schain* _sChain, string& _dirname, string& _prefix, node_id _nodeId, uint64_t _maxDBSize );
+    BlockDB( Schain* _sChain, string& _dirname, string& _prefix, node_id _nodeId,
+        uint64_t _maxDBSize, uint64_t _decodedBlockCacheBytes = DEFAULT_DECODED_BLOCK_CACHE_BYTES,
+        bool _compressBlocks = false );
 
     ptr< vector< uint8_t > > getSerializedBlockFromLevelDB( block_id _blockID );
 
     void saveBlock( const ptr< CommittedBlock >& _block );
 
-    ptr< CommittedBlock > getBlock( block_id _blockID, const ptr< CryptoManager >& _cryptoManager );
+    // stages the block and the last committed marker, see BlockCommitBatch
+    void stageBlock( BlockCommitBatch& _commit, const ptr< CommittedBlock >& _block );
+
+    // saves consecutive blocks with one database write
+    void saveBlocks( const vector< ptr< CommittedBlock > >& _blocks );
+
+    // The returned block may be shared with other readers and must not be modified. Scans
+    // over many blocks pass _cache = false, so that they do not evict the recent blocks
+    ptr< CommittedBlock > getBlock(
+        block_id _blockID, const ptr< CryptoManager >& _cryptoManager, bool _cache = true );
+
+    DecodedBlockCache& getDecodedBlockCache();
 
     block_id readLastCommittedBlockID();
 
@@ -54,12 +78,10 @@ public:
 
     string createLastCommittedKey();
 
-    string createBlockStartKey( block_id _blockID );
-
-    bool unfinishedBlockExists( block_id _blockID );
-
-    ptr< vector< uint8_t > > getSerializedBlocksFromLevelDB(
-        block_id _startBlock, block_id _endBlock, ptr< list< uint64_t > > _blockSizes );
+    // if _compressed is set, blocks are returned in the BlockCompression format and
+    // _blockSizes holds the compressed sizes
+    ptr< vector< uint8_t > > getSerializedBlocksFromLevelDB( block_id _startBlock,
+        block_id _endBlock, ptr< list< uint64_t > > _blockSizes, bool _compressed = false );
 };
 
 
@@ -0,0 +1,223 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockMetadataIndex.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "datastructures/CommittedBlock.h"
+#include "datastructures/TransactionList.h"
+
+#include "BlockMetadataIndex.h"
+
+
+static_assert( sizeof( BlockMetadataIndex::Header ) == 64 );
+static_assert( sizeof( BlockMetadataIndex::Record ) == 128 );
+
+
+BlockMetadataIndex::BlockMetadataIndex( const string& _fileName ) : fileName( _fileName ) {
+    fd = ::open( fileName.c_str(), O_RDWR | O_CREAT, 0644 );
+    CHECK_STATE2( fd >= 0, "Could not open block metadata index " + fileName );
+
+    struct stat st;
+    CHECK_STATE( ::fstat( fd, &st ) == 0 );
+
+    auto size = ( uint64_t ) st.st_size;
+
+    bool valid = size >= sizeof( Header ) && ( size - sizeof( Header ) ) % sizeof( Record ) == 0;
+
+    if ( valid ) {
+        mapFile( size );
+        valid = getHeader()->magic == MAGIC && getHeader()->recordSize == sizeof( Record );
+    }
+
+    if ( !valid ) {
+        if ( size > 0 )
+            LOG( warn, "Recreating invalid block metadata index " << fileName );
+        initEmpty();
+    }
+}
+
+
+void BlockMetadataIndex::initEmpty() {
+    if ( mapping ) {
+        ::munmap( mapping, mappedSize );
+        mapping = nullptr;
+    }
+    CHECK_STATE( ::ftruncate( fd, 0 ) == 0 );
+    mapFile( sizeof( Header ) + GROWTH_RECORDS * sizeof( Record ) );
+    getHeader()->magic = MAGIC;
+    getHeader()->recordSize = sizeof( Record );
+    getHeader()->lastBlockId = 0;
+}
+
+
+void BlockMetadataIndex::clear() {
+    lock_guard< mutex > lock( writeLock );
+    lock_guard< shared_mutex > mappingWriteLock( mappingLock );
+    initEmpty();
+}
+
+
+BlockMetadataIndex::~BlockMetadataIndex() {
+    if ( mapping ) {
+        ::msync( mapping, mappedSize, MS_ASYNC );
+        ::munmap( mapping, mappedSize );
+    }
+    if ( fd >= 0 )
+        ::close( fd );
+}
+
+
+void BlockMetadataIndex::mapFile( uint64_t _size ) {
+    // the file is sparse, unwritten records read as zeroes, so they are not present
+    CHECK_STATE( ::ftruncate( fd, _size ) == 0 );
+
+    if ( mapping )
+        ::munmap( mapping, mappedSize );
+
+    auto addr = ::mmap( nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    CHECK_STATE2( addr != MAP_FAILED, "Could not map block metadata index " + fileName );
+
+    mapping = ( uint8_t* ) addr;
+    mappedSize = _size;
+}
+
+
+BlockMetadataIndex::Header* BlockMetadataIndex::getHeader() {
+    return ( Header* ) mapping;
+}
+
+
+BlockMetadataIndex::Record* BlockMetadataIndex::getRecord( block_id _blockID ) {
+    auto offset = sizeof( Header ) + ( uint64_t ) _blockID * sizeof( Record );
+    if ( offset + sizeof( Record ) > mappedSize )
+        return nullptr;
+    return ( Record* ) ( mapping + offset );
+}
+
+
+void BlockMetadataIndex::ensureCapacity( block_id _blockID ) {
+    {
+        shared_lock< shared_mutex > lock( mappingLock );
+        if ( getRecord( _blockID ) )
+            return;
+    }
+
+    lock_guard< shared_mutex > lock( mappingLock );
+
+    auto records = ( ( ( uint64_t ) _blockID / GROWTH_RECORDS ) + 1 ) * GROWTH_RECORDS;
+    mapFile( sizeof( Header ) + records * sizeof( Record ) );
+}
+
+
+void BlockMetadataIndex::toLimbs( const u256& _value, uint64_t* _limbs ) {
+    for ( int i = 0; i < 4; i++ ) {
+        _limbs[i] = ( uint64_t ) ( _value >> ( 64 * i ) );
+    }
+}
+
+
+u256 BlockMetadataIndex::fromLimbs( const uint64_t* _limbs ) {
+    u256 value = 0;
+    for ( int i = 3; i >= 0; i-- ) {
+        value = ( value << 64 ) | _limbs[i];
+    }
+    return value;
+}
+
+
+void BlockMetadataIndex::write( block_id _blockID, const BlockMetadata& _metadata ) {
+    CHECK_ARGUMENT( _blockID > 0 );
+
+    lock_guard< mutex > lock( writeLock );
+
+    ensureCapacity( _blockID );
+
+    shared_lock< shared_mutex > mappingReadLock( mappingLock );
+
+    auto record = getRecord( _blockID );
+    CHECK_STATE( record );
+
+    // records are immutable once present, readers may be looking at this one
+    if ( __atomic_load_n( &record->present, __ATOMIC_ACQUIRE ) )
+        return;
+
+    record->timeStampS = _metadata.timeStampS;
+    record->timeStampMs = _metadata.timeStampMs;
+    record->proposerIndex = _metadata.proposerIndex;
+    record->transactionCount = _metadata.transactionCount;
+    toLimbs( _metadata.price, record->price );
+    toLimbs( _metadata.random, record->random );
+    toLimbs( _metadata.stateRoot, record->stateRoot );
+
+    __atomic_store_n( &record->present, 1, __ATOMIC_RELEASE );
+
+    if ( getHeader()->lastBlockId < ( uint64_t ) _blockID )
+        __atomic_store_n( &getHeader()->lastBlockId, ( uint64_t ) _blockID, __ATOMIC_RELEASE );
+}
+
+
+bool BlockMetadataIndex::read( block_id _blockID, BlockMetadata& _metadata ) {
+    shared_lock< shared_mutex > lock( mappingLock );
+
+    auto record = getRecord( _blockID );
+
+    if ( !record || !__atomic_load_n( &record->present, __ATOMIC_ACQUIRE ) )
+        return false;
+
+    _metadata.timeStampS = record->timeStampS;
+    _metadata.timeStampMs = record->timeStampMs;
+    _metadata.proposerIndex = record->proposerIndex;
+    _metadata.transactionCount = record->transactionCount;
+    _metadata.price = fromLimbs( record->price );
+    _metadata.random = fromLimbs( record->random );
+    _metadata.stateRoot = fromLimbs( record->stateRoot );
+
+    return true;
+}
+
+
+block_id BlockMetadataIndex::getLastBlockId() {
+    shared_lock< shared_mutex > lock( mappingLock );
+    return __atomic_load_n( &getHeader()->lastBlockId, __ATOMIC_ACQUIRE );
+}
+
+
+BlockMetadata BlockMetadataIndex::createMetadata(
+    const ptr< CommittedBlock >& _block, const u256& _price ) {
+    CHECK_ARGUMENT( _block );
+
+    BlockMetadata metadata;
+    metadata.price = _price;
+    metadata.random = _block->getRandom();
+    metadata.stateRoot = _block->getStateRoot();
+    metadata.timeStampS = _block->getTimeStampS();
+    metadata.timeStampMs = _block->getTimeStampMs();
+    metadata.proposerIndex = ( uint32_t ) ( uint64_t ) _block->getProposerIndex();
+    metadata.transactionCount = _block->getTransactionList()->size();
+    return metadata;
+}
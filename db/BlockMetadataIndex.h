@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockMetadataIndex.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+class CommittedBlock;
+
+
+struct BlockMetadata {
+    u256 price = 0;
+    u256 random = 0;
+    u256 stateRoot = 0;
+    uint64_t timeStampS = 0;
+    uint32_t timeStampMs = 0;
+    uint32_t proposerIndex = 0;
+    uint64_t transactionCount = 0;
+};
+
+
+// Append-only memory mapped file of fixed width per-block metadata, indexed by block id.
+// Lookups are plain memory reads instead of LevelDB gets and string parsing. The file is a
+// cache of data that lives in BlockDB and PriceDB: a missing record only means the caller has
+// to fall back to the databases. Missing records of the newest blocks are rebuilt on startup,
+// see BLOCK_METADATA_REBUILD_WINDOW.
+class BlockMetadataIndex {
+public:
+    static constexpr uint64_t MAGIC = 0x3141544d4b4c4b53;  // "SKLKMTA1"
+    static constexpr uint64_t GROWTH_RECORDS = 65536;
+
+    struct Header {
+        uint64_t magic;
+        uint64_t recordSize;
+        uint64_t lastBlockId;
+        uint64_t reserved[5];
+    };
+
+    // u256 values are stored as four little endian 64 bit limbs
+    struct Record {
+        uint64_t present;
+        uint64_t timeStampS;
+        uint32_t timeStampMs;
+        uint32_t proposerIndex;
+        uint64_t transactionCount;
+        uint64_t price[4];
+        uint64_t random[4];
+        uint64_t stateRoot[4];
+    };
+
+private:
+    string fileName;
+
+    int fd = -1;
+
+    uint8_t* mapping = nullptr;
+    uint64_t mappedSize = 0;
+
+    // readers hold it shared, remapping the file takes it exclusively
+    shared_mutex mappingLock;
+
+    mutex writeLock;
+
+    void mapFile( uint64_t _size );
+
+    void initEmpty();
+
+    void ensureCapacity( block_id _blockID );
+
+    Header* getHeader();
+
+    Record* getRecord( block_id _blockID );
+
+    static void toLimbs( const u256& _value, uint64_t* _limbs );
+
+    static u256 fromLimbs( const uint64_t* _limbs );
+
+public:
+    explicit BlockMetadataIndex( const string& _fileName );
+
+    ~BlockMetadataIndex();
+
+    void write( block_id _blockID, const BlockMetadata& _metadata );
+
+    // returns false if the block is not indexed
+    bool read( block_id _blockID, BlockMetadata& _metadata );
+
+    block_id getLastBlockId();
+
+    // drops all records, used when the index is ahead of the block database
+    void clear();
+
+    static BlockMetadata createMetadata( const ptr< CommittedBlock >& _block, const u256& _price );
+};
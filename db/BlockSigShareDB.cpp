@@ -35,6 +35,8 @@
 #include "exceptions/InvalidStateException.h"
 #include "node/Node.h"
 #include "node/NodeInfo.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/Time.h"
 
 
 #include "LevelDBOptions.h"
@@ -86,6 +88,9 @@ ptr< ThresholdSignature > BlockSigShareDB::checkAndSaveShareInMemory(
         }
 
         CHECK_STATE( _sigShareSet->isEnough() )
+
+        auto mergeStartTimeUs = Time::getMonotonicTimeUs();
+
         auto signature = _sigShareSet->mergeSignature();
 
         CHECK_STATE( signature )
@@ -93,6 +98,9 @@ ptr< ThresholdSignature > BlockSigShareDB::checkAndSaveShareInMemory(
 
         _cryptoManager->verifyThresholdSig( signature, hash );
 
+        LatencyHistogram::record(
+            LAT_BLOCK_SIG_MERGE, Time::getMonotonicTimeUs() - mergeStartTimeUs );
+
 
         return signature;
     } catch ( ExitRequestedException& ) {
@@ -42,7 +42,9 @@
 #include "datastructures/Transaction.h"
 #include "datastructures/TransactionList.h"
 #include "exceptions/LevelDBException.h"
+#include "node/ConsensusEngine.h"
 #include "node/Node.h"
+#include "threads/GlobalThreadRegistry.h"
 
 
 #include "monitoring/LivelinessMonitor.h"
@@ -115,15 +117,12 @@ string CacheLevelDB::readString( string& _key ) {
     return readStringUnsafe( _key );
 }
 
+#include "utils/LatencyHistogram.h"
 #include "utils/Time.h"
 
 string CacheLevelDB::readStringUnsafe( string& _key ) {
-    uint64_t time = 0;
-
     readCounter.fetch_add( 1 );
-    auto measureTime = ( readCounter % 100 == 0 );
-    if ( measureTime )
-        time = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
     for ( int i = LEVELDB_SHARDS - 1; i >= 0; i-- ) {
         string result;
@@ -131,8 +130,7 @@ string CacheLevelDB::readStringUnsafe( string& _key ) {
         auto status = db.at( i )->Get( readOptions, _key, &result );
         throwExceptionOnError( status );
         if ( !status.IsNotFound() ) {
-            if ( measureTime )
-                CacheLevelDB::addReadStats( Time::getCurrentTimeMs() - time );
+            CacheLevelDB::addReadStats( Time::getMonotonicTimeUs() - startTimeUs );
             return result;
         }
     }
@@ -178,11 +176,8 @@ void CacheLevelDB::checkForDeadLockRead( const char* _functionName ) {
 void CacheLevelDB::writeString( const string& _key, const string& _value, bool _overWrite ) {
     rotateDBsIfNeeded();
 
-    uint64_t time = 0;
     writeCounter.fetch_add( 1 );
-    auto measureTime = ( writeCounter % 100 == 0 );
-    if ( measureTime )
-        time = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
 
     {
@@ -197,10 +192,11 @@ void CacheLevelDB::writeString( const string& _key, const string& _value, bool _
         auto status = db.back()->Put( writeOptions, _key, Slice( _value ) );
 
         throwExceptionOnError( status );
+
+        addActiveDBBytes( _key.size() + _value.size() );
     }
 
-    if ( measureTime )
-        CacheLevelDB::addWriteStats( Time::getCurrentTimeMs() - time );
+    CacheLevelDB::addWriteStats( Time::getMonotonicTimeUs() - startTimeUs );
 }
 
 
@@ -211,11 +207,8 @@ void CacheLevelDB::writeByteArray(
 
     rotateDBsIfNeeded();
 
-    uint64_t time = 0;
     writeCounter.fetch_add( 1 );
-    auto measureTime = ( writeCounter % 100 == 0 );
-    if ( measureTime )
-        time = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
 
     {
@@ -231,10 +224,11 @@ void CacheLevelDB::writeByteArray(
             db.back()->Put( writeOptions, Slice( _key, _keyLen ), Slice( _value, _valueLen ) );
 
         throwExceptionOnError( status );
+
+        addActiveDBBytes( _keyLen + _valueLen );
     }
 
-    if ( measureTime )
-        CacheLevelDB::addWriteStats( Time::getCurrentTimeMs() - time );
+    CacheLevelDB::addWriteStats( Time::getMonotonicTimeUs() - startTimeUs );
 }
 
 void CacheLevelDB::writeByteArray( string& _key, const ptr< vector< uint8_t > >& _data ) {
@@ -243,10 +237,7 @@ void CacheLevelDB::writeByteArray( string& _key, const ptr< vector< uint8_t > >&
     rotateDBsIfNeeded();
 
     writeCounter.fetch_add( 1 );
-    uint64_t time = 0;
-    auto measureTime = ( writeCounter % 100 == 0 );
-    if ( measureTime )
-        time = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
     auto value = ( const char* ) _data->data();
     auto valueLen = _data->size();
@@ -256,11 +247,42 @@ void CacheLevelDB::writeByteArray( string& _key, const ptr< vector< uint8_t > >&
         lock_guard< shared_timed_mutex > lock( m );
         auto status = db.back()->Put( writeOptions, Slice( _key ), Slice( value, valueLen ) );
         throwExceptionOnError( status );
+        addActiveDBBytes( _key.size() + valueLen );
+    }
+
+    CacheLevelDB::addWriteStats( Time::getMonotonicTimeUs() - startTimeUs );
+}
+
+void CacheLevelDB::writeByteArrays(
+    vector< pair< string, ptr< vector< uint8_t > > > >& _entries ) {
+    // LevelDB inserts sorted keys into its memtable faster
+    sort( _entries.begin(), _entries.end(),
+        []( auto& _a, auto& _b ) { return _a.first < _b.first; } );
+
+    leveldb::WriteBatch batch;
+    for ( auto&& [key, data] : _entries ) {
+        CHECK_ARGUMENT( data )
+        batch.Put( Slice( key ), Slice( ( const char* ) data->data(), data->size() ) );
     }
 
+    writeBatch( batch, _entries.size() );
+}
+
+void CacheLevelDB::writeBatch( leveldb::WriteBatch& _batch, uint64_t _entryCount, bool _sync ) {
+    rotateDBsIfNeeded();
+
+    writeCounter.fetch_add( _entryCount );
+    auto startTimeUs = Time::getMonotonicTimeUs();
+
+    {
+        checkForDeadLock( __FUNCTION__ );
+        lock_guard< shared_timed_mutex > lock( m );
+        auto status = db.back()->Write( _sync ? writeOptions : asyncWriteOptions, &_batch );
+        throwExceptionOnError( status );
+        addActiveDBBytes( _batch.ApproximateSize() );
+    }
 
-    if ( measureTime )
-        CacheLevelDB::addWriteStats( Time::getCurrentTimeMs() - time );
+    CacheLevelDB::addWriteStats( Time::getMonotonicTimeUs() - startTimeUs );
 }
 
 void CacheLevelDB::throwExceptionOnError( Status& _status ) {
@@ -376,28 +398,83 @@ CacheLevelDB::CacheLevelDB( Schain* _sChain, string& _dirName, string& _prefix,
     this->options = _options;
     this->readOptions.fill_cache = false;
     this->writeOptions.sync = true;
+    this->asyncWriteOptions.sync = false;
     this->isDuplicateAddOK = _isDuplicateAddOK;
 
     boost::filesystem::path path( dirName );
     boost::filesystem::create_directory( path );
 
+    // directories renamed for removal before a restart
+    for ( auto&& entry : boost::filesystem::directory_iterator( path ) ) {
+        if ( entry.path().filename().string().find( "deleted." ) == 0 ) {
+            boost::filesystem::remove_all( entry.path() );
+        }
+    }
+
     highestDBIndex = findMaxMinDBIndex().first;
 
+    ptr< leveldb::DB > newestDB;
+
+    if ( highestDBIndex > LEVELDB_SHARDS ) {
+        newestDB = openDB( highestDBIndex );
+        auto it = unique_ptr< leveldb::Iterator >( newestDB->NewIterator( readOptions ) );
+        it->SeekToFirst();
+        if ( !it->Valid() ) {
+            // an empty newest shard was prepared and not rotated in, or rotated in and not
+            // written to, so it becomes the next shard again
+            nextDB = newestDB;
+            nextDBRequested = true;
+            nextDBReady = true;
+            newestDB = nullptr;
+            highestDBIndex--;
+        }
+    }
+
     if ( highestDBIndex < LEVELDB_SHARDS ) {
         highestDBIndex = LEVELDB_SHARDS;
     }
 
 
     for ( auto i = highestDBIndex - LEVELDB_SHARDS + 1; i <= highestDBIndex; i++ ) {
-        auto dbase = openDB( i );
+        auto dbase = ( newestDB && i == highestDBIndex ) ? newestDB : openDB( i );
         CHECK_STATE( dbase );
         db.push_back( dbase );
     }
 
+    activeDBSize = getActiveDBSize();
+
     verify();
+
+    rotationThread = make_shared< thread >( &CacheLevelDB::rotationLoop, this );
+
+    try {
+        sChain->getNode()->getConsensusEngine()->getThreadRegistry()->add( rotationThread );
+        lock_guard< mutex > lock( rotationMutex );
+        rotationThreadRegistered = true;
+    } catch ( ExitRequestedException& ) {
+        // databases opened without a node join the thread in the destructor
+    }
 }
 
-CacheLevelDB::~CacheLevelDB() {}
+CacheLevelDB::~CacheLevelDB() {
+    {
+        unique_lock< mutex > lock( rotationMutex );
+        rotationStopped = true;
+        rotationCond.notify_all();
+
+        // the rotation thread finishes removing rotated shards, so that the directory can be
+        // reopened. A registered thread is joined by the thread registry, joining it here as
+        // well would race with the registry
+        if ( rotationThreadRegistered ) {
+            rotationCond.wait( lock, [this]() { return rotationExited; } );
+            return;
+        }
+    }
+
+    if ( rotationThread && rotationThread->joinable() ) {
+        rotationThread->join();
+    }
+}
 
 using namespace boost::filesystem;
 
@@ -464,47 +541,58 @@ pair< uint64_t, uint64_t > CacheLevelDB::findMaxMinDBIndex() {
 
 void CacheLevelDB::rotateDBsIfNeeded() {
     try {
-        if ( getActiveDBSize() <= maxDBSize )
+        if ( activeDBSize <= maxDBSize / 2 )
+            return;
+
+        if ( !nextDBReady ) {
+            // writes go to the newest shard until the next one is ready
+            if ( !nextDBRequested.exchange( true ) ) {
+                wakeRotationThread();
+            }
+            return;
+        }
+
+        if ( activeDBSize <= maxDBSize )
             return;
+
+        ptr< leveldb::DB > rotatedDB;
+        uint64_t rotatedIndex = 0;
+
         {
             checkForDeadLock( __FUNCTION__ );
             lock_guard< shared_timed_mutex > lock( m );
 
-            if ( getActiveDBSize() <= maxDBSize )
+            if ( !nextDBReady || activeDBSize <= maxDBSize )
                 return;
 
-            LOG(
-                info, "ROTATED_DATABASE: " << prefix << ":MAX_DB_SIZE:" << to_string( maxDBSize ) );
-
-            auto newDB = openDB( highestDBIndex + 1 );
+            rotatedDB = db.front();
+            rotatedIndex = highestDBIndex - LEVELDB_SHARDS + 1;
 
             for ( uint64_t i = 1; i < LEVELDB_SHARDS; i++ ) {
-                db.at( i - 1 ) = nullptr;
                 db.at( i - 1 ) = db.at( i );
             }
 
-            db[LEVELDB_SHARDS - 1] = newDB;
+            db[LEVELDB_SHARDS - 1] = nextDB;
+            nextDB = nullptr;
 
             highestDBIndex++;
+            activeDBSize = 0;
+            bytesSinceSizeScan = 0;
+            nextDBReady = false;
+            nextDBRequested = false;
 
-            uint64_t minIndex;
-
-            while ( ( minIndex = findMaxMinDBIndex().second ) + LEVELDB_SHARDS <= highestDBIndex ) {
-                if ( minIndex == 0 ) {
-                    return;
-                }
+            verify();
+        }
 
-                auto dbName = index2Path( minIndex );
-                try {
-                    boost::filesystem::remove_all( path( dbName ) );
-                } catch ( SkaleException& e ) {
-                    LOG( err, "Could not remove db:" << dbName );
-                }
-            }
+        LOG( info, "ROTATED_DATABASE: " << prefix << ":MAX_DB_SIZE:" << to_string( maxDBSize ) );
 
-            verify();
+        {
+            lock_guard< mutex > lock( rotationMutex );
+            rotatedDBs.emplace_back( move( rotatedDB ), rotatedIndex );
         }
 
+        wakeRotationThread();
+
     } catch ( ExitRequestedException& e ) {
         throw;
     } catch ( ... ) {
@@ -513,6 +601,141 @@ void CacheLevelDB::rotateDBsIfNeeded() {
 }
 
 
+void CacheLevelDB::addActiveDBBytes( uint64_t _bytes ) {
+    if ( bytesSinceSizeScan.fetch_add( _bytes ) + _bytes < maxDBSize / DB_SIZE_SCANS_PER_SHARD )
+        return;
+
+    if ( !sizeScanRequested.exchange( true ) ) {
+        wakeRotationThread();
+    }
+}
+
+
+void CacheLevelDB::wakeRotationThread() {
+    lock_guard< mutex > lock( rotationMutex );
+    rotationCond.notify_one();
+}
+
+
+bool CacheLevelDB::hasRotationWork() {
+    return !rotatedDBs.empty() || ( nextDBRequested && !nextDBReady ) || sizeScanRequested;
+}
+
+
+bool CacheLevelDB::isExitRequested() {
+    try {
+        return sChain->getNode()->isExitRequested();
+    } catch ( ExitRequestedException& ) {
+        // no node, the destructor stops the thread
+        return false;
+    }
+}
+
+
+void CacheLevelDB::rotationLoop() {
+    while ( true ) {
+        ptr< leveldb::DB > rotatedDB;
+        uint64_t rotatedIndex = 0;
+        bool prepare = false;
+
+        {
+            unique_lock< mutex > lock( rotationMutex );
+
+            // pending work is finished before the thread exits
+            while ( !hasRotationWork() ) {
+                if ( rotationStopped || isExitRequested() ) {
+                    // notified under the lock, so that the destructor can not free the
+                    // condition variable before
+                    rotationExited = true;
+                    rotationCond.notify_all();
+                    return;
+                }
+                rotationCond.wait_for( lock, chrono::milliseconds( DB_ROTATION_POLL_MS ) );
+            }
+
+            if ( !rotatedDBs.empty() ) {
+                tie( rotatedDB, rotatedIndex ) = rotatedDBs.front();
+                rotatedDBs.pop_front();
+            } else {
+                prepare = nextDBRequested && !nextDBReady;
+            }
+        }
+
+        try {
+            if ( rotatedDB ) {
+                removeRotatedDB( rotatedDB, rotatedIndex );
+            } else if ( prepare ) {
+                prepareNextDB();
+            } else {
+                scanActiveDBSize();
+            }
+        } catch ( exception& e ) {
+            SkaleException::logNested( e );
+            if ( prepare ) {
+                // retried by a later write, meanwhile the newest shard keeps growing
+                LOG( err, "Could not prepare next database shard:" << prefix );
+                nextDBRequested = false;
+            }
+        }
+    }
+}
+
+
+void CacheLevelDB::scanActiveDBSize() {
+    sizeScanRequested = false;
+    bytesSinceSizeScan = 0;
+
+    auto index = highestDBIndex.load();
+    auto size = getActiveDBSize();
+
+    // a rotation during the scan has reset the size of the new shard already
+    shared_lock< shared_timed_mutex > lock( m );
+    if ( highestDBIndex == index ) {
+        activeDBSize = size;
+    }
+}
+
+
+void CacheLevelDB::prepareNextDB() {
+    // highestDBIndex does not change until the prepared shard is rotated in
+    nextDB = openDB( highestDBIndex + 1 );
+    nextDBReady = true;
+}
+
+
+void CacheLevelDB::removeRotatedDB( ptr< leveldb::DB >& _db, uint64_t _index ) {
+    CHECK_ARGUMENT( _db );
+
+    // closing waits for compactions of the shard
+    _db = nullptr;
+
+    removeDBDirectory( _index );
+
+    // shards left behind by a restart before they were removed
+    uint64_t minIndex;
+    while ( ( minIndex = findMaxMinDBIndex().second ) != 0 && minIndex < _index ) {
+        removeDBDirectory( minIndex );
+    }
+}
+
+
+void CacheLevelDB::removeDBDirectory( uint64_t _index ) {
+    // the rename is atomic, so a restart never opens a partially removed shard
+    path dbPath( index2Path( _index ) );
+    path deletedPath( dirName + "/deleted." + to_string( _index ) );
+
+    if ( boost::filesystem::exists( dbPath ) ) {
+        boost::filesystem::rename( dbPath, deletedPath );
+    }
+
+    try {
+        boost::filesystem::remove_all( deletedPath );
+    } catch ( exception& ) {
+        LOG( err, "Could not remove db:" << deletedPath.string() );
+    }
+}
+
+
 bool CacheLevelDB::isEnough( block_id _blockID ) {
     return readCount( _blockID ) >= requiredSigners;
 }
@@ -589,11 +812,8 @@ ptr< map< schain_index, string > > CacheLevelDB::writeByteArrayToSetUnsafe(
     const char* _value, uint64_t _valueLen, block_id _blockId, schain_index _index ) {
     CHECK_ARGUMENT( _index > 0 && _index <= totalSigners );
 
-    uint64_t time = 0;
     writeCounter.fetch_add( 1 );
-    auto measureTime = ( writeCounter % 100 == 0 );
-    if ( measureTime )
-        time = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
     auto entryKey = createKey( _blockId, _index );
     CHECK_STATE( entryKey != "" );
@@ -640,6 +860,10 @@ ptr< map< schain_index, string > > CacheLevelDB::writeByteArrayToSetUnsafe(
         batch.Put( counterKey, to_string( count ) );
         batch.Put( entryKey, Slice( _value, _valueLen ) );
         CHECK_STATE2( containingDb->Write( writeOptions, &batch ).ok(), "Could not write LevelDB" );
+        // writes to older shards do not grow the newest one
+        if ( containingDb == db.back() ) {
+            addActiveDBBytes( batch.ApproximateSize() );
+        }
     }
 
 
@@ -662,8 +886,7 @@ ptr< map< schain_index, string > > CacheLevelDB::writeByteArrayToSetUnsafe(
 
     CHECK_STATE( enoughSet->size() == requiredSigners );
 
-    if ( measureTime )
-        CacheLevelDB::addWriteStats( Time::getCurrentTimeMs() - time );
+    CacheLevelDB::addWriteStats( Time::getMonotonicTimeUs() - startTimeUs );
 
     return enoughSet;
 }
@@ -675,7 +898,14 @@ void CacheLevelDB::verify() {
     }
 }
 
-void CacheLevelDB::addWriteStats( uint64_t _time ) {
+void CacheLevelDB::addWriteStats( uint64_t _timeUs ) {
+    LatencyHistogram::record( LAT_DB_WRITE, _timeUs );
+
+    // the short history feeding the block log average is sampled
+    if ( writeCounter % 100 != 0 )
+        return;
+
+    auto _time = _timeUs / 1000;
     CacheLevelDB::writeTimeTotal.fetch_add( _time );
     LOCK( writeTimeMutex );
     CacheLevelDB::writeTimes.push_back( _time );
@@ -685,7 +915,13 @@ void CacheLevelDB::addWriteStats( uint64_t _time ) {
     }
 }
 
-void CacheLevelDB::addReadStats( uint64_t _time ) {
+void CacheLevelDB::addReadStats( uint64_t _timeUs ) {
+    LatencyHistogram::record( LAT_DB_READ, _timeUs );
+
+    if ( readCounter % 100 != 0 )
+        return;
+
+    auto _time = _timeUs / 1000;
     CacheLevelDB::readTimeTotal.fetch_add( _time );
     LOCK( readTimeMutex );
     CacheLevelDB::readTimes.push_back( _time );
@@ -711,7 +947,7 @@ uint64_t CacheLevelDB::getReadStats() {
 }
 
 uint64_t CacheLevelDB::getWriteStats() {
-    return readTimeTotal;
+    return writeTimeTotal;
 }
 void CacheLevelDB::destroy() {
     checkForDeadLock( __FUNCTION__ );
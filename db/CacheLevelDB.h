@@ -33,6 +33,8 @@
 class Schain;
 
 class CacheLevelDB {
+    friend class BlockCommitBatch;
+
     static list< uint64_t > writeTimes;
     static recursive_mutex writeTimeMutex;
     static atomic< uint64_t > writeTimeTotal;
@@ -46,11 +48,57 @@ class CacheLevelDB {
 
     leveldb::Options options;
     leveldb::WriteOptions writeOptions;  // NOLINT(cert-err58-cpp)
+    leveldb::WriteOptions asyncWriteOptions;
     leveldb::ReadOptions readOptions;    // NOLINT(cert-err58-cpp)
 
+    // on-disk size of the newest shard, the unit of maxDBSize. The write path does not scan the
+    // shard directory, it counts the bytes it writes to the newest shard and asks the rotation
+    // thread for a rescan once they reach 1 / DB_SIZE_SCANS_PER_SHARD of maxDBSize
+    atomic< uint64_t > activeDBSize = 0;
+    atomic< uint64_t > bytesSinceSizeScan = 0;
+    atomic< bool > sizeScanRequested = false;
+
+    // the next shard is opened by the rotation thread once the newest shard is half full, and
+    // rotated in by a writer once it is full. Rotated out shards are closed and removed by the
+    // rotation thread as well, so writers never wait for the file system
+    ptr< leveldb::DB > nextDB;
+    atomic< bool > nextDBRequested = false;
+    atomic< bool > nextDBReady = false;
+
+    mutex rotationMutex;
+    condition_variable rotationCond;
+    list< pair< ptr< leveldb::DB >, uint64_t > > rotatedDBs;
+    bool rotationStopped = false;
+    ptr< thread > rotationThread;
+
+    // a thread in the thread registry is joined by the registry only, the destructor waits for
+    // rotationExited instead. Guarded by rotationMutex
+    bool rotationThreadRegistered = false;
+    bool rotationExited = false;
+
+    // call with m locked, so that a concurrent rotation does not move the bytes to another shard
+    void addActiveDBBytes( uint64_t _bytes );
+
+    void wakeRotationThread();
+
+    void rotationLoop();
+
+    // call with rotationMutex locked
+    bool hasRotationWork();
+
+    bool isExitRequested();
+
+    void scanActiveDBSize();
+
+    void prepareNextDB();
+
+    void removeRotatedDB( ptr< leveldb::DB >& _db, uint64_t _index );
+
+    void removeDBDirectory( uint64_t _index );
+
 protected:
     vector< ptr< leveldb::DB > > db;
-    uint64_t highestDBIndex = 0;
+    atomic< uint64_t > highestDBIndex = 0;
 
 
     node_id nodeId = 0;
@@ -87,6 +135,12 @@ protected:
     void writeByteArray( const char* _key, size_t _keyLen, const char* _value, size_t _valueLen );
     void writeByteArray( string& _key, const ptr< vector< uint8_t > >& _data );
 
+    // writes all entries with one LevelDB write, overwriting existing keys
+    void writeByteArrays( vector< pair< string, ptr< vector< uint8_t > > > >& _entries );
+
+    // unsynced writes reach the OS on return but may be lost on power failure
+    void writeBatch( leveldb::WriteBatch& _batch, uint64_t _entryCount, bool _sync = true );
+
     string createKey( block_id _blockId );
 
     string createKey( block_id _blockId, schain_index _proposerIndex );
@@ -108,6 +162,7 @@ protected:
 
     string readStringFromSet( block_id _blockId, schain_index _index );
 
+    // cheap unless the newest shard is full and the next one is ready, see activeDBSize
     void rotateDBsIfNeeded();
 
     ptr< leveldb::DB > openDB( uint64_t _index );
@@ -147,8 +202,9 @@ public:
 
     ptr< map< string, string > > readPrefixRange( string& _prefix );
 
-    static void addWriteStats( uint64_t _time );
-    static void addReadStats( uint64_t _time );
+    // durations are in microseconds
+    static void addWriteStats( uint64_t _timeUs );
+    static void addReadStats( uint64_t _timeUs );
 
     static uint64_t getReadStats();
     static uint64_t getWriteStats();
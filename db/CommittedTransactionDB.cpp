@@ -26,6 +26,7 @@
 #include "Log.h"
 
 #include "datastructures/Transaction.h"
+#include "utils/CuckooFilter.h"
 
 
 #include "CommittedTransactionDB.h"
@@ -33,7 +34,9 @@
 
 CommittedTransactionDB::CommittedTransactionDB( Schain* _sChain, string& _dirName, string& _prefix,
     node_id _nodeId, uint64_t _maxDBSize, leveldb::Options& _options )
-    : CacheLevelDB( _sChain, _dirName, _prefix, _nodeId, _maxDBSize, _options, false ) {}
+    : CacheLevelDB( _sChain, _dirName, _prefix, _nodeId, _maxDBSize, _options, false ) {
+    loadFilters();
+}
 
 
 const string& CommittedTransactionDB::getFormatVersion() {
@@ -42,18 +45,114 @@ const string& CommittedTransactionDB::getFormatVersion() {
 }
 
 
-void CommittedTransactionDB::writeCommittedTransaction(
-    const ptr< Transaction >& _t, __uint64_t _committedTransactionCounter ) {
-    CHECK_ARGUMENT( _t )
-    auto hash = _t->getPartialHash();
-    CHECK_STATE( hash )
-    auto key = ( const char* ) hash->data();
-    auto keyLen = PARTIAL_HASH_LEN;
-    auto value = ( const char* ) &_committedTransactionCounter;
-    auto valueLen = sizeof( _committedTransactionCounter );
-    writeByteArray( key, keyLen, value, valueLen );
+void CommittedTransactionDB::loadFilters() {
+    WRITE_LOCK( filtersMutex );
+
+    leveldb::ReadOptions readOptions;
+    readOptions.fill_cache = false;
+
+    uint64_t keyCount = 0;
+
+    for ( uint64_t i = 0; i < LEVELDB_SHARDS; i++ ) {
+        CHECK_STATE( db.at( i ) );
+        auto shardIndex = highestDBIndex - LEVELDB_SHARDS + 1 + i;
+        auto it = unique_ptr< leveldb::Iterator >( db.at( i )->NewIterator( readOptions ) );
+        for ( it->SeekToFirst(); it->Valid(); it->Next() ) {
+            // skip the counter entry, transaction keys are raw partial hashes
+            if ( it->key().size() != PARTIAL_HASH_LEN )
+                continue;
+            uint64_t key;
+            memcpy( &key, it->key().data(), PARTIAL_HASH_LEN );
+            addToFiltersUnsafe( shardIndex, key );
+            keyCount++;
+        }
+    }
+
+    LOG( info, "Loaded committed transaction filters:" << keyCount );
+}
+
+
+void CommittedTransactionDB::addToFiltersUnsafe( uint64_t _shardIndex, uint64_t _key ) {
+    auto& shardFilters = filters[_shardIndex];
+
+    if ( shardFilters.empty() || !shardFilters.back()->insert( _key ) ) {
+        shardFilters.push_back(
+            make_shared< CuckooFilter >( COMMITTED_TRANSACTIONS_FILTER_CAPACITY ) );
+        CHECK_STATE( shardFilters.back()->insert( _key ) );
+    }
+}
+
+
+void CommittedTransactionDB::dropRotatedFiltersUnsafe() {
+    while ( !filters.empty() && filters.begin()->first + LEVELDB_SHARDS <= highestDBIndex ) {
+        filters.erase( filters.begin() );
+    }
+}
+
+
+bool CommittedTransactionDB::isTransactionCommittedUnsafe( uint64_t _partialHashKey ) {
+    for ( auto&& item : filters ) {
+        for ( auto&& filter : item.second ) {
+            if ( filter->contains( _partialHashKey ) ) {
+                // rule out a false positive
+                return keyExists(
+                    string( ( const char* ) &_partialHashKey, PARTIAL_HASH_LEN ) );
+            }
+        }
+    }
+    return false;
+}
+
+
+bool CommittedTransactionDB::isTransactionCommitted( uint64_t _partialHashKey ) {
+    READ_LOCK( filtersMutex );
+    return isTransactionCommittedUnsafe( _partialHashKey );
+}
+
+
+void CommittedTransactionDB::writeCommittedTransactions(
+    const vector< ptr< Transaction > >& _transactions, uint64_t _firstCounter ) {
+    if ( _transactions.empty() )
+        return;
+
+    WRITE_LOCK( filtersMutex );
+
+    vector< pair< string, ptr< vector< uint8_t > > > > entries;
+    vector< uint64_t > keys;
+    unordered_set< uint64_t > batchKeys;
+
+    entries.reserve( _transactions.size() + 1 );
+    keys.reserve( _transactions.size() );
 
-    static auto key1 = getFormatVersion() + ":transactions";
-    auto value1 = to_string( _committedTransactionCounter );
-    writeString( key1, value1 );
-}
\ No newline at end of file
+    auto counter = _firstCounter;
+
+    for ( auto&& t : _transactions ) {
+        CHECK_ARGUMENT( t );
+        auto key = t->getPartialHashKey();
+        auto value = counter++;
+
+        if ( !batchKeys.insert( key ).second || isTransactionCommittedUnsafe( key ) ) {
+            LOG( trace, "Double entry written to db" );
+            continue;
+        }
+
+        auto data = make_shared< vector< uint8_t > >( sizeof( value ) );
+        memcpy( data->data(), &value, sizeof( value ) );
+        entries.emplace_back( string( ( const char* ) &key, PARTIAL_HASH_LEN ), data );
+        keys.push_back( key );
+    }
+
+    static auto counterKey = getFormatVersion() + ":transactions";
+    auto counterValue = to_string( counter - 1 );
+    entries.emplace_back( counterKey,
+        make_shared< vector< uint8_t > >( counterValue.begin(), counterValue.end() ) );
+
+    writeByteArrays( entries );
+
+    // the batch went to the newest shard, possibly just rotated in
+    dropRotatedFiltersUnsafe();
+
+    for ( auto key : keys ) {
+        addToFiltersUnsafe( highestDBIndex, key );
+    }
+}
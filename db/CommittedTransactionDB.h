@@ -26,19 +26,40 @@
 #define SKALED_COMMITTEDTRANSACTIONDB_H
 
 class Transaction;
+class CuckooFilter;
 
 #include "CacheLevelDB.h"
 
+// Partial hashes of committed transactions. Membership is answered from per shard cuckoo
+// filters held in memory, LevelDB is only read to rule out a filter false positive.
+// Filters follow shard rotation: the filters of a shard are dropped with the shard.
 class CommittedTransactionDB : public CacheLevelDB {
+    // filters by the index of the shard that holds their keys
+    map< uint64_t, vector< ptr< CuckooFilter > > > filters;
+
+    shared_mutex filtersMutex;
+
     const string& getFormatVersion() override;
 
+    void loadFilters();
+
+    void addToFiltersUnsafe( uint64_t _shardIndex, uint64_t _key );
+
+    void dropRotatedFiltersUnsafe();
+
+    bool isTransactionCommittedUnsafe( uint64_t _partialHashKey );
+
 
 public:
     CommittedTransactionDB( Schain* _sChain, string& _dirName, string& _prefix, node_id _nodeId,
         uint64_t _maxDBSize, leveldb::Options& _options );
 
-    void writeCommittedTransaction(
-        const ptr< Transaction >& _t, __uint64_t _committedTransactionCounter );
+    // writes the transactions of a block with one LevelDB write. Transaction i gets counter
+    // _firstCounter + i, transactions committed before are skipped and keep their counter.
+    void writeCommittedTransactions(
+        const vector< ptr< Transaction > >& _transactions, uint64_t _firstCounter );
+
+    bool isTransactionCommitted( uint64_t _partialHashKey );
 };
 
 
@@ -39,7 +39,14 @@
 
 #include "chains/Schain.h"
 
+#include "BlockCommitBatch.h"
 #include "BlockDB.h"
+#include "BlockMetadataIndex.h"
+#include "CommittedTransactionDB.h"
+#include "DecodedBlockCache.h"
+#include "LevelDBOptions.h"
+#include "PriceDB.h"
+#include "datastructures/Transaction.h"
 
 
 void test_committed_block_save() {
@@ -66,6 +73,9 @@ void test_committed_block_save() {
         auto bb = db->getBlock( t->getBlockID(), cryptoManager );
 
         REQUIRE( bb != nullptr );
+
+        // second read is served from the decoded block cache
+        REQUIRE( db->getBlock( t->getBlockID(), cryptoManager ) == bb );
     }
 
     REQUIRE( db->findMaxMinDBIndex().first > 10 );
@@ -75,3 +85,316 @@ TEST_CASE( "Save/read block", "[block-save-read-db]" ) {
     SECTION( "Test successful save/read" )
     test_committed_block_save();
 }
+
+
+TEST_CASE( "Save blocks in one batch", "[block-batch-save-db]" ) {
+    auto sChain = make_shared< Schain >();
+    static string dirName = "/tmp";
+    boost::random::mt19937 gen;
+    auto cryptoManager = make_shared< CryptoManager >( *sChain );
+
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    for ( bool compressBlocks : { false, true } ) {
+        string fileName = "test_committed_block_batch_save_" + to_string( compressBlocks );
+
+        if ( std::system( ( "rm -rf " + dirName + "/" + fileName ).c_str() ) != 0 ) {
+            BOOST_THROW_EXCEPTION( runtime_error( "Remove failed" ) );
+        }
+
+        auto db = make_shared< BlockDB >( sChain.get(), dirName, fileName, node_id( 1 ), 5000000,
+            DEFAULT_DECODED_BLOCK_CACHE_BYTES, compressBlocks );
+
+        vector< ptr< CommittedBlock > > blocks;
+
+        for ( uint64_t i = 1; i <= 200; i++ ) {
+            blocks.push_back(
+                CommittedBlock::createRandomSample( cryptoManager, i % 10 + 1, gen, ubyte, i ) );
+        }
+
+        for ( uint64_t start = 0; start < blocks.size(); start += CATCHUP_BLOCK_SAVE_BATCH ) {
+            auto end = min( start + CATCHUP_BLOCK_SAVE_BATCH, ( uint64_t ) blocks.size() );
+            db->saveBlocks(
+                vector< ptr< CommittedBlock > >( blocks.begin() + start, blocks.begin() + end ) );
+            REQUIRE( db->readLastCommittedBlockID() == end );
+        }
+
+        for ( auto&& block : blocks ) {
+            auto serialized = db->getSerializedBlockFromLevelDB( block->getBlockID() );
+            REQUIRE( serialized != nullptr );
+            REQUIRE( *serialized == *block->serialize() );
+        }
+
+        // reading without the cache, as the metadata index rebuild does, leaves it empty
+        db = nullptr;
+        db = make_shared< BlockDB >( sChain.get(), dirName, fileName, node_id( 1 ), 5000000,
+            DEFAULT_DECODED_BLOCK_CACHE_BYTES, compressBlocks );
+
+        for ( auto&& block : blocks ) {
+            REQUIRE( db->getBlock( block->getBlockID(), cryptoManager, false ) != nullptr );
+        }
+        REQUIRE( db->getDecodedBlockCache().getSize() == 0 );
+    }
+}
+
+
+TEST_CASE( "Commit block and price in one batch", "[block-commit-batch]" ) {
+    auto sChain = make_shared< Schain >();
+    static string dirName = "/tmp";
+    boost::random::mt19937 gen;
+    auto cryptoManager = make_shared< CryptoManager >( *sChain );
+
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    string blockFileName = "test_block_commit_batch_blocks";
+    string priceFileName = "test_block_commit_batch_prices";
+
+    if ( std::system( ( "rm -rf " + dirName + "/" + blockFileName + " " + dirName + "/" +
+                        priceFileName )
+                          .c_str() ) != 0 ) {
+        BOOST_THROW_EXCEPTION( runtime_error( "Remove failed" ) );
+    }
+
+    auto blockDB = make_shared< BlockDB >( sChain.get(), dirName, blockFileName, node_id( 1 ),
+        5000000, DEFAULT_DECODED_BLOCK_CACHE_BYTES, false );
+    auto priceDB =
+        make_shared< PriceDB >( sChain.get(), dirName, priceFileName, node_id( 1 ), 5000000 );
+
+    for ( uint64_t i = 2; i <= 50; i++ ) {
+        auto block = CommittedBlock::createRandomSample( cryptoManager, i % 10 + 1, gen, ubyte, i );
+
+        BlockCommitBatch commit;
+        blockDB->stageBlock( commit, block );
+        priceDB->stagePrice( commit, u256( 1000 + i ), i );
+
+        // nothing is written or cached before the batch is applied
+        REQUIRE( !priceDB->hasPrice( i ) );
+        REQUIRE( blockDB->readLastCommittedBlockID() == ( i > 2 ? i - 1 : 0 ) );
+        REQUIRE( blockDB->getSerializedBlockFromLevelDB( i ) == nullptr );
+        REQUIRE( blockDB->getDecodedBlockCache().get( i ) == nullptr );
+
+        commit.apply();
+
+        REQUIRE( blockDB->readLastCommittedBlockID() == i );
+        REQUIRE( blockDB->getDecodedBlockCache().get( i ) == block );
+        REQUIRE( *blockDB->getSerializedBlockFromLevelDB( i ) == *block->serialize() );
+        REQUIRE( priceDB->readPrice( i ) == u256( 1000 + i ) );
+    }
+}
+
+
+TEST_CASE( "Rotate database shards in the background", "[db-rotation]" ) {
+    auto sChain = make_shared< Schain >();
+    static string dirName = "/tmp";
+    static string fileName = "test_db_rotation";
+
+    if ( std::system( ( "rm -rf " + dirName + "/" + fileName ).c_str() ) != 0 ) {
+        BOOST_THROW_EXCEPTION( runtime_error( "Remove failed" ) );
+    }
+
+    {
+        auto db = make_shared< PriceDB >( sChain.get(), dirName, fileName, node_id( 1 ), 4000 );
+
+        for ( uint64_t i = 2; i < 1000; i++ ) {
+            db->savePrice( u256( i ), i );
+            REQUIRE( db->readPrice( i ) == u256( i ) );
+        }
+
+        REQUIRE( db->findMaxMinDBIndex().first > LEVELDB_SHARDS + 1 );
+    }
+
+    // rotated shards are removed before close, at most a prepared next shard is left over
+    auto db = make_shared< PriceDB >( sChain.get(), dirName, fileName, node_id( 1 ), 4000 );
+    auto [maxIndex, minIndex] = db->findMaxMinDBIndex();
+    REQUIRE( maxIndex - minIndex + 1 <= LEVELDB_SHARDS + 1 );
+    REQUIRE( db->readPrice( 999 ) == u256( 999 ) );
+}
+
+
+TEST_CASE( "Database write latency across rotations", "[.benchmark]" ) {
+    auto sChain = make_shared< Schain >();
+    static string dirName = "/tmp";
+    static string fileName = "test_db_rotation_latency";
+
+    if ( std::system( ( "rm -rf " + dirName + "/" + fileName ).c_str() ) != 0 ) {
+        BOOST_THROW_EXCEPTION( runtime_error( "Remove failed" ) );
+    }
+
+    auto db = make_shared< PriceDB >( sChain.get(), dirName, fileName, node_id( 1 ), 200000 );
+
+    auto firstIndex = db->findMaxMinDBIndex().first;
+
+    const uint64_t writeCount = 50000;
+    vector< uint64_t > latencyUs;
+    latencyUs.reserve( writeCount );
+
+    auto begin = chrono::steady_clock::now();
+    for ( uint64_t i = 2; i < writeCount + 2; i++ ) {
+        auto start = chrono::steady_clock::now();
+        db->savePrice( u256( i ), i );
+        latencyUs.push_back(
+            chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - start )
+                .count() );
+    }
+    auto totalMs =
+        chrono::duration_cast< chrono::milliseconds >( chrono::steady_clock::now() - begin )
+            .count();
+
+    auto rotations = db->findMaxMinDBIndex().first - firstIndex;
+    REQUIRE( rotations > 0 );
+
+    sort( latencyUs.begin(), latencyUs.end() );
+    auto percentile = [&]( double _p ) {
+        return latencyUs.at( min( ( uint64_t )( _p * writeCount ), writeCount - 1 ) );
+    };
+
+    WARN( writeCount << " writes rotations:" << rotations << " total ms:" << totalMs
+                     << " p50 us:" << percentile( 0.5 ) << " p99 us:" << percentile( 0.99 )
+                     << " p999 us:" << percentile( 0.999 ) << " max us:" << latencyUs.back() );
+}
+
+
+TEST_CASE( "Committed transactions", "[committed-tx-db]" ) {
+    auto sChain = make_shared< Schain >();
+    static string dirName = "/tmp";
+    static string fileName = "test_committed_transactions";
+    boost::random::mt19937 gen;
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    if ( std::system( ( "rm -rf " + dirName + "/" + fileName ).c_str() ) != 0 ) {
+        BOOST_THROW_EXCEPTION( runtime_error( "Remove failed" ) );
+    }
+
+    auto options = LevelDBOptions::getSmallDBOptions();
+
+    vector< ptr< Transaction > > committed;
+    vector< ptr< Transaction > > notCommitted;
+
+    {
+        // small shards, so that the writes below rotate
+        auto db = make_shared< CommittedTransactionDB >(
+            sChain.get(), dirName, fileName, node_id( 1 ), 10000, options );
+
+        uint64_t counter = 1;
+
+        for ( uint64_t i = 0; i < 20; i++ ) {
+            vector< ptr< Transaction > > block;
+            for ( uint64_t j = 0; j < 100; j++ ) {
+                block.push_back( Transaction::createRandomSample( 100, gen, ubyte ) );
+                notCommitted.push_back( Transaction::createRandomSample( 100, gen, ubyte ) );
+            }
+            // transactions committed before are skipped
+            if ( i > 0 ) {
+                block.push_back( committed.back() );
+            }
+            db->writeCommittedTransactions( block, counter );
+            counter += block.size();
+            committed.insert( committed.end(), block.begin(), block.begin() + 100 );
+        }
+
+        REQUIRE( db->findMaxMinDBIndex().first > LEVELDB_SHARDS );
+
+        // the newest transactions are still in the retained shards
+        for ( uint64_t i = committed.size() - 100; i < committed.size(); i++ ) {
+            REQUIRE( db->isTransactionCommitted( committed[i]->getPartialHashKey() ) );
+        }
+
+        for ( auto&& t : notCommitted ) {
+            REQUIRE( !db->isTransactionCommitted( t->getPartialHashKey() ) );
+        }
+    }
+
+    // filters are rebuilt from the shards on reopen
+    auto db = make_shared< CommittedTransactionDB >(
+        sChain.get(), dirName, fileName, node_id( 1 ), 10000, options );
+
+    for ( uint64_t i = committed.size() - 100; i < committed.size(); i++ ) {
+        REQUIRE( db->isTransactionCommitted( committed[i]->getPartialHashKey() ) );
+    }
+
+    for ( auto&& t : notCommitted ) {
+        REQUIRE( !db->isTransactionCommitted( t->getPartialHashKey() ) );
+    }
+}
+
+
+TEST_CASE( "Decoded block cache", "[decoded-block-cache]" ) {
+    DecodedBlockCache cache( 1000 );
+
+    auto b1 = make_shared< CommittedBlock >( 1, 0 );
+    auto b2 = make_shared< CommittedBlock >( 2, 0 );
+    auto b3 = make_shared< CommittedBlock >( 3, 0 );
+
+    cache.put( 1, b1, 400 );
+    cache.put( 2, b2, 400 );
+
+    REQUIRE( cache.get( 1 ) == b1 );
+
+    // block 2 is now the least recently used one
+    cache.put( 3, b3, 400 );
+
+    REQUIRE( cache.get( 2 ) == nullptr );
+    REQUIRE( cache.get( 1 ) == b1 );
+    REQUIRE( cache.get( 3 ) == b3 );
+    REQUIRE( cache.getBytes() == 800 );
+    REQUIRE( cache.getSize() == 2 );
+
+    // blocks larger than the whole cache are not cached
+    cache.put( 4, make_shared< CommittedBlock >( 4, 0 ), 2000 );
+    REQUIRE( cache.get( 4 ) == nullptr );
+    REQUIRE( cache.getSize() == 2 );
+
+    REQUIRE( cache.getHits() == 3 );
+    REQUIRE( cache.getMisses() == 2 );
+}
+
+
+TEST_CASE( "Block metadata index", "[block-metadata-index]" ) {
+    static string fileName = "/tmp/test_block_metadata_index.idx";
+    std::remove( fileName.c_str() );
+
+    u256 bigValue = ( u256( 1 ) << 255 ) + 12345;
+
+    {
+        BlockMetadataIndex index( fileName );
+        REQUIRE( index.getLastBlockId() == 0 );
+
+        for ( uint64_t i = 1; i < 3 * BlockMetadataIndex::GROWTH_RECORDS; i += 1000 ) {
+            BlockMetadata metadata;
+            metadata.price = i * 100;
+            metadata.random = bigValue + i;
+            metadata.stateRoot = i;
+            metadata.timeStampS = 1700000000 + i;
+            metadata.timeStampMs = i % 1000;
+            metadata.proposerIndex = i % 16 + 1;
+            metadata.transactionCount = i * 2;
+            index.write( i, metadata );
+        }
+    }
+
+    // records survive reopening the file
+    BlockMetadataIndex index( fileName );
+
+    BlockMetadata metadata;
+    REQUIRE( !index.read( 2, metadata ) );
+    REQUIRE( !index.read( 10 * BlockMetadataIndex::GROWTH_RECORDS, metadata ) );
+
+    for ( uint64_t i = 1; i < 3 * BlockMetadataIndex::GROWTH_RECORDS; i += 1000 ) {
+        REQUIRE( index.read( i, metadata ) );
+        REQUIRE( metadata.price == i * 100 );
+        REQUIRE( metadata.random == bigValue + i );
+        REQUIRE( metadata.stateRoot == i );
+        REQUIRE( metadata.timeStampS == 1700000000 + i );
+        REQUIRE( metadata.timeStampMs == i % 1000 );
+        REQUIRE( metadata.proposerIndex == i % 16 + 1 );
+        REQUIRE( metadata.transactionCount == i * 2 );
+    }
+
+    REQUIRE( ( uint64_t ) index.getLastBlockId() > 2 * BlockMetadataIndex::GROWTH_RECORDS );
+
+    index.clear();
+    REQUIRE( index.getLastBlockId() == 0 );
+    REQUIRE( !index.read( 1, metadata ) );
+
+    std::remove( fileName.c_str() );
+}
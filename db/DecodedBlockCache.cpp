@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file DecodedBlockCache.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "DecodedBlockCache.h"
+
+
+DecodedBlockCache::DecodedBlockCache( uint64_t _maxBytes ) : maxBytes( _maxBytes ) {}
+
+
+ptr< CommittedBlock > DecodedBlockCache::get( block_id _blockID ) {
+    lock_guard< mutex > lock( m );
+
+    auto it = index.find( ( uint64_t ) _blockID );
+
+    if ( it == index.end() ) {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    items.splice( items.begin(), items, it->second );
+    return it->second->second.first;
+}
+
+
+void DecodedBlockCache::put(
+    block_id _blockID, const ptr< CommittedBlock >& _block, uint64_t _sizeBytes ) {
+    CHECK_ARGUMENT( _block );
+
+    // a block that does not fit would evict everything else
+    if ( _sizeBytes > maxBytes )
+        return;
+
+    lock_guard< mutex > lock( m );
+
+    auto it = index.find( ( uint64_t ) _blockID );
+
+    if ( it != index.end() ) {
+        bytes -= it->second->second.second;
+        items.erase( it->second );
+        index.erase( it );
+    }
+
+    items.push_front( { ( uint64_t ) _blockID, { _block, _sizeBytes } } );
+    index[( uint64_t ) _blockID] = items.begin();
+    bytes += _sizeBytes;
+
+    while ( bytes > maxBytes ) {
+        auto& last = items.back();
+        bytes -= last.second.second;
+        index.erase( last.first );
+        items.pop_back();
+    }
+}
+
+
+uint64_t DecodedBlockCache::getHits() const {
+    return hits;
+}
+
+
+uint64_t DecodedBlockCache::getMisses() const {
+    return misses;
+}
+
+
+uint64_t DecodedBlockCache::getBytes() const {
+    return bytes;
+}
+
+
+uint64_t DecodedBlockCache::getSize() {
+    lock_guard< mutex > lock( m );
+    return items.size();
+}
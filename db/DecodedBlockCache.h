@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file DecodedBlockCache.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+class CommittedBlock;
+
+
+// Bounded LRU of decoded committed blocks, keyed by block id. The bound is on the estimated
+// memory of the cached blocks. Blocks are shared with every reader and are never modified once
+// they are committed, so a hit hands out the cached object itself.
+class DecodedBlockCache {
+    typedef pair< uint64_t, pair< ptr< CommittedBlock >, uint64_t > > Item;
+
+    mutex m;
+
+    list< Item > items;
+    unordered_map< uint64_t, list< Item >::iterator > index;
+
+    uint64_t maxBytes;
+
+    atomic< uint64_t > bytes = 0;
+    atomic< uint64_t > hits = 0;
+    atomic< uint64_t > misses = 0;
+
+public:
+    explicit DecodedBlockCache( uint64_t _maxBytes );
+
+    // returns nullptr on miss
+    ptr< CommittedBlock > get( block_id _blockID );
+
+    void put( block_id _blockID, const ptr< CommittedBlock >& _block, uint64_t _sizeBytes );
+
+    uint64_t getHits() const;
+
+    uint64_t getMisses() const;
+
+    uint64_t getBytes() const;
+
+    uint64_t getSize();
+};
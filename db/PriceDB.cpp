@@ -26,6 +26,7 @@
 #include "Log.h"
 #include "chains/Schain.h"
 #include "exceptions/ExitRequestedException.h"
+#include "BlockCommitBatch.h"
 #include "LevelDBOptions.h"
 #include "PriceDB.h"
 
@@ -68,7 +69,11 @@ u256 PriceDB::readPrice( block_id _blockID ) {
     }
 }
 
-void PriceDB::savePrice( const u256& _price, block_id _blockID ) {
+string PriceDB::createStateKey( block_id _blockID ) {
+    return getFormatVersion() + ":STATE:" + to_string( _blockID );
+}
+
+void PriceDB::savePrice( const u256& _price, block_id _blockID, const string& _strategyState ) {
     LOG( trace, "Save price for block" << to_string( _blockID ) );
 
     try {
@@ -77,10 +82,36 @@ void PriceDB::savePrice( const u256& _price, block_id _blockID ) {
 
         auto value = _price.str();
 
-        writeString( key, value );
+        if ( _strategyState.empty() ) {
+            writeString( key, value );
+            return;
+        }
+
+        leveldb::WriteBatch batch;
+        batch.Put( key, value );
+        batch.Put( createStateKey( _blockID ), _strategyState );
+        writeBatch( batch, 2 );
     } catch ( ExitRequestedException& ) {
         throw;
     } catch ( ... ) {
         throw_with_nested( InvalidStateException( __FUNCTION__, __CLASS_NAME__ ) );
     }
 }
+
+void PriceDB::stagePrice( BlockCommitBatch& _commit, const u256& _price, block_id _blockID,
+    const string& _strategyState ) {
+    auto key = createKey( _blockID );
+    CHECK_STATE( key != "" )
+    _commit.put( this, key, _price.str() );
+    if ( !_strategyState.empty() )
+        _commit.put( this, createStateKey( _blockID ), _strategyState );
+}
+
+string PriceDB::readStrategyState( block_id _blockID ) {
+    auto key = createStateKey( _blockID );
+    return readString( key );
+}
+
+bool PriceDB::hasPrice( block_id _blockID ) {
+    return keyExists( createKey( _blockID ) );
+}
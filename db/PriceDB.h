@@ -28,7 +28,11 @@
 
 #include "CacheLevelDB.h"
 
+class BlockCommitBatch;
+
 class PriceDB : public CacheLevelDB {
+    string createStateKey( block_id _blockID );
+
 public:
     const string& getFormatVersion() override;
 
@@ -37,7 +41,17 @@ public:
 
     u256 readPrice( block_id _blockID );
 
-    void savePrice( const u256& _price, block_id _blockID );
+    // _strategyState is the pricing strategy state after _blockID, written in the same LevelDB
+    // batch as the price so that one is never saved without the other
+    void savePrice( const u256& _price, block_id _blockID, const string& _strategyState = "" );
+
+    void stagePrice( BlockCommitBatch& _commit, const u256& _price, block_id _blockID,
+        const string& _strategyState = "" );
+
+    // empty if no state was saved with the price of _blockID
+    string readStrategyState( block_id _blockID );
+
+    bool hasPrice( block_id _blockID );
 };
 
 
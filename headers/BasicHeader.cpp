@@ -27,13 +27,14 @@
 #include "exceptions/InvalidArgumentException.h"
 #include "exceptions/NetworkProtocolException.h"
 #include "network/Buffer.h"
+#include "BinaryHeader.h"
 #include "BasicHeader.h"
 
 bool BasicHeader::isComplete() const {
     return complete;
 }
 
-string BasicHeader::serializeToString() {
+nlohmann::json BasicHeader::toJson() {
     CHECK_STATE( complete )
     nlohmann::json j;
 
@@ -43,7 +44,11 @@ string BasicHeader::serializeToString() {
 
     addFields( j );
 
-    string s( j.dump() );
+    return j;
+}
+
+string BasicHeader::serializeToString() {
+    string s( toJson().dump() );
 
     CHECK_STATE( s.size() > 16 )
 
@@ -66,6 +71,27 @@ ptr< Buffer > BasicHeader::toBuffer() {
     return buf;
 }
 
+ptr< Buffer > BasicHeader::toWireBuffer( bool _binary ) {
+    auto j = toJson();
+
+    string s;
+    uint64_t prefix;
+
+    if ( _binary ) {
+        s = BinaryHeader::encode( j );
+        prefix = s.size() | BinaryHeader::LENGTH_FLAG;
+    } else {
+        j[BinaryHeader::SUPPORT_FIELD] = true;
+        s = j.dump();
+        prefix = s.size();
+    }
+
+    auto buf = make_shared< Buffer >( s.size() + sizeof( prefix ) );
+    buf->write( &prefix, sizeof( prefix ) );
+    buf->write( ( void* ) s.data(), s.size() );
+    return buf;
+}
+
 
 void BasicHeader::nullCheck( nlohmann::json& js, const char* _name ) {
     CHECK_ARGUMENT( _name );
@@ -73,10 +73,17 @@ public:
     static void nullCheck( nlohmann::json& js, const char* _name );
 
 
+    nlohmann::json toJson();
+
     virtual string serializeToString();
 
+    // length prefixed JSON, the form headers are stored in
     ptr< Buffer > toBuffer();
 
+    // length prefixed header to send over TCP, binary if the peer supports it. JSON headers
+    // advertise binary header support to the peer
+    ptr< Buffer > toWireBuffer( bool _binary );
+
     virtual void addFields( nlohmann::json& j ) = 0;
 
     static uint64_t getUint64( nlohmann::json& _js, const char* _name );
@@ -0,0 +1,331 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinaryHeader.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "exceptions/ParsingException.h"
+
+#include "BinaryHeader.h"
+
+
+class BinaryHeader::Reader {
+    const uint8_t* data;
+    uint64_t size;
+    uint64_t position = 0;
+
+public:
+    const vector< const char* >& fields;
+
+    Reader( const uint8_t* _data, uint64_t _size, const vector< const char* >& _fields )
+        : data( _data ), size( _size ), fields( _fields ) {}
+
+    bool atEnd() const { return position == size; }
+
+    uint8_t readByte() {
+        if ( position >= size )
+            BOOST_THROW_EXCEPTION(
+                ParsingException( "Truncated binary header", "BinaryHeader" ) );
+        return data[position++];
+    }
+
+    uint64_t readVarint() {
+        uint64_t result = 0;
+        for ( uint64_t shift = 0; shift < 64; shift += 7 ) {
+            auto byte = readByte();
+            result |= ( uint64_t )( byte & 0x7F ) << shift;
+            if ( ( byte & 0x80 ) == 0 )
+                return result;
+        }
+        BOOST_THROW_EXCEPTION( ParsingException( "Varint too long", "BinaryHeader" ) );
+    }
+
+    // a length that the remaining input can hold, each element takes at least a byte
+    uint64_t readLength() {
+        auto length = readVarint();
+        if ( length > size - position )
+            BOOST_THROW_EXCEPTION(
+                ParsingException( "Invalid length in binary header", "BinaryHeader" ) );
+        return length;
+    }
+
+    const uint8_t* readBytes( uint64_t _count ) {
+        if ( _count > size - position )
+            BOOST_THROW_EXCEPTION(
+                ParsingException( "Truncated binary header", "BinaryHeader" ) );
+        auto result = data + position;
+        position += _count;
+        return result;
+    }
+};
+
+
+const vector< const char* >& BinaryHeader::getFieldTable( uint8_t _version ) {
+    // append only, the index of a name is its code on the wire
+    static const vector< const char* > version1 = { "type", "status", "substatus", "schainID",
+        "blockID", "nodeID", "proposerIndex", "proposerNodeID", "timeStamp", "timeStampMs",
+        "hash", "sig", "sr", "sizes", "count", "blockCount", "blockHash", "blockSize", "compressed",
+        "daSig", "thrSig", "dataFragments", "fragmentSize", "fragmentIndex", "lastBid", "lastTs",
+        "pk", "pks", "sss", "txCount", SUPPORT_FIELD };
+
+    if ( _version != 1 )
+        BOOST_THROW_EXCEPTION( ParsingException(
+            "Unknown binary header version " + to_string( _version ), "BinaryHeader" ) );
+
+    return version1;
+}
+
+
+void BinaryHeader::writeVarint( string& _out, uint64_t _value ) {
+    while ( _value >= 0x80 ) {
+        _out.push_back( ( char ) ( ( _value & 0x7F ) | 0x80 ) );
+        _value >>= 7;
+    }
+    _out.push_back( ( char ) _value );
+}
+
+
+bool BinaryHeader::isLowercaseHex( const string& _s ) {
+    if ( _s.empty() || _s.size() % 2 != 0 )
+        return false;
+    for ( auto c : _s ) {
+        if ( !( ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'f' ) ) )
+            return false;
+    }
+    return true;
+}
+
+
+void BinaryHeader::writeValue( string& _out, const nlohmann::json& _value, uint64_t _depth ) {
+    CHECK_STATE( _depth < MAX_DEPTH );
+
+    switch ( _value.type() ) {
+    case nlohmann::json::value_t::null:
+        _out.push_back( TAG_NULL );
+        break;
+    case nlohmann::json::value_t::boolean:
+        _out.push_back( _value.get< bool >() ? TAG_TRUE : TAG_FALSE );
+        break;
+    case nlohmann::json::value_t::number_unsigned:
+        _out.push_back( TAG_UINT );
+        writeVarint( _out, _value.get< uint64_t >() );
+        break;
+    case nlohmann::json::value_t::number_integer: {
+        auto v = _value.get< int64_t >();
+        if ( v >= 0 ) {
+            _out.push_back( TAG_UINT );
+            writeVarint( _out, ( uint64_t ) v );
+        } else {
+            _out.push_back( TAG_NEGATIVE_INT );
+            writeVarint( _out, ( uint64_t ) ( -( v + 1 ) ) );
+        }
+        break;
+    }
+    case nlohmann::json::value_t::number_float: {
+        auto v = _value.get< double >();
+        _out.push_back( TAG_DOUBLE );
+        _out.append( ( const char* ) &v, sizeof( v ) );
+        break;
+    }
+    case nlohmann::json::value_t::string: {
+        auto& s = _value.get_ref< const string& >();
+        if ( isLowercaseHex( s ) ) {
+            _out.push_back( TAG_HEX_STRING );
+            writeVarint( _out, s.size() / 2 );
+            for ( uint64_t i = 0; i < s.size(); i += 2 ) {
+                auto nibble = []( char c ) { return c <= '9' ? c - '0' : c - 'a' + 10; };
+                _out.push_back( ( char ) ( nibble( s[i] ) << 4 | nibble( s[i + 1] ) ) );
+            }
+        } else {
+            _out.push_back( TAG_STRING );
+            writeVarint( _out, s.size() );
+            _out.append( s );
+        }
+        break;
+    }
+    case nlohmann::json::value_t::array: {
+        bool allUnsigned = true;
+        for ( auto&& item : _value ) {
+            if ( !item.is_number_unsigned() &&
+                 !( item.is_number_integer() && item.get< int64_t >() >= 0 ) ) {
+                allUnsigned = false;
+                break;
+            }
+        }
+        _out.push_back( allUnsigned ? TAG_UINT_ARRAY : TAG_ARRAY );
+        writeVarint( _out, _value.size() );
+        for ( auto&& item : _value ) {
+            if ( allUnsigned )
+                writeVarint( _out, item.get< uint64_t >() );
+            else
+                writeValue( _out, item, _depth + 1 );
+        }
+        break;
+    }
+    case nlohmann::json::value_t::object:
+        _out.push_back( TAG_OBJECT );
+        writeObject( _out, _value, _depth + 1 );
+        break;
+    default:
+        CHECK_STATE2( false, "Unsupported JSON value in header" );
+    }
+}
+
+
+void BinaryHeader::writeObject( string& _out, const nlohmann::json& _object, uint64_t _depth ) {
+    auto& fields = getFieldTable( CURRENT_VERSION );
+
+    writeVarint( _out, _object.size() );
+
+    for ( auto it = _object.begin(); it != _object.end(); it++ ) {
+        const auto& key = it.key();
+        uint64_t code = 0;
+        for ( uint64_t i = 0; i < fields.size(); i++ ) {
+            if ( key == fields[i] ) {
+                code = i + 1;
+                break;
+            }
+        }
+
+        // names missing from the table are sent inline after a 0 code
+        writeVarint( _out, code );
+        if ( code == 0 ) {
+            writeVarint( _out, key.size() );
+            _out.append( key );
+        }
+
+        writeValue( _out, it.value(), _depth );
+    }
+}
+
+
+string BinaryHeader::encode( const nlohmann::json& _header ) {
+    CHECK_ARGUMENT( _header.is_object() );
+
+    string result;
+    result.reserve( 64 );
+    result.push_back( ( char ) CURRENT_VERSION );
+    writeObject( result, _header, 0 );
+    return result;
+}
+
+
+nlohmann::json BinaryHeader::readValue( Reader& _in, uint64_t _depth ) {
+    if ( _depth >= MAX_DEPTH )
+        BOOST_THROW_EXCEPTION( ParsingException( "Binary header too deep", "BinaryHeader" ) );
+
+    switch ( _in.readByte() ) {
+    case TAG_NULL:
+        return nullptr;
+    case TAG_FALSE:
+        return false;
+    case TAG_TRUE:
+        return true;
+    case TAG_UINT:
+        return _in.readVarint();
+    case TAG_NEGATIVE_INT:
+        return -( int64_t ) _in.readVarint() - 1;
+    case TAG_DOUBLE: {
+        double v;
+        memcpy( &v, _in.readBytes( sizeof( v ) ), sizeof( v ) );
+        return v;
+    }
+    case TAG_STRING: {
+        auto length = _in.readLength();
+        return string( ( const char* ) _in.readBytes( length ), length );
+    }
+    case TAG_HEX_STRING: {
+        static const char* digits = "0123456789abcdef";
+        auto length = _in.readLength();
+        auto bytes = _in.readBytes( length );
+        string s( length * 2, '0' );
+        for ( uint64_t i = 0; i < length; i++ ) {
+            s[2 * i] = digits[bytes[i] >> 4];
+            s[2 * i + 1] = digits[bytes[i] & 0x0F];
+        }
+        return s;
+    }
+    case TAG_UINT_ARRAY: {
+        auto count = _in.readLength();
+        nlohmann::json::array_t items;
+        items.reserve( count );
+        for ( uint64_t i = 0; i < count; i++ ) {
+            items.emplace_back( _in.readVarint() );
+        }
+        return items;
+    }
+    case TAG_ARRAY: {
+        auto count = _in.readLength();
+        nlohmann::json::array_t items;
+        items.reserve( count );
+        for ( uint64_t i = 0; i < count; i++ ) {
+            items.push_back( readValue( _in, _depth + 1 ) );
+        }
+        return items;
+    }
+    case TAG_OBJECT:
+        return readObject( _in, _depth + 1 );
+    default:
+        BOOST_THROW_EXCEPTION(
+            ParsingException( "Unknown value tag in binary header", "BinaryHeader" ) );
+    }
+}
+
+
+nlohmann::json BinaryHeader::readObject( Reader& _in, uint64_t _depth ) {
+    auto count = _in.readLength();
+    auto result = nlohmann::json::object();
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        auto code = _in.readVarint();
+        string key;
+        if ( code == 0 ) {
+            auto length = _in.readLength();
+            key.assign( ( const char* ) _in.readBytes( length ), length );
+        } else if ( code <= _in.fields.size() ) {
+            key = _in.fields[code - 1];
+        } else {
+            BOOST_THROW_EXCEPTION(
+                ParsingException( "Unknown field code in binary header", "BinaryHeader" ) );
+        }
+        result[key] = readValue( _in, _depth );
+    }
+
+    return result;
+}
+
+
+nlohmann::json BinaryHeader::decode( const uint8_t* _data, uint64_t _size ) {
+    CHECK_ARGUMENT( _data );
+
+    if ( _size < 2 )
+        BOOST_THROW_EXCEPTION( ParsingException( "Binary header too short", "BinaryHeader" ) );
+
+    Reader in( _data + 1, _size - 1, getFieldTable( _data[0] ) );
+    auto result = readObject( in, 0 );
+
+    if ( !in.atEnd() )
+        BOOST_THROW_EXCEPTION(
+            ParsingException( "Trailing bytes after binary header", "BinaryHeader" ) );
+
+    return result;
+}
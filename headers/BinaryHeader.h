@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinaryHeader.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include "thirdparty/json.hpp"
+
+
+// Compact binary encoding of TCP protocol headers, used instead of JSON text once the peer
+// advertised support for it. It encodes the same fields as the JSON header, so the code that
+// reads headers does not change. Field names known to the protocol are sent as indexes into a
+// versioned field table, integers as varints, integer arrays such as catchup block sizes as
+// packed varints and lowercase hex strings such as hashes as raw bytes.
+class BinaryHeader {
+public:
+    // set in the 8 byte length prefix of a binary header, JSON headers never come close
+    static constexpr uint64_t LENGTH_FLAG = 1ULL << 63;
+
+    // field names advertised in JSON headers to tell the peer binary headers can be sent back
+    static constexpr const char* SUPPORT_FIELD = "binHdr";
+
+    static constexpr uint8_t CURRENT_VERSION = 1;
+
+    static string encode( const nlohmann::json& _header );
+
+    // throws ParsingException on malformed input or an unknown version
+    static nlohmann::json decode( const uint8_t* _data, uint64_t _size );
+
+private:
+    enum Tag : uint8_t {
+        TAG_NULL = 0,
+        TAG_FALSE = 1,
+        TAG_TRUE = 2,
+        TAG_UINT = 3,
+        TAG_NEGATIVE_INT = 4,
+        TAG_STRING = 5,
+        TAG_HEX_STRING = 6,
+        TAG_UINT_ARRAY = 7,
+        TAG_ARRAY = 8,
+        TAG_OBJECT = 9,
+        TAG_DOUBLE = 10
+    };
+
+    static constexpr uint64_t MAX_DEPTH = 8;
+
+    // field names of each version, a new version may only append to the table of the previous
+    static const vector< const char* >& getFieldTable( uint8_t _version );
+
+    class Reader;
+
+    static void writeVarint( string& _out, uint64_t _value );
+
+    static void writeValue( string& _out, const nlohmann::json& _value, uint64_t _depth );
+
+    static void writeObject( string& _out, const nlohmann::json& _object, uint64_t _depth );
+
+    static nlohmann::json readValue( Reader& _in, uint64_t _depth );
+
+    static nlohmann::json readObject( Reader& _in, uint64_t _depth );
+
+    static bool isLowercaseHex( const string& _s );
+};
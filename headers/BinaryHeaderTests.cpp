@@ -0,0 +1,181 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinaryHeaderTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "exceptions/ParsingException.h"
+#include "BinaryHeader.h"
+
+
+static const string HASH = "3f1a6c0b9e7d2f48a5c1e0b7d6f9a2c4e8b1d3f5a7c9e0b2d4f6a8c1e3b5d7f9";
+
+static const string SIG =
+    "1234567890123456789012345678901234567890:9876543210987654321098765432109876543210:"
+    "1:1";
+
+
+static nlohmann::json catchupResponse( uint64_t _blocks ) {
+    nlohmann::json j = { { "type", "BlckCatchupRsp" }, { "status", 3 }, { "substatus", 4 },
+        { "count", _blocks }, { "lastBid", 123456789 }, { "lastTs", 1760000000 },
+        { "compressed", true } };
+    vector< uint64_t > sizes;
+    for ( uint64_t i = 0; i < _blocks; i++ ) {
+        sizes.push_back( 2000 + ( i * 7919 ) % 60000 );
+    }
+    j["sizes"] = sizes;
+    return j;
+}
+
+
+// the fields each header type puts on the wire
+static vector< pair< string, nlohmann::json > > headerSamples() {
+    return {
+        { "BlockProposalRequest",
+            { { "type", "BlckPrpslReq" }, { "schainID", 1 }, { "proposerNodeID", 5 },
+                { "proposerIndex", 3 }, { "blockID", 123456 }, { "txCount", 1500 },
+                { "timeStamp", 1760000000 }, { "timeStampMs", 345 }, { "hash", HASH },
+                { "sig", SIG }, { "sr", HASH }, { "binHdr", true } } },
+        { "BlockProposalResponse",
+            { { "type", "BlckPrpslRsp" }, { "status", 3 }, { "substatus", 4 },
+                { "sss", SIG }, { "sig", SIG } } },
+        { "MissingTransactionsRequest",
+            { { "type", "MsngTxsReq" }, { "status", 3 }, { "substatus", 4 },
+                { "count", 12 } } },
+        { "MissingTransactionsResponse",
+            { { "type", "MsngTxsRsp" }, { "sizes", vector< uint64_t >( 12, 345 ) } } },
+        { "SubmitDAProofRequest",
+            { { "type", "DAPrfReq" }, { "schainID", 1 }, { "proposerNodeID", 5 },
+                { "proposerIndex", 3 }, { "blockID", 123456 }, { "thrSig", SIG },
+                { "hash", HASH } } },
+        { "BlockFinalizeRequest",
+            { { "type", "BlckFinalizeReq" }, { "schainID", 1 }, { "blockID", 123456 },
+                { "proposerIndex", 3 }, { "nodeID", 7 }, { "fragmentIndex", 2 } } },
+        { "BlockFinalizeResponse",
+            { { "type", "BlckFnlzRsp" }, { "status", 3 }, { "substatus", 4 },
+                { "blockSize", 654321 }, { "blockHash", HASH }, { "fragmentSize", 40000 },
+                { "dataFragments", 16 } } },
+        { "CatchupRequest",
+            { { "type", "BlckCatchupReq" }, { "schainID", 1 }, { "blockID", 123456 },
+                { "nodeID", 7 }, { "blockCount", 128 }, { "compressed", true } } },
+        { "CatchupResponse", catchupResponse( 128 ) },
+        { "CatchupResponseLarge", catchupResponse( 4096 ) },
+    };
+}
+
+
+TEST_CASE( "Binary headers round trip", "[binary-header]" ) {
+    for ( auto&& [name, header] : headerSamples() ) {
+        auto encoded = BinaryHeader::encode( header );
+        auto decoded =
+            BinaryHeader::decode( ( const uint8_t* ) encoded.data(), encoded.size() );
+
+        INFO( name );
+        REQUIRE( decoded == header );
+        REQUIRE( encoded.size() < header.dump().size() );
+    }
+}
+
+
+TEST_CASE( "Binary headers keep values outside the fast paths", "[binary-header]" ) {
+    nlohmann::json header = { { "type", "X" }, { "unknownField", "ABCDEF" },
+        { "negative", -5 }, { "minimum", INT64_MIN }, { "maximum", UINT64_MAX },
+        { "float", 1.5 }, { "null", nullptr }, { "mixed", { 1, -1, "a" } },
+        { "nested", { { "inner", { 1, 2, 3 } } } }, { "oddHex", "abc" }, { "empty", "" } };
+
+    auto encoded = BinaryHeader::encode( header );
+    auto decoded = BinaryHeader::decode( ( const uint8_t* ) encoded.data(), encoded.size() );
+
+    REQUIRE( decoded == header );
+    REQUIRE( decoded["oddHex"] == "abc" );
+    REQUIRE( decoded["unknownField"] == "ABCDEF" );
+}
+
+
+TEST_CASE( "Binary headers reject malformed input", "[binary-header]" ) {
+    auto encoded = BinaryHeader::encode( catchupResponse( 16 ) );
+    auto data = ( const uint8_t* ) encoded.data();
+
+    // every truncation fails cleanly
+    for ( uint64_t i = 0; i < encoded.size(); i++ ) {
+        REQUIRE_THROWS_AS( BinaryHeader::decode( data, i ), ParsingException );
+    }
+
+    auto trailing = encoded + "x";
+    REQUIRE_THROWS_AS(
+        BinaryHeader::decode( ( const uint8_t* ) trailing.data(), trailing.size() ),
+        ParsingException );
+
+    auto unknownVersion = encoded;
+    unknownVersion[0] = 99;
+    REQUIRE_THROWS_AS( BinaryHeader::decode( ( const uint8_t* ) unknownVersion.data(),
+                           unknownVersion.size() ),
+        ParsingException );
+
+    // random bytes never crash the decoder
+    mt19937 random( 1 );
+    for ( uint64_t i = 0; i < 10000; i++ ) {
+        auto corrupted = encoded;
+        corrupted[1 + random() % ( corrupted.size() - 1 )] = ( char ) random();
+        try {
+            BinaryHeader::decode( ( const uint8_t* ) corrupted.data(), corrupted.size() );
+        } catch ( ParsingException& ) {
+        }
+    }
+}
+
+
+TEST_CASE( "Binary header benchmark", "[.benchmark]" ) {
+    for ( auto&& [name, header] : headerSamples() ) {
+        uint64_t iterations = header.dump().size() > 10000 ? 1000 : 100000;
+
+        auto start = chrono::steady_clock::now();
+        uint64_t jsonBytes = 0;
+        for ( uint64_t i = 0; i < iterations; i++ ) {
+            auto s = header.dump();
+            jsonBytes = s.size();
+            auto parsed = nlohmann::json::parse( s );
+            REQUIRE( parsed.size() == header.size() );
+        }
+        auto jsonNs = chrono::duration_cast< chrono::nanoseconds >(
+            chrono::steady_clock::now() - start )
+                          .count();
+
+        start = chrono::steady_clock::now();
+        uint64_t binaryBytes = 0;
+        for ( uint64_t i = 0; i < iterations; i++ ) {
+            auto s = BinaryHeader::encode( header );
+            binaryBytes = s.size();
+            auto parsed = BinaryHeader::decode( ( const uint8_t* ) s.data(), s.size() );
+            REQUIRE( parsed.size() == header.size() );
+        }
+        auto binaryNs = chrono::duration_cast< chrono::nanoseconds >(
+            chrono::steady_clock::now() - start )
+                            .count();
+
+        WARN( name << ": JSON " << jsonBytes << " bytes " << jsonNs / iterations
+              << " ns, binary " << binaryBytes << " bytes " << binaryNs / iterations << " ns" );
+    }
+}
@@ -46,15 +46,18 @@ using namespace std;
 
 
 BlockFinalizeRequestHeader::BlockFinalizeRequestHeader( Schain& _sChain, block_id _blockID,
-    schain_index _proposerIndex, node_id _nodeID, fragment_index _fragmentIndex )
+    schain_index _proposerIndex, node_id _nodeID, fragment_index _fragmentIndex,
+    uint64_t _dataFragments )
     : AbstractBlockRequestHeader( _sChain.getNodeCount(), _sChain.getSchainID(), _blockID,
           Header::BLOCK_FINALIZE_REQ, _proposerIndex ) {
     CHECK_ARGUMENT( _fragmentIndex > 0 );
 
     CHECK_ARGUMENT( ( uint64_t ) _fragmentIndex <= _sChain.getNodeCount() - 1 )
+    CHECK_ARGUMENT( _dataFragments <= _sChain.getNodeCount() - 1 )
 
     this->fragmentIndex = _fragmentIndex;
     this->nodeID = _nodeID;
+    this->dataFragments = _dataFragments;
 
 
     complete = true;
@@ -65,6 +68,9 @@ void BlockFinalizeRequestHeader::addFields( nlohmann::basic_json<>& jsonRequest
 
     jsonRequest["fragmentIndex"] = ( uint64_t ) fragmentIndex;
     jsonRequest["nodeID"] = ( uint64_t ) nodeID;
+
+    if ( dataFragments > 0 )
+        jsonRequest["dataFragments"] = dataFragments;
 }
 
 const node_id& BlockFinalizeRequestHeader::getNodeId() const {
@@ -28,11 +28,13 @@
 class BlockFinalizeRequestHeader : public AbstractBlockRequestHeader {
     fragment_index fragmentIndex;
     node_id nodeID;
+    // non zero if the fragment is requested Reed-Solomon coded
+    uint64_t dataFragments = 0;
 
 
 public:
     BlockFinalizeRequestHeader( Schain& _sChain, block_id _blockID, schain_index _proposerIndex,
-        node_id _nodeID, fragment_index _fragmentIndex );
+        node_id _nodeID, fragment_index _fragmentIndex, uint64_t _dataFragments = 0 );
 
 
     void addFields( nlohmann::basic_json<>& jsonRequest ) override;
@@ -48,6 +48,14 @@ void BlockFinalizeResponseHeader::addFields( nlohmann::json& _j ) {
     if ( !daProofSig.empty() ) {
         _j["daSig"] = daProofSig;
     }
+
+    if ( dataFragments > 0 ) {
+        _j["dataFragments"] = dataFragments;
+    }
+}
+
+void BlockFinalizeResponseHeader::setDataFragments( uint64_t _dataFragments ) {
+    dataFragments = _dataFragments;
 }
 
 void BlockFinalizeResponseHeader::setFragmentParams(
@@ -30,12 +30,15 @@ class BlockFinalizeResponseHeader : public Header {
     uint64_t blockSize = 0;
     string blockHash = "";
     string daProofSig = "";
+    uint64_t dataFragments = 0;
 
 
 public:
     void setFragmentParams( uint64_t _fragmentSize, uint64_t _blockSize, const string& _hash,
         const string& _daProofSig );
 
+    void setDataFragments( uint64_t _dataFragments );
+
 
     BlockFinalizeResponseHeader();
 
@@ -51,12 +51,24 @@ CatchupRequestHeader::CatchupRequestHeader( Schain& _sChain, schain_index _dstIn
     complete = true;
 }
 
+CatchupRequestHeader::CatchupRequestHeader(
+    Schain& _sChain, schain_index _dstIndex, block_id _blockID, uint64_t _blockCount )
+    : CatchupRequestHeader( _sChain, _dstIndex ) {
+    this->blockID = _blockID;
+    this->blockCount = _blockCount;
+    this->compressed = true;
+}
+
 void CatchupRequestHeader::addFields( nlohmann::json& _j ) {
     Header::addFields( _j );
 
     _j["schainID"] = ( uint64_t ) schainID;
     _j["blockID"] = ( uint64_t ) blockID;
     _j["nodeID"] = ( uint64_t ) nodeID;
+    if ( blockCount > 0 )
+        _j["blockCount"] = blockCount;
+    if ( compressed )
+        _j["compressed"] = true;
 }
 
 const node_id& CatchupRequestHeader::getNodeId() const {
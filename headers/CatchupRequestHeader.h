@@ -33,12 +33,19 @@ class CatchupRequestHeader : public Header {
     schain_id schainID;
     block_id blockID;
     node_id nodeID;
+    // at most this many blocks after blockID, 0 means as many as the server sends
+    uint64_t blockCount = 0;
+    // the client accepts blocks in the BlockCompression format
+    bool compressed = false;
 
 public:
     CatchupRequestHeader();
 
     CatchupRequestHeader( Schain& _sChain, schain_index _dstIndex );
 
+    CatchupRequestHeader(
+        Schain& _sChain, schain_index _dstIndex, block_id _blockID, uint64_t _blockCount );
+
     void addFields( nlohmann::basic_json<>& j ) override;
 
     [[nodiscard]] const node_id& getNodeId() const;
@@ -48,6 +48,10 @@ void CatchupResponseHeader::setBlockSizesAndLatestBlockInfo(
     complete = true;
 }
 
+void CatchupResponseHeader::setCompressed(bool _compressed) {
+    compressed = _compressed;
+}
+
 void CatchupResponseHeader::addFields(nlohmann::json &_j) {
     Header::addFields(_j);
 
@@ -58,4 +62,7 @@ void CatchupResponseHeader::addFields(nlohmann::json &_j) {
 
     if (blockSizes != nullptr)
         _j["sizes"] = *blockSizes;
+
+    if (compressed)
+        _j["compressed"] = true;
 }
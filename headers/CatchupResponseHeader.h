@@ -39,6 +39,8 @@ public:
     void setBlockSizesAndLatestBlockInfo( const ptr< list< uint64_t > >& _blockSizes,
         block_id _lastCommittedBlockId, uint64_t _lastCommittedBlockTimestampS );
 
+    void setCompressed( bool _compressed );
+
     void addFields( nlohmann::basic_json<>& j_ ) override;
 
 private:
@@ -49,4 +51,7 @@ private:
     uint64_t lastCommittedBlockId = 0;
     uint64_t lastCommittedBlockTimestampS = 0;
 
+    // blocks are sent in the BlockCompression format, only if the client asked for it
+    bool compressed = false;
+
 };
@@ -46,9 +46,9 @@ MissingTransactionsRequestHeader::MissingTransactionsRequestHeader()
 
 
 MissingTransactionsRequestHeader::MissingTransactionsRequestHeader(
-    const ptr< map< uint64_t, ptr< partial_sha_hash > > >& _missingMessages )
+    uint64_t _missingTransactionsCount )
     : MissingTransactionsRequestHeader() {
-    this->missingTransactionsCount = _missingMessages->size();
+    this->missingTransactionsCount = _missingTransactionsCount;
     complete = true;
 }
 
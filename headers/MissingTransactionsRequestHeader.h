@@ -35,8 +35,7 @@ class MissingTransactionsRequestHeader : public Header {
 public:
     MissingTransactionsRequestHeader();
 
-    explicit MissingTransactionsRequestHeader(
-        const ptr< map< uint64_t, ptr< partial_sha_hash > > >& _missingMessages );
+    explicit MissingTransactionsRequestHeader( uint64_t _missingTransactionsCount );
 
     void addFields( nlohmann::basic_json<>& j_ ) override;
 
@@ -141,7 +141,13 @@ ptr< Node > JSONFactory::createNodeFromJsonObject( const nlohmann::json& _j,
         CHECK_STATE( JSONFactory::splitString( _blsKeyName )->size() == 7 );
     }
 
-    Network::setTransport( TransportType::ZMQ );
+    // in-memory broadcast channel for many nodes in one process, used in benchmarks
+    if ( _j.find( "transport" ) != _j.end() &&
+         _j.at( "transport" ).get< string >() == "simulated" ) {
+        Network::setTransport( TransportType::SIMULATED );
+    } else {
+        Network::setTransport( TransportType::ZMQ );
+    }
 
     if ( _j.find( "logLevelConfig" ) != _j.end() ) {
         string logLevel( _j.at( "logLevelConfig" ).get< string >() );
@@ -0,0 +1,118 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AdaptiveProposalTimeout.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "AdaptiveProposalTimeout.h"
+
+
+void AdaptiveProposalTimeout::addSample(
+    deque< uint64_t >& _window, uint64_t _latencyMs, uint64_t _maxSize ) {
+    _window.push_back( _latencyMs );
+    while ( _window.size() > _maxSize ) {
+        _window.pop_front();
+    }
+}
+
+
+uint64_t AdaptiveProposalTimeout::getPercentile(
+    const deque< uint64_t >& _window, uint64_t _percentile ) {
+    CHECK_ARGUMENT( !_window.empty() );
+    CHECK_ARGUMENT( _percentile <= 100 );
+
+    vector< uint64_t > sorted( _window.begin(), _window.end() );
+    auto index = ( sorted.size() - 1 ) * _percentile / 100;
+    nth_element( sorted.begin(), sorted.begin() + index, sorted.end() );
+    return sorted[index];
+}
+
+
+void AdaptiveProposalTimeout::proofArrived(
+    block_id _blockID, uint64_t _proposerIndex, uint64_t _latencyMs ) {
+    LOCK( m )
+
+    if ( _blockID < currentBlockID )
+        return;
+
+    if ( _blockID > currentBlockID ) {
+        currentBlockID = _blockID;
+        arrivedProposers.clear();
+    }
+
+    // a DA proof can be delivered more than once
+    if ( !arrivedProposers.insert( _proposerIndex ).second )
+        return;
+
+    addSample( proposerLatencies[_proposerIndex], _latencyMs, PROPOSAL_ARRIVAL_WINDOW );
+    // enough for a full window from every node of a large chain
+    addSample( allLatencies, _latencyMs, PROPOSAL_ARRIVAL_WINDOW * 16 );
+}
+
+
+uint64_t AdaptiveProposalTimeout::getExpectedLatencyMs( uint64_t _proposerIndex ) {
+    auto it = proposerLatencies.find( _proposerIndex );
+
+    // proposers that rarely get DA proofs, for example nodes that are catching up, are expected
+    // as late as the slowest proposals of the chain
+    if ( it != proposerLatencies.end() && it->second.size() >= PROPOSAL_ARRIVAL_MIN_SAMPLES )
+        return getPercentile( it->second, PROPOSAL_ARRIVAL_PERCENTILE ) *
+               PROPOSAL_ARRIVAL_TIMEOUT_FACTOR;
+
+    if ( allLatencies.size() >= PROPOSAL_ARRIVAL_MIN_SAMPLES )
+        return getPercentile( allLatencies, PROPOSAL_ARRIVAL_PERCENTILE ) *
+               PROPOSAL_ARRIVAL_TIMEOUT_FACTOR;
+
+    return 0;
+}
+
+
+uint64_t AdaptiveProposalTimeout::getTimeoutMs(
+    block_id _blockID, uint64_t _nodeCount, const set< uint64_t >& _deadProposers ) {
+    LOCK( m )
+
+    // without a single DA proof consensus can only decide an empty block, so a block that is
+    // late as a whole, for example under load, gets the full wait
+    if ( _blockID != currentBlockID || arrivedProposers.empty() )
+        return BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS;
+
+    uint64_t timeout = PROPOSAL_RECEIPT_MIN_TIMEOUT_MS;
+
+    for ( uint64_t i = 1; i <= _nodeCount; i++ ) {
+        if ( arrivedProposers.count( i ) > 0 )
+            continue;
+
+        if ( _deadProposers.count( i ) > 0 )
+            continue;
+
+        auto expected = getExpectedLatencyMs( i );
+
+        // nothing learned yet
+        if ( expected == 0 )
+            return BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS;
+
+        timeout = max( timeout, expected );
+    }
+
+    return min( timeout, BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS );
+}
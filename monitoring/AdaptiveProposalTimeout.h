@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AdaptiveProposalTimeout.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Learns how long after the start of a block the DA proofs of each proposer arrive, and decides
+// when the proposal receipt timeout fires for the current block. Consensus starts by itself
+// once 2/3 N + 1 DA proofs are in, so the timeout only matters when fewer arrive. It waits for
+// each missing live proposer until its DA proof is later than a high percentile of its recent
+// ones, and does not wait for dead nodes.
+//
+// The estimates follow the latencies of the last blocks, so when load slows the chain down the
+// timeout grows with it, and a live proposer is only cut off when its DA proof is more than
+// twice as late as any of its recent ones. A block without any DA proof yet always gets the
+// fixed timeout, so an early start never produces an empty block that waiting could avoid.
+class AdaptiveProposalTimeout {
+    recursive_mutex m;
+
+    // recent arrival latencies, oldest first
+    map< uint64_t, deque< uint64_t > > proposerLatencies;
+    deque< uint64_t > allLatencies;
+
+    block_id currentBlockID = 0;
+    set< uint64_t > arrivedProposers;
+
+    static void addSample( deque< uint64_t >& _window, uint64_t _latencyMs, uint64_t _maxSize );
+
+    static uint64_t getPercentile( const deque< uint64_t >& _window, uint64_t _percentile );
+
+    // the latest a DA proof from the proposer is expected, 0 if not known
+    uint64_t getExpectedLatencyMs( uint64_t _proposerIndex );
+
+public:
+    // a DA proof of _proposerIndex for _blockID arrived _latencyMs after the block started
+    void proofArrived( block_id _blockID, uint64_t _proposerIndex, uint64_t _latencyMs );
+
+    // time from the block start after which consensus for _blockID starts with the proposals
+    // received so far. _deadProposers holds the indexes of nodes known to be down
+    uint64_t getTimeoutMs(
+        block_id _blockID, uint64_t _nodeCount, const set< uint64_t >& _deadProposers );
+};
@@ -0,0 +1,171 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AdaptiveProposalTimeoutTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "AdaptiveProposalTimeout.h"
+
+
+static const uint64_t NODES = 16;
+
+
+// every node proposes block _blockID with latencies from _latencyMs, except _skip
+static void runBlock( AdaptiveProposalTimeout& _timeout, uint64_t _blockID,
+    const function< uint64_t( uint64_t ) >& _latencyMs, const set< uint64_t >& _skip = {} ) {
+    for ( uint64_t i = 1; i <= NODES; i++ ) {
+        if ( _skip.count( i ) == 0 )
+            _timeout.proofArrived( _blockID, i, _latencyMs( i ) );
+    }
+}
+
+
+TEST_CASE( "Proposal timeout uses the fixed timeout until it learns", "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+
+    REQUIRE( timeout.getTimeoutMs( 1, NODES, {} ) == BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS );
+
+    // one block gives a full chain wide sample, so only the proposers missing from it are
+    // estimated from the chain
+    runBlock( timeout, 1, []( uint64_t ) { return 100; } );
+
+    // all proposals of the current block are in
+    REQUIRE( timeout.getTimeoutMs( 1, NODES, {} ) == PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+
+    timeout.proofArrived( 2, 1, 100 );
+    REQUIRE( timeout.getTimeoutMs( 2, NODES, {} ) == PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+}
+
+
+TEST_CASE( "Proposal timeout follows the slowest live proposer", "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+
+    // node 16 is regularly slow
+    for ( uint64_t b = 1; b <= 100; b++ ) {
+        runBlock(
+            timeout, b, [b]( uint64_t i ) { return i == NODES ? 1000 + b % 10 : 300 + i; } );
+    }
+
+    set< uint64_t > missing;
+    for ( uint64_t i = 1; i <= NODES; i++ ) {
+        missing.insert( i );
+    }
+
+    SECTION( "waits for the slow node while it is missing" ) {
+        runBlock( timeout, 101, []( uint64_t ) { return 150; }, { NODES } );
+        REQUIRE( timeout.getTimeoutMs( 101, NODES, {} ) == 1009 * 2 );
+    }
+
+    SECTION( "stops waiting once the slow node arrived" ) {
+        runBlock( timeout, 101, []( uint64_t ) { return 150; }, { 1 } );
+        REQUIRE( timeout.getTimeoutMs( 101, NODES, {} ) == 301 * 2 );
+        REQUIRE( timeout.getTimeoutMs( 101, NODES, {} ) < PROPOSAL_RECEIPT_MIN_TIMEOUT_MS * 2 );
+    }
+
+    SECTION( "does not wait for dead nodes" ) {
+        runBlock( timeout, 101, []( uint64_t ) { return 150; }, { 1, NODES } );
+        REQUIRE( timeout.getTimeoutMs( 101, NODES, { NODES } ) == 301 * 2 );
+        REQUIRE( timeout.getTimeoutMs( 101, NODES, { 1, NODES } ) ==
+                 PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+    }
+
+    SECTION( "never exceeds the fixed timeout" ) {
+        for ( uint64_t b = 101; b <= 200; b++ ) {
+            runBlock( timeout, b, []( uint64_t i ) { return i == NODES ? 60000 : 100; } );
+        }
+        REQUIRE( timeout.getTimeoutMs( 201, NODES, {} ) == BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS );
+    }
+}
+
+
+TEST_CASE( "Proposal timeout ignores stale and repeated proofs", "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+
+    for ( uint64_t b = 1; b <= 20; b++ ) {
+        runBlock( timeout, b, []( uint64_t ) { return 100; } );
+    }
+
+    // a repeated proof and a proof of an old block do not move the estimate
+    timeout.proofArrived( 20, 1, 20000 );
+    timeout.proofArrived( 5, 2, 20000 );
+    timeout.proofArrived( 21, 3, 100 );
+
+    REQUIRE( timeout.getTimeoutMs( 21, NODES, {} ) == PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+}
+
+
+TEST_CASE( "Proposal timeout waits in full for a block without proofs", "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+
+    for ( uint64_t b = 1; b <= 20; b++ ) {
+        runBlock( timeout, b, []( uint64_t ) { return 100; } );
+    }
+
+    REQUIRE( timeout.getTimeoutMs( 21, NODES, {} ) == BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS );
+
+    timeout.proofArrived( 21, 1, 100 );
+    REQUIRE( timeout.getTimeoutMs( 21, NODES, {} ) == PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+}
+
+
+// six of sixteen nodes are down, so only ten DA proofs arrive, fewer than the eleven that
+// start consensus by themselves, and every block runs into the receipt timeout
+TEST_CASE( "Proposal timeout does not wait for dead nodes below 2/3 N + 1", "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+    set< uint64_t > dead = { 2, 5, 7, 11, 13, 16 };
+
+    REQUIRE( NODES - dead.size() < 2 * NODES / 3 + 1 );
+
+    for ( uint64_t b = 1; b <= 200; b++ ) {
+        runBlock(
+            timeout, b, [b]( uint64_t i ) { return 100 + ( b * 37 + i * 101 ) % 100; }, dead );
+        if ( b > PROPOSAL_ARRIVAL_MIN_SAMPLES )
+            REQUIRE( timeout.getTimeoutMs( b, NODES, dead ) == PROPOSAL_RECEIPT_MIN_TIMEOUT_MS );
+    }
+}
+
+
+// the chain slows down fourfold over a hundred blocks, and four live proposers arrive after the
+// others. Consensus must not start before them
+TEST_CASE( "Proposal timeout keeps waiting for live proposers under growing load",
+    "[proposal-timeout]" ) {
+    AdaptiveProposalTimeout timeout;
+    set< uint64_t > late = { 3, 8, 12, 15 };
+
+    for ( uint64_t b = 1; b <= 200; b++ ) {
+        auto baseMs = 100 + 3 * min< uint64_t >( b, 100 );
+        auto latency = [baseMs, &late](
+                           uint64_t i ) { return late.count( i ) > 0 ? baseMs * 2 : baseMs; };
+
+        runBlock( timeout, b, latency, late );
+
+        if ( b > PROPOSAL_ARRIVAL_MIN_SAMPLES )
+            REQUIRE( timeout.getTimeoutMs( b, NODES, {} ) > baseMs * 2 );
+
+        for ( auto i : late ) {
+            timeout.proofArrived( b, i, latency( i ) );
+        }
+    }
+}
@@ -22,53 +22,135 @@
 */
 #include "SkaleCommon.h"
 #include "Log.h"
-#include "thirdparty/json.hpp"
 
+#include "Agent.h"
 #include "utils/Time.h"
-#include "chains/Schain.h"
-#include "node/Node.h"
 #include "LivelinessMonitor.h"
 
 
-LivelinessMonitor::LivelinessMonitor( const ptr< MonitoringAgent >& _agent, const string& _class,
-    const string& _function, uint64_t _maxTime )
-    : cl( _class ), function( _function ), agent( _agent ) {
+recursive_mutex LivelinessMonitor::threadsMutex;
+
+set< ptr< LivelinessMonitor::ThreadSlots > > LivelinessMonitor::threads;
+
+
+LivelinessMonitor::ThreadSlots& LivelinessMonitor::getThreadSlots() {
+    // registered on the first monitored scope of a thread, removed when the thread exits.
+    // The agent keeps a reference while it scans, so the slots outlive a racing exit
+    struct Registration {
+        ptr< ThreadSlots > slots = make_shared< ThreadSlots >();
+
+        Registration() {
+            slots->threadId = pthread_self();
+            LOCK( threadsMutex )
+            threads.insert( slots );
+        }
+
+        ~Registration() {
+            LOCK( threadsMutex )
+            threads.erase( slots );
+        }
+    };
+
+    // a trivially initialized pointer keeps the common path free of TLS init checks
+    static thread_local ThreadSlots* current = nullptr;
+
+    if ( !current ) {
+        static thread_local Registration registration;
+        current = registration.slots.get();
+    }
+
+    return *current;
+}
+
+
+void LivelinessMonitor::writeSlot( Slot& _slot, MonitoringAgent* _agent,
+    const char* _prettyFunction, const char* _function, uint64_t _startTime,
+    uint64_t _expiryTime ) {
+    // only the owning thread writes, so the sequence needs no read-modify-write
+    auto sequence = _slot.sequence.load( memory_order_relaxed );
+    _slot.sequence.store( sequence + 1, memory_order_relaxed );
+    atomic_thread_fence( memory_order_release );
+    _slot.agent.store( _agent, memory_order_relaxed );
+    _slot.prettyFunction.store( _prettyFunction, memory_order_relaxed );
+    _slot.function.store( _function, memory_order_relaxed );
+    _slot.startTime.store( _startTime, memory_order_relaxed );
+    _slot.expiryTime.store( _expiryTime, memory_order_relaxed );
+    _slot.sequence.store( sequence + 2, memory_order_release );
+}
+
+
+LivelinessMonitor::LivelinessMonitor( MonitoringAgent* _agent, const char* _prettyFunction,
+    const char* _function, uint64_t _maxTime ) {
     CHECK_ARGUMENT( _agent );
+    CHECK_ARGUMENT( _prettyFunction );
+    CHECK_ARGUMENT( _function );
 
-    startTime = Time::getCurrentTimeMs();
-    expiryTime = startTime + _maxTime;
-    threadId = pthread_self();
-    id = counter++;
+    threadSlots = &getThreadSlots();
+
+    // scopes nested deeper than the slots are not monitored
+    if ( threadSlots->depth < MAX_DEPTH ) {
+        slot = &threadSlots->slots[threadSlots->depth];
+        auto startTime = Time::getCoarseTimeMs();
+        writeSlot( *slot, _agent, _prettyFunction, _function, startTime, startTime + _maxTime );
+    }
+
+    threadSlots->depth++;
 }
 
+
 LivelinessMonitor::~LivelinessMonitor() {
-    auto pointer = agent.lock();
-    if ( pointer ) {
-        pointer->unregisterMonitor( this->getId() );
+    if ( slot ) {
+        writeSlot( *slot, nullptr, nullptr, nullptr, 0, 0 );
     }
+
+    threadSlots->depth--;
 }
 
-string LivelinessMonitor::toString() {
-    auto pointer = agent.lock();
-    if ( pointer ) {
-        return "Node:" + to_string( pointer->getSchain()->getNode()->getNodeID() ) +
-               ":Thread:" + to_string( ( uint64_t ) threadId ) + ":" + cl + string( "::" ) +
-               function;
-    } else {
-        return "";
+
+vector< LivelinessMonitor::Record > LivelinessMonitor::getActiveScopes(
+    const MonitoringAgent* _agent ) {
+    vector< ptr< ThreadSlots > > threadsCopy;
+
+    {
+        LOCK( threadsMutex )
+        threadsCopy.assign( threads.begin(), threads.end() );
     }
-}
 
-uint64_t LivelinessMonitor::getExpiryTime() const {
-    return expiryTime;
-}
+    vector< Record > result;
+
+    for ( auto&& threadSlots : threadsCopy ) {
+        for ( auto&& slot : threadSlots->slots ) {
+            Record record;
+            const MonitoringAgent* agent;
+            uint64_t before, after;
+
+            do {
+                before = slot.sequence.load( memory_order_acquire );
+                agent = slot.agent.load( memory_order_relaxed );
+                record.prettyFunction = slot.prettyFunction.load( memory_order_relaxed );
+                record.function = slot.function.load( memory_order_relaxed );
+                record.startTime = slot.startTime.load( memory_order_relaxed );
+                record.expiryTime = slot.expiryTime.load( memory_order_relaxed );
+                atomic_thread_fence( memory_order_acquire );
+                after = slot.sequence.load( memory_order_relaxed );
+            } while ( before != after || ( before & 1 ) );
+
+            if ( record.expiryTime == 0 || agent != _agent )
+                continue;
+
+            record.threadId = threadSlots->threadId;
+            result.push_back( record );
+        }
+    }
 
-uint64_t LivelinessMonitor::getStartTime() const {
-    return startTime;
+    return result;
 }
 
-atomic< uint64_t > LivelinessMonitor::counter = 0;
 
-uint64_t LivelinessMonitor::getId() const {
-    return id;
+string LivelinessMonitor::toString( const Record& _record, node_id _nodeId ) {
+    CHECK_ARGUMENT( _record.prettyFunction );
+    CHECK_ARGUMENT( _record.function );
+    return "Node:" + to_string( _nodeId ) +
+           ":Thread:" + to_string( ( uint64_t ) _record.threadId ) + ":" +
+           className( _record.prettyFunction ) + string( "::" ) + _record.function;
 }
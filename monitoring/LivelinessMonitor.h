@@ -26,40 +26,78 @@
 
 
 #include "MonitoringAgent.h"
-#define MONITOR2( _C_, _F_, _T_ )                                                             \
-    auto __L__ =                                                                              \
-        make_shared< LivelinessMonitor >( getSchain()->getMonitoringAgent(), _C_, _F_, _T_ ); \
-    getSchain()->getMonitoringAgent()->registerMonitor( __L__ );
 
-#define MONITOR( _C_, _F_ )                                                                    \
-    auto __L__ =                                                                               \
-        make_shared< LivelinessMonitor >( getSchain()->getMonitoringAgent(), _C_, _F_, 2000 ); \
-    getSchain()->getMonitoringAgent()->registerMonitor( __L__ );
+// The class argument is kept for existing call sites, the class name is taken from
+// __PRETTY_FUNCTION__ only when a stuck scope is reported. _F_ must be a string with static
+// storage, such as __FUNCTION__
+#define MONITOR2( _C_, _F_, _T_ )                                                 \
+    LivelinessMonitor __L__(                                                      \
+        getSchain()->getMonitoringAgent().get(), __PRETTY_FUNCTION__, _F_, _T_ );
 
+#define MONITOR( _C_, _F_ ) MONITOR2( _C_, _F_, 2000 )
 
+
+// A monitored scope. Each thread has a fixed array of slots, one per nesting level, that
+// the scope writes on entry and clears on exit without locks or allocation. The monitoring
+// agent scans the slots of all threads for scopes that are past their expiry time.
 class LivelinessMonitor {
-    string cl;
-    string function;
-    pthread_t threadId = 0;
-    uint64_t id = 0;
-    uint64_t startTime = 0;
-    uint64_t expiryTime = 0;
-    static atomic< uint64_t > counter;
-    weak_ptr< MonitoringAgent > agent;
+public:
+    static constexpr uint64_t MAX_DEPTH = 16;
+
+    // a copy of a slot taken by the monitoring agent
+    struct Record {
+        pthread_t threadId = 0;
+        const char* prettyFunction = nullptr;
+        const char* function = nullptr;
+        uint64_t startTime = 0;
+        uint64_t expiryTime = 0;
+    };
+
+private:
+    struct Slot {
+        // odd while the owning thread writes the slot
+        atomic< uint64_t > sequence = 0;
+        atomic< MonitoringAgent* > agent = nullptr;
+        atomic< const char* > prettyFunction = nullptr;
+        atomic< const char* > function = nullptr;
+        atomic< uint64_t > startTime = 0;
+        // 0 if the slot is not in use
+        atomic< uint64_t > expiryTime = 0;
+    };
+
+    struct ThreadSlots {
+        pthread_t threadId = 0;
+        uint64_t depth = 0;
+        Slot slots[MAX_DEPTH];
+    };
+
+    static ThreadSlots& getThreadSlots();
+
+    static recursive_mutex threadsMutex;
+
+    static set< ptr< ThreadSlots > > threads;  // tsafe
+
+    static void writeSlot( Slot& _slot, MonitoringAgent* _agent, const char* _prettyFunction,
+        const char* _function, uint64_t _startTime, uint64_t _expiryTime );
+
+    ThreadSlots* threadSlots = nullptr;
+
+    Slot* slot = nullptr;
 
 public:
-    [[nodiscard]] uint64_t getId() const;
+    LivelinessMonitor( MonitoringAgent* _agent, const char* _prettyFunction,
+        const char* _function, uint64_t _maxTime );
 
-    [[nodiscard]] uint64_t getStartTime() const;
+    ~LivelinessMonitor();
 
-    [[nodiscard]] uint64_t getExpiryTime() const;
+    LivelinessMonitor( const LivelinessMonitor& ) = delete;
 
-    string toString();
+    LivelinessMonitor& operator=( const LivelinessMonitor& ) = delete;
 
-    virtual ~LivelinessMonitor();
+    // scopes of _agent that were entered before the call and have not exited
+    static vector< Record > getActiveScopes( const MonitoringAgent* _agent );
 
-    LivelinessMonitor( const ptr< MonitoringAgent >& _agent, const string& _class,
-        const string& _function, uint64_t _maxTime );
+    static string toString( const Record& _record, node_id _nodeId );
 };
 
 
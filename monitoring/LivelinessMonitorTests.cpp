@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file LivelinessMonitorTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "Agent.h"
+#include "utils/Time.h"
+#include "LivelinessMonitor.h"
+
+
+// the agent is only compared, never used
+static MonitoringAgent* testAgent( uint64_t _index ) {
+    static uint64_t storage[2];
+    return reinterpret_cast< MonitoringAgent* >( &storage[_index] );
+}
+
+
+TEST_CASE( "Liveliness monitor sees active scopes", "[liveliness-monitor]" ) {
+    REQUIRE( LivelinessMonitor::getActiveScopes( testAgent( 0 ) ).empty() );
+
+    atomic< bool > entered = false;
+    atomic< bool > release = false;
+
+    thread stuck( [&]() {
+        LivelinessMonitor outer( testAgent( 0 ), __PRETTY_FUNCTION__, "outer", 0 );
+        {
+            LivelinessMonitor inner( testAgent( 0 ), __PRETTY_FUNCTION__, "inner", 100000 );
+            LivelinessMonitor other( testAgent( 1 ), __PRETTY_FUNCTION__, "other", 0 );
+            entered = true;
+            while ( !release ) {
+                usleep( 1000 );
+            }
+        }
+        REQUIRE( LivelinessMonitor::getActiveScopes( testAgent( 0 ) ).size() == 1 );
+    } );
+
+    while ( !entered ) {
+        usleep( 1000 );
+    }
+
+    auto scopes = LivelinessMonitor::getActiveScopes( testAgent( 0 ) );
+    REQUIRE( scopes.size() == 2 );
+    REQUIRE( string( scopes[0].function ) == "outer" );
+    REQUIRE( scopes[0].expiryTime == scopes[0].startTime );
+    REQUIRE( string( scopes[1].function ) == "inner" );
+    REQUIRE( scopes[1].expiryTime == scopes[1].startTime + 100000 );
+    REQUIRE( LivelinessMonitor::toString( scopes[0], node_id( 7 ) ).find( "Node:7:Thread:" ) == 0 );
+
+    REQUIRE( LivelinessMonitor::getActiveScopes( testAgent( 1 ) ).size() == 1 );
+
+    release = true;
+    stuck.join();
+
+    REQUIRE( LivelinessMonitor::getActiveScopes( testAgent( 0 ) ).empty() );
+    REQUIRE( LivelinessMonitor::getActiveScopes( testAgent( 1 ) ).empty() );
+}
+
+
+TEST_CASE( "Liveliness monitor scope cost", "[.benchmark]" ) {
+    const uint64_t iterations = 1000000;
+
+    // what a scope cost before, a heap allocated monitor registered in a locked map
+    map< uint64_t, weak_ptr< vector< uint64_t > > > monitors;
+    recursive_mutex monitorsMutex;
+
+    auto begin = chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < iterations; i++ ) {
+        auto monitor = make_shared< vector< uint64_t > >( 4, Time::getCurrentTimeMs() );
+        {
+            LOCK( monitorsMutex )
+            monitors[i] = monitor;
+        }
+        LOCK( monitorsMutex )
+        monitors.erase( i );
+    }
+    auto mapNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - begin )
+            .count();
+
+    begin = chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < iterations; i++ ) {
+        LivelinessMonitor monitor( testAgent( 0 ), __PRETTY_FUNCTION__, __FUNCTION__, 2000 );
+    }
+    auto slotNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - begin )
+            .count();
+
+    WARN( "Monitored scope ns, allocated and registered:" << mapNs / iterations
+          << " thread slot:" << slotNs / iterations );
+}
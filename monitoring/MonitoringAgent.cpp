@@ -30,7 +30,6 @@
 
 #include "LivelinessMonitor.h"
 #include "MonitoringAgent.h"
-#include "MonitoringThreadPool.h"
 #include "chains/Schain.h"
 #include "node/Node.h"
 #include "utils/Time.h"
@@ -42,8 +41,8 @@ MonitoringAgent::MonitoringAgent( Schain& _sChain ) : Agent( _sChain, false, tru
         logThreadLocal_ = _sChain.getNode()->getLog();
         this->sChain = &_sChain;
 
-        this->monitoringThreadPool = make_shared< MonitoringThreadPool >( 1, this );
-        monitoringThreadPool->startService();
+        monitoringTimer = WorkStealingExecutor::getInstance().schedulePeriodic(
+            _sChain.getNode()->getMonitoringIntervalMs(), [this]() { monitoringTick(); } );
 
     } catch ( ... ) {
         throw_with_nested( FatalError( __FUNCTION__, __CLASS_NAME__ ) );
@@ -55,79 +54,46 @@ void MonitoringAgent::monitor() {
     if ( ConsensusEngine::isOnTravis() )
         return;
 
-    while ( !getNode()->isInited() ) {
-        usleep( 100000 );
-    }
-
+    if ( !getNode()->isInited() )
+        return;
 
-    map< uint64_t, weak_ptr< LivelinessMonitor > > monitorsCopy;
 
-    {
-        LOCK( monitorsMutex )
-        monitorsCopy = activeMonitors;
-    }
+    auto nodeId = getNode()->getNodeID();
 
-    for ( auto&& item : monitorsCopy ) {
+    for ( auto&& scope : LivelinessMonitor::getActiveScopes( this ) ) {
         if ( sChain->getNode()->isExitRequested() )
             return;
 
-        ptr< LivelinessMonitor > monitor = item.second.lock();
+        auto currentTime = Time::getCurrentTimeMs();
 
-        if ( monitor ) {
-            CHECK_STATE( monitor != nullptr );
-
-            auto currentTime = Time::getCurrentTimeMs();
-
-            if ( currentTime > monitor->getExpiryTime() ) {
-                LOG( warn, monitor->toString()
-                               << " has been stuck for "
-                               << to_string( currentTime - monitor->getStartTime() ) + " ms" );
-            }
+        if ( currentTime > scope.expiryTime ) {
+            LOG( warn, LivelinessMonitor::toString( scope, nodeId )
+                           << " has been stuck for "
+                           << to_string( currentTime - scope.startTime ) + " ms" );
         }
     }
 }
 
 
-void MonitoringAgent::monitoringLoop( MonitoringAgent* _agent ) {
-    CHECK_ARGUMENT( _agent );
-
-    setThreadName( "MonitoringLoop", _agent->getSchain()->getNode()->getConsensusEngine() );
-
+void MonitoringAgent::monitoringTick() {
+    // executor threads are shared by all nodes of the process
+    logThreadLocal_ = getNode()->getLog();
 
-    LOG( info, "Monitoring agent started monitoring" );
+    if ( getNode()->isExitRequested() )
+        return;
 
     try {
-        while ( !_agent->getSchain()->getNode()->isExitRequested() ) {
-            usleep( _agent->getSchain()->getNode()->getMonitoringIntervalMs() * 1000 );
-
-            try {
-                _agent->monitor();
-
-            } catch ( ExitRequestedException& ) {
-                return;
-            } catch ( exception& e ) {
-                SkaleException::logNested( e );
-            }
-        };
+        monitor();
+    } catch ( ExitRequestedException& ) {
     } catch ( FatalError& e ) {
         SkaleException::logNested( e );
-        _agent->getSchain()->getNode()->initiateApplicationExitOnFatalConsensusError( e.what() );
+        WorkStealingExecutor::getInstance().cancel( monitoringTimer );
+        getNode()->initiateApplicationExitOnFatalConsensusError( e.what() );
+    } catch ( exception& e ) {
+        SkaleException::logNested( e );
     }
 }
 
-void MonitoringAgent::registerMonitor( const ptr< LivelinessMonitor >& _m ) {
-    CHECK_ARGUMENT( _m )
-    LOCK( monitorsMutex )
-    activeMonitors[_m->getId()] = _m;
-}
-
-void MonitoringAgent::unregisterMonitor( uint64_t _id ) {
-    LOCK( monitorsMutex )
-    activeMonitors.erase( _id );
-}
-
-
 void MonitoringAgent::join() {
-    CHECK_STATE( monitoringThreadPool );
-    monitoringThreadPool->joinAll();
+    WorkStealingExecutor::getInstance().cancel( monitoringTimer );
 }
@@ -23,27 +23,20 @@
 
 #pragma once
 
+#include "threads/WorkStealingExecutor.h"
+
 class Schain;
-class MonitoringThreadPool;
-class LivelinessMonitor;
 
 class MonitoringAgent : public Agent {
-    map< uint64_t, weak_ptr< LivelinessMonitor > > activeMonitors;  // tsafe
-    recursive_mutex monitorsMutex;
+    WorkStealingExecutor::timer_id monitoringTimer = 0;
 
-    ptr< MonitoringThreadPool > monitoringThreadPool = nullptr;
+    // one pass of monitoring, run periodically on the shared executor
+    void monitoringTick();
 
 public:
     explicit MonitoringAgent( Schain& _sChain );
 
-    static void monitoringLoop( MonitoringAgent* agent );
-
     void monitor();
 
     void join();
-
-
-    void registerMonitor( const ptr< LivelinessMonitor >& _m );
-
-    void unregisterMonitor( uint64_t _id );
 };
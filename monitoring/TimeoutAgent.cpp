@@ -31,6 +31,7 @@
 #include "utils/Time.h"
 #include "node/Node.h"
 #include "chains/Schain.h"
+#include "AdaptiveProposalTimeout.h"
 #include "LivelinessMonitor.h"
 #include "TimeoutAgent.h"
 #include "TimeoutThreadPool.h"
@@ -61,53 +62,33 @@ void TimeoutAgent::timeoutLoop( TimeoutAgent* _agent ) {
 
     LOG( info, "Timeout agent started monitoring" );
 
-    uint64_t blockProcessingStart =
+    _agent->blockProcessingStart =
         max( _agent->getSchain()->getLastCommitTimeMs(), _agent->getSchain()->getStartTimeMs() );
 
-    if ( blockProcessingStart == 0 )
-        blockProcessingStart = Time::getCurrentTimeMs();
+    if ( _agent->blockProcessingStart == 0 )
+        _agent->blockProcessingStart = Time::getCurrentTimeMs();
 
-    uint64_t lastRebroadCastTime = blockProcessingStart;
+    _agent->lastRebroadCastTime = _agent->blockProcessingStart;
 
-    bool proposalReceiptTimedOut = false;
+    // the loop runs early at each deadline and wake up, the interval is a fallback
+    auto intervalMs = _agent->getSchain()->getNode()->getMonitoringIntervalMs();
+    auto nextRunMs = Time::getCurrentTimeMs() + intervalMs;
 
     try {
         while ( !_agent->getSchain()->getNode()->isExitRequested() ) {
-            usleep( _agent->getSchain()->getNode()->getMonitoringIntervalMs() * 1000 );
+            _agent->waitUntil( nextRunMs );
+
+            if ( _agent->getSchain()->getNode()->isExitRequested() )
+                return;
+
+            nextRunMs = Time::getCurrentTimeMs() + intervalMs;
 
             try {
-                auto currentBlockId = _agent->getSchain()->getLastCommittedBlockID() + 1;
-                auto currentTime = Time::getCurrentTimeMs();
-
-                auto timeZero = max( _agent->getSchain()->getLastCommitTimeMs(),
-                    _agent->getSchain()->getStartTimeMs() );
-
-                blockProcessingStart = timeZero;
-
-                lastRebroadCastTime = max( lastRebroadCastTime, timeZero );
-
-                if ( _agent->getSchain()->getNodeCount() > 2 ) {
-                    if ( currentTime - blockProcessingStart <= BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS )
-                        proposalReceiptTimedOut = false;
-
-                    if ( !proposalReceiptTimedOut && currentBlockId > 2 &&
-                         currentTime - blockProcessingStart > BLOCK_PROPOSAL_RECEIVE_TIMEOUT_MS ) {
-                        try {
-                            _agent->getSchain()->blockProposalReceiptTimeoutArrived(
-                                currentBlockId );
-                            proposalReceiptTimedOut = true;
-                        } catch ( ... ) {
-                        }
-                    }
-
-                    if ( currentBlockId > 2 &&
-                         currentTime - lastRebroadCastTime > REBROADCAST_TIMEOUT_MS ) {
-                        _agent->getSchain()->rebroadcastAllMessagesForCurrentBlock();
-                        lastRebroadCastTime = currentTime;
-                    }
-                }
+                nextRunMs = min( nextRunMs, _agent->checkTimeouts() );
             } catch ( ExitRequestedException& ) {
                 return;
+            } catch ( FatalError& ) {
+                throw;
             } catch ( exception& e ) {
                 SkaleException::logNested( e );
             }
@@ -118,7 +99,79 @@ void TimeoutAgent::timeoutLoop( TimeoutAgent* _agent ) {
     }
 }
 
+
+uint64_t TimeoutAgent::checkTimeouts() {
+    auto currentBlockId = getSchain()->getLastCommittedBlockID() + 1;
+    auto currentTime = Time::getCurrentTimeMs();
+
+    auto timeZero = max( getSchain()->getLastCommitTimeMs(), getSchain()->getStartTimeMs() );
+
+    blockProcessingStart = timeZero;
+
+    lastRebroadCastTime = max( lastRebroadCastTime, timeZero );
+
+    if ( getSchain()->getNodeCount() <= 2 )
+        return UINT64_MAX;
+
+    auto nodeCount = ( uint64_t ) getSchain()->getNodeCount();
+    set< uint64_t > deadProposers;
+    for ( uint64_t i = 1; i <= nodeCount; i++ ) {
+        auto deathTime = getSchain()->getDeathTimeMs( i );
+        if ( deathTime != 0 && deathTime + NODE_DEATH_INTERVAL_MS > currentTime )
+            deadProposers.insert( i );
+    }
+
+    auto receiptTimeoutMs =
+        getSchain()->getProposalTimeout()->getTimeoutMs( currentBlockId, nodeCount, deadProposers );
+
+    if ( currentTime - blockProcessingStart <= receiptTimeoutMs )
+        proposalReceiptTimedOut = false;
+
+    if ( !proposalReceiptTimedOut && currentBlockId > 2 &&
+         currentTime - blockProcessingStart > receiptTimeoutMs ) {
+        try {
+            getSchain()->blockProposalReceiptTimeoutArrived( currentBlockId );
+            proposalReceiptTimedOut = true;
+        } catch ( ... ) {
+        }
+    }
+
+    if ( currentBlockId > 2 && currentTime - lastRebroadCastTime > REBROADCAST_TIMEOUT_MS ) {
+        getSchain()->rebroadcastAllMessagesForCurrentBlock();
+        lastRebroadCastTime = currentTime;
+    }
+
+    // run again right when the next timeout expires
+    auto nextRunMs = lastRebroadCastTime + REBROADCAST_TIMEOUT_MS + 1;
+    if ( !proposalReceiptTimedOut )
+        nextRunMs = min( nextRunMs, blockProcessingStart + receiptTimeoutMs + 1 );
+    return nextRunMs;
+}
+
+
+void TimeoutAgent::waitUntil( uint64_t _timeMs ) {
+    unique_lock< mutex > lock( messageMutex );
+
+    while ( !wakeUpRequested && !getNode()->isExitRequested() ) {
+        auto currentTime = Time::getCurrentTimeMs();
+        if ( currentTime >= _timeMs )
+            break;
+        messageCond.wait_for( lock, chrono::milliseconds( _timeMs - currentTime ) );
+    }
+
+    wakeUpRequested = false;
+}
+
+void TimeoutAgent::wakeUp() {
+    {
+        lock_guard< mutex > lock( messageMutex );
+        wakeUpRequested = true;
+    }
+    messageCond.notify_all();
+}
+
 void TimeoutAgent::join() {
     CHECK_STATE( timeoutThreadPool );
+    messageCond.notify_all();
     timeoutThreadPool->joinAll();
 }
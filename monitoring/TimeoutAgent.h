@@ -29,13 +29,34 @@ class Schain;
 class TimeoutThreadPool;
 class LivelinessMonitor;
 
+// Runs the proposal receipt and rebroadcast timeouts on its own thread. It is not moved to
+// the shared executor, because a timeout takes the chain lock and sends to the network.
 class TimeoutAgent : public Agent {
     ptr< TimeoutThreadPool > timeoutThreadPool = nullptr;
 
+    // the state below is only used by the timeout thread
+    uint64_t blockProcessingStart = 0;
+
+    uint64_t lastRebroadCastTime = 0;
+
+    bool proposalReceiptTimedOut = false;
+
+    // guarded by messageMutex
+    bool wakeUpRequested = false;
+
+    // returns the time of the next deadline
+    uint64_t checkTimeouts();
+
+    // sleeps until _timeMs, a wake up or exit
+    void waitUntil( uint64_t _timeMs );
+
 public:
     explicit TimeoutAgent( Schain& _sChain );
 
-    static void timeoutLoop( TimeoutAgent* agent );
+    static void timeoutLoop( TimeoutAgent* _agent );
+
+    // re-evaluates the timeouts now, called when a block commits or a proposal arrives
+    void wakeUp();
 
     void join();
 };
@@ -0,0 +1,142 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file ConsensusTrace.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "exceptions/FatalError.h"
+
+#include "ConsensusTrace.h"
+
+
+template < class T >
+static void writeField( ofstream& _stream, const T& _value ) {
+    _stream.write( ( const char* ) &_value, sizeof( T ) );
+}
+
+template < class T >
+static bool readField( ifstream& _stream, T& _value ) {
+    _stream.read( ( char* ) &_value, sizeof( T ) );
+    return _stream.gcount() == sizeof( T );
+}
+
+
+ConsensusTraceRecorder::ConsensusTraceRecorder(
+    const string& _fileName, schain_index _schainIndex, node_count _nodeCount )
+    : startTime( chrono::steady_clock::now() ) {
+    stream.open( _fileName, ios::binary | ios::trunc );
+
+    CHECK_STATE2( stream.is_open(), "Could not open trace file:" + _fileName );
+
+    writeField( stream, CONSENSUS_TRACE_MAGIC );
+    writeField( stream, CONSENSUS_TRACE_VERSION );
+    writeField( stream, ( uint64_t ) _schainIndex );
+    writeField( stream, ( uint64_t ) _nodeCount );
+}
+
+void ConsensusTraceRecorder::record( TraceRecordType _type, schain_index _srcIndex,
+    block_id _blockID, const char* _data, uint64_t _len ) {
+    CHECK_ARGUMENT( _data || _len == 0 );
+
+    uint64_t timeUs = chrono::duration_cast< chrono::microseconds >(
+        chrono::steady_clock::now() - startTime )
+                          .count();
+
+    lock_guard< mutex > lock( streamMutex );
+
+    writeField( stream, timeUs );
+    writeField( stream, ( uint8_t ) _type );
+    writeField( stream, ( uint64_t ) _srcIndex );
+    writeField( stream, ( uint64_t ) _blockID );
+    writeField( stream, _len );
+    stream.write( _data, _len );
+
+    recordCount++;
+}
+
+void ConsensusTraceRecorder::record( TraceRecordType _type, schain_index _srcIndex,
+    block_id _blockID, const ptr< vector< uint8_t > >& _data ) {
+    CHECK_ARGUMENT( _data );
+    record( _type, _srcIndex, _blockID, ( const char* ) _data->data(), _data->size() );
+}
+
+void ConsensusTraceRecorder::flush() {
+    lock_guard< mutex > lock( streamMutex );
+    stream.flush();
+}
+
+uint64_t ConsensusTraceRecorder::getRecordCount() const {
+    return recordCount;
+}
+
+
+ConsensusTraceReader::ConsensusTraceReader( const string& _fileName ) {
+    stream.open( _fileName, ios::binary );
+
+    CHECK_STATE2( stream.is_open(), "Could not open trace file:" + _fileName );
+
+    uint64_t magic = 0;
+    uint32_t version = 0;
+
+    CHECK_STATE2( readField( stream, magic ) && magic == CONSENSUS_TRACE_MAGIC,
+        "Not a consensus trace file:" + _fileName );
+    CHECK_STATE2( readField( stream, version ) && version == CONSENSUS_TRACE_VERSION,
+        "Unsupported consensus trace version:" + to_string( version ) );
+    CHECK_STATE( readField( stream, schainIndex ) );
+    CHECK_STATE( readField( stream, nodeCount ) );
+}
+
+ptr< TraceRecord > ConsensusTraceReader::readNext() {
+    auto record = make_shared< TraceRecord >();
+
+    uint8_t type = 0;
+    uint64_t len = 0;
+
+    if ( !readField( stream, record->timeUs ) )
+        return nullptr;
+
+    // a truncated last record is possible if the node was killed while recording
+    if ( !readField( stream, type ) || !readField( stream, record->srcIndex ) ||
+         !readField( stream, record->blockID ) || !readField( stream, len ) ) {
+        return nullptr;
+    }
+
+    CHECK_STATE2( type >= TRACE_CONSENSUS_MESSAGE && type <= TRACE_CATCHUP_BLOCKS,
+        "Corrupt trace record type:" + to_string( type ) );
+
+    record->type = ( TraceRecordType ) type;
+    record->payload.resize( len );
+    stream.read( record->payload.data(), len );
+
+    if ( ( uint64_t ) stream.gcount() != len )
+        return nullptr;
+
+    return record;
+}
+
+uint64_t ConsensusTraceReader::getSchainIndex() const {
+    return schainIndex;
+}
+
+uint64_t ConsensusTraceReader::getNodeCount() const {
+    return nodeCount;
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file ConsensusTrace.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Binary trace of everything a single node received from the outside world. A trace can be
+// replayed offline into a single Schain by consensusr.
+
+static constexpr uint64_t CONSENSUS_TRACE_MAGIC = 0x5452414345534B4C;
+
+static constexpr uint32_t CONSENSUS_TRACE_VERSION = 1;
+
+enum TraceRecordType : uint8_t {
+    TRACE_CONSENSUS_MESSAGE = 1,
+    TRACE_BLOCK_PROPOSAL = 2,
+    TRACE_DA_PROOF = 3,
+    TRACE_CATCHUP_BLOCKS = 4
+};
+
+struct TraceRecord {
+    // arrival time in microseconds since the start of the trace
+    uint64_t timeUs = 0;
+    TraceRecordType type = TRACE_CONSENSUS_MESSAGE;
+    uint64_t srcIndex = 0;
+    uint64_t blockID = 0;
+    string payload;
+};
+
+
+class ConsensusTraceRecorder {
+    ofstream stream;
+    mutex streamMutex;
+
+    const chrono::steady_clock::time_point startTime;
+
+    atomic< uint64_t > recordCount = 0;
+
+public:
+    ConsensusTraceRecorder(
+        const string& _fileName, schain_index _schainIndex, node_count _nodeCount );
+
+    // thread safe, called from network, proposal server and catchup threads
+    void record( TraceRecordType _type, schain_index _srcIndex, block_id _blockID,
+        const char* _data, uint64_t _len );
+
+    void record( TraceRecordType _type, schain_index _srcIndex, block_id _blockID,
+        const ptr< vector< uint8_t > >& _data );
+
+    void flush();
+
+    [[nodiscard]] uint64_t getRecordCount() const;
+};
+
+
+class ConsensusTraceReader {
+    ifstream stream;
+
+    uint64_t schainIndex = 0;
+    uint64_t nodeCount = 0;
+
+public:
+    explicit ConsensusTraceReader( const string& _fileName );
+
+    // returns nullptr at the end of the trace
+    ptr< TraceRecord > readNext();
+
+    [[nodiscard]] uint64_t getSchainIndex() const;
+
+    [[nodiscard]] uint64_t getNodeCount() const;
+};
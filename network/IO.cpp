@@ -34,11 +34,13 @@
 #include "ServerConnection.h"
 #include "abstracttcpserver/ConnectionStatus.h"
 #include "chains/Schain.h"
+#include "datastructures/PartialHashesList.h"
 #include "exceptions/ExitRequestedException.h"
 #include "exceptions/IOException.h"
 #include "exceptions/NetworkProtocolException.h"
 #include "exceptions/ParsingException.h"
 #include "exceptions/PingException.h"
+#include "headers/BinaryHeader.h"
 #include "headers/BlockProposalRequestHeader.h"
 #include "headers/Header.h"
 #include "node/Node.h"
@@ -201,33 +203,74 @@ void IO::writeMagic( const ptr< ClientSocket >& _socket, bool _isPing ) {
 
 void IO::writeHeader( const ptr< ClientSocket >& _socket, const ptr< Header >& _header ) {
     CHECK_ARGUMENT( _socket );
+    writeHeader( _socket->getDescriptor(), _socket->getIP(), _header );
+}
+
+void IO::writeHeader(
+    file_descriptor _descriptor, const string& _ip, const ptr< Header >& _header ) {
     CHECK_ARGUMENT( _header );
     CHECK_ARGUMENT( _header->isComplete() );
-    writeBuf( _socket->getDescriptor(), _header->toBuffer() );
+
+    if ( !binaryHeaders ) {
+        writeBuf( _descriptor, _header->toBuffer() );
+        return;
+    }
+
+    writeBuf( _descriptor, _header->toWireBuffer( isBinaryHeaderPeer( _ip ) ) );
+}
+
+bool IO::isBinaryHeaderPeer( const string& _ip ) {
+    lock_guard< mutex > lock( binaryHeaderPeersLock );
+    return binaryHeaderPeers.count( _ip ) > 0;
+}
+
+void IO::setBinaryHeaderPeer( const string& _ip, bool _isBinary ) {
+    lock_guard< mutex > lock( binaryHeaderPeersLock );
+    if ( _isBinary )
+        binaryHeaderPeers.insert( _ip );
+    else
+        binaryHeaderPeers.erase( _ip );
 }
 
 void IO::writeBytesVector( file_descriptor _socket, const ptr< vector< uint8_t > >& _bytes ) {
     writeBytes( _socket, _bytes, msg_len( _bytes->size() ) );
 }
 
-void IO::writePartialHashes(
-    file_descriptor _socket, const ptr< map< uint64_t, ptr< partial_sha_hash > > >& _hashes ) {
+void IO::writePartialHashes( file_descriptor _socket, const ptr< PartialHashesList >& _hashes,
+    const ptr< vector< uint64_t > >& _missing ) {
     CHECK_ARGUMENT( _hashes );
-    CHECK_ARGUMENT( _hashes->size() > 0 );
+    CHECK_ARGUMENT( _missing );
+
+    auto count = ( uint64_t ) _hashes->getTransactionCount();
+    auto hashes = _hashes->getPartialHashes();
+
+    CHECK_ARGUMENT( _missing->size() == ( count + 63 ) / 64 );
+
+    uint64_t missingCount = 0;
+    for ( auto word : *_missing ) {
+        missingCount += __builtin_popcountll( word );
+    }
 
-    auto buffer = make_shared< vector< uint8_t > >( _hashes->size() * PARTIAL_HASH_LEN );
+    CHECK_ARGUMENT( missingCount > 0 );
+
+    auto buffer = make_shared< vector< uint8_t > >( missingCount * PARTIAL_HASH_LEN );
 
     uint64_t counter = 0;
-    for ( auto&& item : *_hashes ) {
-        memcpy(
-            buffer->data() + counter * PARTIAL_HASH_LEN, item.second->data(), PARTIAL_HASH_LEN );
-        counter++;
+    for ( uint64_t w = 0; w < _missing->size(); w++ ) {
+        for ( auto word = ( *_missing )[w]; word != 0; word &= word - 1 ) {
+            auto i = w * 64 + __builtin_ctzll( word );
+            CHECK_ARGUMENT( i < count );
+            memcpy( buffer->data() + counter * PARTIAL_HASH_LEN,
+                hashes->data() + i * PARTIAL_HASH_LEN, PARTIAL_HASH_LEN );
+            counter++;
+        }
     }
 
     return writeBytesVector( _socket, buffer );
 }
 
-IO::IO( Schain* _sChain ) : sChain( _sChain ) {
+IO::IO( Schain* _sChain, bool _binaryHeaders )
+    : sChain( _sChain ), binaryHeaders( _binaryHeaders ) {
     CHECK_ARGUMENT( _sChain );
 };
 
@@ -275,6 +318,9 @@ nlohmann::json IO::readJsonHeader( file_descriptor descriptor, const char* _erro
 
     uint64_t headerLen = *( uint64_t* ) buf2->data();
 
+    bool isBinary = ( headerLen & BinaryHeader::LENGTH_FLAG ) != 0;
+    headerLen &= ~BinaryHeader::LENGTH_FLAG;
+
     if ( headerLen < 2 || headerLen > _maxHeaderLen ) {
         LOG( err, "Total Len:" << to_string( headerLen ) );
         BOOST_THROW_EXCEPTION(
@@ -296,13 +342,25 @@ nlohmann::json IO::readJsonHeader( file_descriptor descriptor, const char* _erro
             __CLASS_NAME__ ) );
     }
 
+    nlohmann::json js;
+
+    if ( isBinary ) {
+        try {
+            js = BinaryHeader::decode( buf->getBuf()->data(), headerLen );
+        } catch ( ... ) {
+            throw_with_nested( ParsingException(
+                string( _errorString ) + ":Could not parse binary header from" + _ip,
+                __CLASS_NAME__ ) );
+        }
+        setBinaryHeaderPeer( _ip, true );
+        return js;
+    }
+
     auto s = make_shared< string >(
         ( const char* ) buf->getBuf()->data(), ( size_t ) buf->getBuf()->size() );
 
     LOG( trace, "Read JSON header" << *s );
 
-    nlohmann::json js;
-
     try {
         js = nlohmann::json::parse( *s );
     } catch ( ExitRequestedException& ) {
@@ -313,5 +371,9 @@ nlohmann::json IO::readJsonHeader( file_descriptor descriptor, const char* _erro
             __CLASS_NAME__ ) );
     }
 
+    // a peer that does not advertise binary headers gets JSON, also after a downgrade
+    if ( binaryHeaders )
+        setBinaryHeaderPeer( _ip, js.value( BinaryHeader::SUPPORT_FIELD, false ) );
+
     return js;
 };
@@ -29,13 +29,28 @@ class ServerConnection;
 class Header;
 class Buffer;
 class ClientSocket;
+class PartialHashesList;
 class Schain;
 
 class IO {
     Schain* sChain = nullptr;
 
+    bool binaryHeaders = true;
+
+    // IPs of peers that accept binary headers, learned from the headers they send
+    mutex binaryHeaderPeersLock;
+    set< string > binaryHeaderPeers;
+
+    void setBinaryHeaderPeer( const string& _ip, bool _isBinary );
+
 public:
-    IO( Schain* _sChain );
+    IO( Schain* _sChain, bool _binaryHeaders = true );
+
+    // whether headers sent to _ip are binary
+    bool isBinaryHeaderPeer( const string& _ip );
+
+    void writeHeader(
+        file_descriptor _descriptor, const string& _ip, const ptr< Header >& _header );
 
     void readBytes( const ptr< ServerConnection >& _env, const ptr< vector< uint8_t > >& _buffer,
         msg_len _len, uint32_t _timeoutSec );
@@ -57,8 +72,9 @@ public:
 
     void writeBytesVector( file_descriptor _socket, const ptr< vector< uint8_t > >& _bytes );
 
-    void writePartialHashes(
-        file_descriptor _socket, const ptr< map< uint64_t, ptr< partial_sha_hash > > >& _hashes );
+    // writes the hashes of _hashes whose bits are set in the _missing bitmap
+    void writePartialHashes( file_descriptor _socket, const ptr< PartialHashesList >& _hashes,
+        const ptr< vector< uint64_t > >& _missing );
 
     void readMagic( file_descriptor descriptor );
 
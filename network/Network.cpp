@@ -51,6 +51,7 @@
 #include "protocols/blockconsensus/BlockConsensusAgent.h"
 
 #include "Buffer.h"
+#include "ConsensusTrace.h"
 #include "Network.h"
 #include "messages/NetworkMessageEnvelope.h"
 #include "network/Sockets.h"
@@ -122,6 +123,7 @@ void Network::addToDelayedSends(
     if ( delayedSends.at( dstIndex - 1 ).size() > MAX_DELAYED_MESSAGE_SENDS ) {
         delayedSends.at( dstIndex - 1 ).pop_front();
     }
+    delayedSendsSizes.at( dstIndex - 1 ) = delayedSends.at( dstIndex - 1 ).size();
 }
 
 void Network::broadcastMessage( const ptr< NetworkMessage >& _msg ) {
@@ -254,31 +256,7 @@ void Network::networkReadLoop() {
             if ( !m )
                 continue;  // check exit again
 
-            auto msg = dynamic_pointer_cast< NetworkMessage >( m->getMessage() );
-
-
-            // catchup test
-            if ( msg->getBlockID() <= catchupBlocks ) {
-                auto syncInfo = getSchain()->getCatchupClientAgent()->getSyncInfo();
-                cerr <<  "Sync Info:" << syncInfo.toString() << endl;
-                continue;
-            }
-
-
-            if ( !knownMsgHashes.putIfDoesNotExist( msg->getHash().toHex(), true ) ) {
-                // already seen this message, dropping
-                continue;
-            }
-
-            if ( msg->getMsgType() == MSG_ORACLE_REQ_BROADCAST ||
-                 msg->getMsgType() == MSG_ORACLE_RSP ) {
-                sChain->getOracleResultAssemblyAgent()->postMessage( m );
-                continue;
-            }
-
-            CHECK_STATE( sChain );
-
-            postDeferOrDrop( m );
+            dispatchReceivedMessage( m );
         } catch ( ExitRequestedException& ) {
             break;
         } catch ( FatalError& e ) {
@@ -294,6 +272,37 @@ void Network::networkReadLoop() {
 }
 
 
+void Network::dispatchReceivedMessage( const ptr< NetworkMessageEnvelope >& _me ) {
+    CHECK_ARGUMENT( _me );
+
+    auto msg = dynamic_pointer_cast< NetworkMessage >( _me->getMessage() );
+
+    CHECK_STATE( msg );
+
+    // catchup test
+    if ( msg->getBlockID() <= catchupBlocks ) {
+        auto syncInfo = getSchain()->getCatchupClientAgent()->getSyncInfo();
+        cerr << "Sync Info:" << syncInfo.toString() << endl;
+        return;
+    }
+
+
+    if ( !knownMsgHashes.putIfDoesNotExist( msg->getHash().toHex(), true ) ) {
+        // already seen this message, dropping
+        return;
+    }
+
+    if ( msg->getMsgType() == MSG_ORACLE_REQ_BROADCAST || msg->getMsgType() == MSG_ORACLE_RSP ) {
+        sChain->getOracleResultAssemblyAgent()->postMessage( _me );
+        return;
+    }
+
+    CHECK_STATE( sChain );
+
+    postDeferOrDrop( _me );
+}
+
+
 /*
  * Consensus initially defers messages that come from the "future" - those that
  * have the block_id or the consensus round larger than currently processed.
@@ -362,6 +371,7 @@ void Network::trySendingDelayedSends() {
                     {
                         LOCK( delayedSendsLocks.at( i ) );
                         delayedSends.at( i ).pop_front();
+                        delayedSendsSizes.at( i ) = delayedSends.at( i ).size();
                     }
                 }
                 {
@@ -403,11 +413,24 @@ void Network::deferredMessagesLoop() {
             // print the error and continue the loop
             SkaleException::logNested( e );
         }
-        usleep( 1000000 );
+
+        unique_lock< mutex > lock( deferredLoopMutex );
+        deferredLoopCond.wait_for( lock, chrono::milliseconds( DEFERRED_MESSAGES_POLL_MS ),
+            [this]() { return deferredLoopWakeUp; } );
+        deferredLoopWakeUp = false;
     }
 }
 
 
+void Network::wakeUpDeferredMessagesLoop() {
+    {
+        lock_guard< mutex > lock( deferredLoopMutex );
+        deferredLoopWakeUp = true;
+    }
+    deferredLoopCond.notify_one();
+}
+
+
 void Network::startThreads() {
     networkReadThread = make_shared< thread >( std::bind( &Network::networkReadLoop, this ) );
     deferredMessageThread =
@@ -439,7 +462,21 @@ ptr< NetworkMessageEnvelope > Network::receiveMessage() {
 
     string msg( ( const char* ) buf->getBuf()->data(), readBytes );
 
-    auto mptr = NetworkMessage::parseMessage( msg, getSchain() );
+    auto traceRecorder = getNode()->getTraceRecorder();
+
+    if ( traceRecorder ) {
+        traceRecorder->record( TRACE_CONSENSUS_MESSAGE, schain_index( 0 ), block_id( 0 ),
+            msg.data(), msg.size() );
+    }
+
+    auto mptr = parseNetworkMessage( msg );
+
+    return createVerifiedEnvelope( mptr );
+};
+
+
+ptr< NetworkMessage > Network::parseNetworkMessage( const string& _msg ) {
+    auto mptr = NetworkMessage::parseMessage( _msg, getSchain() );
 
     CHECK_STATE( mptr );
 
@@ -447,6 +484,14 @@ ptr< NetworkMessageEnvelope > Network::receiveMessage() {
         saveToVisualization( mptr, getSchain()->getNode()->getVisualizationType() );
     }
 
+    return mptr;
+}
+
+
+ptr< NetworkMessageEnvelope > Network::createVerifiedEnvelope( const ptr< NetworkMessage >& _msg ) {
+    CHECK_ARGUMENT( _msg );
+
+    auto mptr = _msg;
 
     mptr->verify( getSchain()->getCryptoManager() );
 
@@ -498,11 +543,17 @@ uint64_t Network::computeTotalDelayedSends() {
     return total;
 }
 
+uint64_t Network::getDelayedSendsSize( schain_index _dstIndex ) const {
+    CHECK_ARGUMENT( _dstIndex > 0 && ( uint64_t ) _dstIndex <= delayedSendsSizes.size() );
+    return delayedSendsSizes.at( ( uint64_t ) _dstIndex - 1 );
+}
+
 Network::Network( Schain& _sChain )
     : Agent( _sChain, false ),
       knownMsgHashes( KNOWN_MSG_HASHES_SIZE ),
       delayedSends( ( uint64_t ) _sChain.getNodeCount() ),
-      delayedSendsLocks( ( uint64_t ) _sChain.getNodeCount() ) {
+      delayedSendsLocks( ( uint64_t ) _sChain.getNodeCount() ),
+      delayedSendsSizes( ( uint64_t ) _sChain.getNodeCount() ) {
     // no network objects needed for sync nodes
     CHECK_STATE( !getNode()->isSyncOnlyNode() );
 
@@ -35,7 +35,7 @@ class Buffer;
 class Node;
 class Schain;
 
-enum TransportType { ZMQ };
+enum TransportType { ZMQ, SIMULATED };
 
 class Network : public Agent {
 protected:
@@ -43,6 +43,8 @@ protected:
 
     vector< list< pair< ptr< NetworkMessage >, ptr< NodeInfo > > > > delayedSends;  // tsafe
     vector< recursive_mutex > delayedSendsLocks;
+    // per peer queue sizes, readable without taking delayedSendsLocks
+    vector< atomic< uint64_t > > delayedSendsSizes;
 
     // used in testing
 
@@ -54,6 +56,10 @@ protected:
 
     ptr< thread > deferredMessageThread;
 
+    mutex deferredLoopMutex;
+    condition_variable deferredLoopCond;
+    bool deferredLoopWakeUp = false;
+
     static TransportType transport;
 
     explicit Network( Schain& _sChain );
@@ -73,6 +79,9 @@ public:
 
     void deferredMessagesLoop();
 
+    // makes the deferred messages loop run now instead of on its next poll
+    void wakeUpDeferredMessagesLoop();
+
     void networkReadLoop();
 
     static string ipToString( uint32_t _ip );
@@ -89,6 +98,13 @@ public:
 
     ptr< NetworkMessageEnvelope > receiveMessage();
 
+    ptr< NetworkMessage > parseNetworkMessage( const string& _msg );
+
+    ptr< NetworkMessageEnvelope > createVerifiedEnvelope( const ptr< NetworkMessage >& _msg );
+
+    // drops duplicates and routes a verified message to oracle or consensus
+    void dispatchReceivedMessage( const ptr< NetworkMessageEnvelope >& _me );
+
     virtual uint64_t readMessageFromNetwork( ptr< Buffer > buf ) = 0;
 
     static bool validateIpAddress( const string& _ip );
@@ -111,5 +127,7 @@ public:
 
     uint64_t computeTotalDelayedSends();
 
+    uint64_t getDelayedSendsSize( schain_index _dstIndex ) const;
+
     void saveToVisualization( ptr< NetworkMessage > _msg, uint64_t _visualizationType );
 };
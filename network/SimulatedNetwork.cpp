@@ -0,0 +1,245 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file SimulatedNetwork.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "exceptions/FatalError.h"
+
+#include "exceptions/ExitRequestedException.h"
+#include "exceptions/NetworkProtocolException.h"
+#include "messages/NetworkMessage.h"
+#include "node/Node.h"
+#include "node/NodeInfo.h"
+#include "thirdparty/lrucache.hpp"
+
+#include "Buffer.h"
+#include "SimulatedNetwork.h"
+#include "chains/Schain.h"
+
+
+map< pair< uint64_t, uint64_t >, ptr< SimulatedMailbox > > SimulatedNetwork::registry;
+recursive_mutex SimulatedNetwork::registryMutex;
+
+
+void SimulatedMailbox::push( uint64_t _deliverAtUs, string&& _data ) {
+    {
+        lock_guard< mutex > lock( m );
+        queue.push( { _deliverAtUs, seqCounter++, move( _data ) } );
+    }
+    cv.notify_one();
+}
+
+
+bool SimulatedMailbox::pop( string& _data, uint64_t _maxWaitMs ) {
+    unique_lock< mutex > lock( m );
+
+    auto deadlineUs = SimulatedNetwork::nowUs() + 1000 * _maxWaitMs;
+
+    while ( true ) {
+        auto now = SimulatedNetwork::nowUs();
+
+        if ( !queue.empty() && queue.top().deliverAtUs <= now ) {
+            // priority_queue::top is const, the element is popped right after
+            _data = move( const_cast< Delivery& >( queue.top() ).data );
+            queue.pop();
+            return true;
+        }
+
+        if ( now >= deadlineUs )
+            return false;
+
+        auto waitUntilUs = deadlineUs;
+        if ( !queue.empty() )
+            waitUntilUs = min( waitUntilUs, queue.top().deliverAtUs );
+
+        cv.wait_for( lock, chrono::microseconds( waitUntilUs - now ) );
+    }
+}
+
+
+uint64_t SimulatedNetwork::nowUs() {
+    return chrono::duration_cast< chrono::microseconds >(
+        chrono::steady_clock::now().time_since_epoch() )
+        .count();
+}
+
+
+SimulatedNetwork::SimulatedNetwork( Schain& _schain )
+    : Network( _schain ),
+      mailbox( make_shared< SimulatedMailbox >() ),
+      links( ( uint64_t ) _schain.getNodeCount() ) {
+    parseLinkParams();
+
+    LOCK( registryMutex );
+    // a restarted node in the same process replaces its old mailbox
+    registry[{ ( uint64_t ) _schain.getSchainID(), ( uint64_t ) _schain.getSchainIndex() }] =
+        mailbox;
+}
+
+
+SimulatedNetwork::~SimulatedNetwork() {
+    LOCK( registryMutex );
+
+    auto key =
+        make_pair( ( uint64_t ) sChain->getSchainID(), ( uint64_t ) sChain->getSchainIndex() );
+
+    auto it = registry.find( key );
+
+    if ( it != registry.end() && it->second == mailbox )
+        registry.erase( it );
+}
+
+
+void SimulatedNetwork::parseLinkParams() {
+    auto node = getNode();
+    auto cfg = node->getCfg();
+
+    SimulatedLinkParams defaults;
+    defaults.latencyMs = node->getParamUint64( "simulatedLatencyMs", 0 );
+    defaults.bandwidthBytesPerSec = 1024 * node->getParamUint64( "simulatedBandwidthKBps", 0 );
+    defaults.packetLoss = packetLoss;
+
+    auto myIndex = ( uint64_t ) sChain->getSchainIndex();
+
+    for ( uint64_t i = 0; i < links.size(); i++ ) {
+        links[i].params = defaults;
+        // fixed seeds make the loss pattern of each link reproducible between runs
+        links[i].lossGen.seed( ( uint32_t )( myIndex * 1000 + i + 1 ) );
+    }
+
+    // optional per link overrides:
+    // "simulatedLinks": [{"dst": 2, "latencyMs": 100, "bandwidthKBps": 1000, "packetLoss": 5}]
+    if ( cfg.find( "simulatedLinks" ) == cfg.end() )
+        return;
+
+    for ( auto&& link : cfg.at( "simulatedLinks" ) ) {
+        auto dst = link.at( "dst" ).get< uint64_t >();
+        CHECK_STATE2( dst >= 1 && dst <= links.size(), "Invalid simulated link dst" );
+
+        auto params = defaults;
+
+        if ( link.find( "latencyMs" ) != link.end() )
+            params.latencyMs = link.at( "latencyMs" ).get< uint64_t >();
+        if ( link.find( "bandwidthKBps" ) != link.end() )
+            params.bandwidthBytesPerSec = 1024 * link.at( "bandwidthKBps" ).get< uint64_t >();
+        if ( link.find( "packetLoss" ) != link.end() )
+            params.packetLoss = link.at( "packetLoss" ).get< uint32_t >();
+
+        CHECK_STATE( params.packetLoss <= 100 );
+
+        links[dst - 1].params = params;
+    }
+}
+
+
+void SimulatedNetwork::setLinkParams( schain_index _dstIndex, const SimulatedLinkParams& _params ) {
+    CHECK_ARGUMENT( _dstIndex >= 1 && ( uint64_t ) _dstIndex <= links.size() );
+    CHECK_ARGUMENT( _params.packetLoss <= 100 );
+    lock_guard< mutex > lock( linksMutex );
+    links[( uint64_t ) _dstIndex - 1].params = _params;
+}
+
+
+SimulatedLinkParams SimulatedNetwork::getLinkParams( schain_index _dstIndex ) {
+    CHECK_ARGUMENT( _dstIndex >= 1 && ( uint64_t ) _dstIndex <= links.size() );
+    lock_guard< mutex > lock( linksMutex );
+    return links[( uint64_t ) _dstIndex - 1].params;
+}
+
+
+ptr< SimulatedMailbox > SimulatedNetwork::findMailbox( uint64_t _schainID, uint64_t _schainIndex ) {
+    LOCK( registryMutex );
+    auto it = registry.find( { _schainID, _schainIndex } );
+    if ( it == registry.end() )
+        return nullptr;
+    return it->second;
+}
+
+
+bool SimulatedNetwork::sendMessage(
+    const ptr< NodeInfo >& _remoteNodeInfo, const ptr< NetworkMessage >& _msg ) {
+    CHECK_ARGUMENT( _remoteNodeInfo );
+    CHECK_ARGUMENT( _msg );
+
+    getSchain()->getNode()->exitCheck();
+
+    auto dstIndex = ( uint64_t ) _remoteNodeInfo->getSchainIndex();
+    CHECK_STATE( dstIndex >= 1 && dstIndex <= links.size() );
+
+    auto dstMailbox = findMailbox( ( uint64_t ) sChain->getSchainID(), dstIndex );
+
+    // destination did not start yet, the message goes to delayed sends like on EAGAIN
+    if ( !dstMailbox )
+        return false;
+
+    auto buf = _msg->serializeToString();
+
+    uint64_t deliverAtUs;
+
+    {
+        lock_guard< mutex > lock( linksMutex );
+        auto& link = links[dstIndex - 1];
+
+        if ( link.params.packetLoss > 0 && link.lossGen() % 100 < link.params.packetLoss ) {
+            // lost on the wire, the sender does not know
+            return true;
+        }
+
+        auto now = nowUs();
+        auto startUs = max( now, link.linkFreeAtUs );
+        uint64_t transmitUs = 0;
+
+        if ( link.params.bandwidthBytesPerSec > 0 )
+            transmitUs = 1000000 * buf.size() / link.params.bandwidthBytesPerSec;
+
+        link.linkFreeAtUs = startUs + transmitUs;
+        deliverAtUs = link.linkFreeAtUs + 1000 * link.params.latencyMs;
+    }
+
+    dstMailbox->push( deliverAtUs, move( buf ) );
+
+    return true;
+}
+
+
+uint64_t SimulatedNetwork::readMessageFromNetwork( const ptr< Buffer > _buf ) {
+    CHECK_ARGUMENT( _buf );
+    CHECK_STATE( _buf->getBuf()->size() >= MAX_CONSENSUS_MESSAGE_LEN );
+
+    string data;
+
+    while ( !mailbox->pop( data, 100 ) ) {
+        getSchain()->getNode()->exitCheck();
+    }
+
+    getSchain()->getNode()->exitCheck();
+
+    if ( data.size() >= MAX_CONSENSUS_MESSAGE_LEN ) {
+        BOOST_THROW_EXCEPTION( NetworkProtocolException(
+            "Consensus Message length too large:" + to_string( data.size() ), __CLASS_NAME__ ) );
+    }
+
+    memcpy( _buf->getBuf()->data(), data.data(), data.size() );
+
+    return data.size();
+}
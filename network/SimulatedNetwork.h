@@ -0,0 +1,106 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file SimulatedNetwork.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include <boost/random/mersenne_twister.hpp>
+
+#include "Network.h"
+
+class Buffer;
+class NetworkMessage;
+class NodeInfo;
+class Schain;
+
+
+// parameters of a simulated one-directional link between two nodes
+struct SimulatedLinkParams {
+    uint64_t latencyMs = 0;
+    // zero means unlimited
+    uint64_t bandwidthBytesPerSec = 0;
+    uint32_t packetLoss = 0;
+};
+
+
+// incoming queue of a node, messages are released to the reader at their delivery time
+class SimulatedMailbox {
+    struct Delivery {
+        uint64_t deliverAtUs;
+        uint64_t seq;
+        string data;
+
+        bool operator>( const Delivery& _other ) const {
+            return tie( deliverAtUs, seq ) > tie( _other.deliverAtUs, _other.seq );
+        }
+    };
+
+    mutex m;
+    condition_variable cv;
+    priority_queue< Delivery, vector< Delivery >, greater< Delivery > > queue;
+    uint64_t seqCounter = 0;
+
+public:
+    void push( uint64_t _deliverAtUs, string&& _data );
+
+    // waits at most _maxWaitMs, returns false if no message is due
+    bool pop( string& _data, uint64_t _maxWaitMs );
+};
+
+
+// In-memory replacement of the ZMQ broadcast channel for many nodes running in one process.
+// Nodes of the same schain find each other through a process wide registry.
+class SimulatedNetwork : public Network {
+    struct LinkState {
+        SimulatedLinkParams params;
+        uint64_t linkFreeAtUs = 0;
+        boost::random::mt19937 lossGen;
+    };
+
+    ptr< SimulatedMailbox > mailbox;
+
+    vector< LinkState > links;  // indexed by destination schain index - 1
+    mutex linksMutex;
+
+    static map< pair< uint64_t, uint64_t >, ptr< SimulatedMailbox > > registry;
+    static recursive_mutex registryMutex;
+
+    static ptr< SimulatedMailbox > findMailbox( uint64_t _schainID, uint64_t _schainIndex );
+
+    void parseLinkParams();
+
+public:
+    explicit SimulatedNetwork( Schain& _schain );
+
+    ~SimulatedNetwork() override;
+
+    bool sendMessage(
+        const ptr< NodeInfo >& _remoteNodeInfo, const ptr< NetworkMessage >& _msg ) override;
+
+    uint64_t readMessageFromNetwork( ptr< Buffer > _buf ) override;
+
+    void setLinkParams( schain_index _dstIndex, const SimulatedLinkParams& _params );
+
+    SimulatedLinkParams getLinkParams( schain_index _dstIndex );
+
+    static uint64_t nowUs();
+};
@@ -73,6 +73,7 @@
 #include "bls.h"
 
 #include "datastructures/CommittedBlock.h"
+#include "datastructures/Transaction.h"
 #include "datastructures/TransactionList.h"
 
 #pragma GCC diagnostic pop
@@ -104,6 +105,7 @@
 #include "protocols/binconsensus/BinConsensusInstance.h"
 
 #include "tools/utils.h"
+#include "utils/AsyncLogQueue.h"
 
 #include "exceptions/FatalError.h"
 
@@ -119,6 +121,8 @@ using namespace boost::filesystem;
 
 shared_ptr< spdlog::logger > ConsensusEngine::configLogger = nullptr;
 
+atomic< int > ConsensusEngine::configLogLevel = spdlog::level::info;
+
 recursive_mutex ConsensusEngine::logMutex;
 
 atomic< uint64_t > ConsensusEngine::engineCounter;
@@ -179,6 +183,7 @@ void ConsensusEngine::logInit() {
 
 
     configLogger = createLogger( "config" );
+    configLogLevel = configLogger->level();
 }
 
 
@@ -215,6 +220,7 @@ void ConsensusEngine::setConfigLogLevel( string& _s ) {
     auto configLogLevel = SkaleLog::logLevelFromString( _s );
     CHECK_STATE( configLogger != nullptr );
     configLogger->set_level( configLogLevel );
+    ConsensusEngine::configLogLevel = configLogLevel;
 }
 
 void ConsensusEngine::logConfig(
@@ -227,7 +233,7 @@ void ConsensusEngine::log(
     level_enum _severity, const string& _message, const string& _className ) {
     if ( logThreadLocal_ == nullptr ) {
         CHECK_STATE( configLogger != nullptr );
-        configLogger->log( _severity, _message );
+        AsyncLogQueue::getInstance().push( configLogger, _severity, string( _message ) );
     } else {
         auto engine = logThreadLocal_->getEngine();
         CHECK_STATE( engine );
@@ -235,7 +241,8 @@ void ConsensusEngine::log(
         string fullMessage =
             to_string( ( uint64_t ) engine->getLargestCommittedBlockID() ) + ":" + _message;
 
-        logThreadLocal_->loggerForClass( _className.c_str() )->log( _severity, fullMessage );
+        AsyncLogQueue::getInstance().push(
+            logThreadLocal_->loggerForClass( _className.c_str() ), _severity, move( fullMessage ) );
     }
 }
 
@@ -966,6 +973,13 @@ set< node_id >& ConsensusEngine::getNodeIDs() {
     return nodeIDs;
 }
 
+ptr< Node > ConsensusEngine::getNode( node_id _nodeID ) {
+    auto it = nodes.find( _nodeID );
+    if ( it == nodes.end() )
+        return nullptr;
+    return it->second;
+}
+
 
 string ConsensusEngine::getEngineVersion() {
     static string engineVersion( ENGINE_VERSION );
@@ -1132,6 +1146,44 @@ ConsensusEngine::getBlock( block_id _blockId ) {
 }
 
 
+ptr< CommittedBlockView > ConsensusEngine::getBlockView( block_id _blockId ) {
+    CHECK_STATE( nodes.size() > 0 )
+    auto node = nodes.begin()->second;
+    CHECK_STATE( node )
+
+    auto schain = node->getSchain();
+
+    CHECK_STATE( schain );
+
+    auto committedBlock = schain->getBlock( _blockId );
+
+    if ( !committedBlock ) {
+        return nullptr;
+    }
+
+    auto view = make_shared< CommittedBlockView >();
+
+    view->owner = committedBlock;
+    view->timeStampS = committedBlock->getTimeStampS();
+    view->timeStampMs = committedBlock->getTimeStampMs();
+    view->stateRoot = committedBlock->getStateRoot();
+    view->price = schain->getPriceForBlockId( ( uint64_t ) committedBlock->getBlockID() - 1 );
+
+    auto items = committedBlock->getTransactionList()->getItems();
+    CHECK_STATE( items );
+
+    view->transactions.reserve( items->size() );
+
+    for ( auto&& t : *items ) {
+        auto data = t->getData();
+        CHECK_STATE( data );
+        view->transactions.emplace_back( data->data(), data->size() );
+    }
+
+    return view;
+}
+
+
 uint64_t ConsensusEngine::submitOracleRequest(
     const string& _spec, string& _receipt, string& _errorMessage ) {
     if ( nodes.size() == 0 ) {
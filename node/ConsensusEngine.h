@@ -49,6 +49,21 @@ class StorageLimits;
 
 #include "thirdparty/lrucache.hpp"
 
+
+/*
+ * Read only view of a committed block. Transactions are not copied, each entry points into
+ * the shared decoded block, which the view keeps alive through owner.
+ */
+struct CommittedBlockView {
+    ptr< const void > owner;
+    vector< pair< const uint8_t*, size_t > > transactions;
+    uint32_t timeStampS = 0;
+    uint32_t timeStampMs = 0;
+    u256 price = 0;
+    u256 stateRoot = 0;
+};
+
+
 class ConsensusEngine : public ConsensusInterface {
     map< node_id, ptr< Node > > nodes;  // tsafe
 
@@ -103,6 +118,9 @@ class ConsensusEngine : public ConsensusInterface {
 
     static ptr< spdlog::logger > configLogger;
 
+    // level of configLogger, spdlog starts loggers at info
+    static atomic< int > configLogLevel;
+
     string dataDir;
     string logDir;
 
@@ -143,6 +161,10 @@ public:
 
     static void setConfigLogLevel( string& _s );
 
+    static bool isConfigLogEnabled( level_enum _severity ) {
+        return _severity >= configLogLevel.load( memory_order_relaxed );
+    }
+
     [[nodiscard]] const string& getHealthCheckDir() const;
 
     static void log( level_enum _severity, const string& _message, const string& _className );
@@ -199,8 +221,17 @@ public:
     tuple< ptr< ConsensusExtFace::transactions_vector >, uint32_t, uint32_t, u256, u256 > getBlock(
         block_id _blockID );
 
+    /*
+     * Same as getBlock, but hands out pointers into the cached decoded block instead of copying
+     * every transaction. Returns nullptr if the block is not found.
+     */
+    ptr< CommittedBlockView > getBlockView( block_id _blockID );
+
     set< node_id >& getNodeIDs();
 
+    // returns nullptr if the node was not created by this engine
+    ptr< Node > getNode( node_id _nodeID );
+
     static bool isOnTravis();
 
     [[maybe_unused]] static bool isNoUlimitCheck();
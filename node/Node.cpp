@@ -50,6 +50,7 @@
 #include "chains/Schain.h"
 #include "datastructures/CommittedBlock.h"
 #include "db/BlockDB.h"
+#include "db/BlockMetadataIndex.h"
 #include "db/BlockProposalDB.h"
 #include "db/BlockSigShareDB.h"
 #include "db/ConsensusStateDB.h"
@@ -64,6 +65,8 @@
 #include "db/SigDB.h"
 #include "messages/Message.h"
 #include "messages/NetworkMessageEnvelope.h"
+#include "network/ConsensusTrace.h"
+#include "network/SimulatedNetwork.h"
 #include "network/Sockets.h"
 #include "network/TCPServerSocket.h"
 #include "network/ZMQNetwork.h"
@@ -176,12 +179,16 @@ void Node::initLevelDBs() {
     string internalInfoDBPrefix = "/internal_info_" + to_string( nodeID ) + ".db";
 
 
-    blockDB =
-        make_shared< BlockDB >( getSchain(), dbDir, blockDBPrefix, getNodeID(), getBlockDBSize() );
+    blockDB = make_shared< BlockDB >( getSchain(), dbDir, blockDBPrefix, getNodeID(),
+        getBlockDBSize(),
+        getParamUint64( "decodedBlockCacheBytes", DEFAULT_DECODED_BLOCK_CACHE_BYTES ),
+        getParamUint64( "compressBlockDB", 0 ) > 0 );
     randomDB = make_shared< RandomDB >(
         getSchain(), dbDir, randomDBPrefix, getNodeID(), getRandomDBSize() );
     priceDB =
         make_shared< PriceDB >( getSchain(), dbDir, priceDBPrefix, getNodeID(), getPriceDBSize() );
+    blockMetadataIndex = make_shared< BlockMetadataIndex >(
+        dbDir + "/block_metadata_" + to_string( nodeID ) + ".idx" );
     proposalHashDB = make_shared< ProposalHashDB >(
         getSchain(), dbDir, proposalHashDBPrefix, getNodeID(), getProposalHashDBSize() );
     proposalVectorDB = make_shared< ProposalVectorDB >(
@@ -226,6 +233,8 @@ void Node::initLogging() {
             log->loggers[item.first]->set_level( SkaleLog::logLevelFromString( logLevel ) );
         }
     }
+
+    log->updateMinLogLevel();
 }
 
 
@@ -253,6 +262,7 @@ void Node::initParamsFromConfig() {
         getParamUint64( "maxTransactionsPerBlock", MAX_TRANSACTIONS_PER_BLOCK );
     minBlockIntervalMs = getParamUint64( "minBlockIntervalMs", MIN_BLOCK_INTERVAL_MS );
     testNet = ( getParamUint64( "isTestNet", 0 ) > 0 );
+    binaryHeaders = ( getParamUint64( "binaryHeaders", 1 ) > 0 );
 
     blockDBSize = storageLimits->getBlockDbSize();
     proposalHashDBSize = storageLimits->getProposalHashDbSize();
@@ -323,6 +333,10 @@ void Node::startServers( ptr< vector< uint8_t > > _startingFromSnapshotWithThisA
 
     LOG( info, "Starting node on" );
 
+    // server and network threads read the recorder without a lock, so it is set before they
+    // start
+    initTraceRecorder();
+
     LOG( trace, "Initing sockets" );
 
     this->sockets = make_shared< Sockets >( *this );
@@ -336,7 +350,11 @@ void Node::startServers( ptr< vector< uint8_t > > _startingFromSnapshotWithThisA
     LOG( trace, " Creating consensus network" );
 
     if ( !isSyncOnlyNode() ) {
-        network = make_shared< ZMQNetwork >( *sChain );
+        if ( Network::getTransport() == TransportType::SIMULATED ) {
+            network = make_shared< SimulatedNetwork >( *sChain );
+        } else {
+            network = make_shared< ZMQNetwork >( *sChain );
+        }
 
         LOG( trace, " Starting consensus messaging" );
 
@@ -353,6 +371,23 @@ void Node::startServers( ptr< vector< uint8_t > > _startingFromSnapshotWithThisA
 }
 
 
+void Node::initTraceRecorder() {
+    string noTrace = "";
+    auto traceFile = getParamString( "consensusTraceFile", noTrace );
+
+    if ( traceFile.empty() )
+        return;
+
+    // many nodes may run in a single process in tests, so each node gets its own file
+    traceFile += "." + to_string( getNodeID() );
+
+    traceRecorder = make_shared< ConsensusTraceRecorder >(
+        traceFile, sChain->getSchainIndex(), sChain->getNodeCount() );
+
+    LOG( info, "Recording consensus trace to " << traceFile );
+}
+
+
 void Node::startClients() {
     if ( isExitRequested() )
         return;
@@ -564,6 +599,10 @@ void Node::exitImmediately() {
 
     closeAllSocketsAndNotifyAllAgentsAndThreads();
 
+    if ( traceRecorder ) {
+        traceRecorder->flush();
+    }
+
     LOG( info, __FUNCTION__ << string( " completed" ) );
 }
 
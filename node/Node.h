@@ -45,6 +45,7 @@ class BLSPublicKey;
 class BLSPrivateKeyShare;
 class CacheLevelDB;
 class BlockDB;
+class BlockMetadataIndex;
 class BlockProposalDB;
 class RandomDB;
 class PriceDB;
@@ -57,6 +58,7 @@ class BlockSigShareDB;
 class DASigShareDB;
 class DAProofDB;
 class InternalInfoDB;
+class ConsensusTraceRecorder;
 
 namespace leveldb {
 class DB;
@@ -115,6 +117,9 @@ class Node {
 
     ptr< Network > network = nullptr;
 
+    // not null only if consensusTraceFile is set
+    ptr< ConsensusTraceRecorder > traceRecorder = nullptr;
+
     ptr< Schain > sChain = nullptr;
 
     ptr< TestConfig > testConfig = nullptr;
@@ -157,6 +162,8 @@ class Node {
 
     ptr< PriceDB > priceDB = nullptr;
 
+    ptr< BlockMetadataIndex > blockMetadataIndex = nullptr;
+
     ptr< ProposalHashDB > proposalHashDB = nullptr;
 
     ptr< ProposalVectorDB > proposalVectorDB;
@@ -220,6 +227,9 @@ class Node {
     string gethURL = "";
     bool testNet = false;
 
+    // send binary TCP headers to peers that support them
+    bool binaryHeaders = true;
+
 
     bool isSyncNode = false;
 
@@ -267,6 +277,8 @@ public:
 
     bool isTestNet() const;
 
+    bool isBinaryHeaders() const;
+
     [[nodiscard]] const ptr< TestConfig >& getTestConfig() const;
 
     ptr< BlockDB > getBlockDB() const;
@@ -275,6 +287,8 @@ public:
 
     ptr< PriceDB > getPriceDB() const;
 
+    ptr< BlockMetadataIndex > getBlockMetadataIndex() const;
+
     ptr< InternalInfoDB > getInternalInfoDB() const;
 
     ptr< ProposalHashDB > getProposalHashDB() const;
@@ -370,6 +384,10 @@ public:
 
     ptr< Network > getNetwork() const;
 
+    ptr< ConsensusTraceRecorder > getTraceRecorder() const;
+
+    void initTraceRecorder();
+
     string getBindIP() const;
 
     network_port getBasePort() const;
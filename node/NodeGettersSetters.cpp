@@ -184,6 +184,10 @@ ptr< Network > Node::getNetwork() const {
     return network;
 }
 
+ptr< ConsensusTraceRecorder > Node::getTraceRecorder() const {
+    return traceRecorder;
+}
+
 nlohmann::json Node::getCfg() const {
     return cfg;
 }
@@ -251,6 +255,11 @@ ptr< PriceDB > Node::getPriceDB() const {
     return priceDB;
 }
 
+ptr< BlockMetadataIndex > Node::getBlockMetadataIndex() const {
+    CHECK_STATE( blockMetadataIndex )
+    return blockMetadataIndex;
+}
+
 ptr< InternalInfoDB > Node::getInternalInfoDB() const {
     CHECK_STATE( internalInfoDB )
     return internalInfoDB;
@@ -425,6 +434,10 @@ bool Node::isTestNet() const {
     return testNet;
 }
 
+bool Node::isBinaryHeaders() const {
+    return binaryHeaders;
+}
+
 void Node::setExitOnBlockBoundaryRequested() {
     LOG( info, "Set exit on block boundary" );
     exitOnBlockBoundaryRequested = true;
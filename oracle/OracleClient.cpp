@@ -44,7 +44,8 @@
 OracleClient::OracleClient( Schain& _sChain )
     : ProtocolInstance( ORACLE, _sChain ),
       sChain( &_sChain ),
-      receiptsMap( ORACLE_RECEIPTS_MAP_SIZE ) {
+      receiptsMap( ORACLE_RECEIPTS_MAP_SIZE ),
+      resultsBySignedSpec( ORACLE_RECEIPTS_MAP_SIZE ) {
     gethURL = getSchain()->getNode()->getGethUrl();
 
     if ( gethURL.empty() ) {
@@ -62,6 +63,22 @@ uint64_t OracleClient::broadcastRequest( ptr< OracleRequestBroadcastMessage > _m
 
         auto receipt = _msg->getParsedSpec()->getReceipt();
 
+        auto signedKey = _msg->getParsedSpec()->getSpecWithoutPow();
+
+        // a request that differs from an earlier one only in pow gets the same signed
+        // result, so it shares the earlier results instead of being broadcast again
+        auto existing = resultsBySignedSpec.getIfExists( signedKey );
+
+        if ( existing.has_value() ) {
+            auto earlierResults = std::any_cast< ptr< OracleReceivedResults > >( existing );
+            if ( earlierResults->addReceipt() ) {
+                if ( !receiptsMap.putIfDoesNotExist( receipt, earlierResults ) ) {
+                    LOG( err, "Request exists:" << receipt );
+                    return ORACLE_DUPLICATE_REQUEST;
+                }
+                return ORACLE_SUCCESS;
+            }
+        }
 
         auto results = make_shared< OracleReceivedResults >( _msg->getParsedSpec(),
             getSchain()->getRequiredSigners(), ( uint64_t ) getSchain()->getNodeCount(),
@@ -74,6 +91,8 @@ uint64_t OracleClient::broadcastRequest( ptr< OracleRequestBroadcastMessage > _m
             return ORACLE_DUPLICATE_REQUEST;
         }
 
+        resultsBySignedSpec.put( signedKey, results );
+
         LOCK( m );
 
         sChain->getNode()->getNetwork()->broadcastOracleRequestMessage( _msg );
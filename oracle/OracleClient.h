@@ -39,6 +39,9 @@ class OracleClient : public ProtocolInstance {
 
     cache::lru_cache< string, ptr< OracleReceivedResults > > receiptsMap;
 
+    // results by spec without pow, shared by requests that produce the same signed result
+    cache::lru_cache< string, ptr< OracleReceivedResults > > resultsBySignedSpec;
+
     string gethURL;
 
     uint64_t broadcastRequest( ptr< OracleRequestBroadcastMessage > _msg );
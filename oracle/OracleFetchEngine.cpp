@@ -0,0 +1,232 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleFetchEngine.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "exceptions/ExitRequestedException.h"
+#include "node/ConsensusInterface.h"
+
+#include "OracleFetchEngine.h"
+
+
+OracleFetchEngine::OracleFetchEngine(
+    uint64_t _maxConnectionsPerHost, uint64_t _maxTotalConnections, uint64_t _timeoutMs )
+    : timeoutMs( _timeoutMs ) {
+    CHECK_ARGUMENT( _maxConnectionsPerHost > 0 );
+    CHECK_ARGUMENT( _maxTotalConnections >= _maxConnectionsPerHost );
+
+    multi = curl_multi_init();
+    CHECK_STATE2( multi, "Could not init curl multi object" );
+
+    // requests above the limits are queued inside curl until a connection frees up
+    curl_multi_setopt( multi, CURLMOPT_MAX_HOST_CONNECTIONS, ( long ) _maxConnectionsPerHost );
+    curl_multi_setopt( multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, ( long ) _maxTotalConnections );
+    curl_multi_setopt( multi, CURLMOPT_MAXCONNECTS, ( long ) _maxTotalConnections );
+
+    share = curl_share_init();
+    CHECK_STATE2( share, "Could not init curl share object" );
+
+    // the share is used only by the polling thread, so no lock callbacks are needed
+    curl_share_setopt( share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+    curl_share_setopt( share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION );
+}
+
+
+OracleFetchEngine::~OracleFetchEngine() {
+    for ( auto&& [handle, transfer] : inFlight ) {
+        curl_multi_remove_handle( multi, handle );
+        curl_slist_free_all( transfer->headers );
+        curl_easy_cleanup( handle );
+    }
+
+    for ( auto handle : freeHandles ) {
+        curl_easy_cleanup( handle );
+    }
+
+    curl_multi_cleanup( multi );
+    curl_share_cleanup( share );
+}
+
+
+void OracleFetchEngine::submit(
+    const string& _uri, bool _isPost, const string& _postString, Callback _callback ) {
+    CHECK_ARGUMENT( _callback );
+
+    {
+        lock_guard< mutex > lock( pendingMutex );
+        pending.push_back( { _uri, _isPost, _postString, move( _callback ) } );
+    }
+
+    inFlightCount++;
+
+    wakeup();
+}
+
+
+void OracleFetchEngine::wakeup() {
+    curl_multi_wakeup( multi );
+}
+
+
+uint64_t OracleFetchEngine::getInFlightCount() const {
+    return inFlightCount;
+}
+
+
+size_t OracleFetchEngine::writeCallback(
+    void* _contents, size_t _size, size_t _nmemb, void* _userp ) {
+    auto realSize = _size * _nmemb;
+    auto transfer = ( Transfer* ) _userp;
+    transfer->response.append( ( const char* ) _contents, realSize );
+    return realSize;
+}
+
+
+void OracleFetchEngine::startPendingTransfers() {
+    vector< PendingRequest > requests;
+
+    {
+        lock_guard< mutex > lock( pendingMutex );
+        requests.swap( pending );
+    }
+
+    for ( auto&& request : requests ) {
+        startTransfer( request );
+    }
+}
+
+
+void OracleFetchEngine::startTransfer( PendingRequest& _request ) {
+    auto transfer = make_shared< Transfer >();
+    transfer->uri = move( _request.uri );
+    transfer->postString = move( _request.postString );
+    transfer->callback = move( _request.callback );
+
+    if ( !freeHandles.empty() ) {
+        transfer->handle = freeHandles.back();
+        freeHandles.pop_back();
+        curl_easy_reset( transfer->handle );
+    } else {
+        transfer->handle = curl_easy_init();
+        CHECK_STATE2( transfer->handle, "Could not init curl object" );
+    }
+
+    auto curl = transfer->handle;
+
+    curl_easy_setopt( curl, CURLOPT_URL, transfer->uri.c_str() );
+    curl_easy_setopt( curl, CURLOPT_SSL_VERIFYPEER, 1L );
+    curl_easy_setopt( curl, CURLOPT_WRITEFUNCTION, writeCallback );
+    curl_easy_setopt( curl, CURLOPT_WRITEDATA, ( void* ) transfer.get() );
+    curl_easy_setopt( curl, CURLOPT_PRIVATE, ( void* ) transfer.get() );
+    curl_easy_setopt( curl, CURLOPT_COOKIEFILE, "" );
+    curl_easy_setopt( curl, CURLOPT_TIMEOUT_MS, ( long ) timeoutMs );
+    curl_easy_setopt( curl, CURLOPT_USERAGENT, "libcurl-agent/1.0" );
+    curl_easy_setopt( curl, CURLOPT_DNS_SERVERS, "8.8.8.8" );
+    curl_easy_setopt( curl, CURLOPT_SHARE, share );
+    curl_easy_setopt( curl, CURLOPT_NOSIGNAL, 1L );
+
+    if ( _request.isPost ) {
+        transfer->headers = curl_slist_append( nullptr, "Content-Type: application/json" );
+        curl_easy_setopt( curl, CURLOPT_HTTPHEADER, transfer->headers );
+        curl_easy_setopt( curl, CURLOPT_POSTFIELDS, transfer->postString.c_str() );
+    }
+
+    inFlight[curl] = transfer;
+
+    auto res = curl_multi_add_handle( multi, curl );
+
+    if ( res != CURLM_OK ) {
+        LOG( err, "Curl multi add handle failed for url: " << transfer->uri
+                                                           << " with error code:"
+                                                           << to_string( res ) );
+        finishTransfer( curl, CURLE_FAILED_INIT );
+    }
+}
+
+
+void OracleFetchEngine::finishTransfer( CURL* _handle, CURLcode _result ) {
+    auto it = inFlight.find( _handle );
+    CHECK_STATE( it != inFlight.end() );
+
+    auto transfer = it->second;
+    inFlight.erase( it );
+
+    curl_multi_remove_handle( multi, _handle );
+    curl_slist_free_all( transfer->headers );
+    transfer->headers = nullptr;
+    freeHandles.push_back( _handle );
+
+    uint64_t status = ORACLE_SUCCESS;
+
+    if ( _result != CURLE_OK ) {
+        LOG( err, "Curl transfer failed for url: " << transfer->uri
+                                                   << " with error code:" + to_string( _result ) );
+        status = ORACLE_COULD_NOT_CONNECT_TO_ENDPOINT;
+    }
+
+    inFlightCount--;
+
+    try {
+        transfer->callback( status, transfer->response );
+    } catch ( ExitRequestedException& ) {
+        throw;
+    } catch ( exception& e ) {
+        SkaleException::logNested( e );
+    }
+}
+
+
+uint64_t OracleFetchEngine::poll( uint64_t _maxWaitMs ) {
+    auto noThread = thread::id();
+    if ( !pollThread.compare_exchange_strong( noThread, this_thread::get_id() ) )
+        CHECK_STATE2( noThread == this_thread::get_id(), "poll() called from a second thread" );
+
+    startPendingTransfers();
+
+    int running = 0;
+    curl_multi_perform( multi, &running );
+
+    uint64_t completed = 0;
+
+    auto collect = [&]() {
+        CURLMsg* msg;
+        int remaining = 0;
+        while ( ( msg = curl_multi_info_read( multi, &remaining ) ) ) {
+            if ( msg->msg == CURLMSG_DONE ) {
+                finishTransfer( msg->easy_handle, msg->data.result );
+                completed++;
+            }
+        }
+    };
+
+    collect();
+
+    if ( completed == 0 && _maxWaitMs > 0 ) {
+        curl_multi_poll( multi, nullptr, 0, ( int ) _maxWaitMs, nullptr );
+        startPendingTransfers();
+        curl_multi_perform( multi, &running );
+        collect();
+    }
+
+    return completed;
+}
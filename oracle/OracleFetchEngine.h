@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleFetchEngine.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include <curl/curl.h>
+
+
+// Event driven HTTP fetcher for oracle endpoints. All transfers run on one curl multi handle
+// that is driven by the thread calling poll(), so many slow endpoints can be in flight at the
+// same time. The multi handle keeps a cache of live connections, and a share handle keeps DNS
+// and TLS sessions, so repeated requests to the same endpoint skip the handshakes.
+class OracleFetchEngine {
+public:
+    typedef function< void( uint64_t _status, const string& _response ) > Callback;
+
+private:
+    struct Transfer {
+        CURL* handle = nullptr;
+        curl_slist* headers = nullptr;
+        string uri;
+        string postString;
+        string response;
+        Callback callback;
+    };
+
+    struct PendingRequest {
+        string uri;
+        bool isPost = false;
+        string postString;
+        Callback callback;
+    };
+
+    CURLM* multi = nullptr;
+    CURLSH* share = nullptr;
+
+    uint64_t timeoutMs;
+
+    // submit() may be called from any thread, the transfers are touched only by poll()
+    mutex pendingMutex;
+    vector< PendingRequest > pending;
+
+    map< CURL*, ptr< Transfer > > inFlight;
+    vector< CURL* > freeHandles;
+
+    atomic< uint64_t > inFlightCount = 0;
+
+    // the one thread that may call poll(), set by the first call
+    atomic< thread::id > pollThread;
+
+    void startPendingTransfers();
+
+    void startTransfer( PendingRequest& _request );
+
+    void finishTransfer( CURL* _handle, CURLcode _result );
+
+    static size_t writeCallback( void* _contents, size_t _size, size_t _nmemb, void* _userp );
+
+public:
+    OracleFetchEngine( uint64_t _maxConnectionsPerHost, uint64_t _maxTotalConnections,
+        uint64_t _timeoutMs );
+
+    ~OracleFetchEngine();
+
+    // Thread safe. The callback is invoked later from the thread calling poll().
+    void submit( const string& _uri, bool _isPost, const string& _postString, Callback _callback );
+
+    // Drives all transfers, waiting up to _maxWaitMs for socket activity if nothing completed.
+    // Returns the number of callbacks invoked. Not thread safe, every call must come from the
+    // same thread.
+    uint64_t poll( uint64_t _maxWaitMs );
+
+    // Thread safe. Makes a poll() that is waiting for sockets return immediately.
+    void wakeup();
+
+    // Requests submitted and not yet completed
+    uint64_t getInFlightCount() const;
+};
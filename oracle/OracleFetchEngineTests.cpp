@@ -0,0 +1,191 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleFetchEngineTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "node/ConsensusInterface.h"
+#include "thirdparty/catch.hpp"
+#include "utils/Time.h"
+
+#include "OracleFetchEngine.h"
+
+
+// Minimal keep-alive HTTP server on the loopback. GET /delay/N answers after N ms.
+class StubHttpServer {
+    int listenFd = -1;
+    uint16_t port = 0;
+    atomic< bool > stopped = false;
+    thread acceptThread;
+    mutex connectionsMutex;
+    vector< thread > connections;
+
+    static void serveConnection( int _fd ) {
+        string buffer;
+        char chunk[4096];
+
+        while ( true ) {
+            auto end = buffer.find( "\r\n\r\n" );
+            if ( end == string::npos ) {
+                auto n = ::recv( _fd, chunk, sizeof( chunk ), 0 );
+                if ( n <= 0 )
+                    break;
+                buffer.append( chunk, n );
+                continue;
+            }
+
+            auto requestLine = buffer.substr( 0, buffer.find( "\r\n" ) );
+            buffer.erase( 0, end + 4 );
+
+            uint64_t delayMs = 0;
+            auto pos = requestLine.find( "/delay/" );
+            if ( pos != string::npos )
+                delayMs = stoull( requestLine.substr( pos + 7 ) );
+
+            usleep( delayMs * 1000 );
+
+            string body = "{\"result\":" + to_string( delayMs ) + "}";
+            string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                              "Content-Length: " +
+                              to_string( body.size() ) + "\r\n\r\n" + body;
+            if ( ::send( _fd, response.data(), response.size(), MSG_NOSIGNAL ) < 0 )
+                break;
+        }
+
+        ::close( _fd );
+    }
+
+public:
+    StubHttpServer() {
+        listenFd = ::socket( AF_INET, SOCK_STREAM, 0 );
+        CHECK_STATE( listenFd >= 0 );
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        CHECK_STATE( ::bind( listenFd, ( sockaddr* ) &addr, sizeof( addr ) ) == 0 );
+        CHECK_STATE( ::listen( listenFd, 512 ) == 0 );
+
+        socklen_t len = sizeof( addr );
+        CHECK_STATE( ::getsockname( listenFd, ( sockaddr* ) &addr, &len ) == 0 );
+        port = ntohs( addr.sin_port );
+
+        acceptThread = thread( [this]() {
+            while ( !stopped ) {
+                auto fd = ::accept( listenFd, nullptr, nullptr );
+                if ( fd < 0 )
+                    break;
+                lock_guard< mutex > lock( connectionsMutex );
+                connections.emplace_back( serveConnection, fd );
+            }
+        } );
+    }
+
+    ~StubHttpServer() {
+        stopped = true;
+        ::shutdown( listenFd, SHUT_RDWR );
+        ::close( listenFd );
+        acceptThread.join();
+        lock_guard< mutex > lock( connectionsMutex );
+        for ( auto&& t : connections )
+            t.detach();
+    }
+
+    string getUrl( uint64_t _delayMs ) const {
+        return "http://127.0.0.1:" + to_string( port ) + "/delay/" + to_string( _delayMs );
+    }
+};
+
+
+static uint64_t runUntilDone( OracleFetchEngine& _engine ) {
+    uint64_t completed = 0;
+    while ( _engine.getInFlightCount() > 0 )
+        completed += _engine.poll( 100 );
+    return completed;
+}
+
+
+TEST_CASE( "Oracle fetch engine completes all requests", "[oracle-fetch]" ) {
+    curl_global_init( CURL_GLOBAL_ALL );
+
+    StubHttpServer server;
+    OracleFetchEngine engine( 8, 64, 2000 );
+
+    uint64_t successes = 0;
+    uint64_t failures = 0;
+
+    for ( uint64_t i = 0; i < 20; i++ ) {
+        engine.submit( server.getUrl( i ), false, "", [&, i]( uint64_t _status, const string& _r ) {
+            if ( _status == ORACLE_SUCCESS && _r == "{\"result\":" + to_string( i ) + "}" )
+                successes++;
+            else
+                failures++;
+        } );
+    }
+
+    // an endpoint that is slower than the timeout fails without holding up the rest
+    engine.submit( server.getUrl( 3000 ), false, "",
+        [&]( uint64_t _status, const string& ) { REQUIRE( _status != ORACLE_SUCCESS ); } );
+
+    REQUIRE( runUntilDone( engine ) == 21 );
+    REQUIRE( successes == 20 );
+    REQUIRE( failures == 0 );
+}
+
+
+TEST_CASE( "Oracle fetch engine benchmark", "[.benchmark]" ) {
+    curl_global_init( CURL_GLOBAL_ALL );
+
+    StubHttpServer server;
+
+    static constexpr uint64_t REQUESTS = 64;
+    static constexpr uint64_t DELAY_MS = 50;
+
+    // one request at a time, which is what the blocking curl_easy_perform worker did
+    OracleFetchEngine serialEngine( 1, 1, 2000 );
+    auto start = Time::getCurrentTimeMs();
+    for ( uint64_t i = 0; i < REQUESTS; i++ ) {
+        serialEngine.submit(
+            server.getUrl( DELAY_MS ), false, "", []( uint64_t, const string& ) {} );
+        runUntilDone( serialEngine );
+    }
+    auto serialMs = Time::getCurrentTimeMs() - start;
+
+    OracleFetchEngine engine( ORACLE_MAX_CONNECTIONS_PER_HOST * 4, ORACLE_MAX_TOTAL_CONNECTIONS,
+        ORACLE_HTTP_TIMEOUT_MS );
+    start = Time::getCurrentTimeMs();
+    for ( uint64_t i = 0; i < REQUESTS; i++ ) {
+        engine.submit( server.getUrl( DELAY_MS ), false, "", []( uint64_t, const string& ) {} );
+    }
+    REQUIRE( runUntilDone( engine ) == REQUESTS );
+    auto concurrentMs = Time::getCurrentTimeMs() - start;
+
+    WARN( "Oracle fetch of " << REQUESTS << " x " << DELAY_MS << "ms endpoints: serial "
+          << serialMs << "ms, concurrent " << concurrentMs << "ms" );
+
+}
@@ -164,6 +164,17 @@ uint64_t OracleReceivedResults::tryGettingResult( string& _result ) {
     }
 }
 
+bool OracleReceivedResults::addReceipt() {
+    if ( getRequestTime() + ORACLE_TIMEOUT_MS < Time::getCurrentTimeMs() )
+        return false;
+    receiptCount++;
+    return true;
+}
+
+uint64_t OracleReceivedResults::getReceiptCount() const {
+    return receiptCount;
+}
+
 const ptr< OracleRequestSpec >& OracleReceivedResults::getRequestSpec() const {
     return requestSpec;
 }
@@ -18,6 +18,7 @@ class OracleReceivedResults {
     ptr< map< string, uint64_t > > resultsByCount;
     ptr< OracleRequestSpec > requestSpec;
     bool isSgx;
+    atomic< uint64_t > receiptCount = 1;
 
     vector< uint8_t > ecdsaSigStringToByteArray( string& _sig );
 
@@ -33,6 +34,12 @@ public:
 
     uint64_t tryGettingResult( string& _result );
 
+    // Lets another receipt whose spec differs only in pow share these results, since the
+    // signed result is identical. Returns false if the results already timed out.
+    bool addReceipt();
+
+    uint64_t getReceiptCount() const;
+
     string compileCompleteResultJson( string& _unsignedResult );
 
     string compileCompleteResultRlp( string& _unsignedResult );
@@ -0,0 +1,99 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleRequestCoalescer.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "node/ConsensusInterface.h"
+
+#include "OracleRequestCoalescer.h"
+
+
+OracleRequestCoalescer::OracleRequestCoalescer( uint64_t _responseCacheMs,
+    uint64_t _responseCacheSize, uint64_t _signedResultsCacheSize )
+    : responses( _responseCacheSize ),
+      responseCacheMs( _responseCacheMs ),
+      signedResults( _signedResultsCacheSize ) {}
+
+
+ptr< CachedEndpointResponse > OracleRequestCoalescer::getCachedResponse(
+    const string& _fetchKey, uint64_t _nowMs ) {
+    if ( responseCacheMs == 0 )
+        return nullptr;
+
+    auto cached = responses.getIfExists( _fetchKey );
+    if ( !cached.has_value() )
+        return nullptr;
+
+    auto entry = any_cast< ptr< CachedEndpointResponse > >( cached );
+    if ( entry->timeMs + responseCacheMs < _nowMs )
+        return nullptr;
+
+    return entry;
+}
+
+
+bool OracleRequestCoalescer::addWaiter( const string& _fetchKey, const Waiter& _waiter ) {
+    auto& waiters = inFlight[_fetchKey];
+    waiters.push_back( _waiter );
+    return waiters.size() == 1;
+}
+
+
+vector< OracleRequestCoalescer::Waiter > OracleRequestCoalescer::complete(
+    const string& _fetchKey, uint64_t _status, const string& _response, uint64_t _nowMs ) {
+    auto it = inFlight.find( _fetchKey );
+    CHECK_STATE( it != inFlight.end() );
+
+    auto waiters = move( it->second );
+    inFlight.erase( it );
+
+    if ( responseCacheMs > 0 && _status == ORACLE_SUCCESS ) {
+        responses.put( _fetchKey, make_shared< CachedEndpointResponse >(
+                                      CachedEndpointResponse{ _nowMs, _status, _response } ) );
+    }
+
+    return waiters;
+}
+
+
+bool OracleRequestCoalescer::getSignedResult( const string& _signedKey, string& _result ) {
+    auto cached = signedResults.getIfExists( _signedKey );
+    if ( !cached.has_value() )
+        return false;
+
+    _result = any_cast< string >( cached );
+    return true;
+}
+
+
+void OracleRequestCoalescer::putSignedResult(
+    const string& _signedKey, uint64_t _status, const string& _result ) {
+    if ( _status == ORACLE_SUCCESS )
+        signedResults.put( _signedKey, _result );
+}
+
+
+uint64_t OracleRequestCoalescer::getInFlightCount() const {
+    return inFlight.size();
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleRequestCoalescer.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+#include "thirdparty/lrucache.hpp"
+
+class OracleRequestSpec;
+
+struct CachedEndpointResponse {
+    uint64_t timeMs;
+    uint64_t status;
+    string response;
+};
+
+
+// Bookkeeping that lets the oracle server answer equal requests with one endpoint call and one
+// signature. Requests wait on a fetch key while its call is in flight, successful raw responses
+// are kept for a configurable time, and successful signed results are kept by the spec without
+// pow. Not thread safe, the oracle server uses it from its worker thread only.
+class OracleRequestCoalescer {
+public:
+    typedef pair< ptr< OracleRequestSpec >, schain_index > Waiter;
+
+private:
+    map< string, vector< Waiter > > inFlight;
+
+    cache::lru_cache< string, ptr< CachedEndpointResponse > > responses;
+
+    // 0 disables the response cache
+    uint64_t responseCacheMs;
+
+    cache::lru_cache< string, string > signedResults;
+
+public:
+    OracleRequestCoalescer( uint64_t _responseCacheMs, uint64_t _responseCacheSize,
+        uint64_t _signedResultsCacheSize );
+
+    // a response for _fetchKey received at most responseCacheMs before _nowMs, or nullptr
+    ptr< CachedEndpointResponse > getCachedResponse( const string& _fetchKey, uint64_t _nowMs );
+
+    // Adds a request waiting on _fetchKey. Returns true if no call for the key is in flight yet,
+    // then the caller starts it.
+    bool addWaiter( const string& _fetchKey, const Waiter& _waiter );
+
+    // Removes and returns the requests waiting on _fetchKey. A successful response is cached.
+    vector< Waiter > complete(
+        const string& _fetchKey, uint64_t _status, const string& _response, uint64_t _nowMs );
+
+    // returns false if no signed result for _signedKey is cached
+    bool getSignedResult( const string& _signedKey, string& _result );
+
+    // only successful results are cached, an error may go away on the next call
+    void putSignedResult( const string& _signedKey, uint64_t _status, const string& _result );
+
+    [[nodiscard]] uint64_t getInFlightCount() const;
+};
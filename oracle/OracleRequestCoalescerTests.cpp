@@ -0,0 +1,154 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file OracleRequestCoalescerTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "node/ConsensusInterface.h"
+#include "thirdparty/catch.hpp"
+
+#include "OracleRequestCoalescer.h"
+#include "OracleRequestSpec.h"
+
+
+static const string URI = "https://example.com/api";
+
+
+static ptr< OracleRequestSpec > makeSpec( const vector< string >& _jsps,
+    const vector< uint64_t >& _trims, const string& _post, uint64_t _time ) {
+    return OracleRequestSpec::makeWebSpec( 1, URI, _jsps, _trims, _post, "json", _time );
+}
+
+
+// the same spec with the next valid pow, as sent by a client that retries a request
+static ptr< OracleRequestSpec > withOtherPow( const ptr< OracleRequestSpec >& _spec ) {
+    for ( auto pow = _spec->getPow() + 1;; pow++ ) {
+        auto spec = _spec->getSpecWithoutPow() + "\"pow\":" + to_string( pow ) + "}";
+        if ( OracleRequestSpec::verifyPow( spec ) )
+            return make_shared< OracleRequestSpec >( spec );
+    }
+}
+
+
+TEST_CASE( "Oracle fetch key identifies the endpoint call", "[oracle-coalesce]" ) {
+    auto spec = makeSpec( { "/a" }, { 0 }, "", 1000 );
+
+    // the result part of the spec and its time do not change what is fetched
+    REQUIRE( spec->getFetchKey() == makeSpec( { "/b", "/c" }, { 1, 2 }, "", 2000 )->getFetchKey() );
+    REQUIRE( spec->getFetchKey() == withOtherPow( spec )->getFetchKey() );
+
+    REQUIRE( spec->getFetchKey() != makeSpec( { "/a" }, { 0 }, "body", 1000 )->getFetchKey() );
+    REQUIRE( spec->getFetchKey() !=
+             OracleRequestSpec::makeWebSpec( 2, URI, { "/a" }, { 0 }, "", "json", 1000 )
+                 ->getFetchKey() );
+    REQUIRE( spec->getFetchKey() !=
+             OracleRequestSpec::makeWebSpec( 1, URI + "/v2", { "/a" }, { 0 }, "", "json", 1000 )
+                 ->getFetchKey() );
+
+    auto ethCall = [&]( const string& _data ) {
+        return OracleRequestSpec::makeEthCallSpec( 1, "http://localhost:8545/",
+            "0x9876543210987654321098765432109876543210",
+            "0x5FbDB2315678afecb367f032d93F642f64180aa3", _data, "0x100000", "latest", "json",
+            1000 );
+    };
+
+    REQUIRE( ethCall( "0x893d20e8" )->getFetchKey() == ethCall( "0x893d20e8" )->getFetchKey() );
+    REQUIRE( ethCall( "0x893d20e8" )->getFetchKey() != ethCall( "0x893d20e9" )->getFetchKey() );
+}
+
+
+TEST_CASE( "Oracle spec without pow", "[oracle-coalesce]" ) {
+    auto spec = makeSpec( { "/a" }, { 0 }, "", 1000 );
+    auto signedKey = spec->getSpecWithoutPow();
+
+    REQUIRE( spec->getSpec().find( signedKey ) == 0 );
+    REQUIRE( signedKey.find( "pow" ) == string::npos );
+
+    REQUIRE( withOtherPow( spec )->getSpecWithoutPow() == signedKey );
+
+    // the signature covers time and the result part
+    REQUIRE( makeSpec( { "/a" }, { 0 }, "", 2000 )->getSpecWithoutPow() != signedKey );
+    REQUIRE( makeSpec( { "/b" }, { 0 }, "", 1000 )->getSpecWithoutPow() != signedKey );
+}
+
+
+TEST_CASE( "Oracle requests wait on one endpoint call", "[oracle-coalesce]" ) {
+    OracleRequestCoalescer coalescer( 0, 10, 10 );
+
+    auto a = makeSpec( { "/a" }, {}, "", 1000 );
+    auto b = makeSpec( { "/b" }, {}, "", 1001 );
+    auto other = makeSpec( { "/a" }, {}, "body", 1000 );
+
+    REQUIRE( coalescer.addWaiter( a->getFetchKey(), { a, schain_index( 1 ) } ) );
+    REQUIRE( !coalescer.addWaiter( b->getFetchKey(), { b, schain_index( 2 ) } ) );
+    REQUIRE( coalescer.addWaiter( other->getFetchKey(), { other, schain_index( 3 ) } ) );
+    REQUIRE( coalescer.getInFlightCount() == 2 );
+
+    auto waiters = coalescer.complete( a->getFetchKey(), ORACLE_SUCCESS, "{}", 1000 );
+    REQUIRE( waiters.size() == 2 );
+    REQUIRE( waiters[0].first == a );
+    REQUIRE( waiters[1].first == b );
+    REQUIRE( waiters[1].second == schain_index( 2 ) );
+    REQUIRE( coalescer.getInFlightCount() == 1 );
+
+    // the next request starts a new call, the cache is off
+    REQUIRE( coalescer.getCachedResponse( a->getFetchKey(), 1000 ) == nullptr );
+    REQUIRE( coalescer.addWaiter( a->getFetchKey(), { a, schain_index( 1 ) } ) );
+
+    REQUIRE_THROWS( coalescer.complete( "unknown", ORACLE_SUCCESS, "{}", 1000 ) );
+}
+
+
+TEST_CASE( "Oracle response cache expires", "[oracle-coalesce]" ) {
+    OracleRequestCoalescer coalescer( 500, 10, 10 );
+
+    auto key = makeSpec( { "/a" }, {}, "", 1000 )->getFetchKey();
+
+    coalescer.addWaiter( key, { nullptr, schain_index( 1 ) } );
+    coalescer.complete( key, ORACLE_SUCCESS, "{\"a\":1}", 1000 );
+
+    auto cached = coalescer.getCachedResponse( key, 1500 );
+    REQUIRE( cached );
+    REQUIRE( cached->status == ORACLE_SUCCESS );
+    REQUIRE( cached->response == "{\"a\":1}" );
+
+    REQUIRE( coalescer.getCachedResponse( key, 1501 ) == nullptr );
+
+    // failed calls are not cached
+    coalescer.addWaiter( key, { nullptr, schain_index( 1 ) } );
+    coalescer.complete( key, ORACLE_COULD_NOT_CONNECT_TO_ENDPOINT, "", 2000 );
+    REQUIRE( coalescer.getCachedResponse( key, 2000 ) == nullptr );
+}
+
+
+TEST_CASE( "Oracle signed results cache only successes", "[oracle-coalesce]" ) {
+    OracleRequestCoalescer coalescer( 0, 10, 10 );
+    string result;
+
+    coalescer.putSignedResult( "error", ORACLE_COULD_NOT_CONNECT_TO_ENDPOINT, "signed error" );
+    REQUIRE( !coalescer.getSignedResult( "error", result ) );
+
+    coalescer.putSignedResult( "ok", ORACLE_SUCCESS, "signed result" );
+    REQUIRE( coalescer.getSignedResult( "ok", result ) );
+    REQUIRE( result == "signed result" );
+}
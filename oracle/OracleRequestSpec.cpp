@@ -487,6 +487,22 @@ bool OracleRequestSpec::isEthMainnet() const {
     return uri == "eth://";
 }
 
+string OracleRequestSpec::getFetchKey() const {
+    string key = to_string( chainid ) + "\n" + uri + "\n";
+    if ( !ethApi.empty() ) {
+        key.append( ethApi + "\n" + from + "\n" + to + "\n" + data + "\n" + gas + "\n" + blockId );
+    } else {
+        key.append( post );
+    }
+    return key;
+}
+
+string OracleRequestSpec::getSpecWithoutPow() const {
+    auto commaPosition = spec.find_last_of( "," );
+    CHECK_STATE( commaPosition != string::npos );
+    return spec.substr( 0, commaPosition + 1 );
+}
+
 const string& OracleRequestSpec::getEthApi() const {
     return ethApi;
 }
@@ -126,6 +126,14 @@ public:
 
     bool isEthMainnet() const;
 
+    // Identifies the endpoint call. Specs that differ only in time, pow, jsps or trims fetch
+    // the same data.
+    string getFetchKey() const;
+
+    // The spec without the trailing pow. This is the part covered by the result signature, so
+    // specs with equal values produce identical signed results.
+    string getSpecWithoutPow() const;
+
     static ptr< OracleRequestSpec > makeWebSpec( uint64_t _chainId, const string& _uri,
         const vector< string >& _jsps, const vector< uint64_t >& _trims, const string& _post,
         const string& _encoding, uint64_t _time );
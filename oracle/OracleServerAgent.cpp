@@ -55,6 +55,8 @@
 
 #include "OracleClient.h"
 #include "OracleErrors.h"
+#include "OracleFetchEngine.h"
+#include "OracleRequestCoalescer.h"
 #include "OracleRequestBroadcastMessage.h"
 #include "OracleRequestSpec.h"
 #include "OracleResponseMessage.h"
@@ -65,7 +67,9 @@
 #include "utils/Time.h"
 
 OracleServerAgent::OracleServerAgent( Schain& _schain )
-    : Agent( _schain, true ), requestCounter( 0 ), threadCounter( 0 ) {
+    : Agent( _schain, true ),
+      requestCounter( 0 ),
+      threadCounter( 0 ) {
     if ( _schain.getNode()->isTestNet() ) {
         // allow things like IP based URLS for tests
         OracleRequestSpec::setTestMode();
@@ -73,11 +77,18 @@ OracleServerAgent::OracleServerAgent( Schain& _schain )
 
     gethURL = getSchain()->getNode()->getGethUrl();
 
+    coalescer = make_shared< OracleRequestCoalescer >(
+        getSchain()->getNode()->getParamUint64( "oracleResponseCacheMs", 0 ),
+        ORACLE_RESPONSE_CACHE_SIZE, ORACLE_SIGNED_RESULTS_CACHE_SIZE );
+
     for ( int i = 0; i < NUM_ORACLE_THREADS; i++ ) {
         incomingQueues.push_back(
             make_shared< BlockingReaderWriterQueue< shared_ptr< MessageEnvelope > > >() );
     }
 
+    fetchEngine = make_shared< OracleFetchEngine >(
+        ORACLE_MAX_CONNECTIONS_PER_HOST, ORACLE_MAX_TOTAL_CONNECTIONS, ORACLE_HTTP_TIMEOUT_MS );
+
     try {
         LOG( info, "Constructing OracleThreadPool" );
 
@@ -104,6 +115,9 @@ void OracleServerAgent::routeAndProcessMessage( const ptr< MessageEnvelope >& _m
 
             this->incomingQueues.at( value % ( uint64_t ) NUM_ORACLE_THREADS )->enqueue( _me );
 
+            // the worker may be waiting on endpoint sockets rather than on the queue
+            fetchEngine->wakeup();
+
             return;
         } else {
             auto client = getSchain()->getOracleClient();
@@ -132,45 +146,25 @@ void OracleServerAgent::workerThreadItemSendLoop( OracleServerAgent* _agent ) {
 
     auto agent = ( Agent* ) _agent;
 
+    auto queue = _agent->incomingQueues.at( threadNumber - 1 );
+    auto engine = _agent->fetchEngine;
+
     while ( !agent->getSchain()->getNode()->isExitRequested() ) {
         try {
             ptr< MessageEnvelope > msge;
 
-            auto success = _agent->incomingQueues.at( threadNumber - 1 )
-                               ->wait_dequeue_timed( msge, 1000 * ORACLE_QUEUE_TIMEOUT_MS );
-            if ( !success )
-                continue;
-
-            auto orclMsg =
-                dynamic_pointer_cast< OracleRequestBroadcastMessage >( msge->getMessage() );
-
-
-            auto spec = orclMsg->getParsedSpec();
-
-            if ( spec->getChainId() != agent->getSchain()->getSchainID() ) {
-                LOG( err, string( "Received msg with invalid schain id in oracle spec:" )
-                              << to_string( spec->getChainId() ) );
-                continue;
-            }
-
-            if ( spec->getTime() + ORACLE_REQUEST_AGE_ON_RECEIPT_MS < Time::getCurrentTimeMs() ) {
-                LOG( err, string( "Received msg with old request with age:" )
-                              << to_string( Time::getCurrentTimeMs() - spec->getTime() ) );
-                continue;
+            // block on the queue only when there are no endpoint requests to drive
+            if ( engine->getInFlightCount() == 0 &&
+                 queue->wait_dequeue_timed( msge, 1000 * ORACLE_QUEUE_TIMEOUT_MS ) ) {
+                _agent->processRequestMessage( msge );
             }
 
-            if ( spec->getTime() > Time::getCurrentTimeMs() + ORACLE_REQUEST_FUTURE_JITTER_MS ) {
-                LOG( err, string( "Received msg with oracle request with time in the future:" )
-                              << to_string( spec->getTime() - Time::getCurrentTimeMs() ) );
-                continue;
+            while ( queue->try_dequeue( msge ) ) {
+                _agent->processRequestMessage( msge );
             }
 
-
-            CHECK_STATE( orclMsg );
-
-            auto msg = _agent->doEndpointRequestResponse( orclMsg->getParsedSpec() );
-
-            _agent->sendOutResult( msg, msge->getSrcSchainIndex() );
+            if ( engine->getInFlightCount() > 0 )
+                engine->poll( ORACLE_FETCH_POLL_MS );
         } catch ( ExitRequestedException& e ) {
             return;
         } catch ( exception& e ) {
@@ -181,31 +175,53 @@ void OracleServerAgent::workerThreadItemSendLoop( OracleServerAgent* _agent ) {
     }
 }
 
-struct MemoryStruct {
-    char* memory;
-    size_t size;
-};
+void OracleServerAgent::processRequestMessage( const ptr< MessageEnvelope >& _me ) {
+    CHECK_ARGUMENT( _me );
 
-static size_t WriteMemoryCallback( void* contents, size_t size, size_t nmemb, void* userp ) {
-    size_t realsize = size * nmemb;
-    struct MemoryStruct* mem = ( struct MemoryStruct* ) userp;
+    auto orclMsg = dynamic_pointer_cast< OracleRequestBroadcastMessage >( _me->getMessage() );
 
-    char* ptr = ( char* ) realloc( mem->memory, mem->size + realsize + 1 );
-    CHECK_STATE( ptr );
-    mem->memory = ptr;
-    memcpy( &( mem->memory[mem->size] ), contents, realsize );
-    mem->size += realsize;
-    mem->memory[mem->size] = 0;
+    CHECK_STATE( orclMsg );
 
-    return realsize;
+    auto spec = orclMsg->getParsedSpec();
+
+    if ( spec->getChainId() != getSchain()->getSchainID() ) {
+        LOG( err, string( "Received msg with invalid schain id in oracle spec:" )
+                      << to_string( spec->getChainId() ) );
+        return;
+    }
+
+    if ( spec->getTime() + ORACLE_REQUEST_AGE_ON_RECEIPT_MS < Time::getCurrentTimeMs() ) {
+        LOG( err, string( "Received msg with old request with age:" )
+                      << to_string( Time::getCurrentTimeMs() - spec->getTime() ) );
+        return;
+    }
+
+    if ( spec->getTime() > Time::getCurrentTimeMs() + ORACLE_REQUEST_FUTURE_JITTER_MS ) {
+        LOG( err, string( "Received msg with oracle request with time in the future:" )
+                      << to_string( spec->getTime() - Time::getCurrentTimeMs() ) );
+        return;
+    }
+
+    submitEndpointRequest( spec, _me->getSrcSchainIndex() );
 }
 
 using namespace nlohmann;
 
-ptr< OracleResponseMessage > OracleServerAgent::doEndpointRequestResponse(
-    ptr< OracleRequestSpec > _requestSpec ) {
+void OracleServerAgent::submitEndpointRequest(
+    ptr< OracleRequestSpec > _requestSpec, schain_index _source ) {
     CHECK_ARGUMENT( _requestSpec )
 
+    auto fetchKey = _requestSpec->getFetchKey();
+
+    auto cached = coalescer->getCachedResponse( fetchKey, Time::getCurrentTimeMs() );
+    if ( cached ) {
+        replyToRequest( _requestSpec, _source, cached->status, cached->response );
+        return;
+    }
+
+    // an identical endpoint call is already in flight, wait for its response
+    if ( !coalescer->addWaiter( fetchKey, { _requestSpec, _source } ) )
+        return;
 
     string endpointUri;
     if ( _requestSpec->isEthMainnet() ) {
@@ -214,90 +230,73 @@ ptr< OracleResponseMessage > OracleServerAgent::doEndpointRequestResponse(
         endpointUri = _requestSpec->getUri();
     }
 
-    auto postString = _requestSpec->whatToPost();
-
-    string response;
-
-    auto status = curlHttp( endpointUri, _requestSpec->isPost(), postString, response );
+    fetchEngine->submit( endpointUri, _requestSpec->isPost(), _requestSpec->whatToPost(),
+        [this, fetchKey]( uint64_t _status, const string& _response ) {
+            completeEndpointRequest( fetchKey, _status, _response );
+        } );
+}
 
-    ptr< OracleResult > oracleResult = nullptr;
+void OracleServerAgent::completeEndpointRequest(
+    const string& _fetchKey, uint64_t _status, const string& _response ) {
+    auto waiters =
+        coalescer->complete( _fetchKey, _status, _response, Time::getCurrentTimeMs() );
 
-    try {
-        oracleResult = make_shared< OracleResult >(
-            _requestSpec, status, response, getSchain()->getCryptoManager() );
-    } catch ( OracleException& e ) {
-        static string EMPTY = "";
-        oracleResult = make_shared< OracleResult >(
-            _requestSpec, e.getError(), EMPTY, getSchain()->getCryptoManager() );
+    for ( auto&& [spec, source] : waiters ) {
+        try {
+            replyToRequest( spec, source, _status, _response );
+        } catch ( ExitRequestedException& ) {
+            throw;
+        } catch ( exception& e ) {
+            SkaleException::logNested( e );
+        }
     }
-
-    auto resultStr = oracleResult->toString();
-
-    LOG( debug, "Oracle request result: " << resultStr );
-
-    string receipt = _requestSpec->getReceipt();
-
-    return make_shared< OracleResponseMessage >( resultStr, receipt,
-        getSchain()->getLastCommittedBlockID() + 1, Time::getCurrentTimeMs(),
-        *getSchain()->getOracleClient() );
 }
 
+void OracleServerAgent::replyToRequest( ptr< OracleRequestSpec > _requestSpec,
+    schain_index _source, uint64_t _status, const string& _response ) {
+    auto msg = createResponseMessage( _requestSpec, _status, _response );
+    sendOutResult( msg, _source );
+}
 
-uint64_t OracleServerAgent::curlHttp(
-    const string& _uri, bool _isPost, string& _postString, string& _result ) {
-    uint64_t status = ORACLE_UNKNOWN_ERROR;
-    CURL* curl;
-    CURLcode res;
-    struct MemoryStruct chunk;
-    chunk.memory = ( char* ) malloc( 1 ); /* will be grown as needed by the realloc above */
-    CHECK_STATE( chunk.memory );
-    chunk.size = 0; /* no data at this point */
-
-    curl = curl_easy_init();
+ptr< OracleResponseMessage > OracleServerAgent::createResponseMessage(
+    ptr< OracleRequestSpec > _requestSpec, uint64_t _status, const string& _response ) {
+    CHECK_ARGUMENT( _requestSpec )
 
-    CHECK_STATE2( curl, "Could not init curl object" );
+    string resultStr;
 
-    curl_easy_setopt( curl, CURLOPT_URL, _uri.c_str() );
-    curl_easy_setopt( curl, CURLOPT_SSL_VERIFYPEER, 1L );
+    auto signedKey = _requestSpec->getSpecWithoutPow();
 
-    string pagedata;
+    if ( !coalescer->getSignedResult( signedKey, resultStr ) ) {
+        ptr< OracleResult > oracleResult = nullptr;
 
-    curl_easy_setopt( curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback );
-    /* we pass our 'chunk' struct to the callback function */
-    curl_easy_setopt( curl, CURLOPT_WRITEDATA, ( void* ) &chunk );
-    curl_easy_setopt( curl, CURLOPT_COOKIEFILE, "" );
-    curl_easy_setopt( curl, CURLOPT_TIMEOUT, 2 );
-    curl_easy_setopt( curl, CURLOPT_USERAGENT, "libcurl-agent/1.0" );
-    curl_easy_setopt( curl, CURLOPT_DNS_SERVERS, "8.8.8.8" );
+        string response = _response;
+        uint64_t status = _status;
 
-    if ( _isPost ) {
-        struct curl_slist* headers = NULL;
-        headers = curl_slist_append( headers, "Content-Type: application/json" );
-        curl_easy_setopt( curl, CURLOPT_HTTPHEADER, headers );
-        curl_easy_setopt( curl, CURLOPT_POSTFIELDS, _postString.c_str() );
-    }
+        try {
+            oracleResult = make_shared< OracleResult >(
+                _requestSpec, _status, response, getSchain()->getCryptoManager() );
+        } catch ( OracleException& e ) {
+            static string EMPTY = "";
+            status = e.getError();
+            oracleResult = make_shared< OracleResult >(
+                _requestSpec, status, EMPTY, getSchain()->getCryptoManager() );
+        }
 
-    res = curl_easy_perform( curl );
+        resultStr = oracleResult->toString();
 
-    if ( res != CURLE_OK ) {
-        LOG( err, "Curl easy perform failed for url: " << _uri
-                                                       << " with error code:" + to_string( res ) );
-        status = ORACLE_COULD_NOT_CONNECT_TO_ENDPOINT;
-    } else {
-        status = ORACLE_SUCCESS;
+        coalescer->putSignedResult( signedKey, status, resultStr );
     }
 
-    curl_easy_cleanup( curl );
-
-    string r = string( chunk.memory, chunk.size );
-
-    free( chunk.memory );
+    LOG( debug, "Oracle request result: " << resultStr );
 
-    _result = r;
+    string receipt = _requestSpec->getReceipt();
 
-    return status;
+    return make_shared< OracleResponseMessage >( resultStr, receipt,
+        getSchain()->getLastCommittedBlockID() + 1, Time::getCurrentTimeMs(),
+        *getSchain()->getOracleClient() );
 }
 
+
 void OracleServerAgent::sendOutResult(
     ptr< OracleResponseMessage > _msg, schain_index _destination ) {
     try {
@@ -47,6 +47,8 @@ class OracleRequestBroadcastMessage;
 
 class OracleThreadPool;
 class OracleRequestSpec;
+class OracleFetchEngine;
+class OracleRequestCoalescer;
 
 class OracleServerAgent : public Agent {
     vector< shared_ptr< BlockingReaderWriterQueue< shared_ptr< MessageEnvelope > > > >
@@ -58,10 +60,27 @@ class OracleServerAgent : public Agent {
 
     ptr< OracleThreadPool > oracleThreadPool = nullptr;
 
+    ptr< OracleFetchEngine > fetchEngine = nullptr;
+
+    // equal requests share one endpoint call and one signature. Only the oracle worker thread
+    // touches it, fetch callbacks run from OracleFetchEngine::poll() on that thread.
+    ptr< OracleRequestCoalescer > coalescer = nullptr;
+
     string gethURL;
 
 
-    ptr< OracleResponseMessage > doEndpointRequestResponse( ptr< OracleRequestSpec > _requestSpec );
+    void processRequestMessage( const ptr< MessageEnvelope >& _me );
+
+    void submitEndpointRequest( ptr< OracleRequestSpec > _requestSpec, schain_index _source );
+
+    void completeEndpointRequest(
+        const string& _fetchKey, uint64_t _status, const string& _response );
+
+    void replyToRequest( ptr< OracleRequestSpec > _requestSpec, schain_index _source,
+        uint64_t _status, const string& _response );
+
+    ptr< OracleResponseMessage > createResponseMessage(
+        ptr< OracleRequestSpec > _requestSpec, uint64_t _status, const string& _response );
 
 
     void sendOutResult( ptr< OracleResponseMessage > _msg, schain_index _destination );
@@ -76,9 +95,6 @@ public:
 
     static void workerThreadItemSendLoop( OracleServerAgent* _agent );
 
-    static uint64_t curlHttp(
-        const string& _uri, bool _isPost, string& _postString, string& _result );
-
     static ptr< vector< ptr< string > > > extractResults(
         string& _response, vector< string >& _jsps );
 };
@@ -46,6 +46,7 @@
 #include "node/ConsensusEngine.h"
 #include "node/Node.h"
 #include "pendingqueue/TestMessageGeneratorAgent.h"
+#include "utils/LatencyHistogram.h"
 #include "utils/Time.h"
 
 #include "microprofile.h"
@@ -64,13 +65,17 @@ ptr< BlockProposal > PendingTransactionsAgent::buildBlockProposal(
 
     auto result = createTransactionsListForProposal( _isCalledAfterCatchup );
     transactionListReceivedTimeMs = Time::getCurrentTimeMs();
+    auto buildStartTimeUs = Time::getMonotonicTimeUs();
     auto transactions = result.first;
     CHECK_STATE( transactions );
     auto stateRoot = result.second;
 
-    while ( Time::getCurrentTimeMs() <=
-            _previousBlockTimeStamp.getS() * 1000 + _previousBlockTimeStamp.getMs() ) {
-        usleep( 10 );
+    // the proposal has to be stamped later than the previous block, sleep out the difference
+    auto previousBlockTimeMs =
+        _previousBlockTimeStamp.getS() * 1000 + _previousBlockTimeStamp.getMs();
+    for ( auto now = Time::getCurrentTimeMs(); now <= previousBlockTimeMs;
+          now = Time::getCurrentTimeMs() ) {
+        usleep( ( previousBlockTimeMs + 1 - now ) * 1000 );
     }
 
     auto transactionList = make_shared< TransactionList >( transactions );
@@ -88,6 +93,8 @@ ptr< BlockProposal > PendingTransactionsAgent::buildBlockProposal(
 
     transactionCounter += ( uint64_t ) pHashesList->getTransactionCount();
 
+    LatencyHistogram::record( LAT_PROPOSAL_BUILD, Time::getMonotonicTimeUs() - buildStartTimeUs );
+
     return myBlockProposal;
 }
 
@@ -102,6 +109,7 @@ PendingTransactionsAgent::createTransactionsListForProposal( bool _isCalledAfter
     ConsensusExtFace::transactions_vector txVector;
 
     auto startTimeMs = Time::getCurrentTimeMs();
+    auto startTimeUs = Time::getMonotonicTimeUs();
 
     u256 stateRoot = 0;
     static u256 stateRootSample = 1;
@@ -155,6 +163,9 @@ PendingTransactionsAgent::createTransactionsListForProposal( bool _isCalledAfter
 
     transactionListWaitTime = finishTimeMs - startTimeMs;
 
+    LatencyHistogram::record(
+        LAT_PENDING_TRANSACTIONS_WAIT, Time::getMonotonicTimeUs() - startTimeUs );
+
     for ( const auto& e : txVector ) {
         ptr< Transaction > pt = Transaction::deserialize(
             make_shared< std::vector< uint8_t > >( e ), 0, e.size(), false );
@@ -168,27 +179,34 @@ PendingTransactionsAgent::createTransactionsListForProposal( bool _isCalledAfter
 
 ptr< Transaction > PendingTransactionsAgent::getKnownTransactionByPartialHash(
     const ptr< partial_sha_hash > hash ) {
+    CHECK_ARGUMENT( hash );
+    READ_LOCK( transactionsMutex );
+    return knownTransactions.find( PartialHashIndex< ptr< Transaction > >::toKey( *hash ) );
+}
+
+uint64_t PendingTransactionsAgent::getKnownTransactionsByPartialHashes(
+    const ptr< PartialHashesList >& _hashes, vector< ptr< Transaction > >& _found,
+    vector< uint64_t >& _missing ) {
+    CHECK_ARGUMENT( _hashes );
+
+    auto keys = _hashes->getPartialHashKeys();
+
     READ_LOCK( transactionsMutex );
-    if ( knownTransactions.count( hash ) )
-        return knownTransactions.at( hash );
-    return nullptr;
+    return knownTransactions.findBatch( keys->data(), keys->size(), _found, _missing );
 }
 
 void PendingTransactionsAgent::pushKnownTransaction( const ptr< Transaction >& _transaction ) {
     CHECK_ARGUMENT( _transaction );
 
+    auto key = _transaction->getPartialHashKey();
+
     WRITE_LOCK( transactionsMutex );
 
-    if ( knownTransactions.count( _transaction->getPartialHash() ) ) {
+    if ( !knownTransactions.insert( key, _transaction ) ) {
         LOG( trace, "Duplicate transaction pushed to known transactions" );
         return;
     }
 
-    auto partialHash = _transaction->getPartialHash();
-
-    CHECK_STATE( partialHash );
-
-    knownTransactions[partialHash] = _transaction;
     knownTransactionsQueue.push( _transaction );
     CHECK_STATE( knownTransactions.size() == knownTransactionsQueue.size() );
     knownTransactionsTotalSize += ( _transaction->getData()->size() + PARTIAL_HASH_LEN );
@@ -198,8 +216,7 @@ void PendingTransactionsAgent::pushKnownTransaction( const ptr< Transaction >& _
         auto tx = knownTransactionsQueue.front();
         CHECK_STATE( tx );
         knownTransactionsTotalSize -= ( tx->getData()->size() + PARTIAL_HASH_LEN );
-        CHECK_STATE( knownTransactions.count( tx->getPartialHash() ) > 0 );
-        knownTransactions.erase( tx->getPartialHash() );
+        CHECK_STATE( knownTransactions.erase( tx->getPartialHashKey() ) );
         knownTransactionsQueue.pop();
     }
 }
@@ -32,36 +32,11 @@ class BlockProposal;
 class PartialHashesList;
 class Transaction;
 
+#include "datastructures/PartialHashIndex.h"
 #include "db/CacheLevelDB.h"
 
 class PendingTransactionsAgent : Agent {
 public:
-    class Hasher {
-    public:
-        std::size_t operator()( const ptr< partial_sha_hash >& a ) const {
-            size_t hash = 0;
-            for ( size_t i = 0; i < PARTIAL_HASH_LEN; i++ ) {
-                hash = hash * 31 + ( *a )[i];
-            }
-            return hash;
-        };
-    };
-
-
-    class Equal {
-    public:
-        std::size_t operator()(
-            const ptr< partial_sha_hash >& a, const ptr< partial_sha_hash >& b ) const {
-            for ( size_t i = 0; i < PARTIAL_HASH_LEN; i++ ) {
-                if ( ( *a )[i] != ( *b )[i] ) {
-                    return false;
-                }
-            }
-            return true;
-        };
-    };
-
-
 private:
     class Comparator {
     public:
@@ -77,7 +52,7 @@ private:
         }
     };
 
-    unordered_map< ptr< partial_sha_hash >, ptr< Transaction >, Hasher, Equal > knownTransactions;
+    PartialHashIndex< ptr< Transaction > > knownTransactions;
     queue< ptr< Transaction > > knownTransactionsQueue;
 
     uint64_t knownTransactionsTotalSize = 0;
@@ -102,6 +77,11 @@ public:
 
     ptr< Transaction > getKnownTransactionByPartialHash( ptr< partial_sha_hash > hash );
 
+    // Looks up all hashes of the list in one pass under a single lock. _found[i] is null and
+    // bit i of _missing is set for every hash that is not known. Returns the number of misses.
+    uint64_t getKnownTransactionsByPartialHashes( const ptr< PartialHashesList >& _hashes,
+        vector< ptr< Transaction > >& _found, vector< uint64_t >& _missing );
+
     ptr< BlockProposal > buildBlockProposal(
         block_id _blockID, TimeStamp& _previousBlockTimeStamp, bool _isCalledAfterCatchup );
 
@@ -27,8 +27,13 @@
 
 
 u256 DynamicPricingStrategy::calculatePrice( u256 _previousPrice,
-    const ConsensusExtFace::transactions_vector& _block, uint64_t, uint32_t, block_id ) {
-    auto loadPercentage = ( _block.size() * 100 ) / MAX_TRANSACTIONS_PER_BLOCK;
+    const ConsensusExtFace::transactions_vector& _block, uint64_t, uint32_t, block_id _blockID ) {
+    return calculatePriceForLoad( _previousPrice, _block.size(), 0, _blockID );
+}
+
+u256 DynamicPricingStrategy::calculatePriceForLoad(
+    u256 _previousPrice, uint64_t _transactionCount, uint64_t, block_id ) {
+    auto loadPercentage = ( _transactionCount * 100 ) / MAX_TRANSACTIONS_PER_BLOCK;
 
     u256 price;
 
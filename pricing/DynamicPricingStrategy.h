@@ -39,6 +39,9 @@ public:
     u256 calculatePrice( u256 previousPrice,
         const ConsensusExtFace::transactions_vector& _approvedTransactions, uint64_t _timeStamp,
         uint32_t _timeStampMs, block_id _blockID ) override;
+
+    u256 calculatePriceForLoad( u256 _previousPrice, uint64_t _transactionCount,
+        uint64_t _transactionBytes, block_id _blockID ) override;
 };
 
 
@@ -27,8 +27,14 @@
 #include "DynamicPricingStrategy.h"
 
 
+#include "WindowedPricingStrategy.h"
 #include "ZeroPricingStrategy.h"
 #include "chains/Schain.h"
+#include "datastructures/CommittedBlock.h"
+#include "datastructures/Transaction.h"
+#include "datastructures/TransactionList.h"
+#include "db/BlockDB.h"
+#include "db/BlockMetadataIndex.h"
 #include "db/PriceDB.h"
 #include "exceptions/ExitRequestedException.h"
 #include "exceptions/FatalError.h"
@@ -40,6 +46,20 @@
 
 #include "PricingAgent.h"
 
+PricingAgent::DynamicPricingParams PricingAgent::readDynamicPricingParams() {
+    DynamicPricingParams params;
+    params.minPrice = sChain->getNode()->getParamUint64(
+        string( "DYNAMIC_PRICING_MIN_PRICE" ), DEFAULT_MIN_PRICE );
+    params.maxPrice =
+        -sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_MAX_PRICE", 1000000000 );
+    params.optimalLoadPercentage =
+        sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_OPTIMAL_LOAD_PERCENTAGE", 70 );
+    params.adjustmentSpeed =
+        sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_ADJUSTMENT_SPEED", 1000 );
+    return params;
+}
+
+
 PricingAgent::PricingAgent( Schain& _sChain ) : Agent( _sChain, false ) {
     string def( "DYNAMIC" );
 
@@ -47,17 +67,18 @@ PricingAgent::PricingAgent( Schain& _sChain ) : Agent( _sChain, false ) {
     CHECK_STATE( !strategy.empty() )
 
     if ( strategy == "DYNAMIC" ) {
-        u256 minPrice = sChain->getNode()->getParamUint64(
-            string( "DYNAMIC_PRICING_MIN_PRICE" ), DEFAULT_MIN_PRICE );
-        u256 maxPrice =
-            -sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_MAX_PRICE", 1000000000 );
-        uint64_t optimalLoadPercentage =
-            sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_OPTIMAL_LOAD_PERCENTAGE", 70 );
-        uint64_t adjustmentSpeed =
-            sChain->getNode()->getParamUint64( "DYNAMIC_PRICING_ADJUSTMENT_SPEED", 1000 );
-        pricingStrategy = make_shared< DynamicPricingStrategy >(
-            minPrice, maxPrice, optimalLoadPercentage, adjustmentSpeed );
-
+        auto params = readDynamicPricingParams();
+        pricingStrategy = make_shared< DynamicPricingStrategy >( params.minPrice,
+            params.maxPrice, params.optimalLoadPercentage, params.adjustmentSpeed );
+
+    } else if ( strategy == "WINDOWED" ) {
+        auto params = readDynamicPricingParams();
+        uint64_t windowSize = sChain->getNode()->getParamUint64( "WINDOWED_PRICING_WINDOW", 16 );
+        uint64_t maxBlockBytes =
+            sChain->getNode()->getParamUint64( "WINDOWED_PRICING_MAX_BLOCK_BYTES", 8388608 );
+        pricingStrategy = make_shared< WindowedPricingStrategy >( params.minPrice,
+            params.maxPrice, params.optimalLoadPercentage, params.adjustmentSpeed, windowSize,
+            maxBlockBytes );
     } else if ( strategy == "ZERO" ) {
         pricingStrategy = make_shared< ZeroPricingStrategy >();
     } else {
@@ -68,7 +89,7 @@ PricingAgent::PricingAgent( Schain& _sChain ) : Agent( _sChain, false ) {
 
 u256 PricingAgent::calculatePrice(
     const ConsensusExtFace::transactions_vector& _approvedTransactions, uint64_t _timeStamp,
-    uint32_t _timeStampMs, block_id _blockID ) {
+    uint32_t _timeStampMs, block_id _blockID, BlockCommitBatch* _commit ) {
     u256 price;
     CHECK_STATE( pricingStrategy );
     try {
@@ -76,12 +97,38 @@ u256 PricingAgent::calculatePrice(
             price = sChain->getNode()->getParamUint64(
                 string( "DYNAMIC_PRICING_START_PRICE" ), DEFAULT_MIN_PRICE );
         } else {
-            auto oldPrice = readPrice( _blockID - 1 );
+            u256 oldPrice;
+            {
+                lock_guard< mutex > lock( lastPriceMutex );
+                oldPrice = ( lastPriceBlockId + 1 == _blockID ) ? lastPrice : 0;
+            }
+            if ( oldPrice == 0 )
+                oldPrice = readPrice( _blockID - 1 );
+
+            if ( pricingStrategy->hasState() &&
+                 pricingStrategy->getLastBlockId() + 1 != _blockID ) {
+                restoreStrategyState( _blockID );
+            }
+
             price = pricingStrategy->calculatePrice(
                 oldPrice, _approvedTransactions, _timeStamp, _timeStampMs, _blockID );
         }
 
-        savePrice( price, _blockID );
+        string state;
+        if ( _blockID > 1 && pricingStrategy->hasState() )
+            state = pricingStrategy->serializeState();
+
+        if ( _commit ) {
+            sChain->getNode()->getPriceDB()->stagePrice( *_commit, price, _blockID, state );
+        } else {
+            savePrice( price, _blockID, state );
+        }
+
+        {
+            lock_guard< mutex > lock( lastPriceMutex );
+            lastPrice = price;
+            lastPriceBlockId = _blockID;
+        }
 
     } catch ( ExitRequestedException& ) {
         throw;
@@ -93,14 +140,37 @@ u256 PricingAgent::calculatePrice(
 }
 
 
-void PricingAgent::savePrice( u256 _price, block_id _blockID ) {
+void PricingAgent::restoreStrategyState( block_id _blockID ) {
+    // block 1 is priced without the strategy
+    if ( _blockID <= 2 ) {
+        pricingStrategy->clearState();
+        return;
+    }
+
+    // the state is saved with the price, so it exists wherever the previous price does. A
+    // node without it can not price like its peers and must not guess
+    auto state = sChain->getNode()->getPriceDB()->readStrategyState( _blockID - 1 );
+    CHECK_STATE2( !state.empty(),
+        "No pricing strategy state saved for block " + to_string( _blockID - 1 ) );
+
+    pricingStrategy->restoreState( state );
+    CHECK_STATE( pricingStrategy->getLastBlockId() + 1 == _blockID );
+}
+
+void PricingAgent::savePrice( u256 _price, block_id _blockID, const string& _strategyState ) {
     auto db = sChain->getNode()->getPriceDB();
     CHECK_STATE( db );
-    db->savePrice( _price, _blockID );
+    db->savePrice( _price, _blockID, _strategyState );
 }
 
 
 u256 PricingAgent::readPrice( block_id _blockID ) {
+    // PriceDB returns the configured start price for blocks 0 and 1, not a stored one. They do
+    // not go through the index, so that changing DYNAMIC_PRICING_START_PRICE still applies
+    BlockMetadata metadata;
+    if ( _blockID > 1 && sChain->getNode()->getBlockMetadataIndex()->read( _blockID, metadata ) )
+        return metadata.price;
+
     auto db = sChain->getNode()->getPriceDB();
     CHECK_STATE( db );
     return db->readPrice( _blockID );
@@ -27,19 +27,39 @@
 #include "Agent.h"
 
 class PricingStrategy;
+class BlockCommitBatch;
 
 class PricingAgent : public Agent {
     ptr< PricingStrategy > pricingStrategy;
 
+    // price of the last priced block, so the next block does not read it back from PriceDB
+    mutex lastPriceMutex;
+    u256 lastPrice = 0;
+    block_id lastPriceBlockId = 0;
+
+    // parameters shared by the DYNAMIC and WINDOWED strategies
+    struct DynamicPricingParams {
+        u256 minPrice;
+        u256 maxPrice;
+        uint64_t optimalLoadPercentage = 0;
+        uint64_t adjustmentSpeed = 0;
+    };
+
+    DynamicPricingParams readDynamicPricingParams();
+
+    void restoreStrategyState( block_id _blockID );
+
 public:
     explicit PricingAgent( Schain& _sChain );
 
+    // the price is staged in _commit if it is set, and saved to PriceDB right away otherwise
     u256 calculatePrice( const ConsensusExtFace::transactions_vector& _approvedTransactions,
-        uint64_t _timeStamp, uint32_t _timeStampMs, block_id _blockID );
+        uint64_t _timeStamp, uint32_t _timeStampMs, block_id _blockID,
+        BlockCommitBatch* _commit = nullptr );
 
     u256 readPrice( block_id _blockId );
 
-    void savePrice( u256 price, block_id _blockID );
+    void savePrice( u256 price, block_id _blockID, const string& _strategyState = "" );
 };
 
 
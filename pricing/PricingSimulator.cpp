@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file PricingSimulator.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "node/ConsensusEngine.h"
+
+#include "PricingStrategy.h"
+#include "PricingSimulator.h"
+
+
+vector< BlockLoad > PricingSimulator::readLoadTrace( const string& _fileName ) {
+    ifstream in( _fileName );
+    CHECK_STATE2( in.is_open(), "Could not open load trace " + _fileName );
+
+    vector< BlockLoad > trace;
+    BlockLoad load;
+
+    while ( in >> load.transactionCount >> load.transactionBytes ) {
+        trace.push_back( load );
+    }
+
+    return trace;
+}
+
+
+void PricingSimulator::writeLoadTrace(
+    const string& _fileName, const vector< BlockLoad >& _trace ) {
+    ofstream out( _fileName );
+    CHECK_STATE2( out.is_open(), "Could not open load trace " + _fileName );
+
+    for ( auto&& load : _trace ) {
+        out << load.transactionCount << " " << load.transactionBytes << "\n";
+    }
+}
+
+
+vector< u256 > PricingSimulator::simulate(
+    PricingStrategy& _strategy, const u256& _startPrice, const vector< BlockLoad >& _trace ) {
+    vector< u256 > prices;
+    prices.reserve( _trace.size() );
+
+    auto price = _startPrice;
+    // block 1 is priced with the start price, like PricingAgent does
+    uint64_t blockId = 2;
+
+    for ( auto&& load : _trace ) {
+        price = _strategy.calculatePriceForLoad(
+            price, load.transactionCount, load.transactionBytes, blockId++ );
+        prices.push_back( price );
+    }
+
+    return prices;
+}
+
+
+double PricingSimulator::getOscillation( const vector< u256 >& _prices ) {
+    if ( _prices.size() < 2 )
+        return 0;
+
+    double total = 0;
+
+    for ( uint64_t i = 1; i < _prices.size(); i++ ) {
+        auto previous = _prices.at( i - 1 ).convert_to< double >();
+        auto current = _prices.at( i ).convert_to< double >();
+        if ( previous > 0 )
+            total += abs( current - previous ) / previous;
+    }
+
+    return total / ( _prices.size() - 1 );
+}
+
+
+uint64_t PricingSimulator::getReversals( const vector< u256 >& _prices ) {
+    uint64_t reversals = 0;
+    int lastDirection = 0;
+
+    for ( uint64_t i = 1; i < _prices.size(); i++ ) {
+        int direction = 0;
+        if ( _prices.at( i ) > _prices.at( i - 1 ) )
+            direction = 1;
+        else if ( _prices.at( i ) < _prices.at( i - 1 ) )
+            direction = -1;
+
+        if ( direction != 0 ) {
+            if ( lastDirection != 0 && direction != lastDirection )
+                reversals++;
+            lastDirection = direction;
+        }
+    }
+
+    return reversals;
+}
@@ -0,0 +1,54 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file PricingSimulator.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#ifndef SKALED_PRICINGSIMULATOR_H
+#define SKALED_PRICINGSIMULATOR_H
+
+class PricingStrategy;
+
+struct BlockLoad {
+    uint64_t transactionCount = 0;
+    uint64_t transactionBytes = 0;
+};
+
+// Runs a pricing strategy offline over a recorded load trace. A trace is a text file with one
+// block per line: transaction count and total transaction bytes.
+class PricingSimulator {
+public:
+    static vector< BlockLoad > readLoadTrace( const string& _fileName );
+
+    static void writeLoadTrace( const string& _fileName, const vector< BlockLoad >& _trace );
+
+    // returns the price after each block, the first block of the trace is block 2
+    static vector< u256 > simulate(
+        PricingStrategy& _strategy, const u256& _startPrice, const vector< BlockLoad >& _trace );
+
+    // mean relative price change per block
+    static double getOscillation( const vector< u256 >& _prices );
+
+    // number of times the price changed direction
+    static uint64_t getReversals( const vector< u256 >& _prices );
+};
+
+
+#endif  // SKALED_PRICINGSIMULATOR_H
@@ -24,4 +24,15 @@
 #include "SkaleCommon.h"
 #include "Log.h"
 #include "node/ConsensusEngine.h"
-#include "PricingStrategy.h"
\ No newline at end of file
+#include "PricingStrategy.h"
+
+
+uint64_t PricingStrategy::getTransactionBytes(
+    const ConsensusExtFace::transactions_vector& _approvedTransactions ) {
+    uint64_t bytes = 0;
+    for ( auto&& t : _approvedTransactions ) {
+        bytes += t.size();
+    }
+    return bytes;
+}
+
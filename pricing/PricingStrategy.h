@@ -30,6 +30,31 @@ public:
     virtual u256 calculatePrice( u256 previousPrice,
         const ConsensusExtFace::transactions_vector& _approvedTransactions, uint64_t _timeStamp,
         uint32_t _timeStampMs, block_id _blockID ) = 0;
+
+    // Prices a block from its load alone. Used for offline simulation of load traces.
+    virtual u256 calculatePriceForLoad( u256 _previousPrice, uint64_t _transactionCount,
+        uint64_t _transactionBytes, block_id _blockID ) = 0;
+
+    // Strategies that look at preceding blocks carry a state from block to block. The state
+    // after each block is saved with its price, so a node that restarts or repairs prices
+    // continues from exactly the state of its peers. Strategies that depend only on the
+    // previous price have no state.
+    virtual bool hasState() const { return false; }
+
+    virtual string serializeState() const { return ""; }
+
+    // _state is the state saved with the price of a block, throws if it is malformed
+    virtual void restoreState( const string& ) {}
+
+    // The state before the first priced block
+    virtual void clearState() {}
+
+    // Last block the strategy has seen, 0 if none
+    virtual block_id getLastBlockId() const { return 0; }
+
+    static uint64_t getTransactionBytes(
+        const ConsensusExtFace::transactions_vector& _approvedTransactions );
+
     virtual ~PricingStrategy() {}
 };
 
@@ -0,0 +1,171 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file PricingStrategyTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+#include "node/ConsensusEngine.h"
+
+#include "DynamicPricingStrategy.h"
+#include "PricingSimulator.h"
+#include "WindowedPricingStrategy.h"
+
+
+// bursty load around the optimal load: full blocks interleaved with nearly idle ones
+static vector< BlockLoad > createBurstyTrace( uint64_t _blocks ) {
+    mt19937 generator( 1234 );
+    uniform_int_distribution< uint64_t > burst( 0, 9 );
+    uniform_int_distribution< uint64_t > idle( 0, MAX_TRANSACTIONS_PER_BLOCK / 10 );
+
+    vector< BlockLoad > trace;
+    for ( uint64_t i = 0; i < _blocks; i++ ) {
+        BlockLoad load;
+        load.transactionCount = burst( generator ) < 7 ? MAX_TRANSACTIONS_PER_BLOCK :
+                                                         idle( generator );
+        load.transactionBytes = load.transactionCount * 200;
+        trace.push_back( load );
+    }
+    return trace;
+}
+
+
+TEST_CASE( "Windowed pricing is more stable than dynamic pricing", "[pricing]" ) {
+    u256 minPrice = 100000;
+    u256 maxPrice = pow( u256( 2 ), 200 );
+    auto trace = createBurstyTrace( 2000 );
+
+    auto traceFile = "/tmp/pricing_trace_" + to_string( getpid() );
+    PricingSimulator::writeLoadTrace( traceFile, trace );
+    auto readTrace = PricingSimulator::readLoadTrace( traceFile );
+    remove( traceFile.c_str() );
+    REQUIRE( readTrace.size() == trace.size() );
+    REQUIRE( readTrace.back().transactionBytes == trace.back().transactionBytes );
+
+    DynamicPricingStrategy dynamic( minPrice, maxPrice, 70, 1000 );
+    WindowedPricingStrategy windowed( minPrice, maxPrice, 70, 1000, 16, 8 * 1024 * 1024 );
+
+    auto dynamicPrices = PricingSimulator::simulate( dynamic, minPrice * 10, readTrace );
+    auto windowedPrices = PricingSimulator::simulate( windowed, minPrice * 10, readTrace );
+
+    for ( auto&& price : windowedPrices ) {
+        REQUIRE( price >= minPrice );
+        REQUIRE( price <= maxPrice );
+    }
+
+    auto dynamicOscillation = PricingSimulator::getOscillation( dynamicPrices );
+    auto windowedOscillation = PricingSimulator::getOscillation( windowedPrices );
+    auto dynamicReversals = PricingSimulator::getReversals( dynamicPrices );
+    auto windowedReversals = PricingSimulator::getReversals( windowedPrices );
+
+    REQUIRE( windowedOscillation < dynamicOscillation );
+    REQUIRE( windowedReversals < dynamicReversals );
+}
+
+
+TEST_CASE( "Windowed pricing restores the window from the saved state", "[pricing]" ) {
+    u256 minPrice = 100000;
+    u256 maxPrice = pow( u256( 2 ), 200 );
+    auto trace = createBurstyTrace( 100 );
+
+    // blocks 2..101 carry the trace, the state is saved with the price of every block
+    WindowedPricingStrategy running( minPrice, maxPrice, 70, 1000, 16, 8 * 1024 * 1024 );
+    map< uint64_t, u256 > prices;
+    map< uint64_t, string > states;
+    u256 price = minPrice * 10;
+    for ( uint64_t id = 2; id < 102; id++ ) {
+        auto& load = trace.at( id - 2 );
+        price = running.calculatePriceForLoad(
+            price, load.transactionCount, load.transactionBytes, id );
+        prices[id] = price;
+        states[id] = running.serializeState();
+    }
+
+    // a node restarted after block 60 has none of the blocks, only the state saved with the
+    // price, and prices every following block like the node that kept running
+    WindowedPricingStrategy restarted( minPrice, maxPrice, 70, 1000, 16, 8 * 1024 * 1024 );
+    restarted.restoreState( states.at( 60 ) );
+    REQUIRE( restarted.getLastBlockId() == 60 );
+
+    price = prices.at( 60 );
+    for ( uint64_t id = 61; id < 102; id++ ) {
+        auto& load = trace.at( id - 2 );
+        price = restarted.calculatePriceForLoad(
+            price, load.transactionCount, load.transactionBytes, id );
+        REQUIRE( price == prices.at( id ) );
+        REQUIRE( restarted.serializeState() == states.at( id ) );
+    }
+
+    REQUIRE( restarted.calculatePriceForLoad( price, 5000, 1000000, 102 ) ==
+             running.calculatePriceForLoad( price, 5000, 1000000, 102 ) );
+}
+
+
+TEST_CASE( "Windowed pricing refuses a missing or foreign state", "[pricing]" ) {
+    u256 minPrice = 100000;
+    u256 maxPrice = pow( u256( 2 ), 200 );
+
+    WindowedPricingStrategy strategy( minPrice, maxPrice, 70, 1000, 16, 8 * 1024 * 1024 );
+
+    REQUIRE_THROWS( strategy.restoreState( "" ) );
+    REQUIRE_THROWS( strategy.restoreState( "{\"lastBlockId\":5}" ) );
+    REQUIRE_THROWS( strategy.restoreState( "{\"lastBlockId\":5,\"loads\":[]}" ) );
+
+    // a window of another size would price differently from the peers
+    WindowedPricingStrategy wider( minPrice, maxPrice, 70, 1000, 32, 8 * 1024 * 1024 );
+    u256 price = minPrice * 10;
+    for ( uint64_t id = 2; id < 40; id++ ) {
+        price = wider.calculatePriceForLoad( price, MAX_TRANSACTIONS_PER_BLOCK, 0, id );
+    }
+    REQUIRE_THROWS( strategy.restoreState( wider.serializeState() ) );
+
+    // a failed restore leaves the strategy as it was
+    REQUIRE( strategy.getLastBlockId() == 0 );
+}
+
+
+TEST_CASE( "Pricing cost per block", "[.benchmark]" ) {
+    u256 minPrice = 100000;
+    u256 maxPrice = pow( u256( 2 ), 200 );
+
+    ConsensusExtFace::transactions_vector transactions(
+        MAX_TRANSACTIONS_PER_BLOCK, vector< uint8_t >( 200 ) );
+
+    DynamicPricingStrategy dynamic( minPrice, maxPrice, 70, 1000 );
+    WindowedPricingStrategy windowed( minPrice, maxPrice, 70, 1000, 16, 8 * 1024 * 1024 );
+
+    for ( PricingStrategy* strategy :
+        initializer_list< PricingStrategy* >{ &dynamic, &windowed } ) {
+        u256 price = minPrice;
+        auto begin = chrono::steady_clock::now();
+        for ( uint64_t id = 2; id < 10002; id++ ) {
+            price = strategy->calculatePrice( price, transactions, 0, 0, id );
+        }
+        auto ns = chrono::duration_cast< chrono::nanoseconds >(
+            chrono::steady_clock::now() - begin )
+                      .count();
+        REQUIRE( price >= minPrice );
+        WARN( ( strategy == &dynamic ? "Dynamic" : "Windowed" )
+              << " pricing ns per block:" << ns / 10000 );
+    }
+}
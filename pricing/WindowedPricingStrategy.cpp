@@ -0,0 +1,159 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file WindowedPricingStrategy.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "node/ConsensusEngine.h"
+#include "thirdparty/json.hpp"
+#include "WindowedPricingStrategy.h"
+
+
+WindowedPricingStrategy::WindowedPricingStrategy( const u256& _minPrice, const u256& _maxPrice,
+    uint32_t _optimalLoadPercentage, uint32_t _adjustmentSpeed, uint64_t _windowSize,
+    uint64_t _maxBlockBytes )
+    : minPrice( _minPrice ),
+      maxPrice( _maxPrice ),
+      optimalLoadPercentage( _optimalLoadPercentage ),
+      adjustmentSpeed( _adjustmentSpeed ),
+      windowSize( _windowSize ),
+      maxBlockBytes( _maxBlockBytes ) {
+    CHECK_ARGUMENT( _windowSize > 0 );
+    CHECK_ARGUMENT( _maxBlockBytes > 0 );
+}
+
+
+uint64_t WindowedPricingStrategy::getLoadPermille(
+    uint64_t _transactionCount, uint64_t _transactionBytes ) const {
+    auto countLoad = ( _transactionCount * 1000 ) / MAX_TRANSACTIONS_PER_BLOCK;
+    auto bytesLoad = ( _transactionBytes * 1000 ) / maxBlockBytes;
+    return min< uint64_t >( max( countLoad, bytesLoad ), 1000 );
+}
+
+
+void WindowedPricingStrategy::addBlock(
+    uint64_t _transactionCount, uint64_t _transactionBytes, block_id _blockID ) {
+    auto load = getLoadPermille( _transactionCount, _transactionBytes );
+
+    loads.push_back( load );
+    loadSum += load;
+
+    if ( loads.size() > windowSize ) {
+        loadSum -= loads.front();
+        loads.pop_front();
+    }
+
+    lastBlockId = _blockID;
+}
+
+
+bool WindowedPricingStrategy::hasState() const {
+    return true;
+}
+
+
+string WindowedPricingStrategy::serializeState() const {
+    nlohmann::json state = nlohmann::json::object();
+    state["lastBlockId"] = ( uint64_t ) lastBlockId;
+    state["loads"] = vector< uint64_t >( loads.begin(), loads.end() );
+    return state.dump();
+}
+
+
+void WindowedPricingStrategy::restoreState( const string& _state ) {
+    CHECK_ARGUMENT2( !_state.empty(), "Empty pricing state" );
+
+    deque< uint64_t > restoredLoads;
+    uint64_t restoredSum = 0;
+    uint64_t restoredBlockId = 0;
+
+    try {
+        auto state = nlohmann::json::parse( _state );
+        restoredBlockId = state.at( "lastBlockId" ).get< uint64_t >();
+        for ( auto&& load : state.at( "loads" ) ) {
+            restoredLoads.push_back( load.get< uint64_t >() );
+            restoredSum += restoredLoads.back();
+        }
+    } catch ( exception& e ) {
+        BOOST_THROW_EXCEPTION( InvalidArgumentException(
+            "Could not parse pricing state:" + string( e.what() ), __CLASS_NAME__ ) );
+    }
+
+    // a state saved with another window size would price differently from the peers
+    CHECK_ARGUMENT2( restoredLoads.size() <= windowSize,
+        "Pricing state window larger than " + to_string( windowSize ) );
+    CHECK_ARGUMENT2( restoredBlockId > 0 && !restoredLoads.empty(), "Empty pricing window" );
+
+    loads = move( restoredLoads );
+    loadSum = restoredSum;
+    lastBlockId = restoredBlockId;
+}
+
+
+void WindowedPricingStrategy::clearState() {
+    loads.clear();
+    loadSum = 0;
+    lastBlockId = 0;
+}
+
+
+block_id WindowedPricingStrategy::getLastBlockId() const {
+    return lastBlockId;
+}
+
+
+u256 WindowedPricingStrategy::calculatePrice( u256 _previousPrice,
+    const ConsensusExtFace::transactions_vector& _approvedTransactions, uint64_t, uint32_t,
+    block_id _blockID ) {
+    return calculatePriceForLoad( _previousPrice, _approvedTransactions.size(),
+        getTransactionBytes( _approvedTransactions ), _blockID );
+}
+
+
+u256 WindowedPricingStrategy::calculatePriceForLoad( u256 _previousPrice,
+    uint64_t _transactionCount, uint64_t _transactionBytes, block_id _blockID ) {
+    addBlock( _transactionCount, _transactionBytes, _blockID );
+
+    auto averageLoad = loadSum / loads.size();
+    uint64_t optimalLoad = optimalLoadPercentage * 10;
+
+    // same response as DynamicPricingStrategy for a steady load, loads are in per mille
+    u256 price;
+
+    if ( averageLoad < optimalLoad ) {
+        price = _previousPrice -
+                ( adjustmentSpeed * _previousPrice ) * ( optimalLoad - averageLoad ) / 10000000;
+    } else {
+        price = _previousPrice +
+                ( adjustmentSpeed * _previousPrice ) * ( averageLoad - optimalLoad ) / 10000000;
+    }
+
+    if ( price < minPrice ) {
+        price = minPrice;
+    }
+
+    if ( price > maxPrice ) {
+        price = maxPrice;
+    }
+
+    return price;
+}
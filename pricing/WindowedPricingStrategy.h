@@ -0,0 +1,76 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file WindowedPricingStrategy.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#ifndef SKALED_WINDOWEDPRICINGSTRATEGY_H
+#define SKALED_WINDOWEDPRICINGSTRATEGY_H
+
+#include "PricingStrategy.h"
+
+// Adjusts the price from the average load of the last windowSize blocks instead of the current
+// block alone, so a single full or empty block does not swing the price. The load of a block is
+// the larger of its transaction count and its byte size relative to the block limits, in per
+// mille. All arithmetic is integer. The window is the strategy state, saved with the price of
+// every block, so a restarted node restores the window its peers have instead of rebuilding it
+// from blocks it may no longer have.
+class WindowedPricingStrategy : public PricingStrategy {
+    u256 minPrice = DEFAULT_MIN_PRICE;
+    u256 maxPrice = pow( u256( 2 ), 200 );
+    uint32_t optimalLoadPercentage = 70;
+    uint32_t adjustmentSpeed = 1000;
+    uint64_t windowSize = 16;
+    uint64_t maxBlockBytes = 8 * 1024 * 1024;
+
+    deque< uint64_t > loads;
+    uint64_t loadSum = 0;
+    block_id lastBlockId = 0;
+
+    void addBlock( uint64_t _transactionCount, uint64_t _transactionBytes, block_id _blockID );
+
+public:
+    WindowedPricingStrategy( const u256& _minPrice, const u256& _maxPrice,
+        uint32_t _optimalLoadPercentage, uint32_t _adjustmentSpeed, uint64_t _windowSize,
+        uint64_t _maxBlockBytes );
+
+    u256 calculatePrice( u256 _previousPrice,
+        const ConsensusExtFace::transactions_vector& _approvedTransactions, uint64_t _timeStamp,
+        uint32_t _timeStampMs, block_id _blockID ) override;
+
+    u256 calculatePriceForLoad( u256 _previousPrice, uint64_t _transactionCount,
+        uint64_t _transactionBytes, block_id _blockID ) override;
+
+    bool hasState() const override;
+
+    // {"lastBlockId": id, "loads": [per mille load of each block in the window, oldest first]}
+    string serializeState() const override;
+
+    void restoreState( const string& _state ) override;
+
+    void clearState() override;
+
+    block_id getLastBlockId() const override;
+
+    uint64_t getLoadPermille( uint64_t _transactionCount, uint64_t _transactionBytes ) const;
+};
+
+
+#endif  // SKALED_WINDOWEDPRICINGSTRATEGY_H
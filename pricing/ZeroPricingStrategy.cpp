@@ -29,3 +29,7 @@ u256 ZeroPricingStrategy::calculatePrice(
     u256, const ConsensusExtFace::transactions_vector&, uint64_t, uint32_t, block_id ) {
     return 0;
 }
+
+u256 ZeroPricingStrategy::calculatePriceForLoad( u256, uint64_t, uint64_t, block_id ) {
+    return 0;
+}
@@ -60,6 +60,7 @@
 #include "protocols/ProtocolInstance.h"
 #include "protocols/blockconsensus/BlockConsensusAgent.h"
 #include "thirdparty/json.hpp"
+#include "utils/LatencyHistogram.h"
 #include "utils/Time.h"
 
 #include "AUXBroadcastMessage.h"
@@ -265,11 +266,7 @@ void BinConsensusInstance::addCommonCoinToHistory(
 
 bool BinConsensusInstance::bvbVoteCore(
     const bin_consensus_round& _r, const bin_consensus_value& _v, const schain_index& _index ) {
-    if ( _v ) {
-        return bvbTrueVotes[_r].insert( _index ).second;
-    } else {
-        return bvbFalseVotes[_r].insert( _index ).second;
-    }
+    return votes.bvbVote( _r, _v, _index );
 }
 
 
@@ -309,16 +306,12 @@ bool BinConsensusInstance::auxVoteCore( const bin_consensus_round& _r,
         CHECK_STATE( _sigShare == nullptr );
     }
 
-    if ( _v ) {
-        return auxTrueVotes[_r].insert( { _index, _sigShare } ).second;
-    } else {
-        return auxFalseVotes[_r].insert( { _index, _sigShare } ).second;
-    }
+    return votes.auxVote( _r, _v, _index, _sigShare );
 }
 
 
 uint64_t BinConsensusInstance::totalAUXVotes( bin_consensus_round r ) {
-    return auxTrueVotes[r].size() + auxFalseVotes[r].size();
+    return votes.totalAUXVotes( r );
 }
 
 void BinConsensusInstance::auxSelfVote(
@@ -331,11 +324,11 @@ void BinConsensusInstance::auxSelfVote(
 
 
 node_count BinConsensusInstance::getBVBVoteCount( bin_consensus_value _v, bin_consensus_round _r ) {
-    return node_count( ( ( _v ? bvbTrueVotes[_r] : bvbFalseVotes[_r] ).size() ) );
+    return votes.getBVBVoteCount( _v, _r );
 }
 
 node_count BinConsensusInstance::getAUXVoteCount( bin_consensus_value _v, bin_consensus_round _r ) {
-    return node_count( ( ( _v ? auxTrueVotes[_r] : auxFalseVotes[_r] ).size() ) );
+    return votes.getAUXVoteCount( _v, _r );
 }
 
 bool BinConsensusInstance::isThird( node_count count ) {
@@ -360,7 +353,7 @@ bool BinConsensusInstance::isTwoThirdVote( const ptr< BVBroadcastMessage >& _m )
 void BinConsensusInstance::insertIntoBinValues( bin_consensus_round _r, bin_consensus_value _v ) {
     getSchain()->getNode()->getConsensusStateDB()->writeBinValue(
         getBlockID(), getBlockProposerIndex(), _r, _v );
-    binValues[_r].insert( _v );
+    votes.insertBinValue( _r, _v );
 }
 
 void BinConsensusInstance::addToBinValuesIfTwoThirds( const ptr< BVBroadcastMessage >& _m ) {
@@ -368,7 +361,7 @@ void BinConsensusInstance::addToBinValuesIfTwoThirds( const ptr< BVBroadcastMess
     auto v = _m->getValue();
 
 
-    if ( binValues[r].count( v ) ) {
+    if ( votes.hasBinValue( r, v ) ) {
         // bin values already includes the value in question
         return;
     }
@@ -380,7 +373,7 @@ void BinConsensusInstance::addToBinValuesIfTwoThirds( const ptr< BVBroadcastMess
         // Section 4.2 (04) The first time binValues is updated it is broadcast
         // Also the aux message needs to be added as self vote in
         // Section 4.2 (05)
-        bool didAUXBroadcast = binValues[r].size() > 1;
+        bool didAUXBroadcast = votes.getBinValuesCount( r ) > 1;
         if ( !didAUXBroadcast ) {
             auxSelfVoteAndBroadcastValue( r, v );
         }
@@ -451,13 +444,16 @@ void BinConsensusInstance::proceedWithDecisionLotteryIfAUXTwoThird( bin_consensu
     bool hasTrue = false;
     bool hasFalse = false;
 
-    if ( binValues[_r].count( bin_consensus_value( true ) ) > 0 && auxTrueVotes[_r].size() > 0 ) {
-        verifiedValuesSize += auxTrueVotes[_r].size();
+    auto auxTrueCount = ( uint64_t ) votes.getAUXVoteCount( bin_consensus_value( true ), _r );
+    auto auxFalseCount = ( uint64_t ) votes.getAUXVoteCount( bin_consensus_value( false ), _r );
+
+    if ( votes.hasBinValue( _r, bin_consensus_value( true ) ) && auxTrueCount > 0 ) {
+        verifiedValuesSize += auxTrueCount;
         hasTrue = true;
     }
 
-    if ( binValues[_r].count( bin_consensus_value( false ) ) > 0 && auxFalseVotes[_r].size() > 0 ) {
-        verifiedValuesSize += auxFalseVotes[_r].size();
+    if ( votes.hasBinValue( _r, bin_consensus_value( false ) ) && auxFalseCount > 0 ) {
+        verifiedValuesSize += auxFalseCount;
         hasFalse = true;
     }
 
@@ -541,6 +537,8 @@ void BinConsensusInstance::proceedWithNextRound( bin_consensus_value _value ) {
     CHECK_STATE( getCurrentRound() < 100 );
     CHECK_STATE( isTwoThird( totalAUXVotes( getCurrentRound() ) ) );
 
+    recordRoundLatency();
+
     setCurrentRound( getCurrentRound() + 1 );
 
     setProposal( getCurrentRound(), _value );
@@ -630,6 +628,8 @@ void BinConsensusInstance::addDecideToGlobalHistory(
 void BinConsensusInstance::decide( bin_consensus_value _b ) {
     CHECK_STATE( !isDecided );
 
+    recordRoundLatency();
+
     setDecidedRoundAndValue( getCurrentRound(), bin_consensus_value( _b ) );
 
     addDecideToGlobalHistory( getCurrentRound(), decidedValue );
@@ -664,7 +664,8 @@ BinConsensusInstance::BinConsensusInstance( BlockConsensusAgent* _instance, bloc
       blockID( _blockId ),
       blockProposerIndex( _blockProposerIndex ),
       nodeCount( _instance ? _instance->getSchain()->getNodeCount() : 0 ),
-      protocolKey( make_shared< ProtocolKey >( _blockId, _blockProposerIndex ) ) {
+      protocolKey( make_shared< ProtocolKey >( _blockId, _blockProposerIndex ) ),
+      votes( nodeCount ) {
     CHECK_ARGUMENT( ( uint64_t ) _blockId > 0 );
     CHECK_ARGUMENT( ( uint64_t ) _blockProposerIndex > 0 );
     CHECK_ARGUMENT( _instance );
@@ -694,18 +695,33 @@ void BinConsensusInstance::initFromDB( const BlockConsensusAgent*
 
     auto bvVotes = db->readBVBVotes( blockID, blockProposerIndex );
 
-    bvbTrueVotes.insert( bvVotes.first->begin(), bvVotes.first->end() );
-    bvbFalseVotes.insert( bvVotes.second->begin(), bvVotes.second->end() );
+    for ( auto&& [r, voters] : *bvVotes.first ) {
+        for ( auto&& voter : voters )
+            votes.bvbVote( r, bin_consensus_value( true ), voter );
+    }
+    for ( auto&& [r, voters] : *bvVotes.second ) {
+        for ( auto&& voter : voters )
+            votes.bvbVote( r, bin_consensus_value( false ), voter );
+    }
 
     auto auxVotes =
         db->readAUXVotes( blockID, blockProposerIndex, _instance->getSchain()->getCryptoManager() );
 
-    auxTrueVotes.insert( auxVotes.first->begin(), auxVotes.first->end() );
-    auxFalseVotes.insert( auxVotes.first->begin(), auxVotes.first->end() );
+    for ( auto&& [r, voters] : *auxVotes.first ) {
+        for ( auto&& [voter, sigShare] : voters )
+            votes.auxVote( r, bin_consensus_value( true ), voter, sigShare );
+    }
+    for ( auto&& [r, voters] : *auxVotes.second ) {
+        for ( auto&& [voter, sigShare] : voters )
+            votes.auxVote( r, bin_consensus_value( false ), voter, sigShare );
+    }
 
     auto bValues = db->readBinValues( blockID, blockProposerIndex );
 
-    binValues.insert( bValues->begin(), bValues->end() );
+    for ( auto&& [r, values] : *bValues ) {
+        for ( auto&& value : values )
+            votes.insertBinValue( r, value );
+    }
 
     auto props = db->readPRs( blockID, blockProposerIndex );
 
@@ -776,19 +792,16 @@ const node_count& BinConsensusInstance::getNodeCount() const {
 uint64_t BinConsensusInstance::calculateBLSRandom( bin_consensus_round _r ) {
     auto shares = getSchain()->getCryptoManager()->createSigShareSet( getBlockID() );
 
-    if ( binValues[_r].count( bin_consensus_value( true ) ) > 0 && auxTrueVotes[_r].size() > 0 ) {
-        for ( auto&& item : auxTrueVotes[_r] ) {
-            CHECK_STATE( item.second );
-            shares->addSigShare( item.second );
-            if ( shares->isEnough() )
-                break;
-        }
-    }
+    for ( auto value : { true, false } ) {
+        if ( !votes.hasBinValue( _r, bin_consensus_value( value ) ) )
+            continue;
 
-    if ( binValues[_r].count( bin_consensus_value( false ) ) > 0 && auxFalseVotes[_r].size() > 0 ) {
-        for ( auto&& item : auxFalseVotes[_r] ) {
-            CHECK_STATE( item.second );
-            shares->addSigShare( item.second );
+        auto sigShares = votes.getAUXSigShares( bin_consensus_value( value ), _r );
+        CHECK_STATE( sigShares.size() ==
+                     ( uint64_t ) votes.getAUXVoteCount( bin_consensus_value( value ), _r ) );
+
+        for ( auto&& sigShare : sigShares ) {
+            shares->addSigShare( sigShare );
             if ( shares->isEnough() )
                 break;
         }
@@ -821,6 +834,16 @@ void BinConsensusInstance::setProposal( bin_consensus_round _r, bin_consensus_va
     getSchain()->getNode()->getConsensusStateDB()->writePr(
         getBlockID(), blockProposerIndex, _r, _v );
     proposals[_r] = _v;
+    roundStartTimeUs = Time::getMonotonicTimeUs();
+}
+
+
+void BinConsensusInstance::recordRoundLatency() {
+    if ( roundStartTimeUs == 0 )
+        return;
+    LatencyHistogram::record(
+        LAT_BIN_CONSENSUS_ROUND, Time::getMonotonicTimeUs() - roundStartTimeUs );
+    roundStartTimeUs = 0;
 }
 
 
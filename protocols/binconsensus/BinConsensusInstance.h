@@ -40,6 +40,8 @@ class ProtocolKey;
 
 #include "thirdparty/lrucache.hpp"
 
+#include "BinConsensusVotes.h"
+
 class BinConsensusInstance : public ProtocolInstance {
     friend class BlockConsensusAgent;
     friend class HistoryMessage;
@@ -54,6 +56,11 @@ class BinConsensusInstance : public ProtocolInstance {
     uint64_t maxProcessingTimeMs = 0;
     uint64_t maxLatencyTimeMs = 0;
 
+    // monotonic start time of the current round, zero if the round was restored from db
+    uint64_t roundStartTimeUs = 0;
+
+    void recordRoundLatency();
+
 
     class Comparator {
     public:
@@ -104,13 +111,8 @@ class BinConsensusInstance : public ProtocolInstance {
 
     std::atomic< bin_consensus_round > currentRound = bin_consensus_round( 0 );
 
-    map< bin_consensus_round, set< schain_index > > bvbTrueVotes;
-    map< bin_consensus_round, set< schain_index > > bvbFalseVotes;
-
-    map< bin_consensus_round, map< schain_index, ptr< ThresholdSigShare > > > auxTrueVotes;
-    map< bin_consensus_round, map< schain_index, ptr< ThresholdSigShare > > > auxFalseVotes;
-
-    map< bin_consensus_round, set< bin_consensus_value > > binValues;
+    // BVB votes, AUX votes and bin values for each round
+    BinConsensusVotes votes;
 
     // END OF ESSENTIAL PROTOCOL FIELDS
 
@@ -0,0 +1,145 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinConsensusVotes.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "Log.h"
+#include "SkaleCommon.h"
+#include "exceptions/FatalError.h"
+
+#include "BinConsensusVotes.h"
+
+
+BinConsensusVotes::BinConsensusVotes( node_count _nodeCount )
+    : nodeCount( ( uint64_t ) _nodeCount ), wordCount( ( ( uint64_t ) _nodeCount + 63 ) / 64 ) {
+    CHECK_ARGUMENT( nodeCount <= MAX_BIN_CONSENSUS_VOTERS );
+}
+
+void BinConsensusVotes::checkIndex( schain_index _index ) const {
+    CHECK_ARGUMENT2( ( uint64_t ) _index > 0 && ( uint64_t ) _index <= nodeCount,
+        "Invalid voter index:" + to_string( _index ) );
+}
+
+BinConsensusVotes::RoundVotes& BinConsensusVotes::getOrCreateRound( bin_consensus_round _r ) {
+    if ( ( uint64_t ) _r >= rounds.size() ) {
+        rounds.resize( ( uint64_t ) _r + 1 );
+    }
+    return rounds[( uint64_t ) _r];
+}
+
+const BinConsensusVotes::RoundVotes* BinConsensusVotes::getRound( bin_consensus_round _r ) const {
+    if ( ( uint64_t ) _r >= rounds.size() )
+        return nullptr;
+    return &rounds[( uint64_t ) _r];
+}
+
+bool BinConsensusVotes::bvbVote(
+    bin_consensus_round _r, bin_consensus_value _v, schain_index _index ) {
+    checkIndex( _index );
+    return getOrCreateRound( _r ).bvbVotes[_v ? 1 : 0].insert( _index );
+}
+
+bool BinConsensusVotes::auxVote( bin_consensus_round _r, bin_consensus_value _v,
+    schain_index _index, const ptr< ThresholdSigShare >& _sigShare ) {
+    checkIndex( _index );
+
+    auto& round = getOrCreateRound( _r );
+    auto value = _v ? 1 : 0;
+
+    if ( !round.auxVotes[value].insert( _index ) )
+        return false;
+
+    if ( _sigShare ) {
+        auto& shares = round.auxSigShares[value];
+        if ( shares.empty() ) {
+            shares.resize( nodeCount );
+        }
+        shares[( uint64_t ) _index - 1] = _sigShare;
+    }
+
+    return true;
+}
+
+node_count BinConsensusVotes::getBVBVoteCount(
+    bin_consensus_value _v, bin_consensus_round _r ) const {
+    auto round = getRound( _r );
+    if ( !round )
+        return node_count( 0 );
+    return node_count( round->bvbVotes[_v ? 1 : 0].count( wordCount ) );
+}
+
+node_count BinConsensusVotes::getAUXVoteCount(
+    bin_consensus_value _v, bin_consensus_round _r ) const {
+    auto round = getRound( _r );
+    if ( !round )
+        return node_count( 0 );
+    return node_count( round->auxVotes[_v ? 1 : 0].count( wordCount ) );
+}
+
+uint64_t BinConsensusVotes::totalAUXVotes( bin_consensus_round _r ) const {
+    auto round = getRound( _r );
+    if ( !round )
+        return 0;
+    return round->auxVotes[0].count( wordCount ) + round->auxVotes[1].count( wordCount );
+}
+
+bool BinConsensusVotes::insertBinValue( bin_consensus_round _r, bin_consensus_value _v ) {
+    auto& round = getOrCreateRound( _r );
+    uint8_t mask = _v ? 2 : 1;
+    if ( round.binValues & mask )
+        return false;
+    round.binValues |= mask;
+    return true;
+}
+
+bool BinConsensusVotes::hasBinValue( bin_consensus_round _r, bin_consensus_value _v ) const {
+    auto round = getRound( _r );
+    if ( !round )
+        return false;
+    return round->binValues & ( _v ? 2 : 1 );
+}
+
+uint64_t BinConsensusVotes::getBinValuesCount( bin_consensus_round _r ) const {
+    auto round = getRound( _r );
+    if ( !round )
+        return 0;
+    return __builtin_popcount( round->binValues );
+}
+
+vector< ptr< ThresholdSigShare > > BinConsensusVotes::getAUXSigShares(
+    bin_consensus_value _v, bin_consensus_round _r ) const {
+    vector< ptr< ThresholdSigShare > > result;
+
+    auto round = getRound( _r );
+    if ( !round )
+        return result;
+
+    for ( auto&& share : round->auxSigShares[_v ? 1 : 0] ) {
+        if ( share )
+            result.push_back( share );
+    }
+
+    return result;
+}
+
+uint64_t BinConsensusVotes::getRoundsCount() const {
+    return rounds.size();
+}
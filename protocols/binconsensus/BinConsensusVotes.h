@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinConsensusVotes.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+class ThresholdSigShare;
+
+// max number of nodes supported by the vote bitmaps
+static constexpr uint64_t MAX_BIN_CONSENSUS_VOTERS = 256;
+
+
+// Set of voters for a single (round, value) pair. Voter with schain index i is bit i - 1
+class VoterBitset {
+    array< uint64_t, MAX_BIN_CONSENSUS_VOTERS / 64 > words = {};
+
+public:
+    // returns false if the voter has already voted
+    bool insert( schain_index _index ) {
+        auto bit = ( uint64_t ) _index - 1;
+        auto mask = ( uint64_t ) 1 << ( bit % 64 );
+        auto& word = words[bit / 64];
+        if ( word & mask )
+            return false;
+        word |= mask;
+        return true;
+    }
+
+    [[nodiscard]] bool contains( schain_index _index ) const {
+        auto bit = ( uint64_t ) _index - 1;
+        return ( words[bit / 64] >> ( bit % 64 ) ) & 1;
+    }
+
+    [[nodiscard]] uint64_t count( uint64_t _wordCount ) const {
+        uint64_t result = 0;
+        for ( uint64_t i = 0; i < _wordCount; i++ ) {
+            result += __builtin_popcountll( words[i] );
+        }
+        return result;
+    }
+};
+
+
+// Compact bookkeeping of BVB/AUX votes and bin values for a single binary consensus instance.
+// Rounds are stored in a vector indexed by round number, since rounds are dense and small.
+class BinConsensusVotes {
+    struct RoundVotes {
+        VoterBitset bvbVotes[2];
+        VoterBitset auxVotes[2];
+        // sig shares are only present for common coin rounds, indexed by schain index - 1
+        vector< ptr< ThresholdSigShare > > auxSigShares[2];
+        uint8_t binValues = 0;
+    };
+
+    const uint64_t nodeCount;
+    // number of 64 bit words actually used by the bitmaps
+    const uint64_t wordCount;
+
+    vector< RoundVotes > rounds;
+
+    RoundVotes& getOrCreateRound( bin_consensus_round _r );
+
+    [[nodiscard]] const RoundVotes* getRound( bin_consensus_round _r ) const;
+
+    void checkIndex( schain_index _index ) const;
+
+public:
+    explicit BinConsensusVotes( node_count _nodeCount );
+
+    // returns false if the vote is a duplicate
+    bool bvbVote( bin_consensus_round _r, bin_consensus_value _v, schain_index _index );
+
+    // returns false if the vote is a duplicate
+    bool auxVote( bin_consensus_round _r, bin_consensus_value _v, schain_index _index,
+        const ptr< ThresholdSigShare >& _sigShare );
+
+    [[nodiscard]] node_count getBVBVoteCount(
+        bin_consensus_value _v, bin_consensus_round _r ) const;
+
+    [[nodiscard]] node_count getAUXVoteCount(
+        bin_consensus_value _v, bin_consensus_round _r ) const;
+
+    [[nodiscard]] uint64_t totalAUXVotes( bin_consensus_round _r ) const;
+
+    // returns false if the value is already in bin values
+    bool insertBinValue( bin_consensus_round _r, bin_consensus_value _v );
+
+    [[nodiscard]] bool hasBinValue( bin_consensus_round _r, bin_consensus_value _v ) const;
+
+    [[nodiscard]] uint64_t getBinValuesCount( bin_consensus_round _r ) const;
+
+    // AUX sig shares for a value in the order of voter schain indices
+    [[nodiscard]] vector< ptr< ThresholdSigShare > > getAUXSigShares(
+        bin_consensus_value _v, bin_consensus_round _r ) const;
+
+    [[nodiscard]] uint64_t getRoundsCount() const;
+};
@@ -0,0 +1,205 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BinConsensusVotesTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#define BOOST_PENDING_INTEGER_LOG2_HPP
+
+#include <boost/integer/integer_log2.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include "thirdparty/catch.hpp"
+
+#include "BinConsensusVotes.h"
+
+
+static constexpr uint64_t TRACE_NODE_COUNT = 16;
+static constexpr uint64_t TRACE_INSTANCES = 20000;
+static constexpr uint64_t TRACE_ROUNDS = 3;
+
+
+struct TracedVote {
+    uint32_t instance;
+    uint8_t round;
+    bool aux;
+    bool value;
+    uint8_t voter;
+};
+
+
+// Message trace of a 16 node chain. Every node broadcasts BVB and AUX votes for each round,
+// some nodes broadcast both values, and messages arrive in random order with duplicates.
+vector< TracedVote > create_bin_consensus_trace() {
+    boost::random::mt19937 gen;
+    boost::random::uniform_int_distribution<> ubyte( 0, 255 );
+
+    vector< TracedVote > trace;
+
+    for ( uint32_t i = 0; i < TRACE_INSTANCES; i++ ) {
+        auto begin = trace.size();
+        for ( uint8_t r = 0; r < TRACE_ROUNDS; r++ ) {
+            for ( uint8_t voter = 1; voter <= TRACE_NODE_COUNT; voter++ ) {
+                bool value = ubyte( gen ) % 4 != 0;
+                trace.push_back( { i, r, false, value, voter } );
+                if ( ubyte( gen ) % 8 == 0 )
+                    trace.push_back( { i, r, false, !value, voter } );
+                if ( ubyte( gen ) % 8 == 0 )
+                    trace.push_back( { i, r, false, value, voter } );
+                trace.push_back( { i, r, true, value, voter } );
+            }
+        }
+        for ( auto j = begin; j < trace.size(); j++ ) {
+            auto k = begin + ( ubyte( gen ) * 256 + ubyte( gen ) ) % ( trace.size() - begin );
+            swap( trace[j], trace[k] );
+        }
+    }
+
+    return trace;
+}
+
+
+// bookkeeping as it was done before BinConsensusVotes, used as a reference
+class MapBasedVotes {
+public:
+    map< bin_consensus_round, set< schain_index > > bvbTrueVotes;
+    map< bin_consensus_round, set< schain_index > > bvbFalseVotes;
+    map< bin_consensus_round, map< schain_index, ptr< ThresholdSigShare > > > auxTrueVotes;
+    map< bin_consensus_round, map< schain_index, ptr< ThresholdSigShare > > > auxFalseVotes;
+
+    bool bvbVote( bin_consensus_round _r, bin_consensus_value _v, schain_index _index ) {
+        return ( _v ? bvbTrueVotes : bvbFalseVotes )[_r].insert( _index ).second;
+    }
+
+    bool auxVote( bin_consensus_round _r, bin_consensus_value _v, schain_index _index ) {
+        return ( _v ? auxTrueVotes : auxFalseVotes )[_r].insert( { _index, nullptr } ).second;
+    }
+
+    node_count getBVBVoteCount( bin_consensus_value _v, bin_consensus_round _r ) {
+        return node_count( ( _v ? bvbTrueVotes[_r] : bvbFalseVotes[_r] ).size() );
+    }
+
+    uint64_t totalAUXVotes( bin_consensus_round _r ) {
+        return auxTrueVotes[_r].size() + auxFalseVotes[_r].size();
+    }
+};
+
+
+// replays the trace the way BinConsensusInstance processes a message, returns a checksum
+// of all threshold decisions
+template < class VOTES, class FACTORY >
+uint64_t replay_bin_consensus_trace(
+    const vector< TracedVote >& _trace, FACTORY _factory, uint64_t& _elapsedUs ) {
+    auto start = chrono::steady_clock::now();
+
+    uint64_t checksum = 0;
+    uint64_t currentInstance = UINT64_MAX;
+    ptr< VOTES > votes;
+
+    for ( auto&& m : _trace ) {
+        if ( m.instance != currentInstance ) {
+            currentInstance = m.instance;
+            votes = _factory();
+        }
+
+        auto r = bin_consensus_round( m.round );
+        auto v = bin_consensus_value( m.value );
+        auto index = schain_index( m.voter );
+
+        if ( !m.aux ) {
+            if ( !votes->bvbVote( r, v, index ) )
+                continue;
+            auto count = ( uint64_t ) votes->getBVBVoteCount( v, r );
+            checksum += ( count * 3 > TRACE_NODE_COUNT );
+            checksum += ( count * 3 > 2 * TRACE_NODE_COUNT ) << 1;
+        } else {
+            if ( !votes->auxVote( r, v, index ) )
+                continue;
+            checksum += ( votes->totalAUXVotes( r ) * 3 > 2 * TRACE_NODE_COUNT ) << 2;
+        }
+    }
+
+    _elapsedUs = chrono::duration_cast< chrono::microseconds >(
+        chrono::steady_clock::now() - start )
+                     .count();
+
+    return checksum;
+}
+
+
+class BitsetVotes : public BinConsensusVotes {
+public:
+    BitsetVotes() : BinConsensusVotes( node_count( TRACE_NODE_COUNT ) ) {}
+
+    bool auxVote( bin_consensus_round _r, bin_consensus_value _v, schain_index _index ) {
+        return BinConsensusVotes::auxVote( _r, _v, _index, nullptr );
+    }
+};
+
+
+TEST_CASE( "Bin consensus vote bookkeeping", "[bin-consensus-votes]" ) {
+    BinConsensusVotes votes{ node_count( TRACE_NODE_COUNT ) };
+
+    REQUIRE( votes.bvbVote(
+        bin_consensus_round( 0 ), bin_consensus_value( 1 ), schain_index( 1 ) ) );
+    REQUIRE( !votes.bvbVote(
+        bin_consensus_round( 0 ), bin_consensus_value( 1 ), schain_index( 1 ) ) );
+    REQUIRE( votes.bvbVote(
+        bin_consensus_round( 0 ), bin_consensus_value( 1 ), schain_index( 16 ) ) );
+    REQUIRE( ( uint64_t ) votes.getBVBVoteCount(
+                 bin_consensus_value( 1 ), bin_consensus_round( 0 ) ) == 2 );
+    REQUIRE( ( uint64_t ) votes.getBVBVoteCount(
+                 bin_consensus_value( 0 ), bin_consensus_round( 7 ) ) == 0 );
+    REQUIRE( votes.getRoundsCount() == 1 );
+
+    REQUIRE( votes.insertBinValue( bin_consensus_round( 1 ), bin_consensus_value( 0 ) ) );
+    REQUIRE( !votes.insertBinValue( bin_consensus_round( 1 ), bin_consensus_value( 0 ) ) );
+    REQUIRE( votes.hasBinValue( bin_consensus_round( 1 ), bin_consensus_value( 0 ) ) );
+    REQUIRE( !votes.hasBinValue( bin_consensus_round( 1 ), bin_consensus_value( 1 ) ) );
+    REQUIRE( votes.getBinValuesCount( bin_consensus_round( 1 ) ) == 1 );
+
+    REQUIRE_THROWS( votes.bvbVote(
+        bin_consensus_round( 0 ), bin_consensus_value( 1 ), schain_index( 17 ) ) );
+    REQUIRE_THROWS( votes.bvbVote(
+        bin_consensus_round( 0 ), bin_consensus_value( 1 ), schain_index( 0 ) ) );
+}
+
+
+TEST_CASE( "Replay 16 node bin consensus trace", "[.benchmark]" ) {
+    auto trace = create_bin_consensus_trace();
+
+    uint64_t mapUs = 0;
+    uint64_t bitsetUs = 0;
+
+    auto mapChecksum = replay_bin_consensus_trace< MapBasedVotes >(
+        trace, []() { return make_shared< MapBasedVotes >(); }, mapUs );
+    auto bitsetChecksum = replay_bin_consensus_trace< BitsetVotes >(
+        trace, []() { return make_shared< BitsetVotes >(); }, bitsetUs );
+
+    REQUIRE( mapChecksum == bitsetChecksum );
+
+    WARN( "Replayed " << trace.size() << " votes. map/set: " << mapUs
+          << " us, bitset: " << bitsetUs << " us" );
+}
@@ -69,6 +69,31 @@ consensustExecutive = getConsensustExecutive()
 #unitTest(consensustExecutive, "[sgx]")
 unitTest(consensustExecutive, "[tx-serialize]")
 unitTest(consensustExecutive, "[tx-list-serialize]")   
+unitTest(consensustExecutive, "[committed-block-list-inflate]")
+unitTest(consensustExecutive, "[block-batch-save-db]")
+unitTest(consensustExecutive, "[block-commit-batch]")
+unitTest(consensustExecutive, "[db-rotation]")
+unitTest(consensustExecutive, "[committed-tx-db]")
+unitTest(consensustExecutive, "[decoded-block-cache]")
+unitTest(consensustExecutive, "[block-metadata-index]")
+unitTest(consensustExecutive, "[fragment-plan]")
+unitTest(consensustExecutive, "[catchup-plan]")
+unitTest(consensustExecutive, "[partial-hash-index]")
+unitTest(consensustExecutive, "[binary-header]")
+unitTest(consensustExecutive, "[proposal-timeout]")
+unitTest(consensustExecutive, "[liveliness-monitor]")
+unitTest(consensustExecutive, "[oracle-fetch]")
+unitTest(consensustExecutive, "[oracle-coalesce]")
+unitTest(consensustExecutive, "[pricing]")
+unitTest(consensustExecutive, "[bin-consensus-votes]")
+unitTest(consensustExecutive, "[timer-wheel]")
+unitTest(consensustExecutive, "[executor]")
+unitTest(consensustExecutive, "[async-log]")
+unitTest(consensustExecutive, "[block-compression]")
+unitTest(consensustExecutive, "[cuckoo-filter]")
+unitTest(consensustExecutive, "[latency-histogram]")
+unitTest(consensustExecutive, "[reed-solomon]")
+unitTest(consensustExecutive, "[erasure-coded-defragment]")
 
 
 # fullConsensusTest("sixteennodes", consensustExecutive, "[consensus-finalization-download]")
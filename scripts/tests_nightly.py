@@ -90,3 +90,4 @@ fullConsensusTest("sixteennodes", consensustExecutive, "[consensus-finalization-
 
 
 
+fullConsensusTest("sixtyfournodes", consensustExecutive, "[consensus-throughput]");
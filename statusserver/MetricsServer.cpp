@@ -0,0 +1,291 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file MetricsServer.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include <arpa/inet.h>
+#include <microhttpd.h>
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "blockfinalize/client/BlockFinalizeDownloadScheduler.h"
+#include "chains/Schain.h"
+#include "crypto/CryptoManager.h"
+#include "datastructures/Transaction.h"
+#include "db/BlockDB.h"
+#include "db/CacheLevelDB.h"
+#include "network/Network.h"
+#include "node/Node.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/Time.h"
+
+#include "MetricsServer.h"
+
+#if MHD_VERSION >= 0x00097002
+using MHDResult = enum MHD_Result;
+#else
+using MHDResult = int;
+#endif
+
+
+static constexpr uint64_t DB_USAGE_REFRESH_INTERVAL_MS = 60000;
+
+
+static void appendHeader(
+    ostream& _out, const string& _name, const char* _type, const char* _help ) {
+    _out << "# HELP " << _name << " " << _help << "\n";
+    _out << "# TYPE " << _name << " " << _type << "\n";
+}
+
+
+static MHDResult handleMetricsRequest( void* _cls, MHD_Connection* _connection, const char* _url,
+    const char* _method, const char*, const char*, size_t*, void** ) {
+    auto server = static_cast< MetricsServer* >( _cls );
+
+    string body;
+    unsigned int status = MHD_HTTP_OK;
+
+    if ( string( _method ) != "GET" ) {
+        status = MHD_HTTP_METHOD_NOT_ALLOWED;
+    } else if ( string( _url ) != "/metrics" ) {
+        status = MHD_HTTP_NOT_FOUND;
+    } else {
+        try {
+            body = server->renderMetrics();
+        } catch ( exception& e ) {
+            SkaleException::logNested( e );
+            status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+        }
+    }
+
+    auto response = MHD_create_response_from_buffer(
+        body.size(), ( void* ) body.data(), MHD_RESPMEM_MUST_COPY );
+    MHD_add_response_header( response, "Content-Type", "text/plain; version=0.0.4" );
+    auto result = MHD_queue_response( _connection, status, response );
+    MHD_destroy_response( response );
+    return result;
+}
+
+
+MetricsServer::MetricsServer( Schain* _sChain, const string& _bindIP, uint16_t _port )
+    : sChain( _sChain ), bindIP( _bindIP ), port( _port ) {
+    CHECK_ARGUMENT( _sChain );
+}
+
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+
+bool MetricsServer::start() {
+    CHECK_STATE( !daemon );
+
+    // many nodes of a test chain share a port on different loopback addresses
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons( port );
+    if ( inet_pton( AF_INET, bindIP.c_str(), &addr.sin_addr ) != 1 )
+        addr.sin_addr.s_addr = htonl( INADDR_ANY );
+
+    daemon = MHD_start_daemon( MHD_USE_SELECT_INTERNALLY, port, nullptr, nullptr,
+        &handleMetricsRequest, this, MHD_OPTION_SOCK_ADDR, ( sockaddr* ) &addr,
+        MHD_OPTION_END );
+
+    return daemon != nullptr;
+}
+
+
+void MetricsServer::stop() {
+    if ( daemon ) {
+        MHD_stop_daemon( daemon );
+        daemon = nullptr;
+    }
+}
+
+
+map< string, uint64_t > MetricsServer::getCachedDBUsage() {
+    lock_guard< mutex > lock( dbUsageMutex );
+
+    auto now = Time::getCurrentTimeMs();
+
+    if ( dbUsageTimeMs == 0 || now - dbUsageTimeMs > DB_USAGE_REFRESH_INTERVAL_MS ) {
+        dbUsage = sChain->getNode()->getDBUsage();
+        dbUsageTimeMs = now;
+    }
+
+    return dbUsage;
+}
+
+
+string MetricsServer::renderMetrics() {
+    CHECK_STATE( sChain );
+
+    auto node = sChain->getNode();
+
+    stringstream out;
+
+    appendHeader( out, "consensus_last_committed_block_id", "gauge", "Last committed block id" );
+    out << "consensus_last_committed_block_id " << ( uint64_t ) sChain->getLastCommittedBlockID()
+        << "\n";
+
+    appendHeader( out, "consensus_tps_average", "gauge", "Transactions per second since start" );
+    out << "consensus_tps_average " << sChain->getTpsAverage() << "\n";
+
+    appendHeader( out, "consensus_block_time_average_ms", "gauge",
+        "Average time between blocks since start" );
+    out << "consensus_block_time_average_ms " << sChain->getBlockTimeAverageMs() << "\n";
+
+    appendHeader( out, "consensus_block_size_average", "gauge",
+        "Average transactions per block since start" );
+    out << "consensus_block_size_average " << sChain->getBlockSizeAverage() << "\n";
+
+    appendHeader( out, "consensus_tps_moving_average", "gauge",
+        "Moving average of transactions per second" );
+    out << "consensus_tps_moving_average " << sChain->getTpsMovingAverage() << "\n";
+
+    appendHeader( out, "consensus_block_time_moving_average_ms", "gauge",
+        "Moving average of time between blocks" );
+    out << "consensus_block_time_moving_average_ms " << sChain->getBlockTimeMovingAverageMs()
+        << "\n";
+
+    appendHeader( out, "consensus_block_size_moving_average", "gauge",
+        "Moving average of transactions per block" );
+    out << "consensus_block_size_moving_average " << sChain->getBlockSizeMovingAverage() << "\n";
+
+    appendHeader( out, "consensus_transaction_objects", "gauge", "Live Transaction objects" );
+    out << "consensus_transaction_objects " << Transaction::getTotalObjects() << "\n";
+
+    appendHeader( out, "consensus_leveldb_reads_total", "counter", "LevelDB reads" );
+    out << "consensus_leveldb_reads_total " << CacheLevelDB::getReads() << "\n";
+
+    appendHeader( out, "consensus_leveldb_writes_total", "counter", "LevelDB writes" );
+    out << "consensus_leveldb_writes_total " << CacheLevelDB::getWrites() << "\n";
+
+    appendHeader( out, "consensus_bls_signatures_total", "counter", "BLS signatures" );
+    out << "consensus_bls_signatures_total " << CryptoManager::getBLSs() << "\n";
+
+    appendHeader( out, "consensus_ecdsa_signatures_total", "counter", "ECDSA signatures" );
+    out << "consensus_ecdsa_signatures_total " << CryptoManager::getECDSAs() << "\n";
+
+    auto& decodedBlocks = node->getBlockDB()->getDecodedBlockCache();
+
+    appendHeader( out, "consensus_decoded_block_cache_hits_total", "counter",
+        "Block reads served from the decoded block cache" );
+    out << "consensus_decoded_block_cache_hits_total " << decodedBlocks.getHits() << "\n";
+
+    appendHeader( out, "consensus_decoded_block_cache_misses_total", "counter",
+        "Block reads that had to deserialize the block" );
+    out << "consensus_decoded_block_cache_misses_total " << decodedBlocks.getMisses() << "\n";
+
+    appendHeader( out, "consensus_decoded_block_cache_bytes", "gauge",
+        "Estimated memory held by the decoded block cache" );
+    out << "consensus_decoded_block_cache_bytes " << decodedBlocks.getBytes() << "\n";
+
+    appendHeader( out, "consensus_decoded_block_cache_blocks", "gauge",
+        "Blocks held by the decoded block cache" );
+    out << "consensus_decoded_block_cache_blocks " << decodedBlocks.getSize() << "\n";
+
+    appendHeader( out, "consensus_db_disk_usage_bytes", "gauge", "Disk usage of each database" );
+    for ( auto&& [name, size] : getCachedDBUsage() ) {
+        out << "consensus_db_disk_usage_bytes{db=\"" << name << "\"} " << size << "\n";
+    }
+
+    auto nodeCount = ( uint64_t ) sChain->getNodeCount();
+    auto myIndex = ( uint64_t ) sChain->getSchainIndex();
+
+    if ( node->isStarted() && !node->isSyncOnlyNode() ) {
+        auto network = node->getNetwork();
+        appendHeader( out, "consensus_delayed_sends", "gauge",
+            "Broadcast messages waiting to be resent to a peer" );
+        for ( uint64_t i = 1; i <= nodeCount; i++ ) {
+            if ( i == myIndex )
+                continue;
+            out << "consensus_delayed_sends{peer=\"" << i << "\"} "
+                << network->getDelayedSendsSize( schain_index( i ) ) << "\n";
+        }
+    }
+
+    appendHeader( out, "consensus_peer_alive", "gauge", "Zero if the peer is considered dead" );
+    for ( uint64_t i = 1; i <= nodeCount; i++ ) {
+        if ( i == myIndex )
+            continue;
+        out << "consensus_peer_alive{peer=\"" << i << "\"} "
+            << ( sChain->getDeathTimeMs( i ) == 0 ? 1 : 0 ) << "\n";
+    }
+
+    if ( !node->isSyncOnlyNode() ) {
+        auto peerStats = sChain->getBlockFinalizeDownloadScheduler()->getPeerStats();
+
+        appendHeader( out, "consensus_finalize_fragments_total", "counter",
+            "Proposal fragments downloaded from a peer during finalization" );
+        for ( uint64_t i = 1; i < peerStats.size(); i++ ) {
+            if ( i == myIndex )
+                continue;
+            out << "consensus_finalize_fragments_total{peer=\"" << i << "\"} "
+                << peerStats[i].fragments << "\n";
+        }
+
+        appendHeader( out, "consensus_finalize_failures_total", "counter",
+            "Failed fragment requests to a peer during finalization" );
+        for ( uint64_t i = 1; i < peerStats.size(); i++ ) {
+            if ( i == myIndex )
+                continue;
+            out << "consensus_finalize_failures_total{peer=\"" << i << "\"} "
+                << peerStats[i].failures << "\n";
+        }
+
+        appendHeader( out, "consensus_finalize_throughput_bytes_per_second", "gauge",
+            "Fragment download throughput of a peer" );
+        for ( uint64_t i = 1; i < peerStats.size(); i++ ) {
+            if ( i == myIndex )
+                continue;
+            out << "consensus_finalize_throughput_bytes_per_second{peer=\"" << i << "\"} "
+                << peerStats[i].getThroughputBytesPerSec() << "\n";
+        }
+
+        appendHeader( out, "consensus_finalize_latency_ms", "gauge",
+            "Moving average of the fragment download latency of a peer" );
+        for ( uint64_t i = 1; i < peerStats.size(); i++ ) {
+            if ( i == myIndex )
+                continue;
+            out << "consensus_finalize_latency_ms{peer=\"" << i << "\"} "
+                << peerStats[i].latencyMs << "\n";
+        }
+    }
+
+    appendHeader( out, "consensus_stage_latency_us", "summary",
+        "Latency of block pipeline stages in microseconds" );
+    for ( uint32_t i = 0; i < LAT_STAGE_COUNT; i++ ) {
+        auto stage = ( LatencyStage ) i;
+        auto snapshot = LatencyHistogram::getSnapshot( stage );
+        string label = string( "stage=\"" ) + LatencyHistogram::getStageName( stage ) + "\"";
+        for ( auto q : { 0.5, 0.99, 0.999 } ) {
+            out << "consensus_stage_latency_us{" << label << ",quantile=\"" << q << "\"} "
+                << snapshot.getValueAtPercentile( q * 100 ) << "\n";
+        }
+        out << "consensus_stage_latency_us_count{" << label << "} " << snapshot.getCount()
+            << "\n";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file MetricsServer.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+class Schain;
+struct MHD_Daemon;
+
+
+// Serves GET /metrics in the Prometheus text exposition format. Values are read from atomics
+// and static counters, the request thread never takes consensus locks.
+class MetricsServer {
+    Schain* sChain = nullptr;
+    string bindIP;
+    uint16_t port = 0;
+
+    MHD_Daemon* daemon = nullptr;
+
+    // db disk usage walks the db directories, so it is refreshed at most once per interval
+    map< string, uint64_t > dbUsage;
+    uint64_t dbUsageTimeMs = 0;
+    mutex dbUsageMutex;
+
+    map< string, uint64_t > getCachedDBUsage();
+
+public:
+    MetricsServer( Schain* _sChain, const string& _bindIP, uint16_t _port );
+
+    ~MetricsServer();
+
+    bool start();
+
+    void stop();
+
+    string renderMetrics();
+};
@@ -3,6 +3,8 @@
 //
 
 #include "StatusServer.h"
+#include "thirdparty/json.hpp"
+#include "utils/LatencyHistogram.h"
 
 
 /*************************************************************************
@@ -40,4 +42,8 @@ string StatusServer::consensus_getBlockSizeAverage() {
 string StatusServer::consensus_getBlockTimeAverageMs() {
     CHECK_STATE( sChain );
     return to_string( sChain->getBlockTimeAverageMs() );
-};
\ No newline at end of file
+};
+
+string StatusServer::consensus_getLatencyHistograms() {
+    return LatencyHistogram::toJson().dump();
+};
@@ -23,6 +23,9 @@ public:
     virtual string consensus_getTPSAverage();
     virtual string consensus_getBlockSizeAverage();
     virtual string consensus_getBlockTimeAverageMs();
+
+    // p50/p99/p999 of each block pipeline stage in microseconds, as a json string
+    virtual string consensus_getLatencyHistograms();
 };
 
 
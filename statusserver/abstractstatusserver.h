@@ -21,6 +21,9 @@ public:
         this->bindAndAddMethod( jsonrpc::Procedure( "consensus_getBlockTimeAverageMs",
                                     jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, NULL ),
             &AbstractStatusServer::consensus_getBlockTimeAverageMsI );
+        this->bindAndAddMethod( jsonrpc::Procedure( "consensus_getLatencyHistograms",
+                                    jsonrpc::PARAMS_BY_NAME, jsonrpc::JSON_STRING, NULL ),
+            &AbstractStatusServer::consensus_getLatencyHistogramsI );
     }
 
     inline virtual void consensus_getTPSAverageI(
@@ -38,9 +41,15 @@ public:
         ( void ) request;
         response = this->consensus_getBlockTimeAverageMs();
     }
+    inline virtual void consensus_getLatencyHistogramsI(
+        const Json::Value& request, Json::Value& response ) {
+        ( void ) request;
+        response = this->consensus_getLatencyHistograms();
+    }
     virtual std::string consensus_getTPSAverage() = 0;
     virtual std::string consensus_getBlockSizeAverage() = 0;
     virtual std::string consensus_getBlockTimeAverageMs() = 0;
+    virtual std::string consensus_getLatencyHistograms() = 0;
 };
 
 #endif  // JSONRPC_CPP_STUB_ABSTRACTSTATUSSERVER_H_
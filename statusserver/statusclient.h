@@ -43,6 +43,16 @@ public:
             throw jsonrpc::JsonRpcException(
                 jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString() );
     }
+    std::string consensus_getLatencyHistograms() throw( jsonrpc::JsonRpcException ) {
+        Json::Value p;
+        p = Json::nullValue;
+        Json::Value result = this->CallMethod( "consensus_getLatencyHistograms", p );
+        if ( result.isString() )
+            return result.asString();
+        else
+            throw jsonrpc::JsonRpcException(
+                jsonrpc::Errors::ERROR_CLIENT_INVALID_RESPONSE, result.toStyledString() );
+    }
 };
 
 #endif  // JSONRPC_CPP_STUB_STATUSCLIENT_H_
@@ -0,0 +1,170 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file TimerWheel.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "TimerWheel.h"
+
+
+TimerWheel::TimerWheel( uint64_t _startMs ) : currentMs( _startMs ) {}
+
+
+bool TimerWheel::isLive( const Entry& _entry ) const {
+    auto it = deadlines.find( _entry.id );
+    return it != deadlines.end() && it->second.generation == _entry.generation;
+}
+
+
+void TimerWheel::place( const Entry& _entry, uint64_t _deadlineMs ) {
+    if ( _deadlineMs < currentMs ) {
+        overdue.push_back( _entry );
+        return;
+    }
+
+    auto deadline = _deadlineMs;
+    auto delta = deadline - currentMs;
+
+    uint64_t level = 0;
+    while ( level < LEVELS - 1 && delta >= ( 1ULL << ( SLOT_BITS * ( level + 1 ) ) ) ) {
+        level++;
+    }
+
+    // deadlines past the top level land in its furthest slot and are placed again when it is
+    // cascaded
+    if ( level == LEVELS - 1 && delta >= ( 1ULL << ( SLOT_BITS * LEVELS ) ) )
+        deadline = currentMs + ( 1ULL << ( SLOT_BITS * LEVELS ) ) - 1;
+
+    auto index = ( deadline >> ( SLOT_BITS * level ) ) & ( SLOTS - 1 );
+    slots[level][index].push_back( _entry );
+}
+
+
+void TimerWheel::add( uint64_t _id, uint64_t _deadlineMs ) {
+    Entry entry{ _id, ++generation };
+    deadlines[_id] = { _deadlineMs, entry.generation };
+    place( entry, _deadlineMs );
+}
+
+
+bool TimerWheel::cancel( uint64_t _id ) {
+    return deadlines.erase( _id ) > 0;
+}
+
+
+uint64_t TimerWheel::getDeadlineMs( uint64_t _id ) const {
+    auto it = deadlines.find( _id );
+    return it == deadlines.end() ? 0 : it->second.deadlineMs;
+}
+
+
+void TimerWheel::cascade( uint64_t _level ) {
+    auto index = ( currentMs >> ( SLOT_BITS * _level ) ) & ( SLOTS - 1 );
+    vector< Entry > entries;
+    entries.swap( slots[_level][index] );
+
+    for ( auto&& entry : entries ) {
+        if ( isLive( entry ) )
+            place( entry, deadlines.at( entry.id ).deadlineMs );
+    }
+}
+
+
+void TimerWheel::advance( uint64_t _nowMs, vector< uint64_t >& _expired ) {
+    for ( auto&& entry : overdue ) {
+        if ( isLive( entry ) ) {
+            deadlines.erase( entry.id );
+            _expired.push_back( entry.id );
+        }
+    }
+    overdue.clear();
+
+    while ( currentMs <= _nowMs ) {
+        // nothing happens before the next wakeup, so the wheel can jump there
+        auto next = getNextWakeupMs();
+        if ( next > _nowMs ) {
+            currentMs = _nowMs + 1;
+            return;
+        }
+        currentMs = max( currentMs, next );
+
+        // higher levels first, so that their timers can still move to the slots about to run
+        for ( uint64_t level = LEVELS - 1; level > 0; level-- ) {
+            if ( ( currentMs & ( ( 1ULL << ( SLOT_BITS * level ) ) - 1 ) ) == 0 )
+                cascade( level );
+        }
+
+        vector< Entry > entries;
+        entries.swap( slots[0][currentMs & ( SLOTS - 1 )] );
+
+        for ( auto&& entry : entries ) {
+            if ( !isLive( entry ) )
+                continue;
+            if ( deadlines.at( entry.id ).deadlineMs <= currentMs ) {
+                deadlines.erase( entry.id );
+                _expired.push_back( entry.id );
+            } else {
+                // a clamped deadline past the top level
+                place( entry, deadlines.at( entry.id ).deadlineMs );
+            }
+        }
+
+        currentMs++;
+    }
+}
+
+
+uint64_t TimerWheel::getNextWakeupMs() const {
+    if ( deadlines.empty() )
+        return UINT64_MAX;
+
+    if ( !overdue.empty() )
+        return 0;
+
+    auto result = UINT64_MAX;
+
+    for ( uint64_t level = 0; level < LEVELS; level++ ) {
+        uint64_t unitBits = SLOT_BITS * level;
+        uint64_t block = currentMs >> unitBits;
+        // a slot that starts at currentMs is processed by the next advance, later slots when
+        // the wheel reaches their start
+        uint64_t first = ( ( block << unitBits ) == currentMs ) ? 0 : 1;
+
+        for ( uint64_t i = first; i <= SLOTS; i++ ) {
+            auto time = ( block + i ) << unitBits;
+            if ( time >= result )
+                break;
+            if ( !slots[level][( block + i ) & ( SLOTS - 1 )].empty() ) {
+                result = time;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+uint64_t TimerWheel::size() const {
+    return deadlines.size();
+}
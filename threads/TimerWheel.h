@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file TimerWheel.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Hierarchical timing wheel of timer ids with millisecond resolution. Level 0 has a slot per
+// millisecond, a slot of each higher level spans a whole turn of the level below. Adding and
+// cancelling are O(1). Timers move down a level when the wheel reaches the span of their slot.
+// The wheel has no tick of its own: getNextWakeupMs tells when advance has work to do, so an
+// idle owner sleeps until then.
+class TimerWheel {
+public:
+    static constexpr uint64_t SLOT_BITS = 6;
+    static constexpr uint64_t SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64_t LEVELS = 4;
+
+private:
+    struct Entry {
+        uint64_t id;
+        uint64_t generation;
+    };
+
+    struct Deadline {
+        uint64_t deadlineMs;
+        uint64_t generation;
+    };
+
+    // entries of cancelled or moved timers stay in their slot and are dropped when it is
+    // processed, they are recognized by a stale generation
+    array< array< vector< Entry >, SLOTS >, LEVELS > slots;
+
+    // timers added with a deadline the wheel already passed
+    vector< Entry > overdue;
+
+    unordered_map< uint64_t, Deadline > deadlines;
+
+    uint64_t generation = 0;
+
+    // the next millisecond to process
+    uint64_t currentMs = 0;
+
+    void place( const Entry& _entry, uint64_t _deadlineMs );
+
+    bool isLive( const Entry& _entry ) const;
+
+    // moves the timers of the slot of _level that starts at currentMs one level down
+    void cascade( uint64_t _level );
+
+public:
+    explicit TimerWheel( uint64_t _startMs );
+
+    // a deadline in the past fires on the next advance. Adding an id again replaces its deadline
+    void add( uint64_t _id, uint64_t _deadlineMs );
+
+    bool cancel( uint64_t _id );
+
+    // 0 if the id is not in the wheel
+    uint64_t getDeadlineMs( uint64_t _id ) const;
+
+    // removes the timers due at _nowMs and appends their ids to _expired
+    void advance( uint64_t _nowMs, vector< uint64_t >& _expired );
+
+    // the earliest time advance has to run, never later than the earliest deadline. 0 if a timer
+    // is overdue, UINT64_MAX if the wheel is empty
+    uint64_t getNextWakeupMs() const;
+
+    uint64_t size() const;
+};
@@ -0,0 +1,138 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file TimerWheelTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "TimerWheel.h"
+
+
+TEST_CASE( "Timer wheel fires timers on their deadline", "[timer-wheel]" ) {
+    TimerWheel wheel( 1000 );
+    vector< uint64_t > expired;
+
+    REQUIRE( wheel.getNextWakeupMs() == UINT64_MAX );
+
+    wheel.add( 1, 1010 );
+    wheel.add( 2, 1000 + 5000 );
+    wheel.add( 3, 500 );
+    REQUIRE( wheel.size() == 3 );
+
+    // an overdue timer fires right away
+    REQUIRE( wheel.getNextWakeupMs() == 0 );
+    wheel.advance( 1000, expired );
+    REQUIRE( expired == vector< uint64_t >{ 3 } );
+
+    expired.clear();
+    wheel.advance( 1009, expired );
+    REQUIRE( expired.empty() );
+    wheel.advance( 1010, expired );
+    REQUIRE( expired == vector< uint64_t >{ 1 } );
+
+    // the far timer needs a few cascades, never a wakeup per millisecond
+    expired.clear();
+    uint64_t wakeups = 0;
+    while ( expired.empty() ) {
+        auto next = wheel.getNextWakeupMs();
+        REQUIRE( next <= 6000 );
+        wheel.advance( next, expired );
+        wakeups++;
+    }
+    REQUIRE( expired == vector< uint64_t >{ 2 } );
+    REQUIRE( wakeups < 5 );
+    REQUIRE( wheel.size() == 0 );
+}
+
+
+TEST_CASE( "Timer wheel cancels and replaces deadlines", "[timer-wheel]" ) {
+    TimerWheel wheel( 0 );
+    vector< uint64_t > expired;
+
+    wheel.add( 1, 100 );
+    wheel.add( 2, 100 );
+    REQUIRE( wheel.cancel( 2 ) );
+    REQUIRE( !wheel.cancel( 2 ) );
+
+    // moving a timer earlier and later leaves a single live entry
+    wheel.add( 1, 50 );
+    wheel.add( 1, 70 );
+    REQUIRE( wheel.getDeadlineMs( 1 ) == 70 );
+
+    wheel.advance( 200, expired );
+    REQUIRE( expired == vector< uint64_t >{ 1 } );
+    REQUIRE( wheel.getDeadlineMs( 1 ) == 0 );
+}
+
+
+TEST_CASE( "Timer wheel matches a sorted reference", "[timer-wheel]" ) {
+    mt19937_64 random( 7 );
+    uint64_t now = 123456;
+    TimerWheel wheel( now );
+    map< uint64_t, uint64_t > reference;
+
+    for ( uint64_t step = 0; step < 20000; step++ ) {
+        auto id = random() % 500;
+        switch ( random() % 4 ) {
+        case 0: {
+            // deadlines from the past to beyond the top level
+            uint64_t range = 1ULL << ( random() % 26 );
+            auto deadline = now + random() % range - min( range / 8, now );
+            wheel.add( id, deadline );
+            reference[id] = deadline;
+            break;
+        }
+        case 1:
+            REQUIRE( wheel.cancel( id ) == ( reference.erase( id ) > 0 ) );
+            break;
+        default: {
+            now += random() % ( 1ULL << ( random() % 20 ) );
+            vector< uint64_t > expired;
+            wheel.advance( now, expired );
+
+            set< uint64_t > expected;
+            for ( auto it = reference.begin(); it != reference.end(); ) {
+                if ( it->second <= now ) {
+                    expected.insert( it->first );
+                    it = reference.erase( it );
+                } else {
+                    it++;
+                }
+            }
+
+            REQUIRE( set< uint64_t >( expired.begin(), expired.end() ) == expected );
+            REQUIRE( expired.size() == expected.size() );
+
+            if ( !reference.empty() ) {
+                uint64_t earliest = UINT64_MAX;
+                for ( auto&& item : reference ) {
+                    earliest = min( earliest, item.second );
+                }
+                REQUIRE( wheel.getNextWakeupMs() <= earliest );
+            }
+        }
+        }
+        REQUIRE( wheel.size() == reference.size() );
+    }
+}
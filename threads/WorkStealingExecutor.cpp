@@ -0,0 +1,327 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file WorkStealingExecutor.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "exceptions/FatalError.h"
+#include "utils/Time.h"
+
+#include "WorkStealingExecutor.h"
+
+
+// index of the worker running on this thread, -1 on other threads
+static thread_local int64_t currentWorker = -1;
+
+// timer whose task runs on this thread, 0 if none
+static thread_local WorkStealingExecutor::timer_id currentTimer = 0;
+
+
+WorkStealingExecutor::WorkStealingExecutor( uint64_t _numThreads )
+    : timerWheel( Time::getCurrentTimeMs() ) {
+    CHECK_ARGUMENT( _numThreads > 0 );
+
+    for ( uint64_t i = 0; i < _numThreads; i++ ) {
+        queues.push_back( make_shared< WorkerQueue >() );
+    }
+
+    for ( uint64_t i = 0; i < _numThreads; i++ ) {
+        workers.emplace_back( &WorkStealingExecutor::workerLoop, this, i );
+    }
+
+    timerThread = thread( &WorkStealingExecutor::timerLoop, this );
+}
+
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    stop();
+}
+
+
+void WorkStealingExecutor::submit( function< void() >&& _task ) {
+    CHECK_ARGUMENT( _task );
+
+    if ( stopped )
+        return;
+
+    uint64_t index = currentWorker >= 0 ? ( uint64_t ) currentWorker :
+                                          nextQueue.fetch_add( 1 ) % queues.size();
+
+    {
+        lock_guard< mutex > lock( queues.at( index )->m );
+        queues.at( index )->tasks.push_back( move( _task ) );
+    }
+
+    {
+        lock_guard< mutex > lock( idleMutex );
+        pendingTasks++;
+    }
+    idleCond.notify_one();
+}
+
+
+bool WorkStealingExecutor::tryTake( uint64_t _workerIndex, function< void() >& _task ) {
+    {
+        auto& own = *queues.at( _workerIndex );
+        lock_guard< mutex > lock( own.m );
+        if ( !own.tasks.empty() ) {
+            _task = move( own.tasks.back() );
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for ( uint64_t i = 1; i < queues.size(); i++ ) {
+        auto& victim = *queues.at( ( _workerIndex + i ) % queues.size() );
+        lock_guard< mutex > lock( victim.m );
+        if ( !victim.tasks.empty() ) {
+            _task = move( victim.tasks.front() );
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void WorkStealingExecutor::runTask( function< void() >& _task ) {
+    try {
+        _task();
+    } catch ( exception& e ) {
+        SkaleException::logNested( e );
+    } catch ( ... ) {
+        LOG( err, "Unknown exception in executor task" );
+    }
+}
+
+
+void WorkStealingExecutor::workerLoop( uint64_t _workerIndex ) {
+    currentWorker = ( int64_t ) _workerIndex;
+    pthread_setname_np( pthread_self(), "Executor" );
+
+    function< void() > task;
+
+    while ( !stopped ) {
+        if ( tryTake( _workerIndex, task ) ) {
+            pendingTasks--;
+            runTask( task );
+            task = nullptr;
+            continue;
+        }
+
+        unique_lock< mutex > lock( idleMutex );
+        idleCond.wait( lock, [this]() { return pendingTasks > 0 || stopped; } );
+    }
+}
+
+
+void WorkStealingExecutor::enqueueTimer( uint64_t _deadlineMs, const ptr< Timer >& _timer ) {
+    timerWheel.add( _timer->id, _deadlineMs );
+    // the timer thread only needs to wake up for a deadline before its planned wakeup
+    if ( _deadlineMs < timerThreadWakeupMs ) {
+        timerThreadWakeupMs = _deadlineMs;
+        timersCond.notify_one();
+    }
+}
+
+
+WorkStealingExecutor::timer_id WorkStealingExecutor::addTimer(
+    uint64_t _delayMs, uint64_t _intervalMs, function< void() >&& _task ) {
+    CHECK_ARGUMENT( _task );
+
+    auto timer = make_shared< Timer >();
+    timer->intervalMs = _intervalMs;
+    timer->task = move( _task );
+
+    lock_guard< mutex > lock( timersMutex );
+    timer->id = nextTimerID++;
+    timers[timer->id] = timer;
+    enqueueTimer( Time::getCurrentTimeMs() + _delayMs, timer );
+    return timer->id;
+}
+
+
+WorkStealingExecutor::timer_id WorkStealingExecutor::schedule(
+    uint64_t _delayMs, function< void() >&& _task ) {
+    return addTimer( _delayMs, 0, move( _task ) );
+}
+
+
+WorkStealingExecutor::timer_id WorkStealingExecutor::schedulePeriodic(
+    uint64_t _intervalMs, function< void() >&& _task ) {
+    CHECK_ARGUMENT( _intervalMs > 0 );
+    return addTimer( _intervalMs, _intervalMs, move( _task ) );
+}
+
+
+void WorkStealingExecutor::cancel( timer_id _timerID ) {
+    ptr< Timer > timer;
+
+    {
+        lock_guard< mutex > lock( timersMutex );
+        auto it = timers.find( _timerID );
+        if ( it == timers.end() )
+            return;
+        timer = it->second;
+        timers.erase( it );
+
+        timer->cancelled = true;
+        timerWheel.cancel( _timerID );
+    }
+
+    // wait for a run in progress on another thread
+    if ( currentTimer != _timerID ) {
+        lock_guard< mutex > lock( timer->running );
+    }
+}
+
+
+void WorkStealingExecutor::runTimer( const ptr< Timer >& _timer ) {
+    {
+        lock_guard< mutex > lock( _timer->running );
+
+        if ( _timer->cancelled )
+            return;
+
+        currentTimer = _timer->id;
+        runTask( _timer->task );
+        currentTimer = 0;
+    }
+
+    lock_guard< mutex > lock( timersMutex );
+
+    if ( _timer->cancelled )
+        return;
+
+    auto requested = _timer->requestedDeadlineMs;
+    _timer->requestedDeadlineMs = 0;
+
+    if ( _timer->intervalMs == 0 ) {
+        timers.erase( _timer->id );
+    } else {
+        auto deadline = Time::getCurrentTimeMs() + _timer->intervalMs;
+        if ( requested != 0 )
+            deadline = min( deadline, requested );
+        enqueueTimer( deadline, _timer );
+    }
+}
+
+
+void WorkStealingExecutor::runSooner( timer_id _timerID, uint64_t _delayMs ) {
+    lock_guard< mutex > lock( timersMutex );
+
+    auto it = timers.find( _timerID );
+    if ( it == timers.end() )
+        return;
+
+    auto& timer = it->second;
+    auto deadline = Time::getCurrentTimeMs() + _delayMs;
+    auto current = timerWheel.getDeadlineMs( _timerID );
+
+    if ( current == 0 ) {
+        // submitted or running, the deadline applies when it is put back in the wheel
+        if ( timer->requestedDeadlineMs == 0 || deadline < timer->requestedDeadlineMs )
+            timer->requestedDeadlineMs = deadline;
+    } else if ( deadline < current ) {
+        enqueueTimer( deadline, timer );
+    }
+}
+
+
+void WorkStealingExecutor::timerLoop() {
+    pthread_setname_np( pthread_self(), "ExecutorTimer" );
+
+    unique_lock< mutex > lock( timersMutex );
+
+    vector< timer_id > expired;
+
+    while ( !stopped ) {
+        auto now = Time::getCurrentTimeMs();
+
+        timerWheel.advance( now, expired );
+
+        for ( auto id : expired ) {
+            auto it = timers.find( id );
+            if ( it != timers.end() ) {
+                auto timer = it->second;
+                submit( [this, timer]() { runTimer( timer ); } );
+            }
+        }
+        expired.clear();
+
+        // sleep until the wheel has work, an earlier timer added meanwhile notifies
+        timerThreadWakeupMs = timerWheel.getNextWakeupMs();
+
+        if ( timerThreadWakeupMs == UINT64_MAX ) {
+            timersCond.wait( lock );
+        } else if ( timerThreadWakeupMs > now ) {
+            timersCond.wait_for( lock, chrono::milliseconds( timerThreadWakeupMs - now ) );
+        }
+    }
+}
+
+
+void WorkStealingExecutor::stop() {
+    if ( stopped.exchange( true ) )
+        return;
+
+    {
+        lock_guard< mutex > lock( idleMutex );
+    }
+    idleCond.notify_all();
+
+    {
+        lock_guard< mutex > lock( timersMutex );
+    }
+    timersCond.notify_all();
+
+    for ( auto&& worker : workers ) {
+        if ( worker.joinable() )
+            worker.join();
+    }
+
+    if ( timerThread.joinable() )
+        timerThread.join();
+}
+
+
+uint64_t WorkStealingExecutor::getThreadCount() const {
+    return workers.size();
+}
+
+
+uint64_t WorkStealingExecutor::getDefaultThreadCount() {
+    return max( ( uint64_t ) thread::hardware_concurrency(), ( uint64_t ) 2 );
+}
+
+
+WorkStealingExecutor& WorkStealingExecutor::getInstance() {
+    // never destroyed, so that agents cancelling timers at exit do not use a dead executor
+    static WorkStealingExecutor* instance = [] {
+        auto executor = new WorkStealingExecutor( getDefaultThreadCount() );
+        atexit( [] { getInstance().stop(); } );
+        return executor;
+    }();
+
+    return *instance;
+}
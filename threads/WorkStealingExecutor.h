@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file WorkStealingExecutor.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+#include "TimerWheel.h"
+
+
+// Process wide pool of worker threads, shared by all chains of the process and sized to the
+// machine. Each worker has its own task deque. Tasks submitted by a worker go to its own deque,
+// other tasks are spread round robin. A worker runs the newest task of its own deque and, when it
+// is empty, steals the oldest task of another worker. Timers run tasks after a delay or
+// periodically. Tasks must not block for long, agents that wait on sockets or queues keep
+// dedicated threads.
+class WorkStealingExecutor {
+public:
+    typedef uint64_t timer_id;
+
+private:
+    struct WorkerQueue {
+        mutex m;
+        deque< function< void() > > tasks;
+    };
+
+    struct Timer {
+        timer_id id = 0;
+        // 0 for one shot timers
+        uint64_t intervalMs = 0;
+        function< void() > task;
+        atomic< bool > cancelled = false;
+        // deadline asked for by runSooner while the task was running, 0 if none
+        uint64_t requestedDeadlineMs = 0;
+        // held while the task runs, so that cancel can wait for it
+        mutex running;
+    };
+
+    vector< ptr< WorkerQueue > > queues;
+
+    vector< thread > workers;
+
+    atomic< uint64_t > nextQueue = 0;
+
+    // tasks submitted and not yet taken, idle workers sleep while it is 0
+    atomic< uint64_t > pendingTasks = 0;
+    mutex idleMutex;
+    condition_variable idleCond;
+
+    mutex timersMutex;
+    condition_variable timersCond;
+    TimerWheel timerWheel;
+    // when the timer thread wakes up next, so that only earlier timers have to wake it
+    uint64_t timerThreadWakeupMs = UINT64_MAX;
+    map< timer_id, ptr< Timer > > timers;
+    timer_id nextTimerID = 1;
+    thread timerThread;
+
+    atomic< bool > stopped = false;
+
+    bool tryTake( uint64_t _workerIndex, function< void() >& _task );
+
+    void workerLoop( uint64_t _workerIndex );
+
+    void timerLoop();
+
+    void runTimer( const ptr< Timer >& _timer );
+
+    timer_id addTimer( uint64_t _delayMs, uint64_t _intervalMs, function< void() >&& _task );
+
+    // the caller holds timersMutex
+    void enqueueTimer( uint64_t _deadlineMs, const ptr< Timer >& _timer );
+
+    static void runTask( function< void() >& _task );
+
+public:
+    explicit WorkStealingExecutor( uint64_t _numThreads );
+
+    ~WorkStealingExecutor();
+
+    void submit( function< void() >&& _task );
+
+    // runs _task once after _delayMs
+    timer_id schedule( uint64_t _delayMs, function< void() >&& _task );
+
+    // runs _task every _intervalMs, counted from the end of the previous run, so runs of one
+    // timer never overlap
+    timer_id schedulePeriodic( uint64_t _intervalMs, function< void() >&& _task );
+
+    // moves the next run of the timer to _delayMs from now, unless it is due earlier. If the
+    // task is running, its next run is moved. Agents use it to react to events at once and poll
+    // rarely
+    void runSooner( timer_id _timerID, uint64_t _delayMs = 0 );
+
+    // once this returns the task of the timer is not running and will not run again, unless
+    // called from the task itself
+    void cancel( timer_id _timerID );
+
+    // stops the workers, tasks that did not start are dropped
+    void stop();
+
+    [[nodiscard]] uint64_t getThreadCount() const;
+
+    // one worker per core
+    static uint64_t getDefaultThreadCount();
+
+    // the process wide executor, stopped at exit
+    static WorkStealingExecutor& getInstance();
+};
@@ -0,0 +1,170 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file WorkStealingExecutorTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "utils/Time.h"
+#include "WorkStealingExecutor.h"
+
+
+static void waitFor( const function< bool() >& _condition ) {
+    auto start = Time::getCurrentTimeMs();
+    while ( !_condition() ) {
+        REQUIRE( Time::getCurrentTimeMs() - start < 10000 );
+        usleep( 1000 );
+    }
+}
+
+
+TEST_CASE( "Executor runs submitted tasks", "[executor]" ) {
+    WorkStealingExecutor executor( 4 );
+    REQUIRE( executor.getThreadCount() == 4 );
+
+    atomic< uint64_t > done = 0;
+
+    for ( uint64_t i = 0; i < 10000; i++ ) {
+        executor.submit( [&done]() { done++; } );
+    }
+
+    waitFor( [&]() { return done == 10000; } );
+}
+
+
+TEST_CASE( "Executor workers steal from a busy worker", "[executor]" ) {
+    WorkStealingExecutor executor( 4 );
+
+    mutex threadsLock;
+    set< thread::id > threads;
+    atomic< uint64_t > done = 0;
+
+    // all children are submitted from one worker, so they land in its own deque
+    executor.submit( [&]() {
+        for ( uint64_t i = 0; i < 400; i++ ) {
+            executor.submit( [&]() {
+                usleep( 1000 );
+                {
+                    lock_guard< mutex > lock( threadsLock );
+                    threads.insert( this_thread::get_id() );
+                }
+                done++;
+            } );
+        }
+    } );
+
+    waitFor( [&]() { return done == 400; } );
+
+    REQUIRE( threads.size() > 1 );
+}
+
+
+TEST_CASE( "Executor timers", "[executor]" ) {
+    WorkStealingExecutor executor( 2 );
+
+    SECTION( "one shot timer runs once after the delay" ) {
+        atomic< uint64_t > runs = 0;
+        auto start = Time::getCurrentTimeMs();
+        atomic< uint64_t > ranAt = 0;
+
+        executor.schedule( 50, [&]() {
+            ranAt = Time::getCurrentTimeMs();
+            runs++;
+        } );
+
+        waitFor( [&]() { return runs == 1; } );
+        usleep( 100000 );
+        REQUIRE( runs == 1 );
+        REQUIRE( ranAt - start >= 50 );
+    }
+
+    SECTION( "periodic timer repeats until cancelled" ) {
+        atomic< uint64_t > runs = 0;
+        auto id = executor.schedulePeriodic( 5, [&]() { runs++; } );
+
+        waitFor( [&]() { return runs >= 5; } );
+        executor.cancel( id );
+
+        uint64_t afterCancel = runs;
+        usleep( 50000 );
+        REQUIRE( runs == afterCancel );
+    }
+
+    SECTION( "cancel waits for a running task" ) {
+        atomic< bool > started = false;
+        atomic< bool > finished = false;
+
+        auto id = executor.schedulePeriodic( 1, [&]() {
+            started = true;
+            usleep( 50000 );
+            finished = true;
+        } );
+
+        waitFor( [&]() { return started.load(); } );
+        executor.cancel( id );
+        REQUIRE( finished );
+    }
+
+    SECTION( "runSooner wakes a slow periodic timer" ) {
+        atomic< uint64_t > runs = 0;
+        auto id = executor.schedulePeriodic( 100000, [&]() { runs++; } );
+
+        executor.runSooner( id );
+        waitFor( [&]() { return runs == 1; } );
+
+        // asked while running or queued, the next run comes early once
+        executor.runSooner( id, 20 );
+        waitFor( [&]() { return runs == 2; } );
+
+        usleep( 50000 );
+        REQUIRE( runs == 2 );
+        executor.cancel( id );
+    }
+
+    SECTION( "a timer can cancel itself" ) {
+        atomic< uint64_t > runs = 0;
+        atomic< uint64_t > id = 0;
+
+        id = executor.schedulePeriodic( 10, [&]() {
+            if ( ++runs == 3 )
+                executor.cancel( id );
+        } );
+
+        waitFor( [&]() { return runs == 3; } );
+        usleep( 50000 );
+        REQUIRE( runs == 3 );
+    }
+}
+
+
+TEST_CASE( "Executor survives throwing tasks", "[executor]" ) {
+    WorkStealingExecutor executor( 1 );
+
+    atomic< bool > ran = false;
+
+    executor.submit( []() { throw runtime_error( "test" ); } );
+    executor.submit( [&]() { ran = true; } );
+
+    waitFor( [&]() { return ran.load(); } );
+}
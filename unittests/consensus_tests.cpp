@@ -95,3 +95,36 @@ TEST_CASE_METHOD(
     unsetenv( "CORRUPT_PROPOSAL_TEST" );
     SUCCEED();
 }
+
+
+// run from test/sixtyfournodes, which uses the in-memory simulated transport
+TEST_CASE_METHOD( StartFromScratch, "Measure consensus throughput", "[consensus-throughput]" ) {
+    engine = new ConsensusEngine( 0, 1000000000 );
+    engine->parseTestConfigsAndCreateAllNodes( Consensust::getConfigDirPath() );
+    engine->slowStartBootStrapTest();
+
+    auto startTime = Time::getCurrentTimeMs();
+    auto startBlock = ( uint64_t ) engine->getLargestCommittedBlockID();
+
+    usleep( 1000 * 1000 * Consensust::getRunningTimeS() ); /* Flawfinder: ignore */
+
+    auto elapsedMs = Time::getCurrentTimeMs() - startTime;
+    auto lastBlock = ( uint64_t ) engine->getLargestCommittedBlockID();
+
+    uint64_t transactionCount = 0;
+    for ( uint64_t i = startBlock + 1; i <= lastBlock; i++ ) {
+        auto [transactions, timestampS, timeStampMs, price, stateRoot] = engine->getBlock( i );
+        if ( transactions )
+            transactionCount += transactions->size();
+    }
+
+    printf( "THROUGHPUT: nodes %lu blocks %lu transactions %lu elapsed_ms %lu tps %lu\n",
+        ( uint64_t ) engine->nodesCount(), lastBlock - startBlock, transactionCount, elapsedMs,
+        transactionCount * 1000 / max< uint64_t >( elapsedMs, 1 ) );
+
+    REQUIRE( lastBlock > startBlock );
+
+    engine->testExitGracefullyBlocking();
+    delete engine;
+    SUCCEED();
+}
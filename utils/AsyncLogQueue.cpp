@@ -0,0 +1,252 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AsyncLogQueue.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "AsyncLogQueue.h"
+
+
+AsyncLogQueue::AsyncLogQueue( uint64_t _capacity ) {
+    CHECK_ARGUMENT( _capacity > 0 );
+
+    uint64_t capacity = 1;
+    while ( capacity < _capacity ) {
+        capacity <<= 1;
+    }
+
+    mask = capacity - 1;
+    slots = make_unique< Slot[] >( capacity );
+
+    // a slot is free for position p when its sequence is p, and full when it is p + 1
+    for ( uint64_t i = 0; i < capacity; i++ ) {
+        slots[i].sequence.store( i, memory_order_relaxed );
+    }
+
+    drainThread = thread( [this]() { drainLoop(); } );
+}
+
+
+AsyncLogQueue::~AsyncLogQueue() {
+    stop();
+}
+
+
+bool AsyncLogQueue::tryPush( const shared_ptr< spdlog::logger >& _logger,
+    spdlog::level::level_enum _severity, string& _message ) {
+    auto pos = head.load( memory_order_relaxed );
+
+    Slot* slot;
+
+    while ( true ) {
+        slot = &slots[pos & mask];
+        auto sequence = slot->sequence.load( memory_order_acquire );
+        auto diff = ( int64_t ) sequence - ( int64_t ) pos;
+        if ( diff == 0 ) {
+            if ( head.compare_exchange_weak( pos, pos + 1, memory_order_relaxed ) )
+                break;
+        } else if ( diff < 0 ) {
+            return false;
+        } else {
+            pos = head.load( memory_order_relaxed );
+        }
+    }
+
+    slot->logger = _logger;
+    slot->severity = _severity;
+    slot->time = spdlog::log_clock::now();
+    slot->message = move( _message );
+    slot->sequence.store( pos + 1, memory_order_release );
+
+    return true;
+}
+
+
+void AsyncLogQueue::push( const shared_ptr< spdlog::logger >& _logger,
+    spdlog::level::level_enum _severity, string&& _message ) {
+    CHECK_ARGUMENT( _logger );
+
+    while ( !stopped ) {
+        if ( tryPush( _logger, _severity, _message ) ) {
+            wakeDrain();
+            // the fence in wakeDrain orders the push before this check, so if stop() is not
+            // seen here the drain thread sees the record before it exits
+            if ( stopped ) {
+                drainAfterStop();
+            } else if ( _severity >= spdlog::level::err ) {
+                flush();
+            }
+            return;
+        }
+        waitForSpace();
+    }
+
+    _logger->log( _severity, _message );
+}
+
+
+bool AsyncLogQueue::writeNext() {
+    auto pos = tail.load( memory_order_relaxed );
+    auto& slot = slots[pos & mask];
+
+    if ( slot.sequence.load( memory_order_acquire ) != pos + 1 )
+        return false;
+
+    auto logger = move( slot.logger );
+    auto severity = slot.severity;
+    auto time = slot.time;
+    auto message = move( slot.message );
+
+    slot.sequence.store( pos + mask + 1, memory_order_release );
+
+    try {
+        logger->log( time, spdlog::source_loc{}, severity, message );
+    } catch ( ... ) {
+        // a failing sink must not stop the other records
+    }
+
+    tail.store( pos + 1, memory_order_release );
+
+    return true;
+}
+
+
+bool AsyncLogQueue::hasNext() const {
+    auto pos = tail.load( memory_order_relaxed );
+    return slots[pos & mask].sequence.load( memory_order_acquire ) == pos + 1;
+}
+
+
+void AsyncLogQueue::wakeDrain() {
+    // pairs with the fence in drainLoop, either the drain thread sees the new record or this
+    // thread sees that it waits
+    atomic_thread_fence( memory_order_seq_cst );
+
+    if ( drainWaiting.load( memory_order_relaxed ) ) {
+        lock_guard< mutex > lock( drainMutex );
+        drainCond.notify_one();
+    }
+}
+
+
+void AsyncLogQueue::wakeFlushers() {
+    // pairs with the fence in flush()
+    atomic_thread_fence( memory_order_seq_cst );
+
+    if ( flushWaiters.load( memory_order_relaxed ) > 0 ) {
+        lock_guard< mutex > lock( flushMutex );
+        flushCond.notify_all();
+    }
+}
+
+
+void AsyncLogQueue::drainLoop() {
+    while ( true ) {
+        if ( writeNext() ) {
+            wakeFlushers();
+            continue;
+        }
+
+        if ( stopped && tail.load() == head.load() ) {
+            drainExited = true;
+            wakeFlushers();
+            return;
+        }
+
+        unique_lock< mutex > lock( drainMutex );
+        drainWaiting = true;
+        atomic_thread_fence( memory_order_seq_cst );
+        drainCond.wait( lock, [this]() { return stopped || hasNext(); } );
+        drainWaiting = false;
+    }
+}
+
+
+void AsyncLogQueue::flush() {
+    auto target = head.load();
+
+    if ( tail.load( memory_order_acquire ) >= target )
+        return;
+
+    unique_lock< mutex > lock( flushMutex );
+    flushWaiters++;
+    atomic_thread_fence( memory_order_seq_cst );
+    flushCond.wait( lock, [this, target]() {
+        return tail.load( memory_order_acquire ) >= target || drainExited;
+    } );
+    flushWaiters--;
+}
+
+
+void AsyncLogQueue::waitForSpace() {
+    unique_lock< mutex > lock( flushMutex );
+    flushWaiters++;
+    atomic_thread_fence( memory_order_seq_cst );
+    flushCond.wait( lock, [this]() {
+        return head.load() - tail.load( memory_order_acquire ) <= mask || stopped || drainExited;
+    } );
+    flushWaiters--;
+}
+
+
+void AsyncLogQueue::drainAfterStop() {
+    {
+        unique_lock< mutex > lock( flushMutex );
+        flushWaiters++;
+        atomic_thread_fence( memory_order_seq_cst );
+        flushCond.wait( lock, [this]() { return drainExited.load(); } );
+        flushWaiters--;
+    }
+
+    lock_guard< mutex > lock( lateDrainMutex );
+    while ( writeNext() ) {
+    }
+}
+
+
+void AsyncLogQueue::stop() {
+    stopped = true;
+    {
+        lock_guard< mutex > lock( drainMutex );
+        drainCond.notify_one();
+    }
+    if ( drainThread.joinable() && drainThread.get_id() != this_thread::get_id() )
+        drainThread.join();
+}
+
+
+uint64_t AsyncLogQueue::getCapacity() const {
+    return mask + 1;
+}
+
+
+AsyncLogQueue& AsyncLogQueue::getInstance() {
+    // never destroyed, so that threads still logging at exit do not use a dead queue
+    static AsyncLogQueue* instance = [] {
+        auto queue = new AsyncLogQueue( LOG_QUEUE_SIZE );
+        atexit( [] { getInstance().stop(); } );
+        return queue;
+    }();
+
+    return *instance;
+}
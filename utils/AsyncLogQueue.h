@@ -0,0 +1,109 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AsyncLogQueue.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Bounded lock-free queue of log records. Any thread can push, one background thread writes the
+// records to their spdlog loggers, so formatting into sinks, file writes and flushes happen off
+// the consensus threads. Producers wait while the queue is full, so records are not dropped.
+// Records at err and above wait until they are written, so they survive an abort right after.
+class AsyncLogQueue {
+    struct Slot {
+        atomic< uint64_t > sequence;
+        shared_ptr< spdlog::logger > logger;
+        spdlog::level::level_enum severity = spdlog::level::off;
+        spdlog::log_clock::time_point time;
+        string message;
+    };
+
+    unique_ptr< Slot[] > slots;
+
+    uint64_t mask = 0;
+
+    // next position to write, shared by producers
+    alignas( 64 ) atomic< uint64_t > head = 0;
+
+    // next position to read, only the drain thread moves it
+    alignas( 64 ) atomic< uint64_t > tail = 0;
+
+    atomic< bool > stopped = false;
+
+    atomic< bool > drainExited = false;
+
+    // the drain thread sleeps on drainCond while the queue is empty, producers wake it
+    mutex drainMutex;
+    condition_variable drainCond;
+    atomic< bool > drainWaiting = false;
+
+    // flush() and producers of a full queue sleep on flushCond until the drain thread wrote
+    // records
+    mutex flushMutex;
+    condition_variable flushCond;
+    atomic< uint64_t > flushWaiters = 0;
+
+    thread drainThread;
+
+    // serializes the writes of records that were pushed after the drain thread exited
+    mutex lateDrainMutex;
+
+    bool tryPush( const shared_ptr< spdlog::logger >& _logger,
+        spdlog::level::level_enum _severity, string& _message );
+
+    // writes one record, returns false if the queue is empty
+    bool writeNext();
+
+    [[nodiscard]] bool hasNext() const;
+
+    void wakeDrain();
+
+    void wakeFlushers();
+
+    void waitForSpace();
+
+    // writes the records that a push raced past stop(), once the drain thread has exited
+    void drainAfterStop();
+
+    void drainLoop();
+
+public:
+    // _capacity is rounded up to a power of two
+    explicit AsyncLogQueue( uint64_t _capacity );
+
+    ~AsyncLogQueue();
+
+    void push( const shared_ptr< spdlog::logger >& _logger, spdlog::level::level_enum _severity,
+        string&& _message );
+
+    // waits until the records pushed before the call are written
+    void flush();
+
+    // writes the remaining records and stops the drain thread, later records are written
+    // by the calling thread
+    void stop();
+
+    [[nodiscard]] uint64_t getCapacity() const;
+
+    // the process wide queue, stopped at exit
+    static AsyncLogQueue& getInstance();
+};
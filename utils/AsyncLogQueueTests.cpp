@@ -0,0 +1,172 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file AsyncLogQueueTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/sinks/ostream_sink.h"
+#include "thirdparty/catch.hpp"
+
+#include "AsyncLogQueue.h"
+
+
+// the LOG macro before records were gated by level
+#define UNGATED_LOG( __LOGGER__, __SEVERITY__, __MESSAGE__ )                            \
+    {                                                                                   \
+        std::stringstream __TMP__LOG__STREAM__;                                         \
+        __TMP__LOG__STREAM__ << __MESSAGE__;                                            \
+        auto __TMP__LOG__CLASS__ = className( __PRETTY_FUNCTION__ );                    \
+        __LOGGER__->log( __SEVERITY__, __TMP__LOG__CLASS__ + __TMP__LOG__STREAM__.str() ); \
+    }
+
+
+TEST_CASE( "Async log queue keeps order and loses nothing", "[async-log]" ) {
+    ostringstream output;
+    auto sink = make_shared< spdlog::sinks::ostream_sink_mt >( output );
+    auto logger = make_shared< spdlog::logger >( "async-log-test", sink );
+    logger->set_pattern( "%v" );
+
+    // a small queue, so that producers wait for the drain thread
+    AsyncLogQueue queue( 100 );
+    REQUIRE( queue.getCapacity() == 128 );
+
+    const uint64_t threadCount = 4;
+    const uint64_t recordCount = 10000;
+
+    vector< thread > producers;
+    for ( uint64_t t = 0; t < threadCount; t++ ) {
+        producers.emplace_back( [&, t]() {
+            for ( uint64_t i = 0; i < recordCount; i++ ) {
+                queue.push( logger, spdlog::level::info, to_string( t ) + ":" + to_string( i ) );
+            }
+        } );
+    }
+    for ( auto&& producer : producers ) {
+        producer.join();
+    }
+
+    // errors are written before push returns
+    queue.push( logger, spdlog::level::err, "last" );
+    REQUIRE( output.str().find( "last" ) != string::npos );
+
+    vector< uint64_t > next( threadCount, 0 );
+    istringstream lines( output.str() );
+    string line;
+    uint64_t total = 0;
+    while ( getline( lines, line ) && line != "last" ) {
+        auto colon = line.find( ':' );
+        auto t = stoull( line.substr( 0, colon ) );
+        REQUIRE( stoull( line.substr( colon + 1 ) ) == next.at( t )++ );
+        total++;
+    }
+    REQUIRE( total == threadCount * recordCount );
+
+    // after stop the caller writes records itself
+    queue.stop();
+    queue.push( logger, spdlog::level::info, "after stop" );
+    REQUIRE( output.str().find( "after stop" ) != string::npos );
+}
+
+
+TEST_CASE( "Records pushed while the queue stops are written", "[async-log]" ) {
+    ostringstream output;
+    auto sink = make_shared< spdlog::sinks::ostream_sink_mt >( output );
+    auto logger = make_shared< spdlog::logger >( "async-log-stop-test", sink );
+    logger->set_pattern( "%v" );
+
+    AsyncLogQueue queue( 16 );
+
+    const uint64_t threadCount = 4;
+    const uint64_t recordCount = 10000;
+
+    vector< thread > producers;
+    for ( uint64_t t = 0; t < threadCount; t++ ) {
+        producers.emplace_back( [&]() {
+            for ( uint64_t i = 0; i < recordCount; i++ ) {
+                queue.push( logger, spdlog::level::info, "record" );
+            }
+        } );
+    }
+
+    this_thread::sleep_for( chrono::milliseconds( 1 ) );
+    queue.stop();
+
+    for ( auto&& producer : producers ) {
+        producer.join();
+    }
+
+    istringstream lines( output.str() );
+    string line;
+    uint64_t total = 0;
+    while ( getline( lines, line ) ) {
+        total++;
+    }
+    REQUIRE( total == threadCount * recordCount );
+}
+
+
+TEST_CASE( "Disabled log levels are not evaluated", "[async-log]" ) {
+    uint64_t evaluated = 0;
+
+    // without a node, the level of the config logger applies, info by default
+    REQUIRE( !SkaleLog::isEnabled( trace ) );
+    REQUIRE( !SkaleLog::isEnabled( debug ) );
+    LOG( trace, "evaluated:" << ++evaluated );
+    LOG( debug, "evaluated:" << ++evaluated );
+    REQUIRE( evaluated == 0 );
+}
+
+
+TEST_CASE( "Disabled trace logging cost", "[.benchmark]" ) {
+    // a logger at the default level, as the node loggers are in production
+    auto logger = make_shared< spdlog::logger >(
+        "log-benchmark", make_shared< spdlog::sinks::null_sink_mt >() );
+    logger->set_level( spdlog::level::info );
+
+    const uint64_t iterations = 1000000;
+    uint64_t blockID = 12345;
+    uint64_t round = 3;
+
+    auto begin = chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < iterations; i++ ) {
+        UNGATED_LOG( logger, trace,
+            "BIN_CONSENSUS_START:BLOCK:" << blockID << ":PROPOSER:" << i % 16 << ":ROUND:"
+                                         << round );
+    }
+    auto ungatedNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - begin )
+            .count();
+
+    begin = chrono::steady_clock::now();
+    for ( uint64_t i = 0; i < iterations; i++ ) {
+        LOG( trace, "BIN_CONSENSUS_START:BLOCK:" << blockID << ":PROPOSER:" << i % 16
+                                                 << ":ROUND:" << round );
+    }
+    auto gatedNs =
+        chrono::duration_cast< chrono::nanoseconds >( chrono::steady_clock::now() - begin )
+            .count();
+
+    WARN( "Disabled LOG(trace) ns per call, formatted first:" << ungatedNs / iterations
+          << " level gated:" << gatedNs / iterations );
+}
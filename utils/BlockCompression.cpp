@@ -0,0 +1,227 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockCompression.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+// miniz otherwise defines compress and uncompress as macros
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include "miniz.h"
+
+#include "BlockCompression.h"
+
+
+namespace {
+
+struct CompressorDeleter {
+    void operator()( tdefl_compressor* _c ) const { tdefl_compressor_free( _c ); }
+};
+
+struct DecompressorDeleter {
+    void operator()( tinfl_decompressor* _d ) const { tinfl_decompressor_free( _d ); }
+};
+
+void appendHex( vector< uint8_t >& _out, const string& _hex ) {
+    for ( uint64_t i = 0; i + 1 < _hex.size(); i += 2 ) {
+        _out.push_back( ( uint8_t ) stoul( _hex.substr( i, 2 ), nullptr, 16 ) );
+    }
+}
+
+}  // namespace
+
+
+const vector< uint8_t >& BlockCompression::getDictionary() {
+    static const vector< uint8_t > dictionary = [] {
+        vector< uint8_t > d;
+
+        // transaction bodies are RLP, mostly ERC-20 calls with 32 byte zero padded arguments.
+        // deflate prefers matches at short distances, so the most common patterns go last
+        static const char* const patterns[] = {
+            "095ea7b3000000000000000000000000",  // approve(address,uint256)
+            "23b872dd000000000000000000000000",  // transferFrom(address,address,uint256)
+            "a9059cbb000000000000000000000000",  // transfer(address,uint256)
+            "f86c808504a817c80082520894", "f8aa808504a817c800830186a094",
+            "02f8b1", "02f872"};
+
+        for ( auto&& pattern : patterns ) {
+            appendHex( d, pattern );
+        }
+
+        d.insert( d.end(), 64, 0 );
+
+        string header = "{\"blockID\":,\"daSig\":\"\",\"hash\":\"\",\"proposerIndex\":,"
+                        "\"proposerNodeID\":,\"schainID\":,\"sig\":\"\",\"sizes\":[],\"sr\":\"\","
+                        "\"thrSig\":\"\",\"timeStamp\":,\"timeStampMs\":}";
+
+        d.insert( d.end(), header.begin(), header.end() );
+
+        return d;
+    }();
+
+    return dictionary;
+}
+
+
+const vector< uint8_t >& BlockCompression::getDictionaryPrefix() {
+    static const vector< uint8_t > prefix = [] {
+        auto& dictionary = getDictionary();
+        CHECK_STATE( dictionary.size() <= UINT16_MAX );
+        uint16_t len = ( uint16_t ) dictionary.size();
+        uint16_t nlen = ( uint16_t ) ~len;
+        // BFINAL = 0, BTYPE = 00 (stored), then LEN and NLEN little endian
+        vector< uint8_t > p = {0, ( uint8_t ) len, ( uint8_t )( len >> 8 ), ( uint8_t ) nlen,
+            ( uint8_t )( nlen >> 8 )};
+        p.insert( p.end(), dictionary.begin(), dictionary.end() );
+        return p;
+    }();
+
+    return prefix;
+}
+
+
+bool BlockCompression::isCompressed( const ptr< vector< uint8_t > >& _data ) {
+    CHECK_ARGUMENT( _data );
+    return _data->size() > FRAME_HEADER_SIZE && _data->at( sizeof( uint64_t ) ) == COMPRESSED_MAGIC;
+}
+
+
+uint64_t BlockCompression::getRawSize( const uint8_t* _data, uint64_t _size ) {
+    CHECK_ARGUMENT( _data );
+
+    if ( _size <= FRAME_HEADER_SIZE || _data[sizeof( uint64_t )] != COMPRESSED_MAGIC )
+        return _size;
+
+    uint64_t rawSize = 0;
+
+    for ( uint64_t i = 0; i < sizeof( uint64_t ); i++ ) {
+        rawSize |= ( ( uint64_t ) _data[i] ) << ( 8 * i );
+    }
+
+    return rawSize;
+}
+
+
+ptr< vector< uint8_t > > BlockCompression::compress(
+    const ptr< vector< uint8_t > >& _block, uint64_t _level, bool _useDictionary ) {
+    CHECK_ARGUMENT( _block );
+    CHECK_ARGUMENT( _level <= 10 );
+
+    if ( _block->size() <= FRAME_HEADER_SIZE || isCompressed( _block ) )
+        return _block;
+
+    static thread_local unique_ptr< tdefl_compressor, CompressorDeleter > compressor(
+        tdefl_compressor_alloc() );
+    CHECK_STATE( compressor );
+
+    auto flags =
+        tdefl_create_comp_flags_from_zip_params( ( int ) _level, -15, MZ_DEFAULT_STRATEGY );
+
+    CHECK_STATE( tdefl_init( compressor.get(), nullptr, nullptr, ( int ) flags ) ==
+                 TDEFL_STATUS_OKAY );
+
+    if ( _useDictionary ) {
+        // the dictionary goes into the LZ window and its output is dropped. The sync flush
+        // byte aligns the stream, so the rest decodes after any stored copy of the dictionary
+        auto& dictionary = getDictionary();
+        vector< uint8_t > discarded( dictionary.size() + 1024 );
+        size_t inSize = dictionary.size();
+        size_t outSize = discarded.size();
+        auto status = tdefl_compress( compressor.get(), dictionary.data(), &inSize,
+            discarded.data(), &outSize, TDEFL_SYNC_FLUSH );
+        CHECK_STATE( status == TDEFL_STATUS_OKAY && inSize == dictionary.size() );
+    }
+
+    auto result = make_shared< vector< uint8_t > >( _block->size() );
+
+    uint64_t rawSize = _block->size();
+
+    for ( uint64_t i = 0; i < sizeof( uint64_t ); i++ ) {
+        result->at( i ) = ( uint8_t )( rawSize >> ( 8 * i ) );
+    }
+
+    result->at( sizeof( uint64_t ) ) = COMPRESSED_MAGIC;
+    result->at( sizeof( uint64_t ) + 1 ) = FORMAT_VERSION;
+
+    size_t inSize = _block->size();
+    size_t outSize = result->size() - FRAME_HEADER_SIZE;
+
+    auto status = tdefl_compress( compressor.get(), _block->data(), &inSize,
+        result->data() + FRAME_HEADER_SIZE, &outSize, TDEFL_FINISH );
+
+    // not smaller than the block, store it raw
+    if ( status != TDEFL_STATUS_DONE || inSize != _block->size() ||
+         outSize + FRAME_HEADER_SIZE >= _block->size() )
+        return _block;
+
+    result->resize( outSize + FRAME_HEADER_SIZE );
+
+    return result;
+}
+
+
+ptr< vector< uint8_t > > BlockCompression::decompress( const ptr< vector< uint8_t > >& _data ) {
+    CHECK_ARGUMENT( _data );
+
+    if ( !isCompressed( _data ) )
+        return _data;
+
+    auto version = _data->at( sizeof( uint64_t ) + 1 );
+
+    CHECK_STATE2( version == FORMAT_VERSION,
+        "Unknown block compression version:" + to_string( ( int ) version ) );
+
+    auto rawSize = getRawSize( _data->data(), _data->size() );
+
+    CHECK_STATE2( rawSize > FRAME_HEADER_SIZE && rawSize <= MAX_CATCHUP_DOWNLOAD_BYTES,
+        "Invalid compressed block size:" + to_string( rawSize ) );
+
+    auto& prefix = getDictionaryPrefix();
+    auto dictionarySize = getDictionary().size();
+
+    vector< uint8_t > input;
+    input.reserve( prefix.size() + _data->size() - FRAME_HEADER_SIZE );
+    input.insert( input.end(), prefix.begin(), prefix.end() );
+    input.insert( input.end(), _data->begin() + FRAME_HEADER_SIZE, _data->end() );
+
+    // the output holds the dictionary followed by the block, so matches can reach back into it
+    auto result = make_shared< vector< uint8_t > >( dictionarySize + rawSize );
+
+    static thread_local unique_ptr< tinfl_decompressor, DecompressorDeleter > decompressor(
+        tinfl_decompressor_alloc() );
+    CHECK_STATE( decompressor );
+
+    tinfl_init( decompressor.get() );
+
+    size_t inSize = input.size();
+    size_t outSize = result->size();
+
+    auto status = tinfl_decompress( decompressor.get(), input.data(), &inSize, result->data(),
+        result->data(), &outSize, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF );
+
+    CHECK_STATE2( status == TINFL_STATUS_DONE && outSize == result->size(),
+        "Could not decompress block, status:" + to_string( ( int ) status ) );
+
+    result->erase( result->begin(), result->begin() + dictionarySize );
+
+    return result;
+}
@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockCompression.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Compresses serialized committed blocks for the block DB and for catchup transfers.
+// A compressed block is [8 byte raw size]['Z'][format version][raw deflate stream]. A serialized
+// block always has '{' at offset 8, so compressed and raw blocks can be told apart and mixed in
+// one DB. The format version names the dictionary, so that a new dictionary does not break
+// blocks that are already stored.
+// The deflate stream is primed with a built-in dictionary of block header keys and common
+// transaction byte patterns, which matters because most blocks are only a few KB.
+class BlockCompression {
+    static const vector< uint8_t >& getDictionary();
+
+    // the dictionary as a single non-final stored deflate block, prepended before inflating
+    static const vector< uint8_t >& getDictionaryPrefix();
+
+public:
+    static constexpr uint64_t FRAME_HEADER_SIZE = sizeof( uint64_t ) + 2;
+
+    static constexpr uint8_t COMPRESSED_MAGIC = 'Z';
+
+    // bump when the dictionary or the frame changes
+    static constexpr uint8_t FORMAT_VERSION = 1;
+
+    static bool isCompressed( const ptr< vector< uint8_t > >& _data );
+
+    // the size the block has once decompressed, as declared in the frame header
+    static uint64_t getRawSize( const uint8_t* _data, uint64_t _size );
+
+    // returns _block unchanged if compression does not make it smaller
+    static ptr< vector< uint8_t > > compress( const ptr< vector< uint8_t > >& _block,
+        uint64_t _level = BLOCK_COMPRESSION_LEVEL, bool _useDictionary = true );
+
+    // returns _data unchanged if it is not compressed. Blocks compressed without the dictionary
+    // never reference it, so they decode the same way
+    static ptr< vector< uint8_t > > decompress( const ptr< vector< uint8_t > >& _data );
+};
@@ -0,0 +1,187 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file BlockCompressionTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "BlockCompression.h"
+
+
+// a serialized block shaped like ERC-20 traffic: a JSON header and legacy signed transfers
+// between a small set of accounts, with random signatures
+static ptr< vector< uint8_t > > createSampleBlock(
+    uint64_t _blockID, uint64_t _transactionCount, mt19937& _generator ) {
+    vector< vector< uint8_t > > accounts( 20, vector< uint8_t >( 20 ) );
+    mt19937 accountGenerator( 42 );
+    for ( auto&& account : accounts ) {
+        for ( auto&& b : account ) {
+            b = ( uint8_t ) accountGenerator();
+        }
+    }
+
+    auto randomBytes = [&]( vector< uint8_t >& _out, uint64_t _count ) {
+        for ( uint64_t i = 0; i < _count; i++ ) {
+            _out.push_back( ( uint8_t ) _generator() );
+        }
+    };
+
+    vector< uint8_t > transactions;
+    string sizes;
+
+    for ( uint64_t i = 0; i < _transactionCount; i++ ) {
+        vector< uint8_t > t = { 0xf8, 0xa9, 0x82 };
+        randomBytes( t, 2 );
+        t.insert( t.end(), { 0x85, 0x04, 0xa8, 0x17, 0xc8, 0x00, 0x83, 0x01, 0x86, 0xa0, 0x94 } );
+        auto& token = accounts[_generator() % 3];
+        t.insert( t.end(), token.begin(), token.end() );
+        t.insert( t.end(), { 0x80, 0xb8, 0x44, 0xa9, 0x05, 0x9c, 0xbb } );
+        t.insert( t.end(), 12, 0 );
+        auto& to = accounts[_generator() % accounts.size()];
+        t.insert( t.end(), to.begin(), to.end() );
+        t.insert( t.end(), 28, 0 );
+        randomBytes( t, 4 );
+        t.insert( t.end(), { 0x82, 0x0b, 0xe1, 0xa0 } );
+        randomBytes( t, 32 );
+        t.push_back( 0xa0 );
+        randomBytes( t, 32 );
+
+        transactions.insert( transactions.end(), t.begin(), t.end() );
+        sizes += ( i == 0 ? "" : "," ) + to_string( t.size() );
+    }
+
+    string header = "{\"blockID\":" + to_string( _blockID ) +
+                    ",\"hash\":\"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08\""
+                    ",\"proposerIndex\":" +
+                    to_string( _blockID % 16 + 1 ) + ",\"proposerNodeID\":" +
+                    to_string( _blockID % 16 + 1 ) +
+                    ",\"schainID\":1,\"sig\":\"EMPTY\",\"sizes\":[" + sizes +
+                    "],\"sr\":\"12345\",\"thrSig\":\"EMPTY\",\"timeStamp\":" +
+                    to_string( 1700000000 + _blockID ) + ",\"timeStampMs\":" +
+                    to_string( _blockID % 1000 ) + "}";
+
+    auto block = make_shared< vector< uint8_t > >( sizeof( uint64_t ) );
+    uint64_t headerSize = header.size();
+    memcpy( block->data(), &headerSize, sizeof( headerSize ) );
+    block->insert( block->end(), header.begin(), header.end() );
+    block->insert( block->end(), transactions.begin(), transactions.end() );
+    block->push_back( '>' );
+
+    return block;
+}
+
+
+TEST_CASE( "Compress and decompress blocks", "[block-compression]" ) {
+    mt19937 generator( 1 );
+
+    for ( uint64_t transactionCount : { 0, 1, 10, 1000 } ) {
+        auto block = createSampleBlock( 5, transactionCount, generator );
+
+        for ( bool useDictionary : { false, true } ) {
+            auto compressed = BlockCompression::compress( block, 6, useDictionary );
+            REQUIRE( BlockCompression::isCompressed( compressed ) );
+            REQUIRE( !BlockCompression::isCompressed( block ) );
+            REQUIRE( compressed->size() < block->size() );
+            REQUIRE( BlockCompression::getRawSize( compressed->data(), compressed->size() ) ==
+                     block->size() );
+            REQUIRE( BlockCompression::getRawSize( block->data(), block->size() ) ==
+                     block->size() );
+            REQUIRE( *BlockCompression::decompress( compressed ) == *block );
+        }
+    }
+
+    // data that does not compress is stored as is
+    auto random = make_shared< vector< uint8_t > >( 1000 );
+    for ( auto&& b : *random ) {
+        b = ( uint8_t ) generator();
+    }
+    random->at( sizeof( uint64_t ) ) = '{';
+    REQUIRE( BlockCompression::compress( random ) == random );
+    REQUIRE( BlockCompression::decompress( random ) == random );
+
+    // a corrupt stream is an error, not a wrong block
+    auto compressed = BlockCompression::compress( createSampleBlock( 6, 10, generator ) );
+    auto corrupt = make_shared< vector< uint8_t > >( *compressed );
+    corrupt->resize( corrupt->size() / 2 );
+    REQUIRE_THROWS( BlockCompression::decompress( corrupt ) );
+
+    // a frame of an unknown format version is not decoded with the wrong dictionary
+    auto unknownVersion = make_shared< vector< uint8_t > >( *compressed );
+    unknownVersion->at( sizeof( uint64_t ) + 1 ) = BlockCompression::FORMAT_VERSION + 1;
+    REQUIRE( BlockCompression::isCompressed( unknownVersion ) );
+    REQUIRE_THROWS( BlockCompression::decompress( unknownVersion ) );
+}
+
+
+TEST_CASE( "Block compression ratio and speed", "[.benchmark]" ) {
+    mt19937 generator( 2 );
+
+    for ( uint64_t transactionCount : { 1, 10, 100, 1000 } ) {
+        vector< ptr< vector< uint8_t > > > blocks;
+        uint64_t rawBytes = 0;
+        for ( uint64_t i = 0; i < 100; i++ ) {
+            blocks.push_back( createSampleBlock( i + 1, transactionCount, generator ) );
+            rawBytes += blocks.back()->size();
+        }
+
+        for ( bool useDictionary : { false, true } ) {
+            uint64_t compressedBytes = 0;
+            vector< ptr< vector< uint8_t > > > compressed;
+
+            auto begin = chrono::steady_clock::now();
+            for ( auto&& block : blocks ) {
+                compressed.push_back( BlockCompression::compress(
+                    block, BLOCK_COMPRESSION_LEVEL, useDictionary ) );
+                compressedBytes += compressed.back()->size();
+            }
+            auto compressUs =
+                chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - begin )
+                    .count();
+
+            begin = chrono::steady_clock::now();
+            for ( uint64_t i = 0; i < blocks.size(); i++ ) {
+                REQUIRE( BlockCompression::decompress( compressed[i] )->size() ==
+                         blocks[i]->size() );
+            }
+            auto decompressUs =
+                chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - begin )
+                    .count();
+
+            REQUIRE( compressedBytes < rawBytes );
+
+            auto averageRaw = rawBytes / blocks.size();
+            auto averageCompressed = compressedBytes / blocks.size();
+
+            WARN( transactionCount << " transactions "
+                  << ( useDictionary ? "dictionary" : "plain" )
+                  << " ratio:" << ( double ) rawBytes / compressedBytes
+                  << " blocks per storage limit:" << DEFAULT_DB_STORAGE_LIMIT / averageRaw << "->"
+                  << DEFAULT_DB_STORAGE_LIMIT / averageCompressed
+                  << " blocks per catchup round:" << MAX_CATCHUP_DOWNLOAD_BYTES / averageRaw << "->"
+                  << MAX_CATCHUP_DOWNLOAD_BYTES / averageCompressed
+                  << " compress us/block:" << compressUs / blocks.size()
+                  << " decompress us/block:" << decompressUs / blocks.size() );
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CuckooFilter.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "CuckooFilter.h"
+
+
+namespace {
+
+constexpr uint64_t LOW_BITS = 0x0001000100010001ULL;
+constexpr uint64_t HIGH_BITS = 0x8000800080008000ULL;
+
+// non zero iff one of the four 16 bit lanes of _word is zero
+inline uint64_t hasZeroLane( uint64_t _word ) {
+    return ( _word - LOW_BITS ) & ~_word & HIGH_BITS;
+}
+
+}  // namespace
+
+
+CuckooFilter::CuckooFilter( uint64_t _capacity ) {
+    CHECK_ARGUMENT( _capacity > 0 );
+    uint64_t bucketCount = 1;
+    while ( bucketCount * 4 * 95 < _capacity * 100 ) {
+        bucketCount *= 2;
+    }
+    buckets.resize( bucketCount, 0 );
+    mask = bucketCount - 1;
+}
+
+void CuckooFilter::locate( uint64_t _key, uint64_t& _bucket, uint16_t& _fingerprint ) const {
+    auto h = _key * 0x9E3779B97F4A7C15ULL;
+    // fingerprint 0 marks an empty lane
+    _fingerprint = ( uint16_t )( h >> 48 );
+    if ( _fingerprint == 0 )
+        _fingerprint = 1;
+    _bucket = ( h >> 16 ) & mask;
+}
+
+uint64_t CuckooFilter::altBucket( uint64_t _bucket, uint16_t _fingerprint ) const {
+    // an involution, so both buckets of a fingerprint can be derived from either one
+    return ( _bucket ^ ( ( uint64_t ) _fingerprint * 0x5BD1E995ULL ) ) & mask;
+}
+
+bool CuckooFilter::bucketContains( uint64_t _bucket, uint16_t _fingerprint ) const {
+    return hasZeroLane( buckets[_bucket] ^ ( LOW_BITS * _fingerprint ) ) != 0;
+}
+
+bool CuckooFilter::bucketInsert( uint64_t _bucket, uint16_t _fingerprint ) {
+    auto& word = buckets[_bucket];
+    auto free = hasZeroLane( word );
+    if ( free == 0 )
+        return false;
+    // lowest empty lane
+    auto shift = ( uint64_t ) __builtin_ctzll( free ) - 15;
+    word |= ( uint64_t ) _fingerprint << shift;
+    return true;
+}
+
+bool CuckooFilter::insert( uint64_t _key ) {
+    uint64_t bucket;
+    uint16_t fingerprint;
+    if ( hasVictim ) {
+        return false;
+    }
+
+    locate( _key, bucket, fingerprint );
+
+    count++;
+
+    auto alt = altBucket( bucket, fingerprint );
+
+    if ( bucketInsert( bucket, fingerprint ) || bucketInsert( alt, fingerprint ) ) {
+        return true;
+    }
+
+    if ( kickState & 1 )
+        bucket = alt;
+
+    for ( uint64_t kick = 0; kick < CUCKOO_FILTER_MAX_KICKS; kick++ ) {
+        kickState ^= kickState << 13;
+        kickState ^= kickState >> 7;
+        kickState ^= kickState << 17;
+
+        auto shift = ( kickState % 4 ) * 16;
+        auto& word = buckets[bucket];
+        auto evicted = ( uint16_t )( word >> shift );
+        word = ( word & ~( ( uint64_t ) 0xFFFF << shift ) ) | ( ( uint64_t ) fingerprint << shift );
+
+        fingerprint = evicted;
+        bucket = altBucket( bucket, fingerprint );
+
+        if ( bucketInsert( bucket, fingerprint ) ) {
+            return true;
+        }
+    }
+
+    hasVictim = true;
+    victimBucket = bucket;
+    victimFingerprint = fingerprint;
+    return true;
+}
+
+bool CuckooFilter::contains( uint64_t _key ) const {
+    uint64_t bucket;
+    uint16_t fingerprint;
+    locate( _key, bucket, fingerprint );
+
+    auto alt = altBucket( bucket, fingerprint );
+
+    if ( bucketContains( bucket, fingerprint ) || bucketContains( alt, fingerprint ) ) {
+        return true;
+    }
+
+    return hasVictim && victimFingerprint == fingerprint &&
+           ( victimBucket == bucket || victimBucket == alt );
+}
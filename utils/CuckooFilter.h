@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CuckooFilter.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Approximate set of 64 bit keys. Each bucket holds four 16 bit fingerprints packed into one
+// uint64_t, so a membership test is two word loads and a SWAR compare. contains() has no false
+// negatives and a false positive rate of about 8 / 2^16. Keys can not be removed, a filter is
+// dropped as a whole. When both candidate buckets stay full after CUCKOO_FILTER_MAX_KICKS
+// relocations the evicted fingerprint is parked in a victim slot and the filter becomes full.
+class CuckooFilter {
+    vector< uint64_t > buckets;
+    uint64_t mask = 0;
+    uint64_t count = 0;
+
+    bool hasVictim = false;
+    uint64_t victimBucket = 0;
+    uint16_t victimFingerprint = 0;
+
+    uint64_t kickState = 0x2545F4914F6CDD1DULL;
+
+    [[nodiscard]] uint64_t altBucket( uint64_t _bucket, uint16_t _fingerprint ) const;
+
+    [[nodiscard]] bool bucketContains( uint64_t _bucket, uint16_t _fingerprint ) const;
+
+    bool bucketInsert( uint64_t _bucket, uint16_t _fingerprint );
+
+    void locate( uint64_t _key, uint64_t& _bucket, uint16_t& _fingerprint ) const;
+
+public:
+    // sized so that _capacity keys fit at 95% bucket occupancy
+    explicit CuckooFilter( uint64_t _capacity );
+
+    // returns false, without recording the key, if the filter is already full
+    bool insert( uint64_t _key );
+
+    [[nodiscard]] bool contains( uint64_t _key ) const;
+
+    [[nodiscard]] bool isFull() const { return hasVictim; }
+
+    [[nodiscard]] uint64_t size() const { return count; }
+
+    [[nodiscard]] uint64_t getMemoryUsed() const { return buckets.size() * sizeof( uint64_t ); }
+};
@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file CuckooFilterTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include <random>
+
+#include "CuckooFilter.h"
+
+
+TEST_CASE( "Cuckoo filter has no false negatives", "[cuckoo-filter]" ) {
+    mt19937_64 gen( 5 );
+    CuckooFilter filter( 100000 );
+
+    vector< uint64_t > keys;
+    for ( uint64_t i = 0; i < 100000; i++ ) {
+        keys.push_back( gen() );
+        REQUIRE( filter.insert( keys.back() ) );
+    }
+
+    REQUIRE( !filter.isFull() );
+    REQUIRE( filter.size() == keys.size() );
+
+    for ( auto key : keys ) {
+        REQUIRE( filter.contains( key ) );
+    }
+
+    // zero and small keys map to valid fingerprints too
+    REQUIRE( filter.insert( 0 ) );
+    REQUIRE( filter.insert( 1 ) );
+    REQUIRE( filter.contains( 0 ) );
+    REQUIRE( filter.contains( 1 ) );
+}
+
+
+TEST_CASE( "Cuckoo filter false positive rate", "[cuckoo-filter]" ) {
+    mt19937_64 gen( 9 );
+    CuckooFilter filter( 100000 );
+
+    for ( uint64_t i = 0; i < 100000; i++ ) {
+        filter.insert( gen() );
+    }
+
+    uint64_t falsePositives = 0;
+    uint64_t probes = 1000000;
+    for ( uint64_t i = 0; i < probes; i++ ) {
+        falsePositives += filter.contains( gen() );
+    }
+
+    // 8 / 2^16 at full occupancy, the filter here is about three quarters full
+    REQUIRE( falsePositives < probes * 8 / 65536 );
+}
+
+
+TEST_CASE( "Cuckoo filter overflow", "[cuckoo-filter]" ) {
+    mt19937_64 gen( 13 );
+    CuckooFilter filter( 1000 );
+
+    vector< uint64_t > keys;
+    while ( true ) {
+        auto key = gen();
+        if ( !filter.insert( key ) )
+            break;
+        keys.push_back( key );
+    }
+
+    REQUIRE( filter.isFull() );
+    // the buckets are close to fully occupied before inserts start to fail
+    REQUIRE( keys.size() * 100 > filter.getMemoryUsed() / sizeof( uint16_t ) * 90 );
+    REQUIRE( filter.size() == keys.size() );
+
+    for ( auto key : keys ) {
+        REQUIRE( filter.contains( key ) );
+    }
+}
@@ -0,0 +1,236 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file LatencyHistogram.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/json.hpp"
+
+#include "LatencyHistogram.h"
+
+
+array< vector< unique_ptr< LatencyHistogram::Shard > >, LAT_STAGE_COUNT > LatencyHistogram::shards;
+array< LatencyHistogram::Shard, LAT_STAGE_COUNT > LatencyHistogram::mergedShards;
+mutex LatencyHistogram::shardsMutex;
+
+
+uint64_t LatencyHistogram::getBucketIndex( uint64_t _value ) {
+    if ( _value < SUB_BUCKET_COUNT )
+        return _value;
+
+    _value = min< uint64_t >( _value, ( 1ULL << MAX_VALUE_BITS ) - 1 );
+
+    uint64_t msb = 63 - __builtin_clzll( _value );
+    uint64_t shift = msb - SUB_BUCKET_BITS + 1;
+    // top bits are in [HALF_SUB_BUCKET_COUNT, SUB_BUCKET_COUNT)
+    uint64_t top = _value >> shift;
+
+    return SUB_BUCKET_COUNT + ( shift - 1 ) * HALF_SUB_BUCKET_COUNT + top - HALF_SUB_BUCKET_COUNT;
+}
+
+
+uint64_t LatencyHistogram::getBucketValue( uint64_t _index ) {
+    CHECK_ARGUMENT( _index < BUCKET_COUNT );
+
+    if ( _index < SUB_BUCKET_COUNT )
+        return _index;
+
+    uint64_t shift = ( _index - SUB_BUCKET_COUNT ) / HALF_SUB_BUCKET_COUNT + 1;
+    uint64_t top = ( _index - SUB_BUCKET_COUNT ) % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+
+    return ( top << shift ) + ( 1ULL << ( shift - 1 ) );
+}
+
+
+LatencyHistogram::Shard* LatencyHistogram::registerShard( LatencyStage _stage ) {
+    lock_guard< mutex > lock( shardsMutex );
+    shards[_stage].push_back( make_unique< Shard >() );
+    return shards[_stage].back().get();
+}
+
+
+void LatencyHistogram::releaseShard( LatencyStage _stage, Shard* _shard ) {
+    CHECK_ARGUMENT( _shard );
+
+    lock_guard< mutex > lock( shardsMutex );
+
+    // every access to the merged shard holds the lock, so a relaxed load and store is enough
+    auto& merged = mergedShards[_stage];
+
+    for ( uint64_t i = 0; i < BUCKET_COUNT; i++ ) {
+        auto count = _shard->counts[i].load( memory_order_relaxed );
+        if ( count > 0 )
+            merged.counts[i].store(
+                merged.counts[i].load( memory_order_relaxed ) + count, memory_order_relaxed );
+    }
+
+    merged.maxValue.store( max( merged.maxValue.load( memory_order_relaxed ),
+                               _shard->maxValue.load( memory_order_relaxed ) ),
+        memory_order_relaxed );
+
+    auto& stageShards = shards[_stage];
+    auto it = find_if( stageShards.begin(), stageShards.end(),
+        [_shard]( auto& _s ) { return _s.get() == _shard; } );
+    CHECK_STATE( it != stageShards.end() );
+    stageShards.erase( it );
+}
+
+
+LatencyHistogram::LocalShards::~LocalShards() {
+    for ( uint32_t i = 0; i < LAT_STAGE_COUNT; i++ ) {
+        if ( stageShards[i] )
+            releaseShard( ( LatencyStage ) i, stageShards[i] );
+    }
+}
+
+
+void LatencyHistogram::record( LatencyStage _stage, uint64_t _valueUs ) {
+    CHECK_ARGUMENT( _stage < LAT_STAGE_COUNT );
+
+    thread_local LocalShards localShards;
+
+    auto shard = localShards.stageShards[_stage];
+
+    if ( !shard ) {
+        shard = registerShard( _stage );
+        localShards.stageShards[_stage] = shard;
+    }
+
+    // only this thread writes to the shard, so a relaxed load and store is enough
+    auto& bucket = shard->counts[getBucketIndex( _valueUs )];
+    bucket.store( bucket.load( memory_order_relaxed ) + 1, memory_order_relaxed );
+
+    if ( _valueUs > shard->maxValue.load( memory_order_relaxed ) )
+        shard->maxValue.store( _valueUs, memory_order_relaxed );
+}
+
+
+LatencyHistogram::Snapshot::Snapshot() : counts( BUCKET_COUNT, 0 ) {}
+
+
+uint64_t LatencyHistogram::Snapshot::getCount() const {
+    return totalCount;
+}
+
+
+uint64_t LatencyHistogram::Snapshot::getMax() const {
+    return maxValue;
+}
+
+
+uint64_t LatencyHistogram::Snapshot::getValueAtPercentile( double _percentile ) const {
+    if ( totalCount == 0 )
+        return 0;
+
+    auto target = ( uint64_t ) ceil( totalCount * min( max( _percentile, 0.0 ), 100.0 ) / 100 );
+    target = max< uint64_t >( target, 1 );
+
+    uint64_t seen = 0;
+
+    for ( uint64_t i = 0; i < BUCKET_COUNT; i++ ) {
+        seen += counts[i];
+        if ( seen >= target )
+            return min( getBucketValue( i ), maxValue );
+    }
+
+    return maxValue;
+}
+
+
+LatencyHistogram::Snapshot LatencyHistogram::getSnapshot( LatencyStage _stage ) {
+    CHECK_ARGUMENT( _stage < LAT_STAGE_COUNT );
+
+    Snapshot snapshot;
+
+    lock_guard< mutex > lock( shardsMutex );
+
+    auto addShard = [&]( const Shard& _shard ) {
+        for ( uint64_t i = 0; i < BUCKET_COUNT; i++ ) {
+            auto count = _shard.counts[i].load( memory_order_relaxed );
+            snapshot.counts[i] += count;
+            snapshot.totalCount += count;
+        }
+        snapshot.maxValue = max( snapshot.maxValue, _shard.maxValue.load( memory_order_relaxed ) );
+    };
+
+    addShard( mergedShards[_stage] );
+
+    for ( auto&& shard : shards[_stage] ) {
+        addShard( *shard );
+    }
+
+    return snapshot;
+}
+
+
+uint64_t LatencyHistogram::getShardCount( LatencyStage _stage ) {
+    CHECK_ARGUMENT( _stage < LAT_STAGE_COUNT );
+    lock_guard< mutex > lock( shardsMutex );
+    return shards[_stage].size();
+}
+
+
+const char* LatencyHistogram::getStageName( LatencyStage _stage ) {
+    switch ( _stage ) {
+    case LAT_PENDING_TRANSACTIONS_WAIT:
+        return "pendingTransactionsWait";
+    case LAT_PROPOSAL_BUILD:
+        return "proposalBuild";
+    case LAT_PROPOSAL_PUSH:
+        return "proposalPush";
+    case LAT_DA_PROOF_ASSEMBLY:
+        return "daProofAssembly";
+    case LAT_BIN_CONSENSUS_ROUND:
+        return "binConsensusRound";
+    case LAT_BLOCK_SIG_MERGE:
+        return "blockSigMerge";
+    case LAT_EVM_CREATE_BLOCK:
+        return "evmCreateBlock";
+    case LAT_DB_WRITE:
+        return "dbWrite";
+    case LAT_DB_READ:
+        return "dbRead";
+    default:
+        return "unknown";
+    }
+}
+
+
+nlohmann::json LatencyHistogram::toJson() {
+    auto result = nlohmann::json::object();
+
+    for ( uint32_t i = 0; i < LAT_STAGE_COUNT; i++ ) {
+        auto stage = ( LatencyStage ) i;
+        auto snapshot = getSnapshot( stage );
+
+        auto stageJson = nlohmann::json::object();
+        stageJson["count"] = snapshot.getCount();
+        stageJson["p50"] = snapshot.getValueAtPercentile( 50 );
+        stageJson["p99"] = snapshot.getValueAtPercentile( 99 );
+        stageJson["p999"] = snapshot.getValueAtPercentile( 99.9 );
+        stageJson["max"] = snapshot.getMax();
+
+        result[getStageName( stage )] = stageJson;
+    }
+
+    return result;
+}
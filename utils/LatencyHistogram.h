@@ -0,0 +1,113 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file LatencyHistogram.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// stages of the block pipeline that have a latency histogram
+enum LatencyStage : uint32_t {
+    LAT_PENDING_TRANSACTIONS_WAIT = 0,
+    LAT_PROPOSAL_BUILD,
+    LAT_PROPOSAL_PUSH,
+    LAT_DA_PROOF_ASSEMBLY,
+    LAT_BIN_CONSENSUS_ROUND,
+    LAT_BLOCK_SIG_MERGE,
+    LAT_EVM_CREATE_BLOCK,
+    LAT_DB_WRITE,
+    LAT_DB_READ,
+    LAT_STAGE_COUNT
+};
+
+
+// Log-linear (HDR style) histogram of microsecond latencies. Each thread records into its own
+// shard without locks or atomic read-modify-write, shards are merged when a snapshot is taken.
+// The shards of a thread are merged into a per stage shard and freed when the thread exits.
+class LatencyHistogram {
+public:
+    // 32 exact buckets, then 16 buckets per power of two, relative error below 6.25%
+    static constexpr uint64_t SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint64_t HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+    // values are clamped to 2^40 us, about 12 days
+    static constexpr uint64_t MAX_VALUE_BITS = 40;
+    static constexpr uint64_t BUCKET_COUNT =
+        SUB_BUCKET_COUNT + ( MAX_VALUE_BITS - SUB_BUCKET_BITS + 1 ) * HALF_SUB_BUCKET_COUNT;
+
+    class Snapshot {
+        vector< uint64_t > counts;
+        uint64_t totalCount = 0;
+        uint64_t maxValue = 0;
+
+        friend class LatencyHistogram;
+
+    public:
+        Snapshot();
+
+        [[nodiscard]] uint64_t getCount() const;
+
+        [[nodiscard]] uint64_t getMax() const;
+
+        // _percentile is in the range [0, 100]
+        [[nodiscard]] uint64_t getValueAtPercentile( double _percentile ) const;
+    };
+
+private:
+    struct Shard {
+        array< atomic< uint64_t >, BUCKET_COUNT > counts{};
+        atomic< uint64_t > maxValue = 0;
+    };
+
+    // the shards of one thread, released by the thread_local destructor
+    struct LocalShards {
+        array< Shard*, LAT_STAGE_COUNT > stageShards{};
+
+        ~LocalShards();
+    };
+
+    static array< vector< unique_ptr< Shard > >, LAT_STAGE_COUNT > shards;
+    // samples of finished threads
+    static array< Shard, LAT_STAGE_COUNT > mergedShards;
+    static mutex shardsMutex;
+
+    static Shard* registerShard( LatencyStage _stage );
+
+    static void releaseShard( LatencyStage _stage, Shard* _shard );
+
+public:
+    static uint64_t getBucketIndex( uint64_t _value );
+
+    // a representative value in the middle of the bucket
+    static uint64_t getBucketValue( uint64_t _index );
+
+    static void record( LatencyStage _stage, uint64_t _valueUs );
+
+    static Snapshot getSnapshot( LatencyStage _stage );
+
+    // shards of the running threads that recorded _stage
+    static uint64_t getShardCount( LatencyStage _stage );
+
+    static const char* getStageName( LatencyStage _stage );
+
+    // count, p50, p99, p999 and max in microseconds for each stage
+    static nlohmann::json toJson();
+};
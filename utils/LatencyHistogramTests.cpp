@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file LatencyHistogramTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+#include "thirdparty/json.hpp"
+
+#include "LatencyHistogram.h"
+
+
+TEST_CASE( "Latency histogram buckets", "[latency-histogram]" ) {
+    for ( uint64_t v : { 0ULL, 1ULL, 31ULL, 32ULL, 33ULL, 1000ULL, 123456ULL, 1ULL << 39 } ) {
+        auto index = LatencyHistogram::getBucketIndex( v );
+        REQUIRE( index < LatencyHistogram::BUCKET_COUNT );
+        auto bucketValue = LatencyHistogram::getBucketValue( index );
+        // bucket value is within 6.25% of the recorded value
+        REQUIRE( bucketValue * 16 >= v * 15 );
+        REQUIRE( bucketValue * 16 <= v * 17 + 16 );
+    }
+
+    for ( uint64_t v = 1; v < 1000000; v = v * 3 / 2 + 1 ) {
+        REQUIRE(
+            LatencyHistogram::getBucketIndex( v ) <= LatencyHistogram::getBucketIndex( v + 1 ) );
+    }
+
+    REQUIRE( LatencyHistogram::getBucketIndex( UINT64_MAX ) < LatencyHistogram::BUCKET_COUNT );
+}
+
+
+TEST_CASE( "Latency histogram percentiles", "[latency-histogram]" ) {
+    auto before = LatencyHistogram::getSnapshot( LAT_PROPOSAL_BUILD ).getCount();
+
+    // four threads record 1..10000 us, with a tail of 1% at 1 s
+    vector< thread > threads;
+    for ( int t = 0; t < 4; t++ ) {
+        threads.emplace_back( [] {
+            for ( uint64_t i = 1; i <= 10000; i++ ) {
+                LatencyHistogram::record( LAT_PROPOSAL_BUILD, i % 100 == 0 ? 1000000 : i );
+            }
+        } );
+    }
+
+    for ( auto&& t : threads )
+        t.join();
+
+    auto snapshot = LatencyHistogram::getSnapshot( LAT_PROPOSAL_BUILD );
+
+    REQUIRE( snapshot.getCount() - before == 40000 );
+    REQUIRE( snapshot.getMax() == 1000000 );
+
+    if ( before == 0 ) {
+        auto p50 = snapshot.getValueAtPercentile( 50 );
+        REQUIRE( p50 >= 4700 );
+        REQUIRE( p50 <= 5300 );
+        // the 1% tail is what the average hides
+        REQUIRE( snapshot.getValueAtPercentile( 99.9 ) >= 900000 );
+    }
+
+    auto json = LatencyHistogram::toJson();
+    REQUIRE( json.count( "proposalBuild" ) > 0 );
+    REQUIRE( json["proposalBuild"]["max"].get< uint64_t >() == 1000000 );
+}
+
+
+TEST_CASE( "Latency histogram merges shards of finished threads", "[latency-histogram]" ) {
+    auto before = LatencyHistogram::getSnapshot( LAT_DA_PROOF_ASSEMBLY ).getCount();
+    auto shardsBefore = LatencyHistogram::getShardCount( LAT_DA_PROOF_ASSEMBLY );
+
+    // each thread registers a shard and releases it on exit
+    for ( int t = 0; t < 100; t++ ) {
+        thread( [] {
+            for ( uint64_t i = 1; i <= 10; i++ ) {
+                LatencyHistogram::record( LAT_DA_PROOF_ASSEMBLY, i * 1000 );
+            }
+        } ).join();
+    }
+
+    REQUIRE( LatencyHistogram::getShardCount( LAT_DA_PROOF_ASSEMBLY ) == shardsBefore );
+
+    auto snapshot = LatencyHistogram::getSnapshot( LAT_DA_PROOF_ASSEMBLY );
+    REQUIRE( snapshot.getCount() - before == 1000 );
+    REQUIRE( snapshot.getMax() >= 10000 );
+}
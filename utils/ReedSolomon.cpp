@@ -0,0 +1,365 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file ReedSolomon.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+#if defined( __x86_64__ )
+#include <immintrin.h>
+#endif
+
+#include "SkaleCommon.h"
+#include "Log.h"
+
+#include "ReedSolomon.h"
+
+
+namespace {
+
+// GF(2^8) with the polynomial x^8 + x^4 + x^3 + x^2 + 1
+struct GaloisTables {
+    uint8_t exp[512];
+    uint8_t log[256];
+    // products of every element with each low and high nibble, for the shuffle kernels
+    uint8_t low[256][16];
+    uint8_t high[256][16];
+
+    GaloisTables() {
+        uint32_t x = 1;
+        for ( uint32_t i = 0; i < 255; i++ ) {
+            exp[i] = ( uint8_t ) x;
+            log[x] = ( uint8_t ) i;
+            x <<= 1;
+            if ( x & 0x100 )
+                x ^= 0x11D;
+        }
+        for ( uint32_t i = 255; i < 512; i++ ) {
+            exp[i] = exp[i - 255];
+        }
+        log[0] = 0;
+
+        for ( uint32_t c = 0; c < 256; c++ ) {
+            for ( uint32_t n = 0; n < 16; n++ ) {
+                low[c][n] = multiply( c, n );
+                high[c][n] = multiply( c, n << 4 );
+            }
+        }
+    }
+
+    uint8_t multiply( uint32_t _a, uint32_t _b ) const {
+        if ( _a == 0 || _b == 0 )
+            return 0;
+        return exp[log[_a] + log[_b]];
+    }
+};
+
+const GaloisTables& getTables() {
+    static const GaloisTables tables;
+    return tables;
+}
+
+
+uint64_t mulAddScalar( uint8_t* _dst, const uint8_t* _src, const uint8_t* _low,
+    const uint8_t* _high, uint64_t _start, uint64_t _len ) {
+    for ( uint64_t i = _start; i < _len; i++ ) {
+        _dst[i] ^= _low[_src[i] & 0x0F] ^ _high[_src[i] >> 4];
+    }
+    return _len;
+}
+
+
+#if defined( __x86_64__ )
+
+__attribute__( ( target( "ssse3" ) ) ) uint64_t mulAddSsse3(
+    uint8_t* _dst, const uint8_t* _src, const uint8_t* _low, const uint8_t* _high, uint64_t _len ) {
+    auto lowTable = _mm_loadu_si128( ( const __m128i* ) _low );
+    auto highTable = _mm_loadu_si128( ( const __m128i* ) _high );
+    auto mask = _mm_set1_epi8( 0x0F );
+
+    uint64_t i = 0;
+    for ( ; i + 16 <= _len; i += 16 ) {
+        auto s = _mm_loadu_si128( ( const __m128i* ) ( _src + i ) );
+        auto l = _mm_shuffle_epi8( lowTable, _mm_and_si128( s, mask ) );
+        auto h = _mm_shuffle_epi8( highTable, _mm_and_si128( _mm_srli_epi64( s, 4 ), mask ) );
+        auto d = _mm_loadu_si128( ( const __m128i* ) ( _dst + i ) );
+        _mm_storeu_si128( ( __m128i* ) ( _dst + i ), _mm_xor_si128( d, _mm_xor_si128( l, h ) ) );
+    }
+    return i;
+}
+
+
+__attribute__( ( target( "avx2" ) ) ) uint64_t mulAddAvx2(
+    uint8_t* _dst, const uint8_t* _src, const uint8_t* _low, const uint8_t* _high, uint64_t _len ) {
+    auto lowTable = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* ) _low ) );
+    auto highTable = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* ) _high ) );
+    auto mask = _mm256_set1_epi8( 0x0F );
+
+    uint64_t i = 0;
+    for ( ; i + 32 <= _len; i += 32 ) {
+        auto s = _mm256_loadu_si256( ( const __m256i* ) ( _src + i ) );
+        auto l = _mm256_shuffle_epi8( lowTable, _mm256_and_si256( s, mask ) );
+        auto h =
+            _mm256_shuffle_epi8( highTable, _mm256_and_si256( _mm256_srli_epi64( s, 4 ), mask ) );
+        auto d = _mm256_loadu_si256( ( const __m256i* ) ( _dst + i ) );
+        _mm256_storeu_si256(
+            ( __m256i* ) ( _dst + i ), _mm256_xor_si256( d, _mm256_xor_si256( l, h ) ) );
+    }
+    return i;
+}
+
+// static initializers may run before the runtime has called __builtin_cpu_init
+bool initCpuFeatures() {
+    __builtin_cpu_init();
+    return true;
+}
+
+const bool CPU_FEATURES_INITED = initCpuFeatures();
+const bool HAS_AVX2 = CPU_FEATURES_INITED && __builtin_cpu_supports( "avx2" );
+const bool HAS_SSSE3 = CPU_FEATURES_INITED && __builtin_cpu_supports( "ssse3" );
+
+#endif
+
+}  // namespace
+
+
+atomic< bool > ReedSolomon::simdEnabled( true );
+
+
+ReedSolomon::ReedSolomon( uint64_t _dataShards, uint64_t _totalShards )
+    : dataShards( _dataShards ), totalShards( _totalShards ) {
+    CHECK_ARGUMENT( _dataShards > 0 );
+    CHECK_ARGUMENT( _totalShards >= _dataShards );
+    CHECK_ARGUMENT( _totalShards <= 256 );
+
+    // Cauchy matrix 1 / (x_i + y_j) with x_i = dataShards + i and y_j = j, every square
+    // submatrix of it is invertible, which makes the code MDS
+    auto parityShards = totalShards - dataShards;
+    parityMatrix.resize( parityShards * dataShards );
+    for ( uint64_t i = 0; i < parityShards; i++ ) {
+        for ( uint64_t j = 0; j < dataShards; j++ ) {
+            parityMatrix[i * dataShards + j] = inverse( ( uint8_t ) ( ( dataShards + i ) ^ j ) );
+        }
+    }
+}
+
+
+uint64_t ReedSolomon::getShardSize( uint64_t _dataSize, uint64_t _dataShards ) {
+    CHECK_ARGUMENT( _dataShards > 0 );
+    return ( _dataSize + _dataShards - 1 ) / _dataShards;
+}
+
+
+uint8_t ReedSolomon::mul( uint8_t _a, uint8_t _b ) {
+    return getTables().multiply( _a, _b );
+}
+
+
+uint8_t ReedSolomon::inverse( uint8_t _a ) {
+    CHECK_ARGUMENT( _a != 0 );
+    auto& tables = getTables();
+    return tables.exp[255 - tables.log[_a]];
+}
+
+
+void ReedSolomon::setSimdEnabled( bool _enabled ) {
+    simdEnabled = _enabled;
+}
+
+
+void ReedSolomon::mulAdd( uint8_t* _dst, const uint8_t* _src, uint8_t _c, uint64_t _len ) {
+    if ( _c == 0 || _len == 0 )
+        return;
+
+    auto& tables = getTables();
+    auto low = tables.low[_c];
+    auto high = tables.high[_c];
+
+    uint64_t done = 0;
+
+#if defined( __x86_64__ )
+    if ( simdEnabled ) {
+        if ( HAS_AVX2 )
+            done = mulAddAvx2( _dst, _src, low, high, _len );
+        else if ( HAS_SSSE3 )
+            done = mulAddSsse3( _dst, _src, low, high, _len );
+    }
+#endif
+
+    mulAddScalar( _dst, _src, low, high, done, _len );
+}
+
+
+vector< uint8_t > ReedSolomon::getMatrixRow( uint64_t _shardIndex ) const {
+    CHECK_ARGUMENT( _shardIndex < totalShards );
+
+    if ( _shardIndex < dataShards ) {
+        vector< uint8_t > row( dataShards, 0 );
+        row[_shardIndex] = 1;
+        return row;
+    }
+
+    auto begin = parityMatrix.begin() + ( _shardIndex - dataShards ) * dataShards;
+    return vector< uint8_t >( begin, begin + dataShards );
+}
+
+
+vector< uint8_t > ReedSolomon::invertMatrix( vector< uint8_t > _matrix, uint64_t _size ) {
+    CHECK_ARGUMENT( _matrix.size() == _size * _size );
+
+    vector< uint8_t > result( _size * _size, 0 );
+    for ( uint64_t i = 0; i < _size; i++ ) {
+        result[i * _size + i] = 1;
+    }
+
+    // Gauss-Jordan elimination, addition in GF(2^8) is xor
+    for ( uint64_t column = 0; column < _size; column++ ) {
+        uint64_t pivot = column;
+        while ( pivot < _size && _matrix[pivot * _size + column] == 0 ) {
+            pivot++;
+        }
+        CHECK_STATE2( pivot < _size, "Singular Reed-Solomon matrix" );
+
+        if ( pivot != column ) {
+            for ( uint64_t j = 0; j < _size; j++ ) {
+                swap( _matrix[pivot * _size + j], _matrix[column * _size + j] );
+                swap( result[pivot * _size + j], result[column * _size + j] );
+            }
+        }
+
+        auto scale = inverse( _matrix[column * _size + column] );
+        for ( uint64_t j = 0; j < _size; j++ ) {
+            _matrix[column * _size + j] = mul( _matrix[column * _size + j], scale );
+            result[column * _size + j] = mul( result[column * _size + j], scale );
+        }
+
+        for ( uint64_t row = 0; row < _size; row++ ) {
+            auto factor = _matrix[row * _size + column];
+            if ( row == column || factor == 0 )
+                continue;
+            for ( uint64_t j = 0; j < _size; j++ ) {
+                _matrix[row * _size + j] ^= mul( factor, _matrix[column * _size + j] );
+                result[row * _size + j] ^= mul( factor, result[column * _size + j] );
+            }
+        }
+    }
+
+    return result;
+}
+
+
+ptr< vector< uint8_t > > ReedSolomon::encodeShard(
+    const uint8_t* _data, uint64_t _dataSize, uint64_t _shardIndex ) const {
+    CHECK_ARGUMENT( _data );
+    CHECK_ARGUMENT( _dataSize > 0 );
+    CHECK_ARGUMENT( _shardIndex < totalShards );
+
+    auto shardSize = getShardSize( _dataSize, dataShards );
+    auto shard = make_shared< vector< uint8_t > >( shardSize, 0 );
+
+    if ( _shardIndex < dataShards ) {
+        auto offset = _shardIndex * shardSize;
+        if ( offset < _dataSize )
+            memcpy( shard->data(), _data + offset, min( shardSize, _dataSize - offset ) );
+        return shard;
+    }
+
+    auto row = getMatrixRow( _shardIndex );
+
+    for ( uint64_t j = 0; j < dataShards; j++ ) {
+        auto offset = j * shardSize;
+        if ( offset >= _dataSize )
+            break;
+        // the last data shard is padded with zeros, which add nothing
+        mulAdd( shard->data(), _data + offset, row[j], min( shardSize, _dataSize - offset ) );
+    }
+
+    return shard;
+}
+
+
+ptr< vector< uint8_t > > ReedSolomon::decode(
+    const map< uint64_t, ptr< vector< uint8_t > > >& _shards, uint64_t _dataSize ) const {
+    CHECK_ARGUMENT( _shards.size() >= dataShards );
+    CHECK_ARGUMENT( _dataSize > 0 );
+
+    auto shardSize = getShardSize( _dataSize, dataShards );
+
+    // use the first dataShards shards, data shards sort first and need no work
+    vector< uint64_t > indices;
+    vector< const uint8_t* > inputs;
+    for ( auto&& [index, shard] : _shards ) {
+        if ( indices.size() == dataShards )
+            break;
+        CHECK_ARGUMENT( index < totalShards );
+        CHECK_ARGUMENT( shard && shard->size() == shardSize );
+        indices.push_back( index );
+        inputs.push_back( shard->data() );
+    }
+
+    auto result = make_shared< vector< uint8_t > >( dataShards * shardSize, 0 );
+
+    vector< uint8_t > matrix;
+    matrix.reserve( dataShards * dataShards );
+    bool haveAllData = true;
+    for ( uint64_t i = 0; i < dataShards; i++ ) {
+        auto row = getMatrixRow( indices[i] );
+        matrix.insert( matrix.end(), row.begin(), row.end() );
+        haveAllData = haveAllData && indices[i] == i;
+    }
+
+    if ( haveAllData ) {
+        for ( uint64_t i = 0; i < dataShards; i++ ) {
+            memcpy( result->data() + i * shardSize, inputs[i], shardSize );
+        }
+    } else {
+        auto decodeMatrix = invertMatrix( matrix, dataShards );
+
+        vector< const uint8_t* > received( dataShards, nullptr );
+        for ( uint64_t j = 0; j < dataShards; j++ ) {
+            if ( indices[j] < dataShards )
+                received[indices[j]] = inputs[j];
+        }
+
+        for ( uint64_t i = 0; i < dataShards; i++ ) {
+            auto out = result->data() + i * shardSize;
+            // data shards that arrived are copied, only the missing ones are computed
+            if ( received[i] ) {
+                memcpy( out, received[i], shardSize );
+                continue;
+            }
+            for ( uint64_t j = 0; j < dataShards; j++ ) {
+                mulAdd( out, inputs[j], decodeMatrix[i * dataShards + j], shardSize );
+            }
+        }
+    }
+
+    result->resize( _dataSize );
+    return result;
+}
+
+
+uint64_t ReedSolomon::getDataShards() const {
+    return dataShards;
+}
+
+
+uint64_t ReedSolomon::getTotalShards() const {
+    return totalShards;
+}
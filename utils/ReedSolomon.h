@@ -0,0 +1,70 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file ReedSolomon.h
+    @author Stan Kladko
+    @date 2026
+*/
+
+#pragma once
+
+
+// Systematic Reed-Solomon code over GF(2^8). Data is split into dataShards equal shards, padded
+// with zeros, and parityShards = totalShards - dataShards parity shards are computed from a
+// Cauchy matrix, so any dataShards of the totalShards shards reconstruct the data.
+// The multiply-accumulate inner loop uses AVX2 or SSSE3 when the CPU has them.
+class ReedSolomon {
+    uint64_t dataShards = 0;
+    uint64_t totalShards = 0;
+
+    // (totalShards - dataShards) x dataShards
+    vector< uint8_t > parityMatrix;
+
+    static atomic< bool > simdEnabled;
+
+    vector< uint8_t > getMatrixRow( uint64_t _shardIndex ) const;
+
+    static vector< uint8_t > invertMatrix( vector< uint8_t > _matrix, uint64_t _size );
+
+public:
+    ReedSolomon( uint64_t _dataShards, uint64_t _totalShards );
+
+    static uint64_t getShardSize( uint64_t _dataSize, uint64_t _dataShards );
+
+    // computes one shard, shards are numbered from 0 and the first dataShards are the data
+    [[nodiscard]] ptr< vector< uint8_t > > encodeShard(
+        const uint8_t* _data, uint64_t _dataSize, uint64_t _shardIndex ) const;
+
+    // reconstructs _dataSize bytes from at least dataShards distinct shards
+    [[nodiscard]] ptr< vector< uint8_t > > decode(
+        const map< uint64_t, ptr< vector< uint8_t > > >& _shards, uint64_t _dataSize ) const;
+
+    [[nodiscard]] uint64_t getDataShards() const;
+
+    [[nodiscard]] uint64_t getTotalShards() const;
+
+    // _dst ^= _c * _src in GF(2^8)
+    static void mulAdd( uint8_t* _dst, const uint8_t* _src, uint8_t _c, uint64_t _len );
+
+    static uint8_t mul( uint8_t _a, uint8_t _b );
+
+    static uint8_t inverse( uint8_t _a );
+
+    // used by tests and benchmarks to compare with the scalar code
+    static void setSimdEnabled( bool _enabled );
+};
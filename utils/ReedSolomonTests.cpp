@@ -0,0 +1,137 @@
+/*
+    Copyright (C) 2026 SKALE Labs
+
+    This file is part of skale-consensus.
+
+    skale-consensus is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published
+    by the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    skale-consensus is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with skale-consensus.  If not, see <https://www.gnu.org/licenses/>.
+
+    @file ReedSolomonTests.cpp
+    @author Stan Kladko
+    @date 2026
+*/
+
+
+#include "SkaleCommon.h"
+#include "Log.h"
+#include "thirdparty/catch.hpp"
+
+#include "ReedSolomon.h"
+
+
+static ptr< vector< uint8_t > > createRandomData( uint64_t _size, mt19937& _generator ) {
+    auto data = make_shared< vector< uint8_t > >( _size );
+    for ( auto&& b : *data ) {
+        b = ( uint8_t ) _generator();
+    }
+    return data;
+}
+
+
+TEST_CASE( "Reed-Solomon field arithmetic", "[reed-solomon]" ) {
+    for ( uint32_t a = 1; a < 256; a++ ) {
+        REQUIRE( ReedSolomon::mul( a, ReedSolomon::inverse( a ) ) == 1 );
+        REQUIRE( ReedSolomon::mul( a, 1 ) == a );
+        REQUIRE( ReedSolomon::mul( a, 0 ) == 0 );
+    }
+
+    // the SIMD kernels agree with the scalar code, including the unaligned tails
+    mt19937 generator( 1 );
+    auto src = createRandomData( 1000, generator );
+    for ( uint32_t c : { 1, 2, 29, 142, 255 } ) {
+        vector< uint8_t > simd( 1000, 7 );
+        vector< uint8_t > scalar( 1000, 7 );
+        ReedSolomon::mulAdd( simd.data() + 3, src->data() + 1, c, 990 );
+        ReedSolomon::setSimdEnabled( false );
+        ReedSolomon::mulAdd( scalar.data() + 3, src->data() + 1, c, 990 );
+        ReedSolomon::setSimdEnabled( true );
+        REQUIRE( simd == scalar );
+        REQUIRE( scalar[3] == ( 7 ^ ReedSolomon::mul( c, src->at( 1 ) ) ) );
+    }
+}
+
+
+TEST_CASE( "Reed-Solomon reconstructs from any data shard count", "[reed-solomon]" ) {
+    mt19937 generator( 2 );
+
+    // chains of 4 and 16 nodes, and a size that does not split evenly
+    for ( auto [dataShards, totalShards] : { pair( 2, 3 ), pair( 10, 15 ), pair( 1, 1 ) } ) {
+        ReedSolomon code( dataShards, totalShards );
+
+        for ( uint64_t size : { 1, 17, 1000, 65537 } ) {
+            auto data = createRandomData( size, generator );
+
+            vector< ptr< vector< uint8_t > > > shards;
+            for ( uint64_t i = 0; i < ( uint64_t ) totalShards; i++ ) {
+                shards.push_back( code.encodeShard( data->data(), size, i ) );
+                REQUIRE( shards.back()->size() == ReedSolomon::getShardSize( size, dataShards ) );
+            }
+
+            for ( int attempt = 0; attempt < 20; attempt++ ) {
+                vector< uint64_t > indices( totalShards );
+                iota( indices.begin(), indices.end(), 0 );
+                shuffle( indices.begin(), indices.end(), generator );
+
+                map< uint64_t, ptr< vector< uint8_t > > > received;
+                for ( int i = 0; i < dataShards; i++ ) {
+                    received[indices[i]] = shards[indices[i]];
+                }
+
+                REQUIRE( *code.decode( received, size ) == *data );
+            }
+        }
+    }
+}
+
+
+TEST_CASE( "Reed-Solomon encode and decode speed", "[.benchmark]" ) {
+    mt19937 generator( 3 );
+    // a 16 node chain, any 10 of the 15 peers reconstruct a proposal
+    ReedSolomon code( 10, 15 );
+
+    for ( bool simd : { false, true } ) {
+        ReedSolomon::setSimdEnabled( simd );
+
+        for ( uint64_t megabytes : { 1, 2, 4, 8, 16 } ) {
+            auto size = megabytes * 1024 * 1024;
+            auto data = createRandomData( size, generator );
+
+            auto begin = chrono::steady_clock::now();
+            map< uint64_t, ptr< vector< uint8_t > > > shards;
+            for ( uint64_t i = 0; i < code.getTotalShards(); i++ ) {
+                shards[i] = code.encodeShard( data->data(), size, i );
+            }
+            auto encodeUs =
+                chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - begin )
+                    .count();
+
+            // the worst case, as many data shards as there are parity shards are lost
+            for ( uint64_t i = 0; i < code.getTotalShards() - code.getDataShards(); i++ ) {
+                shards.erase( i );
+            }
+
+            begin = chrono::steady_clock::now();
+            auto decoded = code.decode( shards, size );
+            auto decodeUs =
+                chrono::duration_cast< chrono::microseconds >( chrono::steady_clock::now() - begin )
+                    .count();
+
+            REQUIRE( *decoded == *data );
+
+            WARN( ( simd ? "SIMD" : "Scalar" ) << " " << megabytes
+                  << "MB encode us:" << encodeUs << " decode us:" << decodeUs );
+        }
+    }
+
+    ReedSolomon::setSimdEnabled( true );
+}
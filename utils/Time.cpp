@@ -40,3 +40,17 @@ uint64_t Time::getCurrentTimeMs() {
                           .count();
     return result;
 }
+
+
+uint64_t Time::getCoarseTimeMs() {
+    timespec now;
+    CHECK_STATE( clock_gettime( CLOCK_REALTIME_COARSE, &now ) == 0 );
+    return ( uint64_t ) now.tv_sec * 1000 + ( uint64_t ) now.tv_nsec / 1000000;
+}
+
+
+uint64_t Time::getMonotonicTimeUs() {
+    return chrono::duration_cast< chrono::microseconds >(
+        chrono::steady_clock::now().time_since_epoch() )
+        .count();
+}
@@ -30,6 +30,12 @@ public:
     static uint64_t getCurrentTimeSec();
 
     static uint64_t getCurrentTimeMs();
+
+    // wall clock at timer tick resolution, a few ms, much cheaper than getCurrentTimeMs
+    static uint64_t getCoarseTimeMs();
+
+    // steady clock, only meaningful for measuring durations
+    static uint64_t getMonotonicTimeUs();
 };
 
 